@@ -8,6 +8,7 @@
 #include <piejam/fx_modules/init.h>
 #include <piejam/gui/init.h>
 #include <piejam/gui/model/Info.h>
+#include <piejam/gui/model/PitchGenerator.h>
 #include <piejam/gui/model/Root.h>
 #include <piejam/gui/qt_log.h>
 #include <piejam/ladspa/instance_manager_processor_factory.h>
@@ -19,6 +20,8 @@
 #include <piejam/network_manager/nfs_client.h>
 #include <piejam/network_manager/nfs_server.h>
 #include <piejam/network_manager/wifi_manager.h>
+#include <piejam/numeric/dft_plans.h>
+#include <piejam/numeric/simd/isa.h>
 #include <piejam/range/iota.h>
 #include <piejam/redux/middleware_factory.h>
 #include <piejam/redux/queueing_middleware.h>
@@ -53,6 +56,8 @@
 #include <piejam/system/disk_usage.h>
 #include <piejam/system/memory.h>
 #include <piejam/thread/affinity.h>
+#include <piejam/thread/configuration.h>
+#include <piejam/thread/placement.h>
 
 #include <QQuickStyle>
 #include <QQuickWindow>
@@ -68,7 +73,9 @@
 #include <boost/core/demangle.hpp>
 #include <boost/polymorphic_cast.hpp>
 
+#include <array>
 #include <filesystem>
+#include <thread>
 
 namespace
 {
@@ -102,6 +109,42 @@ create_directories_if_missing(piejam::runtime::locations const& locs)
     return;
 }
 
+// Plans are shared, creating them ahead saves the spectrum analyzers and the
+// tuners from planning when they are opened.
+auto
+prepare_dft_plans(std::filesystem::path const& wisdom_file) -> std::jthread
+{
+    if (!piejam::numeric::dft_plans::import_wisdom(wisdom_file))
+    {
+        spdlog::info("no fftw wisdom loaded from: {}", wisdom_file.string());
+    }
+
+    return std::jthread([wisdom_file]() {
+        piejam::thread::configuration{
+            .affinity = std::nullopt,
+            .realtime_priority = std::nullopt,
+            .name = "dft_plans"}
+            .apply();
+
+        static constexpr std::array sizes{2048uz, 4096uz, 8192uz, 16384uz};
+        piejam::numeric::dft_plans::prepare(sizes);
+
+        // the tuner correlates with an inverse transform of its window
+        static constexpr std::array inverse_sizes{
+            piejam::gui::model::PitchGenerator::windowSize};
+        piejam::numeric::dft_plans::prepare(
+            inverse_sizes,
+            piejam::numeric::dft_plans::direction::inverse);
+
+        if (!piejam::numeric::dft_plans::export_wisdom(wisdom_file))
+        {
+            spdlog::warn(
+                "could not export fftw wisdom to: {}",
+                wisdom_file.string());
+        }
+    });
+}
+
 constexpr int realtime_priority = 96;
 
 struct QtThreadDelegator
@@ -171,6 +214,13 @@ main(int argc, char* argv[]) -> int
     // Flush log every 5 seconds so logs survive unexpected power loss
     spdlog::flush_every(std::chrono::seconds(5));
 
+    // select the simd kernels now, not on first use in the audio thread
+    spdlog::info(
+        "simd kernels: {}",
+        numeric::simd::to_string(numeric::simd::active_isa_level()));
+
+    auto dft_plans_thread = prepare_dft_plans(locs.fftw_wisdom_file);
+
     QGuiApplication app(argc, argv);
 
     QQuickStyle::setStyle("Material");
@@ -198,6 +248,28 @@ main(int argc, char* argv[]) -> int
         },
         runtime::make_initial_state());
 
+    thread::configuration const audio_main{
+        .affinity = hw_threads > 1 ? 1 : 0,
+        .realtime_priority = realtime_priority,
+        .name = "audio_main"};
+
+    auto audio_workers = piejam::algorithm::transform_to_vector(
+        piejam::range::iota(hw_threads - 1),
+        [=](std::size_t const i) {
+            std::size_t const cpu = (2 + i) % hw_threads;
+            return thread::configuration{
+                .affinity = cpu,
+                .realtime_priority = realtime_priority,
+                .name = std::format("audio_worker_{}", i)};
+        });
+
+    // the background work stays off the cpus of the audio threads
+    std::vector<thread::configuration> audio_threads{audio_main};
+    audio_threads.insert(
+        audio_threads.end(),
+        audio_workers.begin(),
+        audio_workers.end());
+
     store.apply_middleware(
         middleware_factory::make<runtime::persistence_middleware>(
             locs.home_dir,
@@ -205,7 +277,8 @@ main(int argc, char* argv[]) -> int
 
     store.apply_middleware(
         middleware_factory::make<runtime::recorder_middleware>(
-            locs.recordings_dir));
+            locs.recordings_dir,
+            thread::background_cpus(audio_threads)));
 
     auto network_ctrl =
         std::make_shared<network_manager::network_controller>();
@@ -214,26 +287,14 @@ main(int argc, char* argv[]) -> int
     auto nfs_cli = std::make_shared<network_manager::nfs_client>(
         locs.config_dir / "nfs_mounts.json");
 
-    auto audio_workers = piejam::algorithm::transform_to_vector(
-        piejam::range::iota(hw_threads - 1),
-        [=](std::size_t const i) {
-            std::size_t const cpu = (2 + i) % hw_threads;
-            return thread::configuration{
-                .affinity = cpu,
-                .realtime_priority = realtime_priority,
-                .name = std::format("audio_worker_{}", i)};
-        });
-
     store.apply_middleware(
         middleware_factory::make<runtime::audio_engine_middleware>(
-            thread::configuration{
-                .affinity = hw_threads > 1 ? 1 : 0,
-                .realtime_priority = realtime_priority,
-                .name = "audio_main"},
+            audio_main,
             audio_workers,
             audio::get_default_sound_card_manager(),
             ladspa_manager,
-            runtime::make_midi_input_controller(*midi_device_manager)));
+            runtime::make_midi_input_controller(*midi_device_manager),
+            thread::background_cpus(audio_threads)));
 
     store.apply_middleware(
         middleware_factory::make<runtime::midi_control_middleware>(
@@ -344,5 +405,13 @@ main(int argc, char* argv[]) -> int
     store.dispatch(runtime::actions::save_app_config{locs.config_file});
     store.dispatch(runtime::actions::shutdown{});
 
+    dft_plans_thread.join();
+    if (!numeric::dft_plans::export_wisdom(locs.fftw_wisdom_file))
+    {
+        spdlog::warn(
+            "could not export fftw wisdom to: {}",
+            locs.fftw_wisdom_file.string());
+    }
+
     return app_exec_result;
 }
@@ -0,0 +1,124 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/biquad.h>
+#include <piejam/audio/dsp/biquad_bank.h>
+#include <piejam/audio/dsp/biquad_filter.h>
+
+#include <mipp.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <ctime>
+#include <span>
+
+namespace piejam::audio::dsp
+{
+
+namespace
+{
+
+auto
+lp_coefficients() -> biquad<float>::coefficients
+{
+    return biquad_filter::make_lp_coefficients(1000.f, 0.5f, 1.f / 48000.f);
+}
+
+auto
+noise(std::size_t const size) -> mipp::vector<float>
+{
+    mipp::vector<float> result(size);
+    std::ranges::generate(result, []() {
+        return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX) *
+                   2.f -
+               1.f;
+    });
+    return result;
+}
+
+} // namespace
+
+// One scalar biquad per channel and section, as the filter module ran them.
+template <std::size_t NumChannels, std::size_t NumSections>
+static void
+BM_biquad_scalar(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    std::array<mipp::vector<float>, NumChannels> bufs;
+    std::ranges::generate(bufs, [&]() { return noise(buffer_size); });
+
+    std::array<std::array<biquad<float>, NumSections>, NumChannels> filters;
+    for (auto& channel_filters : filters)
+    {
+        channel_filters.fill(biquad<float>{lp_coefficients()});
+    }
+
+    for (auto _ : state)
+    {
+        for (std::size_t ch = 0; ch < NumChannels; ++ch)
+        {
+            for (auto& filter : filters[ch])
+            {
+                std::ranges::transform(
+                    bufs[ch],
+                    bufs[ch].begin(),
+                    [&filter](float const x) { return filter.process(x); });
+            }
+        }
+
+        benchmark::ClobberMemory();
+    }
+}
+
+template <std::size_t NumChannels, std::size_t NumSections>
+static void
+BM_biquad_bank(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    std::array<mipp::vector<float>, NumChannels> bufs;
+    std::ranges::generate(bufs, [&]() { return noise(buffer_size); });
+
+    std::array<std::span<float const>, NumChannels> in;
+    std::array<std::span<float>, NumChannels> out;
+    for (std::size_t ch = 0; ch < NumChannels; ++ch)
+    {
+        in[ch] = bufs[ch];
+        out[ch] = bufs[ch];
+    }
+
+    biquad_bank<float, NumChannels, NumSections> bank;
+    for (std::size_t section = 0; section < NumSections; ++section)
+    {
+        bank.set_coefficients(section, lp_coefficients());
+    }
+
+    for (auto _ : state)
+    {
+        bank.process(in, out);
+
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_biquad_scalar<1, 1>)->RangeMultiplier(2)->Range(64, 1024);
+BENCHMARK(BM_biquad_bank<1, 1>)->RangeMultiplier(2)->Range(64, 1024);
+BENCHMARK(BM_biquad_scalar<2, 1>)->RangeMultiplier(2)->Range(64, 1024);
+BENCHMARK(BM_biquad_bank<2, 1>)->RangeMultiplier(2)->Range(64, 1024);
+BENCHMARK(BM_biquad_scalar<1, 2>)->RangeMultiplier(2)->Range(64, 1024);
+BENCHMARK(BM_biquad_bank<1, 2>)->RangeMultiplier(2)->Range(64, 1024);
+BENCHMARK(BM_biquad_scalar<2, 2>)->RangeMultiplier(2)->Range(64, 1024);
+BENCHMARK(BM_biquad_bank<2, 2>)->RangeMultiplier(2)->Range(64, 1024);
+BENCHMARK(BM_biquad_scalar<2, 4>)->RangeMultiplier(2)->Range(64, 1024);
+BENCHMARK(BM_biquad_bank<2, 4>)->RangeMultiplier(2)->Range(64, 1024);
+
+} // namespace piejam::audio::dsp
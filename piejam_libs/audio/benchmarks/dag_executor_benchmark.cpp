@@ -0,0 +1,81 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/dag.h>
+
+#include <piejam/audio/engine/dag_executor.h>
+#include <piejam/audio/engine/rt_task_executor.h>
+#include <piejam/audio/engine/thread_context.h>
+
+#include <mipp.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+namespace
+{
+
+// A source, fanning out to a number of parallel tasks, merged into a sink.
+// Each parallel task scales a period, the typical work of a mixer channel.
+struct fan_out_fan_in
+{
+    explicit fan_out_fan_in(std::size_t const num_tasks)
+        : bufs(num_tasks, mipp::vector<float>(1024, 0.5f))
+    {
+        auto const source_id = graph.add_task([](thread_context const&) {});
+        auto const sink_id = graph.add_task([](thread_context const&) {});
+
+        for (auto& buf : bufs)
+        {
+            auto const id = graph.add_child_task(
+                source_id,
+                [&buf](thread_context const& ctx) {
+                    std::for_each_n(
+                        buf.begin(),
+                        ctx.buffer_size,
+                        [](float& x) { x *= 0.99f; });
+                });
+            graph.add_child(id, sink_id);
+        }
+    }
+
+    std::vector<mipp::vector<float>> bufs;
+    dag graph;
+};
+
+} // namespace
+
+// NumWorkers == 0 runs the dag on the calling thread only.
+template <std::size_t NumWorkers>
+static void
+BM_dag_executor(benchmark::State& state)
+{
+    fan_out_fan_in sut(state.range(0));
+
+    std::vector<rt_task_executor> workers(NumWorkers);
+    auto executor = sut.graph.make_runnable(workers);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize((*executor)(state.range(1)));
+    }
+}
+
+BENCHMARK(BM_dag_executor<0>)
+    ->ArgsProduct({{1, 4, 16, 64}, {64, 256, 1024}})
+    ->UseRealTime();
+BENCHMARK(BM_dag_executor<1>)
+    ->ArgsProduct({{1, 4, 16, 64}, {64, 256, 1024}})
+    ->UseRealTime();
+BENCHMARK(BM_dag_executor<3>)
+    ->ArgsProduct({{1, 4, 16, 64}, {64, 256, 1024}})
+    ->UseRealTime();
+
+} // namespace piejam::audio::engine
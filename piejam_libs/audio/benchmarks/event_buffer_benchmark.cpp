@@ -0,0 +1,94 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/event_buffer.h>
+
+#include <piejam/audio/engine/event_buffer_memory.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <memory_resource>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+namespace
+{
+
+// Offsets within a period of 1024 frames.
+auto
+offsets(std::size_t const num_events, bool const ordered)
+    -> std::vector<std::size_t>
+{
+    std::srand(std::time(nullptr));
+
+    std::vector<std::size_t> result(num_events);
+    for (std::size_t i = 0; i < num_events; ++i)
+    {
+        result[i] = ordered ? i * 1024 / num_events
+                            : static_cast<std::size_t>(std::rand()) % 1024;
+    }
+    return result;
+}
+
+} // namespace
+
+template <bool Ordered>
+static void
+BM_event_buffer_insert(benchmark::State& state)
+{
+    auto const ev_offsets = offsets(state.range(0), Ordered);
+
+    event_buffer_memory ev_buf_mem(1u << 16);
+    std::pmr::memory_resource* ev_buf_pmr_mem{&ev_buf_mem.memory_resource()};
+    event_buffer<float> sut(ev_buf_pmr_mem);
+
+    for (auto _ : state)
+    {
+        for (std::size_t const offset : ev_offsets)
+        {
+            sut.insert(offset, 1.f);
+        }
+
+        benchmark::DoNotOptimize(sut.size());
+
+        sut.clear();
+        ev_buf_mem.release();
+    }
+}
+
+static void
+BM_event_buffer_iterate(benchmark::State& state)
+{
+    auto const ev_offsets = offsets(state.range(0), false);
+
+    event_buffer_memory ev_buf_mem(1u << 16);
+    std::pmr::memory_resource* ev_buf_pmr_mem{&ev_buf_mem.memory_resource()};
+    event_buffer<float> sut(ev_buf_pmr_mem);
+
+    for (std::size_t const offset : ev_offsets)
+    {
+        sut.insert(offset, 1.f);
+    }
+
+    for (auto _ : state)
+    {
+        float sum{};
+        for (event<float> const& ev : sut)
+        {
+            sum += ev.value();
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_event_buffer_insert<true>)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(BM_event_buffer_insert<false>)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(BM_event_buffer_iterate)->RangeMultiplier(4)->Range(1, 256);
+
+} // namespace piejam::audio::engine
@@ -0,0 +1,85 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/lookahead_limiter.h>
+
+#include <mipp.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <ctime>
+#include <span>
+
+namespace piejam::audio::dsp
+{
+
+namespace
+{
+
+// 1.5 ms at 48 kHz
+constexpr std::size_t lookahead = 72;
+
+auto
+loud_noise(std::size_t const size) -> mipp::vector<float>
+{
+    mipp::vector<float> result(size);
+    std::ranges::generate(result, []() {
+        return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX) *
+                   4.f -
+               2.f;
+    });
+    return result;
+}
+
+} // namespace
+
+// The items are channel samples, items_per_second is the cost per channel.
+template <std::size_t NumChannels, bool TruePeak>
+static void
+BM_lookahead_limiter(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    // not in place, otherwise the input would get quieter in every iteration
+    std::array<mipp::vector<float>, NumChannels> in_bufs;
+    std::ranges::generate(in_bufs, [&]() { return loud_noise(buffer_size); });
+    std::array<mipp::vector<float>, NumChannels> out_bufs;
+    out_bufs.fill(mipp::vector<float>(buffer_size));
+
+    std::array<std::span<float const>, NumChannels> in;
+    std::array<std::span<float>, NumChannels> out;
+    for (std::size_t ch = 0; ch < NumChannels; ++ch)
+    {
+        in[ch] = in_bufs[ch];
+        out[ch] = out_bufs[ch];
+    }
+
+    lookahead_limiter<float, NumChannels> limiter(lookahead);
+    limiter.set_threshold(.5f);
+    limiter.set_release(.9995f);
+    limiter.set_true_peak(TruePeak);
+
+    for (auto _ : state)
+    {
+        limiter.process(in, out);
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(state.iterations() * buffer_size) *
+        NumChannels);
+}
+
+BENCHMARK(BM_lookahead_limiter<1, false>)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_lookahead_limiter<1, true>)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_lookahead_limiter<2, false>)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_lookahead_limiter<2, true>)->RangeMultiplier(4)->Range(64, 1024);
+
+} // namespace piejam::audio::dsp
@@ -2,16 +2,26 @@
 // SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <piejam/audio/engine/event_input_buffers.h>
+#include <piejam/audio/engine/event_output_buffers.h>
+#include <piejam/audio/engine/mix_processor.h>
+#include <piejam/audio/engine/multiply_processor.h>
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/engine/processor.h>
+#include <piejam/audio/engine/weighted_sum_processor.h>
 #include <piejam/audio/slice_algorithms.h>
 
 #include <benchmark/benchmark.h>
 
 #include <algorithm>
+#include <array>
 #include <cstdlib>
 #include <ctime>
 #include <functional>
+#include <memory>
 #include <numeric>
 #include <span>
+#include <vector>
 
 constexpr auto min_period_size = 16;
 constexpr auto max_period_size = 1024;
@@ -173,3 +183,144 @@ BM_multiply_audio_slice_by_constant(benchmark::State& state)
 BENCHMARK(BM_multiply_audio_slice_by_constant)
     ->RangeMultiplier(2)
     ->Range(min_period_size, max_period_size);
+
+namespace
+{
+
+// Signals with their gains, as the inputs of the gain stages feeding a mixer.
+template <std::size_t NumTerms, bool ConstantGains>
+struct gain_stages_fixture
+{
+    explicit gain_stages_fixture(std::size_t const buffer_size)
+    {
+        std::srand(std::time(nullptr));
+
+        for (std::size_t term = 0; term < NumTerms; ++term)
+        {
+            signal_bufs[term] = mipp::vector<float>(
+                buffer_size,
+                static_cast<float>(rand()) / static_cast<float>(RAND_MAX));
+            gain_bufs[term] = mipp::vector<float>(
+                buffer_size,
+                static_cast<float>(rand()) / static_cast<float>(RAND_MAX));
+
+            signals[term] = piejam::audio::slice<float>(signal_bufs[term]);
+
+            if constexpr (ConstantGains)
+            {
+                gains[term] = piejam::audio::slice<float>(gain_bufs[term][0]);
+            }
+            else
+            {
+                gains[term] = piejam::audio::slice<float>(gain_bufs[term]);
+            }
+        }
+    }
+
+    std::array<mipp::vector<float>, NumTerms> signal_bufs;
+    std::array<mipp::vector<float>, NumTerms> gain_bufs;
+    std::array<piejam::audio::slice<float>, NumTerms> signals;
+    std::array<piejam::audio::slice<float>, NumTerms> gains;
+};
+
+} // namespace
+
+// A multiply processor per term, summed by a mix processor.
+template <std::size_t NumTerms, bool ConstantGains>
+static void
+BM_mix_gain_stages_separate(benchmark::State& state)
+{
+    using namespace piejam::audio;
+    using namespace piejam::audio::engine;
+
+    std::size_t const buffer_size = state.range(0);
+    gain_stages_fixture<NumTerms, ConstantGains> fx(buffer_size);
+
+    using input_refs = std::vector<std::reference_wrapper<slice<float> const>>;
+
+    std::array<std::unique_ptr<processor>, NumTerms> amps;
+    std::array<input_refs, NumTerms> amp_ins;
+    std::array<mipp::vector<float>, NumTerms> amp_out_bufs;
+    std::array<std::vector<std::span<float>>, NumTerms> amp_outs;
+    std::array<std::vector<slice<float>>, NumTerms> amp_results;
+    input_refs mix_ins;
+
+    for (std::size_t term = 0; term < NumTerms; ++term)
+    {
+        amps[term] = make_multiply_processor(2);
+        amp_ins[term] = {fx.signals[term], fx.gains[term]};
+        amp_out_bufs[term] = mipp::vector<float>(buffer_size);
+        amp_outs[term] = {amp_out_bufs[term]};
+        amp_results[term] = {{}};
+        mix_ins.emplace_back(amp_results[term][0]);
+    }
+
+    auto mixer = make_mix_processor(NumTerms);
+    mipp::vector<float> out_buf(buffer_size);
+    std::vector<std::span<float>> out{out_buf};
+    std::vector<slice<float>> res{{}};
+
+    for (auto _ : state)
+    {
+        for (std::size_t term = 0; term < NumTerms; ++term)
+        {
+            amps[term]->process(
+                {amp_ins[term],
+                 amp_outs[term],
+                 amp_results[term],
+                 {},
+                 {},
+                 buffer_size});
+        }
+
+        mixer->process({mix_ins, out, res, {}, {}, buffer_size});
+        benchmark::ClobberMemory();
+    }
+}
+
+// The same sum, computed by a single weighted sum processor.
+template <std::size_t NumTerms, bool ConstantGains>
+static void
+BM_mix_gain_stages_fused(benchmark::State& state)
+{
+    using namespace piejam::audio;
+    using namespace piejam::audio::engine;
+
+    std::size_t const buffer_size = state.range(0);
+    gain_stages_fixture<NumTerms, ConstantGains> fx(buffer_size);
+
+    std::vector<std::reference_wrapper<slice<float> const>> in;
+    for (std::size_t term = 0; term < NumTerms; ++term)
+    {
+        in.emplace_back(fx.signals[term]);
+        in.emplace_back(fx.gains[term]);
+    }
+
+    auto sut = make_weighted_sum_processor(NumTerms);
+    mipp::vector<float> out_buf(buffer_size);
+    std::vector<std::span<float>> out{out_buf};
+    std::vector<slice<float>> res{{}};
+
+    for (auto _ : state)
+    {
+        sut->process({in, out, res, {}, {}, buffer_size});
+        benchmark::ClobberMemory();
+    }
+}
+
+#define PIEJAM_MIX_GAIN_STAGES_BENCHMARK(terms, constant_gains)                \
+    BENCHMARK(BM_mix_gain_stages_separate<terms, constant_gains>)              \
+        ->RangeMultiplier(2)                                                   \
+        ->Range(min_period_size, max_period_size);                             \
+    BENCHMARK(BM_mix_gain_stages_fused<terms, constant_gains>)                 \
+        ->RangeMultiplier(2)                                                   \
+        ->Range(min_period_size, max_period_size)
+
+PIEJAM_MIX_GAIN_STAGES_BENCHMARK(2, true);
+PIEJAM_MIX_GAIN_STAGES_BENCHMARK(4, true);
+PIEJAM_MIX_GAIN_STAGES_BENCHMARK(8, true);
+PIEJAM_MIX_GAIN_STAGES_BENCHMARK(2, false);
+PIEJAM_MIX_GAIN_STAGES_BENCHMARK(4, false);
+PIEJAM_MIX_GAIN_STAGES_BENCHMARK(8, false);
+
+#undef PIEJAM_MIX_GAIN_STAGES_BENCHMARK
@@ -0,0 +1,122 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/pan.h>
+
+#include <piejam/audio/pair.h>
+
+#include <mipp.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace piejam::audio::dsp
+{
+
+namespace
+{
+
+// Positions of a sweep from hard left to hard right.
+auto
+sweep(std::size_t const size) -> std::vector<float>
+{
+    std::vector<float> result(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result[i] = -1.f + 2.f * static_cast<float>(i) /
+                               static_cast<float>(size);
+    }
+    return result;
+}
+
+template <auto Law>
+void
+BM_pan_law(benchmark::State& state)
+{
+    std::size_t const buffer_size = state.range(0);
+
+    auto const positions = sweep(buffer_size);
+    std::vector<pair<float>> gains(buffer_size);
+
+    for (auto _ : state)
+    {
+        std::ranges::transform(positions, gains.begin(), Law);
+        benchmark::ClobberMemory();
+    }
+}
+
+// The law evaluated on simd registers, as done while a position is smoothed.
+template <auto Law>
+void
+BM_pan_law_simd(benchmark::State& state)
+{
+    std::size_t const buffer_size = state.range(0);
+    constexpr std::size_t N = mipp::N<float>();
+
+    auto const positions = sweep(buffer_size);
+    mipp::vector<float> left(buffer_size);
+    mipp::vector<float> right(buffer_size);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i + N <= buffer_size; i += N)
+        {
+            mipp::Reg<float> position;
+            position.loadu(positions.data() + i);
+            pair<mipp::Reg<float>> const gains = Law(position);
+            gains.left.storeu(left.data() + i);
+            gains.right.storeu(right.data() + i);
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+} // namespace
+
+static void
+BM_sinusoidal_constant_power_pan(benchmark::State& state)
+{
+    BM_pan_law<&sinusoidal_constant_power_pan<float>>(state);
+}
+
+static void
+BM_sinusoidal_constant_power_pan_exact(benchmark::State& state)
+{
+    BM_pan_law<&sinusoidal_constant_power_pan_exact<float>>(state);
+}
+
+static void
+BM_stereo_balance(benchmark::State& state)
+{
+    BM_pan_law<&stereo_balance<float>>(state);
+}
+
+static void
+BM_sinusoidal_constant_power_pan_simd(benchmark::State& state)
+{
+    BM_pan_law_simd<
+        &sinusoidal_constant_power_pan<float, mipp::Reg<float>>>(state);
+}
+
+static void
+BM_stereo_balance_simd(benchmark::State& state)
+{
+    BM_pan_law_simd<&stereo_balance<float, mipp::Reg<float>>>(state);
+}
+
+BENCHMARK(BM_sinusoidal_constant_power_pan)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024);
+BENCHMARK(BM_sinusoidal_constant_power_pan_simd)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024);
+BENCHMARK(BM_sinusoidal_constant_power_pan_exact)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024);
+BENCHMARK(BM_stereo_balance)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_stereo_balance_simd)->RangeMultiplier(4)->Range(64, 1024);
+
+} // namespace piejam::audio::dsp
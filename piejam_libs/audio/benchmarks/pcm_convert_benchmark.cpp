@@ -0,0 +1,90 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/pcm_convert.h>
+
+#include <piejam/audio/pcm_format.h>
+#include <piejam/audio/pcm_sample_type.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+namespace piejam::audio::pcm_convert
+{
+
+// Per sample conversion, as the alsa process step does it for the formats
+// without simd kernels.
+template <pcm_format F>
+static void
+BM_pcm_convert_from(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    std::vector<pcm_sample_t<F>> in(buffer_size);
+    std::ranges::generate(in, []() {
+        return to<F>(static_cast<float>(std::rand()) /
+                     static_cast<float>(RAND_MAX));
+    });
+    std::vector<float> out(buffer_size);
+
+    for (auto _ : state)
+    {
+        std::ranges::transform(in, out.begin(), &from<F>);
+        benchmark::ClobberMemory();
+    }
+}
+
+template <pcm_format F>
+static void
+BM_pcm_convert_to(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    std::vector<float> in(buffer_size);
+    std::ranges::generate(in, []() {
+        return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+    });
+    std::vector<pcm_sample_t<F>> out(buffer_size);
+
+    for (auto _ : state)
+    {
+        std::ranges::transform(in, out.begin(), &to<F>);
+        benchmark::ClobberMemory();
+    }
+}
+
+#define PIEJAM_PCM_CONVERT_BENCHMARK(format)                                   \
+    BENCHMARK(BM_pcm_convert_from<pcm_format::format>)                         \
+        ->RangeMultiplier(4)                                                   \
+        ->Range(64, 1024);                                                     \
+    BENCHMARK(BM_pcm_convert_to<pcm_format::format>)                           \
+        ->RangeMultiplier(4)                                                   \
+        ->Range(64, 1024)
+
+PIEJAM_PCM_CONVERT_BENCHMARK(s8);
+PIEJAM_PCM_CONVERT_BENCHMARK(u8);
+PIEJAM_PCM_CONVERT_BENCHMARK(s16_le);
+PIEJAM_PCM_CONVERT_BENCHMARK(s16_be);
+PIEJAM_PCM_CONVERT_BENCHMARK(u16_le);
+PIEJAM_PCM_CONVERT_BENCHMARK(u16_be);
+PIEJAM_PCM_CONVERT_BENCHMARK(s32_le);
+PIEJAM_PCM_CONVERT_BENCHMARK(s32_be);
+PIEJAM_PCM_CONVERT_BENCHMARK(u32_le);
+PIEJAM_PCM_CONVERT_BENCHMARK(u32_be);
+PIEJAM_PCM_CONVERT_BENCHMARK(s24_3le);
+PIEJAM_PCM_CONVERT_BENCHMARK(s24_3be);
+PIEJAM_PCM_CONVERT_BENCHMARK(u24_3le);
+PIEJAM_PCM_CONVERT_BENCHMARK(u24_3be);
+
+#undef PIEJAM_PCM_CONVERT_BENCHMARK
+
+} // namespace piejam::audio::pcm_convert
@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <piejam/audio/dsp/pitch_tracker.h>
 #include <piejam/audio/dsp/pitch_yin.h>
 
 #include <piejam/numeric/generators/sine.h>
@@ -36,3 +37,83 @@ BM_pitch_yin(benchmark::State& state)
 }
 
 BENCHMARK(BM_pitch_yin)->DenseRange(0, freqs.size() - 1);
+
+static void
+BM_pitch_yin_window_size(benchmark::State& state)
+{
+    constexpr piejam::audio::sample_rate sr{48000};
+
+    mipp::vector<float> in_buf(static_cast<std::size_t>(state.range(0)));
+    std::ranges::generate(
+        in_buf,
+        piejam::numeric::generators::sine<float>(440.f, sr.as<float>()));
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            piejam::audio::dsp::pitch_yin<float>(in_buf, sr));
+    }
+}
+
+BENCHMARK(BM_pitch_yin_window_size)->RangeMultiplier(2)->Range(1024, 16384);
+
+static void
+BM_pitch_yin_fft_window_size(benchmark::State& state)
+{
+    constexpr piejam::audio::sample_rate sr{48000};
+
+    mipp::vector<float> in_buf(static_cast<std::size_t>(state.range(0)));
+    std::ranges::generate(
+        in_buf,
+        piejam::numeric::generators::sine<float>(440.f, sr.as<float>()));
+    piejam::audio::dsp::pitch_yin_fft pitch_yin_fft{in_buf.size()};
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pitch_yin_fft(in_buf, sr));
+    }
+}
+
+BENCHMARK(BM_pitch_yin_fft_window_size)
+    ->RangeMultiplier(2)
+    ->Range(1024, 16384);
+
+// Cost per block of a locked tracker, range(0) is the block size.
+static void
+BM_pitch_tracker_locked(benchmark::State& state)
+{
+    constexpr piejam::audio::sample_rate sr{48000};
+
+    // 480 Hz has a period of exactly 100 samples, so blocks taken at the
+    // offset modulo the period continue the signal seamlessly.
+    constexpr std::size_t period{100};
+    auto const block_size = static_cast<std::size_t>(state.range(0));
+
+    mipp::vector<float> signal(block_size + period);
+    std::ranges::generate(
+        signal,
+        piejam::numeric::generators::sine<float>(480.f, sr.as<float>()));
+
+    piejam::audio::dsp::pitch_tracker pitch_tracker{8192, sr};
+    std::size_t offset{};
+    auto next_block = [&]() {
+        std::span<float const> const block{signal.data() + offset, block_size};
+        offset = (offset + block_size) % period;
+        return block;
+    };
+
+    for (std::size_t n = 0; n < 4 * 8192; n += block_size)
+    {
+        pitch_tracker.process(next_block());
+    }
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pitch_tracker.process(next_block()));
+    }
+}
+
+BENCHMARK(BM_pitch_tracker_locked)->RangeMultiplier(2)->Range(256, 2048);
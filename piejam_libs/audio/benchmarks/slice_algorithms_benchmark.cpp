@@ -0,0 +1,194 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/slice_algorithms.h>
+
+#include <piejam/audio/slice.h>
+
+#include <mipp.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <ctime>
+
+namespace piejam::audio
+{
+
+namespace
+{
+
+auto
+random_buffer(std::size_t const size) -> mipp::vector<float>
+{
+    return mipp::vector<float>(
+        size,
+        static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX));
+}
+
+template <slice_kind Kind>
+auto
+make_operand(mipp::vector<float> const& buf) -> slice<float>
+{
+    if constexpr (Kind == slice_kind::constant)
+    {
+        return 0.5f;
+    }
+    else
+    {
+        return buf;
+    }
+}
+
+} // namespace
+
+template <slice_kind L, slice_kind R>
+static void
+BM_slice_add(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    auto const l_buf = random_buffer(buffer_size);
+    auto const r_buf = random_buffer(buffer_size);
+    mipp::vector<float> out_buf(buffer_size);
+
+    slice<float> const l = make_operand<L>(l_buf);
+    slice<float> const r = make_operand<R>(r_buf);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(add(l, r, std::span<float>{out_buf}));
+        benchmark::ClobberMemory();
+    }
+}
+
+template <slice_kind L, slice_kind R>
+static void
+BM_slice_multiply(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    auto const l_buf = random_buffer(buffer_size);
+    auto const r_buf = random_buffer(buffer_size);
+    mipp::vector<float> out_buf(buffer_size);
+
+    slice<float> const l = make_operand<L>(l_buf);
+    slice<float> const r = make_operand<R>(r_buf);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(multiply(l, r, std::span<float>{out_buf}));
+        benchmark::ClobberMemory();
+    }
+}
+
+template <slice_kind Kind>
+static void
+BM_slice_clamp(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    auto const buf = random_buffer(buffer_size);
+    mipp::vector<float> out_buf(buffer_size);
+
+    slice<float> const s = make_operand<Kind>(buf);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            clamp(s, 0.25f, 0.75f, std::span<float>{out_buf}));
+        benchmark::ClobberMemory();
+    }
+}
+
+template <slice_kind Kind>
+static void
+BM_slice_copy(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    auto const buf = random_buffer(buffer_size);
+    mipp::vector<float> out_buf(buffer_size);
+
+    slice<float> const s = make_operand<Kind>(buf);
+
+    for (auto _ : state)
+    {
+        copy(s, std::span<float>{out_buf});
+        benchmark::ClobberMemory();
+    }
+}
+
+template <slice_kind Kind>
+static void
+BM_slice_subslice(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    auto const buf = random_buffer(buffer_size);
+
+    slice<float> const s = make_operand<Kind>(buf);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(subslice(s, 1, buffer_size - 1));
+    }
+}
+
+using enum slice_kind;
+
+BENCHMARK(BM_slice_add<constant, constant>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_add<span, constant>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_add<constant, span>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_add<span, span>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_multiply<constant, constant>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_multiply<span, constant>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_multiply<constant, span>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_multiply<span, span>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_clamp<constant>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_clamp<span>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_copy<constant>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_copy<span>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_subslice<constant>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_slice_subslice<span>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+
+} // namespace piejam::audio
@@ -0,0 +1,211 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/smoother_processor.h>
+
+#include <piejam/audio/engine/event_buffer.h>
+#include <piejam/audio/engine/event_buffer_memory.h>
+#include <piejam/audio/engine/event_input_buffers.h>
+#include <piejam/audio/engine/event_output_buffers.h>
+#include <piejam/audio/engine/event_port.h>
+#include <piejam/audio/engine/multiply_processor.h>
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/engine/processor.h>
+#include <piejam/audio/slice.h>
+
+#include <piejam/numeric/dB_lut.h>
+
+#include <mipp.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <memory_resource>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+namespace
+{
+
+constexpr auto gain_lut = numeric::dB_lut<float, -120.f, 24.f, 1024>;
+
+// Feeds the smoothers. With Ramp, every period starts a ramp across the whole
+// lut, alternating the direction. Otherwise the gain stays constant.
+template <bool Ramp>
+struct gain_events
+{
+    gain_events()
+    {
+        ev_ins.add(event_port(std::in_place_type<float>, "ev"));
+        ev_ins.set(0, ev_in_buf);
+    }
+
+    void next()
+    {
+        ev_in_buf.clear();
+
+        if constexpr (Ramp)
+        {
+            up = !up;
+            ev_in_buf.insert(0, up ? gain_lut.back() : gain_lut.front());
+        }
+    }
+
+    event_buffer_memory ev_buf_mem{1024};
+    std::pmr::memory_resource* ev_buf_pmr_mem{&ev_buf_mem.memory_resource()};
+    event_buffer<float> ev_in_buf{ev_buf_pmr_mem};
+    event_input_buffers ev_ins;
+    event_output_buffers ev_outs{};
+    bool up{};
+};
+
+template <bool Ramp>
+void
+BM_lut_smoother(benchmark::State& state)
+{
+    std::size_t const buffer_size = state.range(0);
+
+    auto sut = make_lut_smoother_processor(gain_lut, 1.f);
+
+    gain_events<Ramp> events;
+
+    mipp::vector<float> out_buf(buffer_size);
+    std::vector<std::span<float>> out{out_buf};
+    std::vector<slice<float>> res{{}};
+
+    process_context ctx{
+        {},
+        out,
+        res,
+        events.ev_ins,
+        events.ev_outs,
+        buffer_size};
+
+    for (auto _ : state)
+    {
+        events.next();
+        sut->process(ctx);
+        benchmark::ClobberMemory();
+    }
+}
+
+// smoother feeding a multiply per channel, as it was before fusing
+template <bool Ramp>
+void
+BM_lut_smoother_separate_multiply(benchmark::State& state)
+{
+    std::size_t const buffer_size = state.range(0);
+
+    auto smoother = make_lut_smoother_processor(gain_lut, 1.f);
+    std::array amps{make_multiply_processor(2), make_multiply_processor(2)};
+
+    gain_events<Ramp> events;
+
+    mipp::vector<float> gain_buf(buffer_size);
+    std::vector<std::span<float>> gain_out{gain_buf};
+    std::vector<slice<float>> gain_res{{}};
+
+    process_context gain_ctx{
+        {},
+        gain_out,
+        gain_res,
+        events.ev_ins,
+        events.ev_outs,
+        buffer_size};
+
+    mipp::vector<float> in_buf(
+        buffer_size,
+        static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX));
+    slice<float> const in_slice{in_buf};
+    std::vector<std::reference_wrapper<slice<float> const>> in{
+        in_slice,
+        gain_res[0]};
+
+    std::array<mipp::vector<float>, 2> out_bufs{
+        mipp::vector<float>(buffer_size),
+        mipp::vector<float>(buffer_size)};
+    std::array<std::vector<std::span<float>>, 2> out{
+        {{out_bufs[0]}, {out_bufs[1]}}};
+    std::array<std::vector<slice<float>>, 2> res{{{{}}, {{}}}};
+
+    std::array<process_context, 2> amp_ctxs{
+        process_context{in, out[0], res[0], {}, {}, buffer_size},
+        process_context{in, out[1], res[1], {}, {}, buffer_size}};
+
+    for (auto _ : state)
+    {
+        events.next();
+        smoother->process(gain_ctx);
+        amps[0]->process(amp_ctxs[0]);
+        amps[1]->process(amp_ctxs[1]);
+        benchmark::ClobberMemory();
+    }
+}
+
+template <bool Ramp>
+void
+BM_lut_smoothed_multiply(benchmark::State& state)
+{
+    std::size_t const buffer_size = state.range(0);
+
+    auto sut = make_lut_smoothed_multiply_processor(gain_lut, 1.f, 2);
+
+    gain_events<Ramp> events;
+
+    mipp::vector<float> in_buf(
+        buffer_size,
+        static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX));
+    slice<float> const in_slice{in_buf};
+    std::vector<std::reference_wrapper<slice<float> const>> in{
+        in_slice,
+        in_slice};
+
+    std::array<mipp::vector<float>, 2> out_bufs{
+        mipp::vector<float>(buffer_size),
+        mipp::vector<float>(buffer_size)};
+    std::vector<std::span<float>> out{out_bufs[0], out_bufs[1]};
+    std::vector<slice<float>> res{{}, {}};
+
+    process_context ctx{
+        in,
+        out,
+        res,
+        events.ev_ins,
+        events.ev_outs,
+        buffer_size};
+
+    for (auto _ : state)
+    {
+        events.next();
+        sut->process(ctx);
+        benchmark::ClobberMemory();
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_lut_smoother<true>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_lut_smoother<false>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_lut_smoother_separate_multiply<true>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_lut_smoother_separate_multiply<false>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_lut_smoothed_multiply<true>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+BENCHMARK(BM_lut_smoothed_multiply<false>)
+    ->RangeMultiplier(2)
+    ->Range(mipp::N<float>(), 1024);
+
+} // namespace piejam::audio::engine
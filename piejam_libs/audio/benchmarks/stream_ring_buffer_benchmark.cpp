@@ -0,0 +1,90 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/stream_ring_buffer.h>
+
+#include <piejam/audio/slice.h>
+
+#include <mipp.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+// Writes a period per channel from the rt side. The capacity is no multiple
+// of the period size, so the writes wrap around at varying positions.
+template <std::size_t NumChannels>
+static void
+BM_stream_ring_buffer_write(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    mipp::vector<float> in_buf(
+        buffer_size,
+        static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX));
+    std::vector<slice<float>> in_slices(NumChannels, slice<float>{in_buf});
+    std::vector<std::reference_wrapper<slice<float> const>> in(
+        in_slices.begin(),
+        in_slices.end());
+
+    stream_ring_buffer<float> sut(NumChannels, 8191);
+
+    for (auto _ : state)
+    {
+        if (sut.write(in, buffer_size) < buffer_size)
+        {
+            state.PauseTiming();
+            benchmark::DoNotOptimize(sut.consume());
+            state.ResumeTiming();
+        }
+    }
+}
+
+// Consumes what one period wrote, as the stream processor's consumer does.
+template <std::size_t NumChannels>
+static void
+BM_stream_ring_buffer_consume(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    mipp::vector<float> in_buf(
+        buffer_size,
+        static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX));
+    std::vector<slice<float>> in_slices(NumChannels, slice<float>{in_buf});
+    std::vector<std::reference_wrapper<slice<float> const>> in(
+        in_slices.begin(),
+        in_slices.end());
+
+    stream_ring_buffer<float> sut(NumChannels, 8191);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        sut.write(in, buffer_size);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(sut.consume());
+    }
+}
+
+BENCHMARK(BM_stream_ring_buffer_write<1>)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_stream_ring_buffer_write<2>)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_stream_ring_buffer_consume<1>)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024);
+BENCHMARK(BM_stream_ring_buffer_consume<2>)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024);
+
+} // namespace piejam::audio::engine
@@ -12,36 +12,53 @@
 namespace piejam::audio::components
 {
 
+//! How the gain is applied. A fused gain stage smoothes and multiplies in one
+//! processor, it's fused into the mixers downstream, if all its channels are
+//! mixed. A mixable one uses separate smoother and multiply processors, each
+//! channel can be fused into a mixer downstream.
+enum class gain_stage : bool
+{
+    fused,
+    mixable,
+};
+
 // audio in: num_channels
 // audio out: num_channels
 // event in: gain
-auto make_amplifier(std::size_t num_channels, std::string_view name)
-    -> std::unique_ptr<engine::component>;
+auto make_amplifier(
+    std::size_t num_channels,
+    std::string_view name,
+    gain_stage = gain_stage::fused) -> std::unique_ptr<engine::component>;
 
 inline auto
-make_mono_amplifier(std::string_view name) -> std::unique_ptr<engine::component>
+make_mono_amplifier(std::string_view name, gain_stage stage = gain_stage::fused)
+    -> std::unique_ptr<engine::component>
 {
-    return make_amplifier(1, name);
+    return make_amplifier(1, name, stage);
 }
 
 inline auto
-make_stereo_amplifier(std::string_view name)
-    -> std::unique_ptr<engine::component>
+make_stereo_amplifier(
+    std::string_view name,
+    gain_stage stage = gain_stage::fused) -> std::unique_ptr<engine::component>
 {
-    return make_amplifier(2, name);
+    return make_amplifier(2, name, stage);
 }
 
 // audio in: num_channels
 // audio out: num_channels
 // event in: gain x num_channels
-auto make_split_amplifier(std::size_t num_channels, std::string_view name)
-    -> std::unique_ptr<engine::component>;
+auto make_split_amplifier(
+    std::size_t num_channels,
+    std::string_view name,
+    gain_stage = gain_stage::fused) -> std::unique_ptr<engine::component>;
 
 inline auto
-make_stereo_split_amplifier(std::string_view name)
-    -> std::unique_ptr<engine::component>
+make_stereo_split_amplifier(
+    std::string_view name,
+    gain_stage stage = gain_stage::fused) -> std::unique_ptr<engine::component>
 {
-    return make_split_amplifier(2, name);
+    return make_split_amplifier(2, name, stage);
 }
 
 } // namespace piejam::audio::components
@@ -14,14 +14,14 @@ namespace piejam::audio::components
 
 // audio in: 1
 // audio out: 2
-auto make_pan(
-    std::unique_ptr<engine::processor> pan_converter,
-    std::string_view name = {}) -> std::unique_ptr<engine::component>;
+// event in: pan, gain
+auto make_pan(std::string_view name = {})
+    -> std::unique_ptr<engine::component>;
 
 // audio in: 2
 // audio out: 2
-auto make_balance(
-    std::unique_ptr<engine::processor> balance_converter,
-    std::string_view name = {}) -> std::unique_ptr<engine::component>;
+// event in: balance, gain
+auto make_balance(std::string_view name = {})
+    -> std::unique_ptr<engine::component>;
 
 } // namespace piejam::audio::components
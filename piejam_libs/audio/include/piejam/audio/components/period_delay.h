@@ -0,0 +1,22 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/engine/fwd.h>
+
+#include <memory>
+#include <string_view>
+
+namespace piejam::audio::components
+{
+
+// audio in: num_channels
+// audio out: num_channels, delayed by num_periods
+auto make_period_delay(
+    std::size_t num_channels,
+    std::size_t num_periods,
+    std::string_view name = {}) -> std::unique_ptr<engine::component>;
+
+} // namespace piejam::audio::components
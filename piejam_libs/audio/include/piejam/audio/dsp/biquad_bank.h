@@ -0,0 +1,306 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/dsp/biquad.h>
+
+#include <piejam/numeric/simd/lrot_n.h>
+
+#include <boost/assert.hpp>
+
+#include <mipp.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <span>
+
+namespace piejam::audio::dsp
+{
+
+//! Biquads of several channels and cascaded sections, which are processed
+//! together in the lanes of simd registers. Lane `section * NumChannels +
+//! channel` computes the same as a biquad<T> would.
+//!
+//! The recursion prevents vectorizing along time, so the channels and
+//! sections are vectorized instead. A section depends on the output of the
+//! previous one, the sections are pipelined: in each step a section
+//! processes the output of the previous section from the step before. The
+//! pipeline is filled and drained within each call, the cascade has no
+//! latency.
+template <
+    std::floating_point T,
+    std::size_t NumChannels,
+    std::size_t NumSections = 1>
+class biquad_bank
+{
+    static_assert(NumChannels > 0 && NumSections > 0);
+
+public:
+    using coefficients = typename biquad<T>::coefficients;
+
+    static constexpr std::size_t num_channels = NumChannels;
+    static constexpr std::size_t num_sections = NumSections;
+
+    biquad_bank() noexcept
+    {
+        for (std::size_t section = 0; section < NumSections; ++section)
+        {
+            set_coefficients(section, coefficients{});
+        }
+    }
+
+    //! Sets the coefficients of a section of all channels.
+    void set_coefficients(
+        std::size_t const section,
+        coefficients const& c) noexcept
+    {
+        for (std::size_t channel = 0; channel < NumChannels; ++channel)
+        {
+            set_coefficients(section, channel, c);
+        }
+    }
+
+    void set_coefficients(
+        std::size_t const section,
+        std::size_t const channel,
+        coefficients const& c) noexcept
+    {
+        BOOST_ASSERT(section < NumSections);
+        BOOST_ASSERT(channel < NumChannels);
+
+        std::size_t const lane = section * NumChannels + channel;
+        m_a0[lane] = c.a0;
+        m_a1[lane] = c.a1;
+        m_a2[lane] = c.a2;
+        m_b1[lane] = c.b1;
+        m_b2[lane] = c.b2;
+    }
+
+    //! Processes the channels through all sections. The buffers must have
+    //! the same size, the output may be the input buffer.
+    void process(
+        std::array<std::span<T const>, NumChannels> const& in,
+        std::array<std::span<T>, NumChannels> const& out) noexcept
+    {
+        std::size_t const size = in[0].size();
+
+        BOOST_ASSERT(std::ranges::all_of(in, [size](auto const& buf) {
+            return buf.size() == size;
+        }));
+        BOOST_ASSERT(std::ranges::all_of(out, [size](auto const& buf) {
+            return buf.size() == size;
+        }));
+
+        if (size == 0)
+        {
+            return;
+        }
+
+        registers r = load_registers();
+
+        alignas(mipp::RequiredAlignment) lanes_t x{};
+        alignas(mipp::RequiredAlignment) lanes_t y{};
+        regs_t y_regs{};
+
+        for (std::size_t step = 0; step < size + NumSections - 1; ++step)
+        {
+            for (std::size_t ch = 0; ch < NumChannels; ++ch)
+            {
+                x[ch] = step < size ? in[ch][step] : T{};
+            }
+
+            regs_t x_regs = load(x);
+
+            // each section takes the output of the previous one, from the
+            // step before
+            if constexpr (num_regs == 1 && NumSections > 1)
+            {
+                // in registers, the output is on the critical path
+                reg_t const lane(s_lane_indices.data());
+                x_regs[0] = mipp::blend(
+                    x_regs[0],
+                    numeric::simd::lrot_n(
+                        y_regs[0],
+                        reg_size - NumChannels),
+                    lane < reg_t(static_cast<T>(NumChannels)));
+            }
+            else if constexpr (NumSections > 1)
+            {
+                std::copy_n(
+                    y.begin(),
+                    last_section_lane,
+                    std::next(x.begin(), NumChannels));
+                x_regs = load(x);
+            }
+
+            if (step + 1 < NumSections || size <= step)
+            {
+                // filling or draining the pipeline, only the sections
+                // which have a sample to process are stepped
+                std::size_t const first_section =
+                    size <= step ? step - size + 1 : 0;
+                std::size_t const last_section =
+                    std::min(step + 1, NumSections);
+
+                y_regs = process_step<true>(
+                    r,
+                    x_regs,
+                    first_section * NumChannels,
+                    last_section * NumChannels);
+            }
+            else
+            {
+                y_regs = process_step<false>(r, x_regs, 0, num_lanes);
+            }
+
+            store(y_regs, y);
+
+            if (step + 1 >= NumSections)
+            {
+                for (std::size_t ch = 0; ch < NumChannels; ++ch)
+                {
+                    out[ch][step + 1 - NumSections] =
+                        y[last_section_lane + ch];
+                }
+            }
+        }
+
+        store_state(r);
+    }
+
+    void reset() noexcept
+    {
+        m_z1.fill(T{});
+        m_z2.fill(T{});
+    }
+
+private:
+    static constexpr std::size_t num_lanes = NumChannels * NumSections;
+    static constexpr std::size_t reg_size = mipp::N<T>();
+    static constexpr std::size_t num_regs =
+        (num_lanes + reg_size - 1) / reg_size;
+    static constexpr std::size_t last_section_lane =
+        (NumSections - 1) * NumChannels;
+
+    using lanes_t = std::array<T, num_regs * reg_size>;
+    using reg_t = mipp::Reg<T>;
+    using regs_t = std::array<reg_t, num_regs>;
+
+    struct registers
+    {
+        regs_t a0;
+        regs_t a1;
+        regs_t a2;
+        regs_t b1;
+        regs_t b2;
+        regs_t z1;
+        regs_t z2;
+    };
+
+    static constexpr auto make_lane_indices() noexcept -> lanes_t
+    {
+        lanes_t result{};
+        for (std::size_t lane = 0; lane < result.size(); ++lane)
+        {
+            result[lane] = static_cast<T>(lane);
+        }
+        return result;
+    }
+
+    // Only the lanes in [first_lane, last_lane) keep their new state, if
+    // masked.
+    template <bool Masked>
+    static auto process_step(
+        registers& r,
+        regs_t const& x,
+        [[maybe_unused]] std::size_t const first_lane,
+        [[maybe_unused]] std::size_t const last_lane) noexcept -> regs_t
+    {
+        regs_t y;
+
+        for (std::size_t i = 0; i < num_regs; ++i)
+        {
+            y[i] = r.a0[i] * x[i] + r.z1[i];
+            reg_t z1 = r.a1[i] * x[i] - r.b1[i] * y[i] + r.z2[i];
+            reg_t z2 = r.a2[i] * x[i] - r.b2[i] * y[i];
+
+            if constexpr (Masked)
+            {
+                reg_t const lane(s_lane_indices.data() + i * reg_size);
+                auto const active =
+                    (lane >= reg_t(static_cast<T>(first_lane))) &
+                    (lane < reg_t(static_cast<T>(last_lane)));
+
+                z1 = mipp::blend(z1, r.z1[i], active);
+                z2 = mipp::blend(z2, r.z2[i], active);
+            }
+
+            r.z1[i] = z1;
+            r.z2[i] = z2;
+        }
+
+        return y;
+    }
+
+    static auto load(lanes_t const& lanes) noexcept -> regs_t
+    {
+        regs_t result;
+        for (std::size_t i = 0; i < num_regs; ++i)
+        {
+            result[i] = reg_t(lanes.data() + i * reg_size);
+        }
+        return result;
+    }
+
+    static void store(regs_t const& regs, lanes_t& lanes) noexcept
+    {
+        for (std::size_t i = 0; i < num_regs; ++i)
+        {
+            regs[i].store(lanes.data() + i * reg_size);
+        }
+    }
+
+    auto load_registers() const noexcept -> registers
+    {
+        registers r;
+
+        for (std::size_t i = 0; i < num_regs; ++i)
+        {
+            std::size_t const offset = i * reg_size;
+            r.a0[i] = reg_t(m_a0.data() + offset);
+            r.a1[i] = reg_t(m_a1.data() + offset);
+            r.a2[i] = reg_t(m_a2.data() + offset);
+            r.b1[i] = reg_t(m_b1.data() + offset);
+            r.b2[i] = reg_t(m_b2.data() + offset);
+            r.z1[i] = reg_t(m_z1.data() + offset);
+            r.z2[i] = reg_t(m_z2.data() + offset);
+        }
+
+        return r;
+    }
+
+    void store_state(registers const& r) noexcept
+    {
+        for (std::size_t i = 0; i < num_regs; ++i)
+        {
+            r.z1[i].store(m_z1.data() + i * reg_size);
+            r.z2[i].store(m_z2.data() + i * reg_size);
+        }
+    }
+
+    alignas(mipp::RequiredAlignment) static constexpr lanes_t s_lane_indices =
+        make_lane_indices();
+
+    alignas(mipp::RequiredAlignment) lanes_t m_a0{};
+    alignas(mipp::RequiredAlignment) lanes_t m_a1{};
+    alignas(mipp::RequiredAlignment) lanes_t m_a2{};
+    alignas(mipp::RequiredAlignment) lanes_t m_b1{};
+    alignas(mipp::RequiredAlignment) lanes_t m_b2{};
+    alignas(mipp::RequiredAlignment) lanes_t m_z1{};
+    alignas(mipp::RequiredAlignment) lanes_t m_z2{};
+};
+
+} // namespace piejam::audio::dsp
@@ -0,0 +1,253 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/dsp/true_peak_detector.h>
+
+#include <piejam/numeric/sliding_max.h>
+
+#include <boost/assert.hpp>
+
+#include <mipp.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::dsp
+{
+
+//! Peak limiter with lookahead, the channels are linked.
+//!
+//! The peaks, optionally the true peaks, are held over the lookahead window
+//! with a sliding maximum, and turned into the gains which keep them below
+//! the threshold. The gains recover with the release, and are averaged over
+//! the lookahead window again. The audio is delayed by the latency, so when
+//! a peak reaches the output, the whole averaging window holds gains below
+//! its required gain. The attack is a linear ramp over the lookahead and the
+//! output never exceeds the threshold.
+template <std::floating_point T, std::size_t NumChannels>
+class lookahead_limiter
+{
+    static_assert(NumChannels > 0);
+
+public:
+    explicit lookahead_limiter(std::size_t const lookahead)
+        : m_peak_hold(lookahead + 1)
+        , m_gains(lookahead + 1, T{1})
+        , m_gains_sum(static_cast<double>(lookahead + 1))
+    {
+        for (auto& delay : m_delays)
+        {
+            delay.resize(latency() + block_size);
+        }
+    }
+
+    //! Delay of the output in samples.
+    [[nodiscard]]
+    auto latency() const noexcept -> std::size_t
+    {
+        return m_gains.size() - 1 + true_peak_detector<T>::latency;
+    }
+
+    //! Linear threshold, the output doesn't exceed it.
+    void set_threshold(T const threshold) noexcept
+    {
+        BOOST_ASSERT(threshold > T{0});
+        m_threshold = threshold;
+    }
+
+    //! Coefficient of the one pole release, per sample.
+    void set_release(T const coeff) noexcept
+    {
+        BOOST_ASSERT(T{0} <= coeff && coeff < T{1});
+        m_release_coeff = coeff;
+    }
+
+    void set_true_peak(bool const true_peak) noexcept
+    {
+        m_true_peak = true_peak;
+    }
+
+    //! The gain applied to the last output sample.
+    [[nodiscard]]
+    auto gain() const noexcept -> T
+    {
+        return m_gain;
+    }
+
+    //! The buffers must have the same size, the output may be the input
+    //! buffer.
+    void process(
+        std::array<std::span<T const>, NumChannels> const& in,
+        std::array<std::span<T>, NumChannels> const& out) noexcept
+    {
+        std::size_t const size = in[0].size();
+
+        BOOST_ASSERT(std::ranges::all_of(in, [size](auto const& buf) {
+            return buf.size() == size;
+        }));
+        BOOST_ASSERT(std::ranges::all_of(out, [size](auto const& buf) {
+            return buf.size() == size;
+        }));
+
+        for (std::size_t offset = 0; offset < size; offset += block_size)
+        {
+            std::size_t const count = std::min(block_size, size - offset);
+
+            std::array<std::span<T const>, NumChannels> in_block;
+            std::array<std::span<T>, NumChannels> out_block;
+            for (std::size_t ch = 0; ch < NumChannels; ++ch)
+            {
+                in_block[ch] = in[ch].subspan(offset, count);
+                out_block[ch] = out[ch].subspan(offset, count);
+            }
+
+            process_block(in_block, out_block);
+        }
+    }
+
+    void reset() noexcept
+    {
+        for (auto& detector : m_detectors)
+        {
+            detector.reset();
+        }
+
+        for (auto& delay : m_delays)
+        {
+            std::ranges::fill(delay, T{});
+        }
+
+        m_peak_hold.reset();
+        std::ranges::fill(m_gains, T{1});
+        m_gains_sum = static_cast<double>(m_gains.size());
+        m_gains_pos = 0;
+        m_release_gain = T{1};
+        m_gain = T{1};
+    }
+
+private:
+    // the gains are computed per sample into a block, and applied with simd
+    static constexpr std::size_t block_size = 64;
+
+    void process_block(
+        std::array<std::span<T const>, NumChannels> const& in,
+        std::array<std::span<T>, NumChannels> const& out) noexcept
+    {
+        std::size_t const count = in[0].size();
+        std::size_t const delay = latency();
+
+        alignas(mipp::RequiredAlignment) std::array<T, block_size> gains;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            gains[i] = next_gain(detect(in, i));
+        }
+
+        m_gain = gains[count - 1];
+
+        for (std::size_t ch = 0; ch < NumChannels; ++ch)
+        {
+            // the input is appended to the delay line, its front is the
+            // delayed input for this block
+            std::vector<T>& delay_line = m_delays[ch];
+            std::ranges::copy(in[ch], std::next(delay_line.begin(), delay));
+
+            apply_gains(
+                std::span<T const>(delay_line.data(), count),
+                std::span<T const>(gains.data(), count),
+                out[ch]);
+
+            std::copy(
+                std::next(delay_line.begin(), count),
+                std::next(delay_line.begin(), count + delay),
+                delay_line.begin());
+        }
+    }
+
+    [[nodiscard]]
+    auto detect(
+        std::array<std::span<T const>, NumChannels> const& in,
+        std::size_t const index) noexcept -> T
+    {
+        T peak{};
+        for (std::size_t ch = 0; ch < NumChannels; ++ch)
+        {
+            T const x = in[ch][index];
+            peak = std::max(
+                peak,
+                m_true_peak ? m_detectors[ch](x)
+                            : m_detectors[ch].sample_peak(x));
+        }
+        return peak;
+    }
+
+    [[nodiscard]]
+    auto next_gain(T const peak) noexcept -> T
+    {
+        T const held_peak = m_peak_hold(peak);
+        T const required_gain =
+            held_peak > m_threshold ? m_threshold / held_peak : T{1};
+
+        // attack immediately, the averaging ramps it
+        m_release_gain =
+            required_gain < m_release_gain
+                ? required_gain
+                : required_gain +
+                      (m_release_gain - required_gain) * m_release_coeff;
+
+        m_gains_sum += static_cast<double>(m_release_gain) -
+                       static_cast<double>(m_gains[m_gains_pos]);
+        m_gains[m_gains_pos] = m_release_gain;
+        m_gains_pos = m_gains_pos + 1 == m_gains.size() ? 0 : m_gains_pos + 1;
+
+        // the sum is accumulated in double, so it doesn't drift
+        return static_cast<T>(
+            m_gains_sum / static_cast<double>(m_gains.size()));
+    }
+
+    static void apply_gains(
+        std::span<T const> const in,
+        std::span<T const> const gains,
+        std::span<T> const out) noexcept
+    {
+        constexpr std::size_t N = mipp::N<T>();
+
+        std::size_t i{};
+        for (; i + N <= in.size(); i += N)
+        {
+            mipp::Reg<T> x;
+            x.loadu(in.data() + i);
+            mipp::Reg<T> g;
+            g.loadu(gains.data() + i);
+            (x * g).storeu(out.data() + i);
+        }
+
+        for (; i < in.size(); ++i)
+        {
+            out[i] = in[i] * gains[i];
+        }
+    }
+
+    std::array<true_peak_detector<T>, NumChannels> m_detectors;
+    std::array<std::vector<T>, NumChannels> m_delays;
+
+    numeric::sliding_max<T> m_peak_hold;
+
+    // release gains of the averaging window
+    std::vector<T> m_gains;
+    double m_gains_sum;
+    std::size_t m_gains_pos{};
+
+    T m_threshold{1};
+    T m_release_coeff{};
+    T m_release_gain{1};
+    T m_gain{1};
+    bool m_true_peak{true};
+};
+
+} // namespace piejam::audio::dsp
@@ -7,6 +7,7 @@
 #include <piejam/audio/pair.h>
 #include <piejam/numeric/pow_n.h>
 
+#include <algorithm>
 #include <cmath>
 #include <numbers>
 
@@ -38,9 +39,11 @@ sinusoidal_constant_power_pan_exact(T pan_pos) -> pair<T>
 //           (π^2 x^2)/(32 sqrt(2)) -
 //           (π^3 x^3)/(384 sqrt(2)) +
 //           (π^4 x^4)/(6144 sqrt(2))
-template <std::floating_point T>
+//
+// V is T or a simd register of T.
+template <std::floating_point T, class V>
 constexpr auto
-sinusoidal_constant_power_pan(T pan_pos) -> pair<T>
+sinusoidal_constant_power_pan(V const pan_pos) -> pair<V>
 {
     constexpr T pi = std::numbers::pi_v<T>;
     constexpr T sqrt2 = std::numbers::sqrt2_v<T>;
@@ -52,20 +55,27 @@ sinusoidal_constant_power_pan(T pan_pos) -> pair<T>
     constexpr T pi_quad = pi_cubed * pi;
     constexpr T pi_quad_div_6144root2 = pi_quad / (T{6144} * sqrt2);
     constexpr T inv_sqrt2_f = T{1} / sqrt2;
-    T const x_sqr = pan_pos * pan_pos;
-    T const x_cubed = x_sqr * pan_pos;
-    T const x_quad = x_cubed * pan_pos;
-    T const ax1 = pi_div_4root2 * pan_pos;
-    T const ax2 = pi_sqr_div_32root2 * x_sqr;
-    T const ax3 = pi_cubed_div_384root2 * x_cubed;
-    T const ax4 = pi_quad_div_6144root2 * x_quad;
-    T const axs = inv_sqrt2_f - ax2 + ax4;
-    T const axt = ax1 - ax3;
-    T const left = axs - axt;
-    T const right = axs + axt;
+    V const x_sqr = pan_pos * pan_pos;
+    V const x_cubed = x_sqr * pan_pos;
+    V const x_quad = x_cubed * pan_pos;
+    V const ax1 = V(pi_div_4root2) * pan_pos;
+    V const ax2 = V(pi_sqr_div_32root2) * x_sqr;
+    V const ax3 = V(pi_cubed_div_384root2) * x_cubed;
+    V const ax4 = V(pi_quad_div_6144root2) * x_quad;
+    V const axs = V(inv_sqrt2_f) - ax2 + ax4;
+    V const axt = ax1 - ax3;
+    V const left = axs - axt;
+    V const right = axs + axt;
     return {left, right};
 }
 
+template <std::floating_point T>
+constexpr auto
+sinusoidal_constant_power_pan(T pan_pos) -> pair<T>
+{
+    return sinusoidal_constant_power_pan<T, T>(pan_pos);
+}
+
 template <std::floating_point T>
 constexpr auto
 stereo_balance(T balance_pos) -> pair<T>
@@ -83,4 +93,16 @@ stereo_balance(T balance_pos) -> pair<T>
     return pair{T{1}};
 }
 
+// Branchless stereo_balance, V is T or a simd register of T.
+template <std::floating_point T, class V>
+constexpr auto
+stereo_balance(V const balance_pos) -> pair<V>
+{
+    using std::max;
+    using std::min;
+    return {
+        numeric::pow_n<3>(V(T{1}) - max(balance_pos, V(T{0}))),
+        numeric::pow_n<3>(V(T{1}) + min(balance_pos, V(T{0})))};
+}
+
 } // namespace piejam::audio::dsp
@@ -0,0 +1,50 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/sample_rate.h>
+
+#include <memory>
+#include <span>
+
+namespace piejam::audio::dsp
+{
+
+// Streaming pitch detection over a sliding window.
+//
+// While no pitch is detected, a full YIN search is done every half window.
+// Once a pitch is found, the tracker locks onto it and keeps the difference
+// function only for a neighbourhood of lags around the estimate. This is
+// updated incrementally with the samples entering and leaving the window, so
+// the difference costs new samples times neighbourhood size per call, instead
+// of half the window times neighbourhood size. The remaining bookkeeping,
+// shifting the window, the level check and the energy terms of the
+// normalization, stays linear in the window size. The lock is released when
+// the minimum moves to the border of the neighbourhood or gets too shallow.
+class pitch_tracker
+{
+public:
+    pitch_tracker(std::size_t window_size, sample_rate);
+    pitch_tracker(pitch_tracker&&) noexcept;
+    ~pitch_tracker();
+
+    auto operator=(pitch_tracker&&) noexcept -> pitch_tracker&;
+
+    [[nodiscard]]
+    auto window_size() const noexcept -> std::size_t;
+
+    [[nodiscard]]
+    auto locked() const noexcept -> bool;
+
+    // Appends the samples to the window and returns the current estimate,
+    // zero if no pitch is detected.
+    auto process(std::span<float const>) -> float;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> m_impl;
+};
+
+} // namespace piejam::audio::dsp
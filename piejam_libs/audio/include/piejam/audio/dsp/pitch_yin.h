@@ -7,6 +7,7 @@
 #include <piejam/audio/sample_rate.h>
 
 #include <concepts>
+#include <memory>
 #include <span>
 
 namespace piejam::audio::dsp
@@ -16,4 +17,27 @@ template <std::floating_point T>
 [[nodiscard]]
 auto pitch_yin(std::span<T const> in, sample_rate) -> T;
 
+// Same as pitch_yin, but the difference function is computed via FFT
+// autocorrelation in O(N log N). The window size is fixed, since the
+// transform buffers are kept between calls.
+class pitch_yin_fft
+{
+public:
+    explicit pitch_yin_fft(std::size_t window_size);
+    pitch_yin_fft(pitch_yin_fft&&) noexcept;
+    ~pitch_yin_fft();
+
+    auto operator=(pitch_yin_fft&&) noexcept -> pitch_yin_fft&;
+
+    [[nodiscard]]
+    auto window_size() const noexcept -> std::size_t;
+
+    [[nodiscard]]
+    auto operator()(std::span<float const> in, sample_rate) -> float;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> m_impl;
+};
+
 } // namespace piejam::audio::dsp
@@ -0,0 +1,133 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <numbers>
+
+namespace piejam::audio::dsp
+{
+
+//! Estimates the peaks of the band limited signal between the samples, by
+//! oversampling with a polyphase windowed sinc interpolator, similar to the
+//! true-peak meter of ITU-R BS.1770.
+//!
+//! For each input sample, the magnitudes of the interpolated values in
+//! (n - latency - 1, n - latency] are computed. The last phase hits the
+//! sample itself, so the result is never below its magnitude.
+template <std::floating_point T>
+class true_peak_detector
+{
+public:
+    static constexpr std::size_t oversampling = 4;
+    static constexpr std::size_t taps_per_phase = 12;
+    static constexpr std::size_t latency = taps_per_phase / 2 - 1;
+
+    //! Pushes a sample, returns the true peak around the sample pushed
+    //! latency samples before.
+    [[nodiscard]]
+    auto operator()(T const x) noexcept -> T
+    {
+        push(x);
+
+        // taps along the rows, phases along the columns, the inner loop is
+        // vectorized by the compiler
+        std::array<T, oversampling> acc{};
+        T const* const history = m_history.data() + m_pos;
+        for (std::size_t tap = 0; tap < taps_per_phase; ++tap)
+        {
+            for (std::size_t phase = 0; phase < oversampling; ++phase)
+            {
+                acc[phase] += s_coefficients[tap][phase] * history[tap];
+            }
+        }
+
+        T result{};
+        for (T const y : acc)
+        {
+            result = std::max(result, std::abs(y));
+        }
+        return result;
+    }
+
+    //! Pushes a sample, returns the magnitude of the sample pushed latency
+    //! samples before. Keeps the latency of the interpolated detection.
+    [[nodiscard]]
+    auto sample_peak(T const x) noexcept -> T
+    {
+        push(x);
+        return std::abs(m_history[m_pos + latency]);
+    }
+
+    void reset() noexcept
+    {
+        m_history.fill(T{});
+    }
+
+private:
+    using phases_t = std::array<T, oversampling>;
+    using coefficients_t = std::array<phases_t, taps_per_phase>;
+
+    // the history is stored twice, so the taps are contiguous at any
+    // position, the newest sample is at m_pos
+    void push(T const x) noexcept
+    {
+        m_pos = m_pos == 0 ? taps_per_phase - 1 : m_pos - 1;
+        m_history[m_pos] = x;
+        m_history[m_pos + taps_per_phase] = x;
+    }
+
+    static auto make_coefficients() -> coefficients_t
+    {
+        // blackman windowed sinc, centered on the sample latency samples
+        // back, the last tap of the phases is zero
+        constexpr std::size_t length = taps_per_phase * oversampling - 1;
+        constexpr T center = (latency + 1) * oversampling - 1;
+        constexpr T pi = std::numbers::pi_v<T>;
+
+        coefficients_t result{};
+        for (std::size_t phase = 0; phase < oversampling; ++phase)
+        {
+            T sum{};
+            for (std::size_t tap = 0; tap < taps_per_phase; ++tap)
+            {
+                std::size_t const k = tap * oversampling + phase;
+                if (k >= length)
+                {
+                    continue;
+                }
+
+                T const t = (static_cast<T>(k) - center) /
+                            static_cast<T>(oversampling);
+                T const sinc = t == T{0} ? T{1} : std::sin(pi * t) / (pi * t);
+                T const w = static_cast<T>(k) / static_cast<T>(length - 1);
+                T const window = T{0.42} - T{0.5} * std::cos(T{2} * pi * w) +
+                                 T{0.08} * std::cos(T{4} * pi * w);
+
+                result[tap][oversampling - 1 - phase] = sinc * window;
+                sum += sinc * window;
+            }
+
+            // unity gain at DC
+            for (phases_t& taps : result)
+            {
+                taps[oversampling - 1 - phase] /= sum;
+            }
+        }
+
+        return result;
+    }
+
+    static inline coefficients_t const s_coefficients{make_coefficients()};
+
+    std::array<T, 2 * taps_per_phase> m_history{};
+    std::size_t m_pos{};
+};
+
+} // namespace piejam::audio::dsp
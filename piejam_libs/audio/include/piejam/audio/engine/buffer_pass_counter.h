@@ -0,0 +1,35 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace piejam::audio::engine
+{
+
+//! Counts the results, which processors write into their output buffers,
+//! each is a vectorized pass over the period. Folded and passed through
+//! results are not counted.
+class buffer_pass_counter
+{
+public:
+    void add(std::size_t const num_passes) noexcept
+    {
+        m_num_passes.fetch_add(num_passes, std::memory_order_relaxed);
+    }
+
+    //! The passes since the last call, e.g. of the last period.
+    [[nodiscard]]
+    auto exchange() noexcept -> std::size_t
+    {
+        return m_num_passes.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic_size_t m_num_passes{};
+};
+
+} // namespace piejam::audio::engine
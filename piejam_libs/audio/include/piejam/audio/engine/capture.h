@@ -0,0 +1,41 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/multichannel_buffer.h>
+
+#include <cstdint>
+#include <limits>
+
+namespace piejam::audio::engine
+{
+
+//! Half-open range [start, stop) of engine frames to capture.
+struct capture_window
+{
+    static constexpr std::uint64_t open_end{
+        std::numeric_limits<std::uint64_t>::max()};
+
+    std::uint64_t start{};
+    std::uint64_t stop{};
+
+    [[nodiscard]]
+    constexpr auto empty() const noexcept -> bool
+    {
+        return stop <= start;
+    }
+
+    constexpr auto operator==(capture_window const&) const noexcept
+        -> bool = default;
+};
+
+//! Contiguous captured frames, starting at an engine frame.
+struct captured_frames
+{
+    std::uint64_t frame{};
+    multichannel_buffer<float, multichannel_layout_non_interleaved> data;
+};
+
+} // namespace piejam::audio::engine
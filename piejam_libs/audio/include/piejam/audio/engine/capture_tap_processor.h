@@ -0,0 +1,104 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/engine/capture.h>
+#include <piejam/audio/engine/fwd.h>
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/stream_ring_buffer.h>
+#include <piejam/audio/slice.h>
+#include <piejam/thread/spsc_slot.h>
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+//! Captures its inputs within an armed window of engine frames.
+//!
+//! A window takes effect on exactly the frame it names, so all taps armed
+//! with the same window start and stop on the same sample, no matter in
+//! which period the arming reached them. Every captured block is tagged with
+//! the engine frame of its first sample. Frames, which don't fit into the
+//! ring buffer, are dropped and show up as a gap between the blocks.
+class capture_tap_processor final : public named_processor
+{
+public:
+    capture_tap_processor(
+        frame_clock const&,
+        std::size_t num_channels,
+        std::size_t capacity_per_channel,
+        std::string_view name = {});
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return "capture_tap";
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return m_num_channels;
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return 0;
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    //! Called from the main thread, replaces the current window.
+    void arm(capture_window const& window) noexcept
+    {
+        m_next_window.push(window);
+    }
+
+    void process(process_context const&) override;
+
+    //! Called from the main thread. Contiguous blocks are joined.
+    auto consume() -> std::vector<captured_frames>;
+
+private:
+    struct block
+    {
+        std::uint64_t frame;
+        std::size_t num_frames;
+    };
+
+    frame_clock const& m_clock;
+    std::size_t const m_num_channels;
+
+    thread::spsc_slot<capture_window> m_next_window;
+
+    // audio thread
+    capture_window m_window{};
+    std::vector<slice<float>> m_window_slices;
+    std::vector<std::reference_wrapper<slice<float> const>> m_window_inputs;
+
+    stream_ring_buffer<float> m_buffer;
+    boost::lockfree::spsc_queue<block> m_blocks;
+};
+
+auto make_capture_tap_processor(
+    frame_clock const&,
+    std::size_t num_channels,
+    std::size_t capacity_per_channel,
+    std::string_view name = {}) -> std::unique_ptr<capture_tap_processor>;
+
+} // namespace piejam::audio::engine
@@ -40,6 +40,13 @@ public:
     [[nodiscard]]
     virtual auto event_outputs() const -> endpoints = 0;
 
+    //! Delay of the outputs behind the inputs, in periods.
+    [[nodiscard]]
+    virtual auto period_latency() const noexcept -> std::size_t
+    {
+        return 0;
+    }
+
     virtual void connect(graph&) const = 0;
 };
 
@@ -8,6 +8,7 @@
 
 #include <boost/assert.hpp>
 #include <boost/intrusive/set.hpp>
+#include <boost/polymorphic_cast.hpp>
 
 #include <concepts>
 #include <memory_resource>
@@ -25,6 +26,9 @@ public:
     virtual auto type() const -> std::type_index const& = 0;
 
     virtual void clear() = 0;
+
+    //! Inserts copies of the events of a buffer of the same type.
+    virtual void insert(abstract_event_buffer const&) = 0;
 };
 
 template <class T>
@@ -99,6 +103,16 @@ public:
             std::forward<V>(value)));
     }
 
+    void insert(abstract_event_buffer const& other) override
+    {
+        BOOST_ASSERT(other.type() == type());
+        for (event<T> const& ev :
+             boost::polymorphic_downcast<event_buffer const&>(other))
+        {
+            insert(ev.offset(), ev.value());
+        }
+    }
+
     auto operator=(event_buffer const&) = delete;
     auto operator=(event_buffer&&) = delete;
 
@@ -0,0 +1,90 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/period_size.h>
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
+
+namespace piejam::audio::engine
+{
+
+//! Granularity at which a processor applies its input events. With a
+//! granularity of one, events are applied sample accurate. Otherwise the
+//! event offsets are rounded down to a multiple of the granularity, and of
+//! the events falling onto the same boundary only the last one is applied.
+//! This bounds the number of slices per period to
+//! buffer_size / granularity + 1.
+struct event_quantization
+{
+    std::size_t granularity{1};
+
+    //! Granularities beyond the largest period don't quantize any further,
+    //! a granularity of zero can't quantize at all.
+    [[nodiscard]]
+    constexpr auto is_valid() const noexcept -> bool
+    {
+        return granularity >= 1 && granularity <= max_period_size.value();
+    }
+
+    [[nodiscard]]
+    constexpr auto is_sample_accurate() const noexcept -> bool
+    {
+        return granularity == 1;
+    }
+
+    [[nodiscard]]
+    constexpr auto quantize(std::size_t const offset) const noexcept
+        -> std::size_t
+    {
+        BOOST_ASSERT(granularity > 0);
+        return offset - offset % granularity;
+    }
+
+    constexpr auto operator==(event_quantization const&) const noexcept
+        -> bool = default;
+};
+
+inline constexpr event_quantization sample_accurate_events{1};
+
+//! Suited for parameter changes, which are smoothed or interpolated anyway.
+inline constexpr event_quantization control_rate_events{16};
+
+//! All offsets within a period fall onto its start, the events are applied
+//! once per period and the last one wins.
+inline constexpr event_quantization period_rate_events{
+    max_period_size.value()};
+
+//! Picks the finest power of two granularity at which the fixed overhead per
+//! slice stays below an eighth of the work on the slice. Both costs are in
+//! the same unit, e.g. nanoseconds.
+[[nodiscard]]
+constexpr auto
+event_quantization_for_overhead(
+    double const overhead_per_slice,
+    double const cost_per_sample) noexcept -> event_quantization
+{
+    constexpr double max_overhead_ratio = 0.125;
+
+    if (overhead_per_slice <= 0.)
+    {
+        return sample_accurate_events;
+    }
+
+    std::size_t granularity{1};
+    while (granularity < period_rate_events.granularity &&
+           overhead_per_slice >
+               max_overhead_ratio * cost_per_sample *
+                   static_cast<double>(granularity))
+    {
+        granularity *= 2;
+    }
+
+    return event_quantization{granularity};
+}
+
+} // namespace piejam::audio::engine
@@ -0,0 +1,39 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace piejam::audio::engine
+{
+
+//! Counts the frames processed by the engine.
+//!
+//! The clock is advanced from the audio thread after each period, so while
+//! the processors run, now() is the index of the first frame of the period.
+//! It never wraps around in practice, at 192 kHz it lasts for millions of
+//! years.
+class frame_clock
+{
+public:
+    [[nodiscard]]
+    auto now() const noexcept -> std::uint64_t
+    {
+        return m_frame.load(std::memory_order_acquire);
+    }
+
+    void advance(std::size_t const num_frames) noexcept
+    {
+        m_frame.store(
+            m_frame.load(std::memory_order_relaxed) + num_frames,
+            std::memory_order_release);
+    }
+
+private:
+    std::atomic_uint64_t m_frame{};
+};
+
+} // namespace piejam::audio::engine
@@ -16,6 +16,11 @@ class event_buffer_memory;
 class event_input_buffers;
 class event_output_buffers;
 class event_port;
+struct event_quantization;
+
+struct capture_window;
+struct captured_frames;
+class frame_clock;
 
 class component;
 class processor;
@@ -23,6 +28,7 @@ class named_processor;
 class input_processor;
 class output_processor;
 class stream_processor;
+class capture_tap_processor;
 template <class T>
 class value_io_processor;
 
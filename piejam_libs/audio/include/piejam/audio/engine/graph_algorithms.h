@@ -31,6 +31,8 @@ auto has_event_wire(
 void remove_event_identity_processors(graph&);
 void remove_identity_processors(graph&);
 
+//! The mixers inserted by finalize_graph and the processors feeding them, they
+//! have to be kept alive with the graph.
 using mix_processors = std::vector<std::unique_ptr<processor>>;
 
 auto finalize_graph(graph const&) -> std::tuple<graph, mix_processors>;
@@ -9,6 +9,10 @@
 namespace piejam::audio::engine
 {
 
-auto graph_to_dag(graph const&) -> dag;
+class buffer_pass_counter;
+
+//! Results, which feed only processors folding their inputs, may be folded.
+//! If a counter is given, the jobs count the buffers written by them.
+auto graph_to_dag(graph const&, buffer_pass_counter* = nullptr) -> dag;
 
 } // namespace piejam::audio::engine
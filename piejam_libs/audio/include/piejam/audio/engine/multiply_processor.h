@@ -15,4 +15,6 @@ namespace piejam::audio::engine
 auto make_multiply_processor(std::size_t num_inputs, std::string_view name = {})
     -> std::unique_ptr<processor>;
 
+auto is_multiply_processor(processor const&) noexcept -> bool;
+
 } // namespace piejam::audio::engine
@@ -17,14 +17,9 @@ namespace piejam::audio::engine
 auto make_pan_processor(std::string_view name = {})
     -> std::unique_ptr<processor>;
 
-// event in: volume, pan
-// event out: gain L, gain R
-auto make_volume_pan_processor(std::string_view name = {})
-    -> std::unique_ptr<processor>;
-
-// event in: mute, pan
-// event out: gain L, gain R
-auto make_mute_pan_processor(std::string_view name = {})
+// event in: mute
+// event out: gain
+auto make_mute_gain_processor(std::string_view name = {})
     -> std::unique_ptr<processor>;
 
 // event in: balance
@@ -32,9 +27,4 @@ auto make_mute_pan_processor(std::string_view name = {})
 auto make_balance_processor(std::string_view name = {})
     -> std::unique_ptr<processor>;
 
-// event in: volume, balance
-// event out: gain L, gain R
-auto make_volume_balance_processor(std::string_view name = {})
-    -> std::unique_ptr<processor>;
-
 } // namespace piejam::audio::engine
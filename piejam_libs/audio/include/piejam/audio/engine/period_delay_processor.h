@@ -0,0 +1,23 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/engine/fwd.h>
+
+#include <memory>
+#include <string_view>
+
+namespace piejam::audio::engine
+{
+
+//! Delays the inputs by whole periods, the output of a period is the input of
+//! the num_periods-th previous one. Used to compensate the latency of
+//! pipelined processors on parallel paths.
+auto make_period_delay_processor(
+    std::size_t num_channels,
+    std::size_t num_periods,
+    std::string_view name = {}) -> std::unique_ptr<processor>;
+
+} // namespace piejam::audio::engine
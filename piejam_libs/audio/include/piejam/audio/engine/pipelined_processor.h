@@ -0,0 +1,28 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/engine/fwd.h>
+#include <piejam/thread/fwd.h>
+
+#include <memory>
+
+namespace piejam::audio::engine
+{
+
+//! Runs a processor on a dedicated thread, one period behind.
+//!
+//! The inputs and input events of a period are copied and handed over to the
+//! thread, which processes them while the engine goes on with the rest of the
+//! graph. The outputs of a period are the results of the previous one, so
+//! the processor adds a latency of one period, but isn't on the critical
+//! path of the graph anymore. Processing a period waits, if the thread isn't
+//! finished with the previous one yet. The event outputs of the wrapped
+//! processor are dropped.
+auto make_pipelined_processor(
+    std::unique_ptr<processor>,
+    thread::configuration const&) -> std::unique_ptr<processor>;
+
+} // namespace piejam::audio::engine
@@ -19,6 +19,8 @@ struct process_context
         std::span<std::reference_wrapper<slice<float> const> const>;
     using output_buffers_t = std::span<std::span<float> const>;
     using result_buffers_t = std::span<slice<float>>;
+    using input_factors_t =
+        std::span<std::reference_wrapper<float const> const>;
 
     input_buffers_t inputs{};
     output_buffers_t outputs{};
@@ -26,6 +28,15 @@ struct process_context
     event_input_buffers const& event_inputs;
     event_output_buffers const& event_outputs;
     std::size_t buffer_size{};
+
+    // Set, if the processor folds its inputs. Input i is then
+    // inputs[i] * input_factors[i].
+    input_factors_t input_factors{};
+
+    // Set, if the results may be folded. Instead of multiplying an input into
+    // an output, the processor may then pass the input through as result i
+    // and set result_factors[i]. They are reset to one every period.
+    std::span<float> result_factors{};
 };
 
 } // namespace piejam::audio::engine
@@ -34,6 +34,15 @@ public:
     [[nodiscard]]
     virtual auto event_outputs() const noexcept -> event_ports = 0;
 
+    //! Whether the processor takes inputs scaled by a factor, see
+    //! process_context::input_factors. Results feeding only such processors
+    //! may be folded instead of being multiplied.
+    [[nodiscard]]
+    virtual auto folds_inputs() const noexcept -> bool
+    {
+        return false;
+    }
+
     virtual void process(process_context const&) = 0;
 };
 
@@ -19,6 +19,7 @@
 namespace piejam::audio::engine
 {
 
+class buffer_pass_counter;
 class processor;
 struct thread_context;
 
@@ -27,10 +28,18 @@ class processor_job final
 public:
     using output_buffer_t = std::array<float, max_period_size.value()>;
 
-    processor_job(processor& proc);
+    processor_job(processor& proc, buffer_pass_counter* = nullptr);
 
     auto result_ref(std::size_t index) const -> slice<float> const&;
-    void connect_result(std::size_t index, slice<float> const& res);
+    auto result_factor_ref(std::size_t index) const -> float const&;
+    void connect_result(
+        std::size_t index,
+        slice<float> const& res,
+        float const& factor);
+
+    // Allow the processor to fold its results, all consumers of them must
+    // fold their inputs.
+    void enable_result_folding();
 
     auto event_result_ref(std::size_t index) -> abstract_event_buffer const&;
     void connect_event_result(
@@ -48,11 +57,15 @@ private:
     std::vector<std::reference_wrapper<slice<float> const>> m_inputs;
     std::vector<std::span<float>> m_outputs;
     std::vector<slice<float>> m_results;
+    std::vector<std::reference_wrapper<float const>> m_input_factors;
+    std::vector<float> m_result_factors;
 
     event_input_buffers m_event_inputs;
     event_output_buffers m_event_outputs;
 
     process_context m_process_context;
+
+    buffer_pass_counter* m_buffer_pass_counter{};
 };
 
 } // namespace piejam::audio::engine
@@ -29,10 +29,10 @@ struct processor_test_environment
                .event_outputs = event_outputs,
                .buffer_size = buffer_size})
     {
-        for (std::size_t n = 0, e = proc.num_inputs(); n < e; ++n)
+        audio_inputs.resize(proc.num_inputs());
+        for (slice<float> const& in : audio_inputs)
         {
-            audio_inputs.emplace_back();
-            audio_in_slices.emplace_back(audio_inputs.back());
+            audio_in_slices.emplace_back(in);
         }
         ctx.inputs = audio_in_slices;
 
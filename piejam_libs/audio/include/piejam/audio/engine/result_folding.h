@@ -0,0 +1,47 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/slice.h>
+#include <piejam/audio/slice_algorithms.h>
+
+#include <cstddef>
+
+namespace piejam::audio::engine
+{
+
+//! The factor of an input, one if the processor doesn't fold its inputs.
+[[nodiscard]]
+inline auto
+input_factor(process_context const& ctx, std::size_t const index) noexcept
+    -> float
+{
+    return ctx.input_factors.empty() ? 1.f : ctx.input_factors[index].get();
+}
+
+//! Sets a result to in * factor. It's folded, if the results may be folded,
+//! otherwise multiplied into the output buffer.
+inline void
+set_scaled_result(
+    process_context const& ctx,
+    std::size_t const index,
+    slice<float> const& in,
+    float const factor) noexcept
+{
+    if (in.is_span() && factor != 0.f && factor != 1.f &&
+        !ctx.result_factors.empty())
+    {
+        ctx.results[index] = in;
+        ctx.result_factors[index] = factor;
+    }
+    else
+    {
+        ctx.results[index] =
+            multiply(in, slice<float>(factor), ctx.outputs[index]);
+    }
+}
+
+} // namespace piejam::audio::engine
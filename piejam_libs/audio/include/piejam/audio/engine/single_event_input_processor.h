@@ -5,8 +5,13 @@
 #pragma once
 
 #include <piejam/audio/engine/event_input_buffers.h>
+#include <piejam/audio/engine/event_quantization.h>
 #include <piejam/audio/engine/process_context.h>
 
+#include <boost/assert.hpp>
+
+#include <iterator>
+
 namespace piejam::audio::engine
 {
 
@@ -14,6 +19,19 @@ template <class DerivedProcessor, class T>
 class single_event_input_processor
 {
 public:
+    explicit single_event_input_processor(
+        event_quantization const quantization = sample_accurate_events)
+        : m_event_quantization{quantization}
+    {
+        BOOST_ASSERT(m_event_quantization.granularity > 0);
+    }
+
+    [[nodiscard]]
+    auto quantization() const noexcept -> event_quantization const&
+    {
+        return m_event_quantization;
+    }
+
     void process_sliced(process_context const& ctx)
     {
         event_buffer<T> const& ev_in_buf = ctx.event_inputs.get<T>(0);
@@ -29,7 +47,7 @@ public:
             this_proc.process_event(ctx, ev_in_buf.front());
             this_proc.process_buffer(ctx);
         }
-        else
+        else if (m_event_quantization.is_sample_accurate())
         {
             std::size_t offset{};
             for (event<T> const& ev : ev_in_buf)
@@ -48,7 +66,58 @@ public:
 
             this_proc.process_slice(ctx, offset, ctx.buffer_size - offset);
         }
+        else
+        {
+            process_quantized(ctx, ev_in_buf, this_proc);
+        }
+    }
+
+private:
+    void process_quantized(
+        process_context const& ctx,
+        event_buffer<T> const& ev_in_buf,
+        DerivedProcessor& this_proc)
+    {
+        auto const last = ev_in_buf.end();
+
+        // all events fall onto the first boundary, the block stays whole
+        if (m_event_quantization.quantize(std::prev(last)->offset()) == 0)
+        {
+            this_proc.process_event(ctx, *std::prev(last));
+            this_proc.process_buffer(ctx);
+            return;
+        }
+
+        std::size_t offset{};
+        for (auto it = ev_in_buf.begin(); it != last; ++it)
+        {
+            BOOST_ASSERT(it->offset() < ctx.buffer_size);
+
+            std::size_t const ev_offset =
+                m_event_quantization.quantize(it->offset());
+            BOOST_ASSERT(offset <= ev_offset);
+
+            // coalesce, only the last event on a boundary is applied
+            if (auto const next = std::next(it);
+                next != last &&
+                m_event_quantization.quantize(next->offset()) == ev_offset)
+            {
+                continue;
+            }
+
+            if (offset != ev_offset)
+            {
+                this_proc.process_slice(ctx, offset, ev_offset - offset);
+            }
+
+            this_proc.process_event(ctx, *it);
+            offset = ev_offset;
+        }
+
+        this_proc.process_slice(ctx, offset, ctx.buffer_size - offset);
     }
+
+    event_quantization m_event_quantization;
 };
 
 } // namespace piejam::audio::engine
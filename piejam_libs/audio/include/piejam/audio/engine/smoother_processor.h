@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <piejam/audio/engine/event_quantization.h>
 #include <piejam/audio/engine/fwd.h>
 
 #include <memory>
@@ -16,6 +17,30 @@ namespace piejam::audio::engine
 auto make_lut_smoother_processor(
     std::span<float const> lut,
     float current,
+    std::string_view name = {},
+    event_quantization = sample_accurate_events) -> std::unique_ptr<processor>;
+
+// audio in: num_channels
+// audio out: num_channels
+// event in: gain
+//! Multiplies all channels with the smoothed gain.
+auto make_lut_smoothed_multiply_processor(
+    std::span<float const> lut,
+    float current,
+    std::size_t num_channels,
+    std::string_view name = {},
+    event_quantization = sample_accurate_events) -> std::unique_ptr<processor>;
+
+auto is_lut_smoothed_multiply_processor(processor const&) noexcept -> bool;
+
+// audio out: gain
+// event in: gain
+//! The smoothed gain of a lut smoothed multiply processor, to apply it
+//! elsewhere, e.g. in a weighted sum. Both share the smoothing state, so only
+//! one of them may be part of the graph. The event input of the multiply has
+//! to be connected to it instead.
+auto make_lut_smoothed_gain_processor(
+    processor const& lut_smoothed_multiply,
     std::string_view name = {}) -> std::unique_ptr<processor>;
 
 } // namespace piejam::audio::engine
@@ -0,0 +1,31 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/engine/fwd.h>
+
+#include <memory>
+#include <string_view>
+
+namespace piejam::audio::engine
+{
+
+// The position and the gain are smoothed linearly, while they change the pan
+// law is evaluated per sample. Both outputs are written in one pass. If
+// nothing changes, the results are folded.
+
+// audio in: mono
+// audio out: L, R
+// event in: pan, gain
+auto make_stereo_pan_processor(std::string_view name = {})
+    -> std::unique_ptr<processor>;
+
+// audio in: L, R
+// audio out: L, R
+// event in: balance, gain
+auto make_stereo_balance_processor(std::string_view name = {})
+    -> std::unique_ptr<processor>;
+
+} // namespace piejam::audio::engine
@@ -12,6 +12,7 @@
 #include <boost/assert.hpp>
 
 #include <atomic>
+#include <limits>
 #include <span>
 #include <vector>
 
@@ -104,51 +105,52 @@ public:
         return write_size;
     }
 
-    auto consume() -> multichannel_buffer_t
+    //! consumes up to max_frames per channel
+    auto consume(
+        std::size_t const max_frames = std::numeric_limits<std::size_t>::max())
+        -> multichannel_buffer_t
     {
         std::size_t const read_index =
             m_read_index.load(std::memory_order_acquire);
         std::size_t const write_index = m_write_index.load();
 
-        if (write_index == read_index)
+        std::size_t const frames_to_consume = std::min(
+            write_index >= read_index
+                ? write_index - read_index
+                : m_capacity_per_channel - read_index + write_index,
+            max_frames);
+
+        if (frames_to_consume == 0)
         {
             return multichannel_buffer_t{m_num_channels};
         }
 
+        std::size_t const head_size = std::min(
+            frames_to_consume,
+            m_capacity_per_channel - read_index);
+        std::size_t const tail_size = frames_to_consume - head_size;
+
         multichannel_buffer<float>::vector result;
-        std::size_t frames_to_consume;
+        result.reserve(frames_to_consume * m_num_channels);
 
-        if (write_index < read_index)
+        for (auto d = m_buffer.data(), e = d + m_buffer.size(); d < e;
+             d += m_capacity_per_channel)
         {
-            frames_to_consume =
-                m_capacity_per_channel - read_index + write_index;
-            result.reserve(frames_to_consume * m_num_channels);
+            result.insert(
+                result.end(),
+                d + read_index,
+                d + read_index + head_size);
 
-            for (auto d = m_buffer.data(), e = d + m_buffer.size(); d < e;
-                 d += m_capacity_per_channel)
-            {
-                result.insert(
-                    result.end(),
-                    d + read_index,
-                    d + m_capacity_per_channel);
-
-                result.insert(result.end(), d, d + write_index);
-            }
+            result.insert(result.end(), d, d + tail_size);
         }
-        else
-        {
-            frames_to_consume = write_index - read_index;
-            result.reserve(frames_to_consume * m_num_channels);
 
-            for (auto d = m_buffer.data() + read_index, e = d + m_buffer.size();
-                 d < e;
-                 d += m_capacity_per_channel)
-            {
-                result.insert(result.end(), d, d + frames_to_consume);
-            }
+        std::size_t new_read_index = read_index + frames_to_consume;
+        if (new_read_index >= m_capacity_per_channel)
+        {
+            new_read_index -= m_capacity_per_channel;
         }
 
-        m_read_index.store(write_index, std::memory_order_release);
+        m_read_index.store(new_read_index, std::memory_order_release);
 
         return multichannel_buffer_t{m_num_channels, std::move(result)};
     }
@@ -9,12 +9,15 @@
 #include <piejam/audio/engine/event_port.h>
 #include <piejam/audio/engine/named_processor.h>
 #include <piejam/audio/engine/process_context.h>
+#include <piejam/thread/dirty_set.h>
 #include <piejam/thread/spsc_slot.h>
 
 #include <boost/core/demangle.hpp>
 
 #include <array>
+#include <concepts>
 #include <format>
+#include <optional>
 
 namespace piejam::audio::engine
 {
@@ -41,6 +44,14 @@ public:
         m_out_value.consume(std::forward<F>(f));
     }
 
+    // Marked from the process thread, whenever an input event changes the
+    // value.
+    // Must be set before the processor is inserted into a running graph.
+    void set_change_flag(thread::dirty_set::flag const changed) noexcept
+    {
+        m_changed = changed;
+    }
+
     auto type_name() const noexcept -> std::string_view override
     {
         constexpr auto last_name = [](std::string_view s) {
@@ -79,18 +90,51 @@ public:
     {
         auto& out = ctx.event_outputs.get<T>(0);
 
-        m_in_value.consume([&out](T const& value) { out.insert(0, value); });
+        m_in_value.consume([this, &out](T const& value) {
+            m_value = value;
+            out.insert(0, value);
+        });
+
+        bool changed{};
 
         for (event<T> const& ev : ctx.event_inputs.get<T>(0))
         {
             m_out_value.push(ev.value());
             out.insert(ev.offset(), ev.value());
+
+            if (changes_value(ev.value()))
+            {
+                m_value = ev.value();
+                changed = true;
+            }
+        }
+
+        if (changed)
+        {
+            m_changed.mark();
         }
     }
 
 protected:
     thread::spsc_slot<T> m_in_value;
     thread::spsc_slot<T> m_out_value;
+    thread::dirty_set::flag m_changed;
+
+private:
+    auto changes_value(T const& value) const noexcept -> bool
+    {
+        if constexpr (std::equality_comparable<T>)
+        {
+            return !m_value || *m_value != value;
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    // last value, set or received by the process thread
+    std::optional<T> m_value;
 };
 
 } // namespace piejam::audio::engine
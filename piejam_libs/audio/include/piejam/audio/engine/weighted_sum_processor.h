@@ -0,0 +1,24 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/engine/fwd.h>
+
+#include <memory>
+#include <string_view>
+
+namespace piejam::audio::engine
+{
+
+//! Sums the products of pairs of inputs in one pass, the inputs `2 * i` and
+//! `2 * i + 1` are the factors of term `i`. Replaces a mixer fed by two input
+//! multipliers, e.g. a signal and its gain.
+auto make_weighted_sum_processor(
+    std::size_t num_terms,
+    std::string_view name = {}) -> std::unique_ptr<processor>;
+
+auto is_weighted_sum_processor(processor const&) noexcept -> bool;
+
+} // namespace piejam::audio::engine
@@ -9,12 +9,14 @@
 #include <piejam/numeric/clamp.h>
 #include <piejam/numeric/mipp_iterator.h>
 #include <piejam/numeric/simd/clamp.h>
+#include <piejam/numeric/simd/kernels.h>
 #include <piejam/switch_cast.h>
 
 #include <boost/assert.hpp>
 #include <boost/hof/capture.hpp>
 
 #include <algorithm>
+#include <type_traits>
 
 namespace piejam::audio
 {
@@ -51,11 +53,22 @@ struct slice_add
             default:
                 BOOST_ASSERT(l_buf.size() == m_out.size());
 
-                std::transform(
-                    numeric::mipp_begin(l_buf),
-                    numeric::mipp_end(l_buf),
-                    numeric::mipp_begin(m_out),
-                    bhof::capture(mipp::Reg<T>(r_c))(std::plus<>{}));
+                if constexpr (std::is_same_v<T, float>)
+                {
+                    numeric::simd::kernels().add_constant(
+                        l_buf.data(),
+                        r_c,
+                        m_out.data(),
+                        m_out.size());
+                }
+                else
+                {
+                    std::transform(
+                        numeric::mipp_begin(l_buf),
+                        numeric::mipp_end(l_buf),
+                        numeric::mipp_begin(m_out),
+                        bhof::capture(mipp::Reg<T>(r_c))(std::plus<>{}));
+                }
 
                 return m_out;
         }
@@ -75,12 +88,23 @@ struct slice_add
         BOOST_ASSERT(l_buf.size() == r_buf.size());
         BOOST_ASSERT(l_buf.size() == m_out.size());
 
-        std::transform(
-            numeric::mipp_begin(l_buf),
-            numeric::mipp_end(l_buf),
-            numeric::mipp_begin(r_buf),
-            numeric::mipp_begin(m_out),
-            std::plus<>{});
+        if constexpr (std::is_same_v<T, float>)
+        {
+            numeric::simd::kernels().add(
+                l_buf.data(),
+                r_buf.data(),
+                m_out.data(),
+                m_out.size());
+        }
+        else
+        {
+            std::transform(
+                numeric::mipp_begin(l_buf),
+                numeric::mipp_end(l_buf),
+                numeric::mipp_begin(r_buf),
+                numeric::mipp_begin(m_out),
+                std::plus<>{});
+        }
 
         return m_out;
     }
@@ -119,21 +143,44 @@ struct slice_multiply
             case switch_cast(T{-1}):
                 BOOST_ASSERT(l_buf.size() == m_out.size());
 
-                std::transform(
-                    numeric::mipp_begin(l_buf),
-                    numeric::mipp_end(l_buf),
-                    numeric::mipp_begin(m_out),
-                    bhof::capture(mipp::Reg<T>(T{}))(std::minus<>{}));
+                if constexpr (std::is_same_v<T, float>)
+                {
+                    numeric::simd::kernels().multiply_constant(
+                        l_buf.data(),
+                        r_c,
+                        m_out.data(),
+                        m_out.size());
+                }
+                else
+                {
+                    std::transform(
+                        numeric::mipp_begin(l_buf),
+                        numeric::mipp_end(l_buf),
+                        numeric::mipp_begin(m_out),
+                        bhof::capture(mipp::Reg<T>(T{}))(std::minus<>{}));
+                }
                 return m_out;
 
             default:
                 BOOST_ASSERT(l_buf.size() == m_out.size());
 
-                std::transform(
-                    numeric::mipp_begin(l_buf),
-                    numeric::mipp_end(l_buf),
-                    numeric::mipp_begin(m_out),
-                    bhof::capture(mipp::Reg<T>(r_c))(std::multiplies<>{}));
+                if constexpr (std::is_same_v<T, float>)
+                {
+                    numeric::simd::kernels().multiply_constant(
+                        l_buf.data(),
+                        r_c,
+                        m_out.data(),
+                        m_out.size());
+                }
+                else
+                {
+                    std::transform(
+                        numeric::mipp_begin(l_buf),
+                        numeric::mipp_end(l_buf),
+                        numeric::mipp_begin(m_out),
+                        bhof::capture(mipp::Reg<T>(r_c))(
+                            std::multiplies<>{}));
+                }
 
                 return m_out;
         }
@@ -153,12 +200,23 @@ struct slice_multiply
         BOOST_ASSERT(l_buf.size() == r_buf.size());
         BOOST_ASSERT(l_buf.size() == m_out.size());
 
-        std::transform(
-            numeric::mipp_begin(l_buf),
-            numeric::mipp_end(l_buf),
-            numeric::mipp_begin(r_buf),
-            numeric::mipp_begin(m_out),
-            std::multiplies<>{});
+        if constexpr (std::is_same_v<T, float>)
+        {
+            numeric::simd::kernels().multiply(
+                l_buf.data(),
+                r_buf.data(),
+                m_out.data(),
+                m_out.size());
+        }
+        else
+        {
+            std::transform(
+                numeric::mipp_begin(l_buf),
+                numeric::mipp_end(l_buf),
+                numeric::mipp_begin(r_buf),
+                numeric::mipp_begin(m_out),
+                std::multiplies<>{});
+        }
 
         return m_out;
     }
@@ -14,6 +14,7 @@
 #include <piejam/audio/pcm_sample_type.h>
 #include <piejam/audio/types.h>
 #include <piejam/numeric/rolling_mean.h>
+#include <piejam/numeric/simd/kernels.h>
 #include <piejam/range/iota.h>
 #include <piejam/range/strided_span.h>
 #include <piejam/system/device.h>
@@ -24,6 +25,9 @@
 #include <boost/assert.hpp>
 
 #include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
 
 namespace piejam::audio::alsa
 {
@@ -94,6 +98,55 @@ writei(
         channels_per_frame);
 }
 
+// Signed 16 and 32 bit samples in native byte order, the most common formats,
+// are converted by the simd kernels.
+template <pcm_format F>
+constexpr bool has_simd_kernels =
+    (std::is_same_v<pcm_sample_t<F>, std::int16_t> ||
+     std::is_same_v<pcm_sample_t<F>, std::int32_t>) &&
+    pcm_sample_descriptor_t<F>::little_endian ==
+        (std::endian::native == std::endian::little);
+
+void
+simd_convert(
+    std::int16_t const* const in,
+    std::ptrdiff_t const in_stride,
+    float* const out,
+    std::size_t const size) noexcept
+{
+    numeric::simd::kernels().s16_to_float(in, in_stride, out, size);
+}
+
+void
+simd_convert(
+    std::int32_t const* const in,
+    std::ptrdiff_t const in_stride,
+    float* const out,
+    std::size_t const size) noexcept
+{
+    numeric::simd::kernels().s32_to_float(in, in_stride, out, size);
+}
+
+void
+simd_convert(
+    float const* const in,
+    std::int16_t* const out,
+    std::ptrdiff_t const out_stride,
+    std::size_t const size) noexcept
+{
+    numeric::simd::kernels().float_to_s16(in, out, out_stride, size);
+}
+
+void
+simd_convert(
+    float const* const in,
+    std::int32_t* const out,
+    std::ptrdiff_t const out_stride,
+    std::size_t const size) noexcept
+{
+    numeric::simd::kernels().float_to_s32(in, out, out_stride, size);
+}
+
 struct dummy_reader final : pcm_reader
 {
     [[nodiscard]]
@@ -142,15 +195,26 @@ struct interleaved_reader final : pcm_reader
         BOOST_ASSERT(channel < m_num_channels);
         BOOST_ASSERT(m_period_size.value() == buffer.size());
 
-        range::strided_span<pcm_sample_t<F>> interleaved{
-            m_read_buffer.data() + channel,
-            buffer.size(),
-            static_cast<std::ptrdiff_t>(m_num_channels)};
-
-        std::ranges::transform(
-            interleaved,
-            buffer.begin(),
-            &pcm_convert::from<F>);
+        if constexpr (has_simd_kernels<F>)
+        {
+            simd_convert(
+                m_read_buffer.data() + channel,
+                static_cast<std::ptrdiff_t>(m_num_channels),
+                buffer.data(),
+                buffer.size());
+        }
+        else
+        {
+            range::strided_span<pcm_sample_t<F>> interleaved{
+                m_read_buffer.data() + channel,
+                buffer.size(),
+                static_cast<std::ptrdiff_t>(m_num_channels)};
+
+            std::ranges::transform(
+                interleaved,
+                buffer.begin(),
+                &pcm_convert::from<F>);
+        }
     }
 
     [[nodiscard]]
@@ -280,15 +344,26 @@ struct interleaved_writer final : pcm_writer
         BOOST_ASSERT(channel < m_num_channels);
         BOOST_ASSERT(m_period_size.value() == buffer.size());
 
-        range::strided_span<pcm_sample_t<F>> interleaved{
-            m_write_buffer.data() + channel,
-            buffer.size(),
-            static_cast<std::ptrdiff_t>(m_num_channels)};
-
-        std::ranges::transform(
-            buffer,
-            interleaved.begin(),
-            &pcm_convert::to<F>);
+        if constexpr (has_simd_kernels<F>)
+        {
+            simd_convert(
+                buffer.data(),
+                m_write_buffer.data() + channel,
+                static_cast<std::ptrdiff_t>(m_num_channels),
+                buffer.size());
+        }
+        else
+        {
+            range::strided_span<pcm_sample_t<F>> interleaved{
+                m_write_buffer.data() + channel,
+                buffer.size(),
+                static_cast<std::ptrdiff_t>(m_num_channels)};
+
+            std::ranges::transform(
+                buffer,
+                interleaved.begin(),
+                &pcm_convert::to<F>);
+        }
     }
 
     void convert(float constant, std::size_t size, std::size_t channel)
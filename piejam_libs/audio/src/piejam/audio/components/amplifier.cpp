@@ -64,21 +64,33 @@ auto gain_smoother_lut = numeric::dB_lut<float, -120.f, 24.f, 1024>;
 class amplifier final : public engine::component
 {
 public:
-    amplifier(std::size_t num_channels, std::string_view name)
-        : m_gain_proc{engine::make_lut_smoother_processor(
-              gain_smoother_lut,
-              1.f,
-              std::format("{} gain", name))}
-        , m_amp_procs{algorithm::transform_to_vector(
-              range::iota(num_channels),
-              [=](auto ch) {
-                  return engine::make_multiply_processor(
-                      2,
-                      format_name(name, "amp", ch, num_channels));
-              })}
-        , m_inputs{algorithm::transform_to_vector(
-              m_amp_procs | boost::adaptors::indirected,
-              engine::make_graph_endpoint<0>)}
+    amplifier(
+        std::size_t num_channels,
+        std::string_view name,
+        gain_stage stage)
+        : m_gain_proc{make_gain_proc(num_channels, name, stage)}
+        , m_amp_procs{
+              stage == gain_stage::mixable
+                  ? algorithm::transform_to_vector(
+                        range::iota(num_channels),
+                        [=](auto ch) {
+                            return engine::make_multiply_processor(
+                                2,
+                                format_name(name, "amp", ch, num_channels));
+                        })
+                  : std::vector<std::unique_ptr<engine::processor>>{}}
+        , m_inputs{
+              stage == gain_stage::mixable
+                  ? algorithm::transform_to_vector(
+                        m_amp_procs | boost::adaptors::indirected,
+                        engine::make_graph_endpoint<0>)
+                  : algorithm::transform_to_vector(
+                        range::iota(num_channels),
+                        [this](std::size_t ch) {
+                            return engine::graph_endpoint{
+                                .proc = *m_gain_proc,
+                                .port = ch};
+                        })}
         , m_outputs{m_inputs}
     {
     }
@@ -116,7 +128,35 @@ public:
     }
 
 private:
+    static auto make_gain_proc(
+        std::size_t num_channels,
+        std::string_view name,
+        gain_stage stage) -> std::unique_ptr<engine::processor>
+    {
+        switch (stage)
+        {
+            case gain_stage::fused:
+                return engine::make_lut_smoothed_multiply_processor(
+                    gain_smoother_lut,
+                    1.f,
+                    num_channels,
+                    std::format("{} amp", name),
+                    engine::control_rate_events);
+
+            case gain_stage::mixable:
+                return engine::make_lut_smoother_processor(
+                    gain_smoother_lut,
+                    1.f,
+                    std::format("{} gain", name),
+                    engine::control_rate_events);
+        }
+
+        BOOST_ASSERT(false);
+        return {};
+    }
+
     std::unique_ptr<engine::processor> m_gain_proc;
+    // empty, if the gain stage is fused
     std::vector<std::unique_ptr<engine::processor>> m_amp_procs;
 
     std::vector<engine::graph_endpoint> m_inputs;
@@ -128,24 +168,39 @@ private:
 class split_amplifier final : public engine::component
 {
 public:
-    split_amplifier(std::size_t num_channels, std::string_view name)
+    split_amplifier(
+        std::size_t num_channels,
+        std::string_view name,
+        gain_stage stage)
         : m_gain_procs{algorithm::transform_to_vector(
               range::iota(num_channels),
               [=](auto ch) {
-                  return engine::make_lut_smoother_processor(
-                      gain_smoother_lut,
-                      1.f,
-                      format_name(name, "gain", ch, num_channels));
-              })}
-        , m_amp_procs{algorithm::transform_to_vector(
-              range::iota(num_channels),
-              [=](auto ch) {
-                  return engine::make_multiply_processor(
-                      2,
-                      format_name(name, "amp", ch, num_channels));
+                  return stage == gain_stage::mixable
+                             ? engine::make_lut_smoother_processor(
+                                   gain_smoother_lut,
+                                   1.f,
+                                   format_name(name, "gain", ch, num_channels),
+                                   engine::control_rate_events)
+                             : engine::make_lut_smoothed_multiply_processor(
+                                   gain_smoother_lut,
+                                   1.f,
+                                   1,
+                                   format_name(name, "amp", ch, num_channels),
+                                   engine::control_rate_events);
               })}
+        , m_amp_procs{
+              stage == gain_stage::mixable
+                  ? algorithm::transform_to_vector(
+                        range::iota(num_channels),
+                        [=](auto ch) {
+                            return engine::make_multiply_processor(
+                                2,
+                                format_name(name, "amp", ch, num_channels));
+                        })
+                  : std::vector<std::unique_ptr<engine::processor>>{}}
         , m_inputs{algorithm::transform_to_vector(
-              m_amp_procs | boost::adaptors::indirected,
+              (stage == gain_stage::mixable ? m_amp_procs : m_gain_procs) |
+                  boost::adaptors::indirected,
               engine::make_graph_endpoint<0>)}
         , m_outputs{m_inputs}
         , m_event_inputs{algorithm::transform_to_vector(
@@ -189,6 +244,7 @@ public:
 
 private:
     std::vector<std::unique_ptr<engine::processor>> m_gain_procs;
+    // empty, if the gain stages are fused
     std::vector<std::unique_ptr<engine::processor>> m_amp_procs;
 
     std::vector<engine::graph_endpoint> m_inputs;
@@ -199,17 +255,21 @@ private:
 } // namespace
 
 auto
-make_amplifier(std::size_t num_channels, std::string_view name)
-    -> std::unique_ptr<engine::component>
+make_amplifier(
+    std::size_t num_channels,
+    std::string_view name,
+    gain_stage stage) -> std::unique_ptr<engine::component>
 {
-    return std::make_unique<amplifier>(num_channels, name);
+    return std::make_unique<amplifier>(num_channels, name, stage);
 }
 
 auto
-make_split_amplifier(std::size_t num_channels, std::string_view name)
-    -> std::unique_ptr<engine::component>
+make_split_amplifier(
+    std::size_t num_channels,
+    std::string_view name,
+    gain_stage stage) -> std::unique_ptr<engine::component>
 {
-    return std::make_unique<split_amplifier>(num_channels, name);
+    return std::make_unique<split_amplifier>(num_channels, name, stage);
 }
 
 } // namespace piejam::audio::components
@@ -4,19 +4,16 @@
 
 #include <piejam/audio/components/pan_balance.h>
 
-#include <piejam/audio/components/amplifier.h>
-#include <piejam/audio/components/remap_channels.h>
 #include <piejam/audio/engine/component.h>
 #include <piejam/audio/engine/event_port.h>
-#include <piejam/audio/engine/graph.h>
 #include <piejam/audio/engine/graph_endpoint.h>
 #include <piejam/audio/engine/graph_generic_algorithms.h>
-#include <piejam/audio/engine/identity_processor.h>
-#include <piejam/audio/engine/pan_balance_processor.h>
+#include <piejam/audio/engine/graph_node.h>
 #include <piejam/audio/engine/processor.h>
-#include <piejam/audio/pair.h>
+#include <piejam/audio/engine/stereo_pan_processor.h>
 
 #include <format>
+#include <vector>
 
 namespace piejam::audio::components
 {
@@ -27,24 +24,30 @@ namespace
 class pan_balance final : public engine::component
 {
 public:
-    explicit pan_balance(
-        std::unique_ptr<engine::processor> converter_proc,
-        std::unique_ptr<engine::component> amp_comp)
-        : m_converter_proc(std::move(converter_proc))
-        , m_amp_comp(std::move(amp_comp))
+    explicit pan_balance(std::unique_ptr<engine::processor> proc)
+        : m_proc(std::move(proc))
     {
+        for (std::size_t port = 0; port < m_proc->num_inputs(); ++port)
+        {
+            m_inputs.push_back(engine::in_endpoint(*m_proc, port));
+        }
+
+        for (std::size_t port = 0; port < m_proc->num_outputs(); ++port)
+        {
+            m_outputs.push_back(engine::out_endpoint(*m_proc, port));
+        }
     }
 
     [[nodiscard]]
     auto inputs() const -> endpoints override
     {
-        return m_amp_comp->inputs();
+        return m_inputs;
     }
 
     [[nodiscard]]
     auto outputs() const -> endpoints override
     {
-        return m_amp_comp->outputs();
+        return m_outputs;
     }
 
     [[nodiscard]]
@@ -59,50 +62,34 @@ public:
         return {};
     }
 
-    void connect(engine::graph& g) const override
+    void connect(engine::graph&) const override
     {
-        m_amp_comp->connect(g);
-
-        using namespace engine::endpoint_ports;
-        engine::connect_event(
-            g,
-            *m_converter_proc,
-            from<0, 1>,
-            *m_amp_comp,
-            to<0, 1>);
     }
 
 private:
-    std::unique_ptr<engine::processor> m_converter_proc;
-    std::unique_ptr<engine::component> m_amp_comp;
+    std::unique_ptr<engine::processor> m_proc;
 
+    std::vector<engine::graph_endpoint> m_inputs;
+    std::vector<engine::graph_endpoint> m_outputs;
     std::vector<engine::graph_endpoint> m_event_inputs{
-        engine::in_event_endpoints(*m_converter_proc)};
+        engine::in_event_endpoints(*m_proc)};
 };
 
 } // namespace
 
 auto
-make_pan(
-    std::unique_ptr<engine::processor> pan_converter,
-    std::string_view name) -> std::unique_ptr<engine::component>
+make_pan(std::string_view const name) -> std::unique_ptr<engine::component>
 {
-    using namespace engine::endpoint_ports;
     return std::make_unique<pan_balance>(
-        std::move(pan_converter),
-        make_remap_input_channels(
-            make_stereo_split_amplifier(std::format("pan {}", name)),
-            to<0, 1>));
+        engine::make_stereo_pan_processor(std::format("pan {}", name)));
 }
 
 auto
-make_balance(
-    std::unique_ptr<engine::processor> balance_converter,
-    std::string_view name) -> std::unique_ptr<engine::component>
+make_balance(std::string_view const name) -> std::unique_ptr<engine::component>
 {
     return std::make_unique<pan_balance>(
-        std::move(balance_converter),
-        make_stereo_split_amplifier(std::format("balance {}", name)));
+        engine::make_stereo_balance_processor(
+            std::format("balance {}", name)));
 }
 
 } // namespace piejam::audio::components
@@ -0,0 +1,95 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/components/period_delay.h>
+
+#include <piejam/audio/engine/component.h>
+#include <piejam/audio/engine/graph_endpoint.h>
+#include <piejam/audio/engine/period_delay_processor.h>
+#include <piejam/audio/engine/processor.h>
+
+#include <piejam/algorithm/transform_to_vector.h>
+#include <piejam/range/iota.h>
+
+#include <vector>
+
+namespace piejam::audio::components
+{
+
+namespace
+{
+
+class period_delay final : public engine::component
+{
+public:
+    period_delay(
+        std::size_t const num_channels,
+        std::size_t const num_periods,
+        std::string_view const name)
+        : m_num_periods(num_periods)
+        , m_proc(engine::make_period_delay_processor(
+              num_channels,
+              num_periods,
+              name))
+    {
+    }
+
+    [[nodiscard]]
+    auto inputs() const -> endpoints override
+    {
+        return m_endpoints;
+    }
+
+    [[nodiscard]]
+    auto outputs() const -> endpoints override
+    {
+        return m_endpoints;
+    }
+
+    [[nodiscard]]
+    auto event_inputs() const -> endpoints override
+    {
+        return {};
+    }
+
+    [[nodiscard]]
+    auto event_outputs() const -> endpoints override
+    {
+        return {};
+    }
+
+    [[nodiscard]]
+    auto period_latency() const noexcept -> std::size_t override
+    {
+        return m_num_periods;
+    }
+
+    void connect(engine::graph&) const override
+    {
+    }
+
+private:
+    std::size_t m_num_periods;
+    std::unique_ptr<engine::processor> m_proc;
+
+    std::vector<engine::graph_endpoint> m_endpoints{
+        algorithm::transform_to_vector(
+            range::iota(m_proc->num_inputs()),
+            [this](std::size_t const port) {
+                return engine::graph_endpoint{.proc = *m_proc, .port = port};
+            })};
+};
+
+} // namespace
+
+auto
+make_period_delay(
+    std::size_t const num_channels,
+    std::size_t const num_periods,
+    std::string_view const name) -> std::unique_ptr<engine::component>
+{
+    return std::make_unique<period_delay>(num_channels, num_periods, name);
+}
+
+} // namespace piejam::audio::components
@@ -0,0 +1,335 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/pitch_tracker.h>
+
+#include <piejam/audio/dsp/pitch_yin.h>
+
+#include <piejam/algorithm/shift_push_back.h>
+#include <piejam/numeric/pow_n.h>
+#include <piejam/numeric/simd/rms.h>
+
+#include <mipp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace piejam::audio::dsp
+{
+
+namespace
+{
+
+constexpr float min_level{0.001f}; // -60 dB
+
+// Relative size of the lag neighbourhood around a locked estimate.
+constexpr float lock_range{0.1f};
+
+// Maximum of the normalized difference at the minimum, to keep the lock.
+constexpr float lock_threshold{0.2f};
+
+} // namespace
+
+struct pitch_tracker::impl
+{
+    impl(std::size_t const window_size, sample_rate const sr)
+        : signal(window_size)
+        , full_search(window_size)
+        , sr{sr}
+    {
+    }
+
+    [[nodiscard]]
+    auto half_window_size() const noexcept -> std::size_t
+    {
+        return signal.size() / 2;
+    }
+
+    [[nodiscard]]
+    auto locked() const noexcept -> bool
+    {
+        return !difference.empty();
+    }
+
+    // difference[k] += sign * sum_j (x_j - x_{j + lo + k})^2, j in [first,
+    // last)
+    void accumulate(std::size_t const first, std::size_t const last, float sign)
+    {
+        constexpr std::size_t N = mipp::N<float>();
+
+        std::size_t const size = difference.size();
+        std::size_t const main_size = (size / N) * N;
+        float* const d = difference.data();
+
+        mipp::Reg<float> const reg_sign(sign);
+
+        for (std::size_t j = first; j < last; ++j)
+        {
+            float const x_j = signal[j];
+            float const* const x_tau = signal.data() + j + lo;
+
+            mipp::Reg<float> const reg_x_j(x_j);
+
+            for (std::size_t k = 0; k < main_size; k += N)
+            {
+                mipp::Reg<float> const diff = reg_x_j - mipp::loadu(x_tau + k);
+                mipp::storeu(
+                    d + k,
+                    mipp::fmadd(diff * diff, reg_sign, mipp::loadu(d + k)));
+            }
+
+            for (std::size_t k = main_size; k < size; ++k)
+            {
+                d[k] += sign * numeric::pow_n<2>(x_j - x_tau[k]);
+            }
+        }
+    }
+
+    void compute_difference()
+    {
+        std::ranges::fill(difference, 0.f);
+        accumulate(0, half_window_size(), 1.f);
+        samples_since_sync = 0;
+    }
+
+    void lock(float const frequency)
+    {
+        std::size_t const e = half_window_size();
+        float const tau = sr.as<float>() / frequency;
+
+        std::size_t const first = std::max(
+            std::size_t{2},
+            static_cast<std::size_t>(tau * (1.f - lock_range)));
+        std::size_t const last = std::min(
+            e - 1,
+            static_cast<std::size_t>(std::ceil(tau * (1.f + lock_range))) + 1);
+
+        if (last < first + 3)
+        {
+            unlock();
+            return;
+        }
+
+        lo = first;
+        difference.resize(last - first);
+        normalized.resize(last - first);
+        compute_difference();
+    }
+
+    void unlock() noexcept
+    {
+        difference.clear();
+    }
+
+    [[nodiscard]]
+    auto normalized_difference(std::size_t const tau) const noexcept -> float
+    {
+        float difference_sum{};
+        float energy{};
+        for (std::size_t j = 0; j < half_window_size(); ++j)
+        {
+            difference_sum += numeric::pow_n<2>(signal[j] - signal[j + tau]);
+            energy += numeric::pow_n<2>(signal[j]) +
+                      numeric::pow_n<2>(signal[j + tau]);
+        }
+
+        return energy > 0.f ? difference_sum / energy : 1.f;
+    }
+
+    // Searches the minimum of the normalized difference within the locked
+    // neighbourhood. Returns zero, if the lock is lost.
+    [[nodiscard]]
+    auto search_locked() -> float
+    {
+        std::size_t const e = half_window_size();
+
+        // d(tau) / (sum_j x_j^2 + sum_j x_{j+tau}^2), the denominator is the
+        // expected value of d(tau) for uncorrelated signal parts.
+        float energy_lo{};
+        float energy_tau{};
+        for (std::size_t j = 0; j < e; ++j)
+        {
+            energy_lo += numeric::pow_n<2>(signal[j]);
+            energy_tau += numeric::pow_n<2>(signal[j + lo]);
+        }
+
+        for (std::size_t k = 0; k < difference.size(); ++k)
+        {
+            float const energy = energy_lo + energy_tau;
+            normalized[k] =
+                energy > 0.f ? std::max(difference[k], 0.f) / energy : 1.f;
+
+            energy_tau += numeric::pow_n<2>(signal[lo + k + e]) -
+                          numeric::pow_n<2>(signal[lo + k]);
+        }
+
+        auto const it_min = std::ranges::min_element(normalized);
+        auto const k = static_cast<std::size_t>(
+            std::distance(normalized.begin(), it_min));
+
+        if (k == 0 || k + 1 == normalized.size() || *it_min > lock_threshold)
+        {
+            return 0.f;
+        }
+
+        // quadratic interpolation
+        float const prev = normalized[k - 1];
+        float const next = normalized[k + 1];
+        float const denom = 2.f * (prev - 2.f * *it_min + next);
+        float const tau =
+            static_cast<float>(lo + k) +
+            (std::abs(denom) > std::numeric_limits<float>::epsilon()
+                 ? (prev - next) / denom
+                 : 0.f);
+
+        // A multiple of the period is locked as well as the period itself,
+        // e.g. after a jump of a fifth. Prefer the shortest one, as the full
+        // search does.
+        for (std::size_t const divisor : {3u, 2u})
+        {
+            std::size_t const sub_tau = static_cast<std::size_t>(
+                std::lround(tau / static_cast<float>(divisor)));
+
+            if (sub_tau >= 2 &&
+                normalized_difference(sub_tau) < lock_threshold / 2.f)
+            {
+                float const frequency =
+                    sr.as<float>() * static_cast<float>(divisor) / tau;
+                lock(frequency);
+                return locked() ? frequency : 0.f;
+            }
+        }
+
+        float const frequency = sr.as<float>() / tau;
+
+        // follow a gliding pitch, before it reaches the border
+        std::size_t const center = normalized.size() / 2;
+        std::size_t const distance = k > center ? k - center : center - k;
+        if (4 * distance > normalized.size())
+        {
+            lock(frequency);
+        }
+
+        return frequency;
+    }
+
+    auto process(std::span<float const> const samples) -> float
+    {
+        std::size_t const e = half_window_size();
+        std::size_t const num_samples = std::min(samples.size(), signal.size());
+
+        if (num_samples == 0)
+        {
+            return frequency;
+        }
+
+        // Updating costs two passes per new sample, otherwise recompute.
+        bool const incremental = locked() && 2 * num_samples < e;
+
+        if (incremental)
+        {
+            accumulate(0, num_samples, -1.f);
+        }
+
+        algorithm::shift_push_back(signal, samples.last(num_samples));
+
+        if (incremental)
+        {
+            accumulate(e - num_samples, e, 1.f);
+        }
+
+        samples_since_search += num_samples;
+        samples_since_sync += num_samples;
+
+        if (numeric::simd::rms(signal) < min_level)
+        {
+            unlock();
+            frequency = 0.f;
+            return frequency;
+        }
+
+        bool search = samples_since_search >= e;
+
+        if (locked())
+        {
+            // Recomputing once per window bounds the accumulated rounding
+            // error of the incremental updates.
+            if (!incremental || samples_since_sync >= signal.size())
+            {
+                compute_difference();
+            }
+
+            frequency = search_locked();
+
+            if (frequency > 0.f)
+            {
+                samples_since_search = 0;
+                return frequency;
+            }
+
+            unlock();
+            search = true;
+        }
+
+        if (search)
+        {
+            samples_since_search = 0;
+            frequency = full_search(signal, sr);
+
+            if (frequency > 0.f)
+            {
+                lock(frequency);
+            }
+        }
+
+        return frequency;
+    }
+
+    mipp::vector<float> signal;
+    pitch_yin_fft full_search;
+    sample_rate sr;
+
+    // locked neighbourhood, difference[k] = d(lo + k)
+    std::size_t lo{};
+    std::vector<float> difference;
+    std::vector<float> normalized;
+
+    std::size_t samples_since_search{};
+    std::size_t samples_since_sync{};
+    float frequency{};
+};
+
+pitch_tracker::pitch_tracker(std::size_t const window_size, sample_rate const sr)
+    : m_impl{std::make_unique<impl>(window_size, sr)}
+{
+}
+
+pitch_tracker::pitch_tracker(pitch_tracker&&) noexcept = default;
+
+pitch_tracker::~pitch_tracker() = default;
+
+auto pitch_tracker::operator=(pitch_tracker&&) noexcept
+    -> pitch_tracker& = default;
+
+auto
+pitch_tracker::window_size() const noexcept -> std::size_t
+{
+    return m_impl->signal.size();
+}
+
+auto
+pitch_tracker::locked() const noexcept -> bool
+{
+    return m_impl->locked();
+}
+
+auto
+pitch_tracker::process(std::span<float const> const samples) -> float
+{
+    return m_impl->process(samples);
+}
+
+} // namespace piejam::audio::dsp
@@ -4,18 +4,24 @@
 
 #include <piejam/audio/dsp/pitch_yin.h>
 
+#include <piejam/numeric/dft.h>
 #include <piejam/numeric/mipp_iterator.h>
 #include <piejam/numeric/pow_n.h>
 #include <piejam/numeric/simd/fsqradd.h>
+#include <piejam/numeric/simd/kernels.h>
 #include <piejam/numeric/simd/lrot_n.h>
 
 #include <mipp.h>
 
 #include <boost/hof/compose.hpp>
 
+#include <algorithm>
 #include <array>
+#include <complex>
 #include <numeric>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace piejam::audio::dsp
 {
@@ -41,63 +47,71 @@ sqr_difference_sum(
     std::size_t const e,
     std::size_t const tau) -> T
 {
-    constexpr auto N = mipp::N<T>();
-    auto const data = in.data();
-    auto const offset = tau % N;
-    if (offset == 0)
+    if constexpr (std::is_same_v<T, float>)
     {
-        return mipp::sum(
-            std::transform_reduce(
-                numeric::mipp_iterator{data},
-                numeric::mipp_iterator{data + e},
-                numeric::mipp_iterator{data + tau},
-                mipp::Reg<T>(T{}),
-                std::plus<>{},
-                boost::hof::compose(numeric::pow_n<2>, std::minus<>{})));
+        return numeric::simd::kernels()
+            .sqr_difference_sum(in.data(), in.data() + tau, e);
     }
     else
     {
-        mipp::Reg<T> sums(T{});
+        constexpr auto N = mipp::N<T>();
+        auto const data = in.data();
+        auto const offset = tau % N;
+        if (offset == 0)
+        {
+            return mipp::sum(
+                std::transform_reduce(
+                    numeric::mipp_iterator{data},
+                    numeric::mipp_iterator{data + e},
+                    numeric::mipp_iterator{data + tau},
+                    mipp::Reg<T>(T{}),
+                    std::plus<>{},
+                    boost::hof::compose(numeric::pow_n<2>, std::minus<>{})));
+        }
+        else
+        {
+            mipp::Reg<T> sums(T{});
 
-        auto mask = precomputed_masks<N>[offset];
+            auto mask = precomputed_masks<N>[offset];
 
-        numeric::mipp_iterator it_tau{data + tau - offset};
-        mipp::Reg<T> reg_lo = numeric::simd::lrot_n(*it_tau, offset);
+            numeric::mipp_iterator it_tau{data + tau - offset};
+            mipp::Reg<T> reg_lo = numeric::simd::lrot_n(*it_tau, offset);
 
-        for (auto reg_i : std::ranges::subrange(
-                 numeric::mipp_iterator{data},
-                 numeric::mipp_iterator{data + e}))
-        {
-            ++it_tau;
-            mipp::Reg<T> reg_hi = numeric::simd::lrot_n(*it_tau, offset);
+            for (auto reg_i : std::ranges::subrange(
+                     numeric::mipp_iterator{data},
+                     numeric::mipp_iterator{data + e}))
+            {
+                ++it_tau;
+                mipp::Reg<T> reg_hi = numeric::simd::lrot_n(*it_tau, offset);
 
-            sums = numeric::simd::fsqradd(
-                reg_i - mipp::select(mask, reg_lo, reg_hi),
-                sums);
+                sums = numeric::simd::fsqradd(
+                    reg_i - mipp::select(mask, reg_lo, reg_hi),
+                    sums);
 
-            reg_lo = reg_hi;
-        }
+                reg_lo = reg_hi;
+            }
 
-        return mipp::sum(sums);
+            return mipp::sum(sums);
+        }
     }
 }
 
-} // namespace
-
-template <std::floating_point T>
+// Cumulative mean normalized difference search, shared by the direct and the
+// FFT variant. difference(tau) is only called with increasing tau.
+template <std::floating_point T, class Difference>
 [[nodiscard]]
 auto
-pitch_yin(std::span<T const> const in, sample_rate const sr) -> T
+find_pitch(std::size_t const e, Difference&& difference, sample_rate const sr)
+    -> T
 {
     constexpr T threshold{0.1};
 
-    std::size_t const e = in.size() / 2;
     T prev_cmn = T{1};
     T curr_cmn = T{1};
     T cumulative_sum{};
     for (std::size_t tau = 1; tau < e; ++tau)
     {
-        T const sum = sqr_difference_sum(in, e, tau);
+        T const sum = difference(tau);
 
         cumulative_sum += sum;
         T const next_cmn = tau * sum / cumulative_sum;
@@ -118,6 +132,115 @@ pitch_yin(std::span<T const> const in, sample_rate const sr) -> T
     return T{};
 }
 
+} // namespace
+
+template <std::floating_point T>
+[[nodiscard]]
+auto
+pitch_yin(std::span<T const> const in, sample_rate const sr) -> T
+{
+    std::size_t const e = in.size() / 2;
+    return find_pitch<T>(
+        e,
+        [&](std::size_t const tau) { return sqr_difference_sum(in, e, tau); },
+        sr);
+}
+
 template auto pitch_yin<float>(std::span<float const>, sample_rate) -> float;
 
+struct pitch_yin_fft::impl
+{
+    explicit impl(std::size_t const window_size)
+        : dft{window_size}
+        , lag_spectrum(dft.output_size())
+        , energy(window_size + 1)
+        , difference(window_size / 2)
+    {
+    }
+
+    // d(tau) = sum_j (x_j - x_{j+tau})^2, j in [0, e)
+    //        = sum_j x_j^2 + sum_j x_{j+tau}^2 - 2 * sum_j x_j * x_{j+tau}
+    //
+    // The cross term is the correlation of the first half with the whole
+    // window. Since j + tau < 2e == window size, a circular correlation of
+    // window size doesn't wrap around.
+    void compute_difference(std::span<float const> const in)
+    {
+        std::size_t const window_size = dft.size();
+        std::size_t const e = window_size / 2;
+
+        BOOST_ASSERT(in.size() == window_size);
+
+        std::transform_inclusive_scan(
+            in.begin(),
+            in.end(),
+            std::next(energy.begin()),
+            std::plus<>{},
+            numeric::pow_n<2>);
+
+        auto const dft_in = dft.input_buffer();
+        std::ranges::copy(in.first(e), dft_in.begin());
+        std::ranges::fill(dft_in.subspan(e), 0.f);
+        std::ranges::copy(dft.process(), lag_spectrum.begin());
+
+        std::ranges::copy(in, dft_in.begin());
+        dft.process();
+
+        std::ranges::transform(
+            lag_spectrum,
+            dft.output_buffer(),
+            dft.output_buffer().begin(),
+            [](std::complex<float> const a, std::complex<float> const x) {
+                return std::conj(a) * x;
+            });
+
+        auto const correlation = dft.process_inverse();
+        float const two_div_size = 2.f / static_cast<float>(window_size);
+
+        for (std::size_t tau = 0; tau < e; ++tau)
+        {
+            difference[tau] = energy[e] + (energy[tau + e] - energy[tau]) -
+                              correlation[tau] * two_div_size;
+        }
+    }
+
+    numeric::dft dft;
+    std::vector<std::complex<float>> lag_spectrum;
+    std::vector<float> energy;
+    std::vector<float> difference;
+};
+
+pitch_yin_fft::pitch_yin_fft(std::size_t const window_size)
+    : m_impl{std::make_unique<impl>(window_size)}
+{
+}
+
+pitch_yin_fft::pitch_yin_fft(pitch_yin_fft&&) noexcept = default;
+
+pitch_yin_fft::~pitch_yin_fft() = default;
+
+auto pitch_yin_fft::operator=(pitch_yin_fft&&) noexcept
+    -> pitch_yin_fft& = default;
+
+auto
+pitch_yin_fft::window_size() const noexcept -> std::size_t
+{
+    return m_impl->dft.size();
+}
+
+auto
+pitch_yin_fft::operator()(std::span<float const> const in, sample_rate const sr)
+    -> float
+{
+    m_impl->compute_difference(in);
+
+    return find_pitch<float>(
+        m_impl->difference.size(),
+        [this](std::size_t const tau) {
+            // rounding can push the difference slightly below zero
+            return std::max(m_impl->difference[tau], 0.f);
+        },
+        sr);
+}
+
 } // namespace piejam::audio::dsp
@@ -0,0 +1,106 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/capture_tap_processor.h>
+
+#include <piejam/audio/engine/frame_clock.h>
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/period_size.h>
+#include <piejam/audio/slice_algorithms.h>
+
+#include <piejam/algorithm/transform_to_vector.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+
+namespace piejam::audio::engine
+{
+
+capture_tap_processor::capture_tap_processor(
+    frame_clock const& clock,
+    std::size_t const num_channels,
+    std::size_t const capacity_per_channel,
+    std::string_view const name)
+    : named_processor(name)
+    , m_clock(clock)
+    , m_num_channels(num_channels)
+    , m_window_slices(num_channels)
+    , m_window_inputs(m_window_slices.begin(), m_window_slices.end())
+    , m_buffer(num_channels, capacity_per_channel)
+    // at most one block per period
+    , m_blocks(capacity_per_channel / min_period_size.value() + 1)
+{
+    BOOST_ASSERT(m_num_channels > 0);
+}
+
+void
+capture_tap_processor::process(process_context const& ctx)
+{
+    m_next_window.pull(m_window);
+
+    std::uint64_t const period_start = m_clock.now();
+    std::uint64_t const first = std::max(period_start, m_window.start);
+    std::uint64_t const last =
+        std::min(period_start + ctx.buffer_size, m_window.stop);
+
+    if (first >= last || m_blocks.write_available() == 0)
+    {
+        return;
+    }
+
+    auto const offset = static_cast<std::size_t>(first - period_start);
+    auto const size = static_cast<std::size_t>(last - first);
+
+    for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+    {
+        m_window_slices[ch] = subslice(ctx.inputs[ch].get(), offset, size);
+    }
+
+    if (std::size_t const written = m_buffer.write(m_window_inputs, size))
+    {
+        m_blocks.push(block{.frame = first, .num_frames = written});
+    }
+}
+
+auto
+capture_tap_processor::consume() -> std::vector<captured_frames>
+{
+    // The samples of a block are written before the block is published, so
+    // the published blocks are always complete in the ring buffer.
+    std::vector<block> runs;
+    m_blocks.consume_all([&runs](block const& b) {
+        if (!runs.empty() &&
+            runs.back().frame + runs.back().num_frames == b.frame)
+        {
+            runs.back().num_frames += b.num_frames;
+        }
+        else
+        {
+            runs.push_back(b);
+        }
+    });
+
+    return algorithm::transform_to_vector(runs, [this](block const& run) {
+        auto data = m_buffer.consume(run.num_frames);
+        BOOST_ASSERT(data.num_frames() == run.num_frames);
+        return captured_frames{.frame = run.frame, .data = std::move(data)};
+    });
+}
+
+auto
+make_capture_tap_processor(
+    frame_clock const& clock,
+    std::size_t const num_channels,
+    std::size_t const capacity_per_channel,
+    std::string_view const name) -> std::unique_ptr<capture_tap_processor>
+{
+    return std::make_unique<capture_tap_processor>(
+        clock,
+        num_channels,
+        capacity_per_channel,
+        name);
+}
+
+} // namespace piejam::audio::engine
@@ -10,7 +10,10 @@
 #include <piejam/audio/engine/graph_generic_algorithms.h>
 #include <piejam/audio/engine/identity_processor.h>
 #include <piejam/audio/engine/mix_processor.h>
+#include <piejam/audio/engine/multiply_processor.h>
 #include <piejam/audio/engine/processor.h>
+#include <piejam/audio/engine/smoother_processor.h>
+#include <piejam/audio/engine/weighted_sum_processor.h>
 
 #include <piejam/functional/address_compare.h>
 #include <piejam/functional/operators.h>
@@ -19,7 +22,10 @@
 #include <boost/range/iterator_range_core.hpp>
 
 #include <algorithm>
+#include <map>
+#include <optional>
 #include <set>
+#include <vector>
 
 namespace piejam::audio::engine
 {
@@ -213,6 +219,196 @@ insert_mixer(graph& g) -> mix_processors
     return result;
 }
 
+// The gain stage connected to dst, if it doesn't feed anything else. It's a
+// two input multiplier or a channel of a lut smoothed multiplier.
+auto
+exclusive_gain_stage(graph const& g, graph_endpoint const& dst)
+    -> std::optional<graph_endpoint>
+{
+    auto const src = connected_source(g, dst);
+    if (!src)
+    {
+        return std::nullopt;
+    }
+
+    processor const& proc = src->proc;
+    if (!(is_multiply_processor(proc) && proc.num_inputs() == 2) &&
+        !is_lut_smoothed_multiply_processor(proc))
+    {
+        return std::nullopt;
+    }
+
+    auto const outs = g.audio.equal_range(*src);
+    if (std::distance(outs.first, outs.second) != 1)
+    {
+        return std::nullopt;
+    }
+
+    return src;
+}
+
+void
+move_source(graph& g, graph_endpoint const& from, graph_endpoint const& to)
+{
+    if (auto const src = connected_source(g, from))
+    {
+        g.audio.erase(*src, from);
+        g.audio.insert(*src, to);
+    }
+}
+
+// Replaces mixers, whose inputs are all fed by gain stages, with a weighted
+// sum, which multiplies and sums in one pass. The gain of a lut smoothed
+// multiplier is then generated by a gain processor, which takes over its
+// smoothing, so all its channels have to be fused.
+void
+fuse_gain_stages(graph& g, mix_processors& mixers)
+{
+    // the gain stages of each mixer, empty if it can't be fused
+    std::vector<std::vector<graph_endpoint>> gain_stages(mixers.size());
+    for (std::size_t index = 0; index < mixers.size(); ++index)
+    {
+        processor& mixer = *mixers[index];
+        for (std::size_t port = 0; port < mixer.num_inputs(); ++port)
+        {
+            auto const gain_stage = exclusive_gain_stage(
+                g,
+                graph_endpoint{.proc = mixer, .port = port});
+            if (!gain_stage)
+            {
+                gain_stages[index].clear();
+                break;
+            }
+
+            gain_stages[index].push_back(*gain_stage);
+        }
+    }
+
+    for (bool dropped = true; dropped;)
+    {
+        std::map<processor const*, std::size_t> num_fused_channels;
+        for (auto const& stages : gain_stages)
+        {
+            for (graph_endpoint const& stage : stages)
+            {
+                if (is_lut_smoothed_multiply_processor(stage.proc))
+                {
+                    ++num_fused_channels[&stage.proc.get()];
+                }
+            }
+        }
+
+        dropped = false;
+        for (auto& stages : gain_stages)
+        {
+            if (std::ranges::any_of(stages, [&](graph_endpoint const& stage) {
+                    return is_lut_smoothed_multiply_processor(stage.proc) &&
+                           num_fused_channels[&stage.proc.get()] !=
+                               stage.proc.get().num_outputs();
+                }))
+            {
+                stages.clear();
+                dropped = true;
+            }
+        }
+    }
+
+    std::map<processor*, std::unique_ptr<processor>> gain_procs;
+
+    for (std::size_t index = 0; index < mixers.size(); ++index)
+    {
+        auto const& stages = gain_stages[index];
+        if (stages.empty())
+        {
+            continue;
+        }
+
+        auto& mixer = mixers[index];
+        auto fused = make_weighted_sum_processor(stages.size());
+
+        for (std::size_t term = 0; term < stages.size(); ++term)
+        {
+            graph_endpoint const& stage = stages[term];
+            processor& gain_stage = stage.proc;
+
+            if (is_lut_smoothed_multiply_processor(gain_stage))
+            {
+                move_source(
+                    g,
+                    graph_endpoint{.proc = gain_stage, .port = stage.port},
+                    graph_endpoint{.proc = *fused, .port = 2 * term});
+
+                auto& gain = gain_procs[&gain_stage];
+                if (!gain)
+                {
+                    gain = make_lut_smoothed_gain_processor(
+                        gain_stage,
+                        gain_stage.name());
+                }
+
+                g.audio.insert(
+                    graph_endpoint{.proc = *gain, .port = 0},
+                    graph_endpoint{.proc = *fused, .port = 2 * term + 1});
+            }
+            else
+            {
+                for (std::size_t factor = 0; factor < 2; ++factor)
+                {
+                    move_source(
+                        g,
+                        graph_endpoint{.proc = gain_stage, .port = factor},
+                        graph_endpoint{
+                            .proc = *fused,
+                            .port = 2 * term + factor});
+                }
+            }
+
+            g.audio.erase(
+                stage,
+                graph_endpoint{.proc = *mixer, .port = term});
+        }
+
+        graph_endpoint const mixer_out{.proc = *mixer, .port = 0};
+        std::vector<graph_endpoint> dsts;
+        for (auto const& [src, dst] :
+             boost::make_iterator_range(g.audio.equal_range(mixer_out)))
+        {
+            dsts.push_back(dst);
+        }
+
+        for (auto const& dst : dsts)
+        {
+            g.audio.erase(mixer_out, dst);
+            g.audio.insert(graph_endpoint{.proc = *fused, .port = 0}, dst);
+        }
+
+        mixer = std::move(fused);
+    }
+
+    // the gain processors take over the events of the multipliers
+    for (auto& [multiply, gain] : gain_procs)
+    {
+        graph_endpoint const multiply_ev{.proc = *multiply, .port = 0};
+
+        std::vector<graph_endpoint> srcs;
+        for (auto const& [src, dst] : g.event)
+        {
+            if (dst == multiply_ev)
+            {
+                srcs.push_back(src);
+            }
+        }
+
+        for (auto const& src : srcs)
+        {
+            g.event.erase(src, multiply_ev);
+            g.event.insert(src, graph_endpoint{.proc = *gain, .port = 0});
+        }
+
+        mixers.push_back(std::move(gain));
+    }
+}
+
 } // namespace
 
 void
@@ -236,6 +432,7 @@ finalize_graph(graph const& g) -> std::tuple<graph, mix_processors>
     remove_identity_processors(result);
 
     mix_processors mixers = insert_mixer(result);
+    fuse_gain_stages(result, mixers);
 
     return std::tuple{std::move(result), std::move(mixers)};
 }
@@ -27,7 +27,8 @@ namespace piejam::audio::engine
 {
 
 auto
-graph_to_dag(graph const& g) -> dag
+graph_to_dag(graph const& g, buffer_pass_counter* const buffer_pass_counter)
+    -> dag
 {
     dag result;
 
@@ -40,7 +41,7 @@ graph_to_dag(graph const& g) -> dag
     std::vector<processor_job*> clear_event_buffer_jobs;
 
     auto add_job = [&](graph_endpoint const& e) {
-        auto job = std::make_shared<processor_job>(e.proc);
+        auto job = std::make_shared<processor_job>(e.proc, buffer_pass_counter);
         auto job_ptr = job.get();
         auto id = result.add_task(
             [j = std::move(job)](thread_context const& ctx) { (*j)(ctx); });
@@ -91,7 +92,30 @@ graph_to_dag(graph const& g) -> dag
             added_deps.emplace(src_id, dst_id);
         }
 
-        dst_job->connect_result(dst.port, src_job->result_ref(src.port));
+        dst_job->connect_result(
+            dst.port,
+            src_job->result_ref(src.port),
+            src_job->result_factor_ref(src.port));
+    }
+
+    // results may be folded, if all their consumers fold their inputs
+    {
+        std::set<processor const*, std::less<>> non_folding_sources;
+        for (auto const& [src, dst] : g.audio)
+        {
+            if (!dst.proc.get().folds_inputs())
+            {
+                non_folding_sources.insert(&src.proc.get());
+            }
+        }
+
+        for (auto const& [src, dst] : g.audio)
+        {
+            if (!non_folding_sources.contains(&src.proc.get()))
+            {
+                processor_job_mapping[src.proc].second->enable_result_folding();
+            }
+        }
     }
 
     // connect jobs according to event wires
@@ -6,52 +6,25 @@
 
 #include <piejam/audio/engine/named_processor.h>
 #include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/engine/result_folding.h>
 #include <piejam/audio/slice_algorithms.h>
 
+#include <piejam/functional/operators.h>
 #include <piejam/npos.h>
 
 #include <boost/assert.hpp>
 #include <boost/preprocessor/iteration/local.hpp>
 
+#include <algorithm>
+#include <array>
+#include <typeindex>
+
 namespace piejam::audio::engine
 {
 
 namespace
 {
 
-template <std::size_t N>
-auto
-multiply(process_context const& ctx)
-{
-    return multiply(
-        ctx.inputs[N - 1].get(),
-        multiply<N - 1>(ctx),
-        ctx.outputs[0]);
-}
-
-template <>
-auto
-multiply<2>(process_context const& ctx)
-{
-    return multiply(ctx.inputs[1].get(), ctx.inputs[0].get(), ctx.outputs[0]);
-}
-
-template <>
-auto
-multiply<npos>(process_context const& ctx)
-{
-    slice<float> res{1.f};
-
-    auto const out = ctx.outputs[0];
-
-    for (slice<float> const& in : ctx.inputs)
-    {
-        res = multiply(in, res, out);
-    }
-
-    return res;
-}
-
 template <std::size_t NumInputs>
 class multiply_processor final : public named_processor
 {
@@ -94,9 +67,36 @@ public:
         return {};
     }
 
+    auto folds_inputs() const noexcept -> bool override
+    {
+        return true;
+    }
+
+    // Constant inputs and the input factors are folded into one factor,
+    // which is applied last. With a single buffer input, e.g. a signal and a
+    // static gain, it's then either folded or a single pass.
     void process(process_context const& ctx) override
     {
-        ctx.results[0] = multiply<NumInputs>(ctx);
+        float factor{1.f};
+        slice<float> product{1.f};
+
+        for (std::size_t index = 0; index < num_inputs(); ++index)
+        {
+            slice<float> const& in = ctx.inputs[index];
+
+            factor *= input_factor(ctx, index);
+
+            if (in.is_constant())
+            {
+                factor *= in.constant();
+            }
+            else
+            {
+                product = multiply(in, product, ctx.outputs[0]);
+            }
+        }
+
+        set_scaled_result(ctx, 0, product, factor);
     }
 
 private:
@@ -128,6 +128,23 @@ make_multiply_processor(
     }
 }
 
+bool
+is_multiply_processor(processor const& proc) noexcept
+{
+    static std::array multiply_processor_typeids{
+
+#define BOOST_PP_LOCAL_LIMITS                                                  \
+    (2, PIEJAM_MAX_NUM_FIXED_INPUTS_MULTIPLY_PROCESSOR)
+#define BOOST_PP_LOCAL_MACRO(n) std::type_index(typeid(multiply_processor<n>)),
+#include BOOST_PP_LOCAL_ITERATE()
+
+        std::type_index(typeid(multiply_processor<npos>))};
+
+    return std::ranges::any_of(
+        multiply_processor_typeids,
+        equal_to(std::type_index(typeid(proc))));
+}
+
 #undef PIEJAM_MAX_NUM_FIXED_INPUTS_MULTIPLY_PROCESSOR
 
 } // namespace piejam::audio::engine
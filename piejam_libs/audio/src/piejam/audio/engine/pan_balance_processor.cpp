@@ -31,37 +31,17 @@ make_pan_processor(std::string_view const name)
 }
 
 auto
-make_volume_pan_processor(std::string_view const name)
+make_mute_gain_processor(std::string_view const name)
     -> std::unique_ptr<audio::engine::processor>
 {
     using namespace std::string_view_literals;
-    static constexpr std::array s_input_names{"volume"sv, "pan"sv};
-    static constexpr std::array s_output_names{"gain L"sv, "gain R"sv};
-    return make_event_converter_processor(
-        [](float volume, float pan) -> std::tuple<float, float> {
-            auto pan_gain = dsp::sinusoidal_constant_power_pan(pan);
-            return std::tuple{volume * pan_gain.left, volume * pan_gain.right};
-        },
-        s_input_names,
-        s_output_names,
-        std::format("volume_pan {}", name));
-}
-
-auto
-make_mute_pan_processor(std::string_view const name)
-    -> std::unique_ptr<audio::engine::processor>
-{
-    using namespace std::string_view_literals;
-    static constexpr std::array s_input_names{"mute"sv, "pan"sv};
-    static constexpr std::array s_output_names{"gain L"sv, "gain R"sv};
+    static constexpr std::array s_input_names{"mute"sv};
+    static constexpr std::array s_output_names{"gain"sv};
     return make_event_converter_processor(
-        [](bool mute, float pan) -> std::tuple<float, float> {
-            auto pan_gain = dsp::sinusoidal_constant_power_pan(pan);
-            return std::tuple{!mute * pan_gain.left, !mute * pan_gain.right};
-        },
+        [](bool mute) -> float { return mute ? 0.f : 1.f; },
         s_input_names,
         s_output_names,
-        std::format("mute_pan {}", name));
+        std::format("mute_gain {}", name));
 }
 
 auto
@@ -81,23 +61,4 @@ make_balance_processor(std::string_view const name)
         std::format("balance {}", name));
 }
 
-auto
-make_volume_balance_processor(std::string_view const name)
-    -> std::unique_ptr<audio::engine::processor>
-{
-    using namespace std::string_view_literals;
-    static constexpr std::array s_input_names{"volume"sv, "balance"sv};
-    static constexpr std::array s_output_names{"gain L"sv, "gain R"sv};
-    return make_event_converter_processor(
-        [](float volume, float param) -> std::tuple<float, float> {
-            auto balance_gain = dsp::stereo_balance(param);
-            return std::tuple{
-                volume * balance_gain.left,
-                volume * balance_gain.right};
-        },
-        s_input_names,
-        s_output_names,
-        std::format("volume_balance {}", name));
-}
-
 } // namespace piejam::audio::engine
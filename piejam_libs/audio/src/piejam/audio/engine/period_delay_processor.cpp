@@ -0,0 +1,136 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/period_delay_processor.h>
+
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/period_size.h>
+#include <piejam/audio/slice.h>
+
+#include <mipp.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+namespace
+{
+
+class period_delay_processor final : public named_processor
+{
+public:
+    period_delay_processor(
+        std::size_t const num_channels,
+        std::size_t const num_periods,
+        std::string_view const name)
+        : named_processor(name)
+        , m_num_channels(num_channels)
+        , m_num_slots(num_periods + 1)
+        , m_buffers(m_num_channels * m_num_slots)
+        , m_slots(m_num_channels * m_num_slots)
+    {
+        BOOST_ASSERT(num_periods > 0);
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return "period_delay";
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return m_num_channels;
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return m_num_channels;
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    // The input is stored in the current slot, the result is the oldest
+    // slot. It is overwritten only in the next period, so it is passed on
+    // without copying.
+    void process(process_context const& ctx) override
+    {
+        std::size_t const write_pos = m_pos;
+        m_pos = m_pos + 1 == m_num_slots ? 0 : m_pos + 1;
+
+        for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+        {
+            slice<float> const& in = ctx.inputs[ch];
+            std::size_t const write_index = ch * m_num_slots + write_pos;
+            if (in.is_constant())
+            {
+                m_slots[write_index] = in;
+            }
+            else
+            {
+                auto& buffer = m_buffers[write_index];
+                std::ranges::copy(in.span(), buffer.begin());
+                m_slots[write_index] =
+                    std::span<float const>(buffer.data(), ctx.buffer_size);
+            }
+
+            slice<float> const& delayed = m_slots[ch * m_num_slots + m_pos];
+            if (delayed.is_constant() ||
+                delayed.span().size() == ctx.buffer_size)
+            {
+                ctx.results[ch] = delayed;
+            }
+            else
+            {
+                // the period size changed
+                std::span<float> const out = ctx.outputs[ch];
+                std::size_t const size =
+                    std::min(delayed.span().size(), out.size());
+                std::ranges::copy_n(delayed.span().begin(), size, out.begin());
+                std::ranges::fill(out.subspan(size), 0.f);
+                ctx.results[ch] = out;
+            }
+        }
+    }
+
+private:
+    using buffer_t = std::array<float, max_period_size.value()>;
+
+    std::size_t const m_num_channels;
+    std::size_t const m_num_slots;
+
+    // the slots of a channel are consecutive
+    mipp::vector<buffer_t> m_buffers;
+    std::vector<slice<float>> m_slots;
+    std::size_t m_pos{};
+};
+
+} // namespace
+
+auto
+make_period_delay_processor(
+    std::size_t const num_channels,
+    std::size_t const num_periods,
+    std::string_view const name) -> std::unique_ptr<processor>
+{
+    return std::make_unique<period_delay_processor>(
+        num_channels,
+        num_periods,
+        name);
+}
+
+} // namespace piejam::audio::engine
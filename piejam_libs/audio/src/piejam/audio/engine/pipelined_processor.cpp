@@ -0,0 +1,227 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/pipelined_processor.h>
+
+#include <piejam/audio/engine/event_buffer_memory.h>
+#include <piejam/audio/engine/event_input_buffers.h>
+#include <piejam/audio/engine/event_output_buffers.h>
+#include <piejam/audio/engine/event_port.h>
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/engine/processor.h>
+#include <piejam/audio/engine/rt_task_executor.h>
+#include <piejam/audio/period_size.h>
+#include <piejam/audio/slice.h>
+#include <piejam/range/indices.h>
+#include <piejam/thread/configuration.h>
+
+#include <mipp.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory_resource>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+namespace
+{
+
+class pipelined_processor final : public processor
+{
+public:
+    pipelined_processor(
+        std::unique_ptr<processor> proc,
+        thread::configuration const& conf)
+        : m_proc(std::move(proc))
+        , m_input_buffers(m_proc->num_inputs())
+        , m_inputs(m_proc->num_inputs())
+        , m_input_refs(m_inputs.begin(), m_inputs.end())
+        , m_output_buffers(m_proc->num_outputs())
+        , m_outputs(m_output_buffers.begin(), m_output_buffers.end())
+        , m_results(m_proc->num_outputs())
+        , m_worker(conf)
+    {
+        for (event_port const& port : m_proc->event_inputs())
+        {
+            m_event_input_buffers.push_back(
+                port.make_event_buffer(m_event_memory_resource));
+            m_event_inputs.add(port);
+            m_event_inputs.set(
+                m_event_input_buffers.size() - 1,
+                *m_event_input_buffers.back());
+        }
+
+        m_event_outputs.set_event_memory(m_event_memory_resource);
+        for (event_port const& port : m_proc->event_outputs())
+        {
+            m_event_outputs.add(port);
+        }
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return "pipelined";
+    }
+
+    auto name() const noexcept -> std::string_view override
+    {
+        return m_proc->name();
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return m_proc->num_inputs();
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return m_proc->num_outputs();
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        return m_proc->event_inputs();
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    void process(process_context const& ctx) override
+    {
+        // Everything, which is shared with the thread, is touched only after
+        // it finished the previous period.
+        m_worker.wait();
+
+        pass_results(ctx);
+        hand_over_inputs(ctx);
+
+        m_worker.wakeup(std::cref(m_task));
+    }
+
+private:
+    using buffer_t = std::array<float, max_period_size.value()>;
+
+    // The results may refer to the buffers of the thread, they are copied
+    // before handing over the next period.
+    void pass_results(process_context const& ctx)
+    {
+        for (std::size_t const i : range::indices(m_results))
+        {
+            slice<float> const& res = m_results[i];
+            if (res.is_constant())
+            {
+                ctx.results[i] = res;
+            }
+            else
+            {
+                // the sizes differ only, if the period size changed
+                std::span<float> const out = ctx.outputs[i];
+                std::size_t const size =
+                    std::min(res.span().size(), out.size());
+                std::ranges::copy_n(res.span().begin(), size, out.begin());
+                std::ranges::fill(out.subspan(size), 0.f);
+                ctx.results[i] = out;
+            }
+        }
+    }
+
+    void hand_over_inputs(process_context const& ctx)
+    {
+        for (std::size_t const i : range::indices(m_inputs))
+        {
+            slice<float> const& in = ctx.inputs[i];
+            if (in.is_constant())
+            {
+                m_inputs[i] = in;
+            }
+            else
+            {
+                std::ranges::copy(in.span(), m_input_buffers[i].begin());
+                m_inputs[i] = std::span<float const>(
+                    m_input_buffers[i].data(),
+                    ctx.buffer_size);
+            }
+        }
+
+        for (std::span<float>& out : m_outputs)
+        {
+            out = {out.data(), ctx.buffer_size};
+        }
+
+        m_process_context.buffer_size = ctx.buffer_size;
+
+        // the buffers must be empty, before their memory is released
+        m_event_outputs.clear_buffers();
+        for (auto& ev_buf : m_event_input_buffers)
+        {
+            ev_buf->clear();
+        }
+        m_event_memory.release();
+
+        auto ev_in = ctx.event_inputs.begin();
+        for (auto& ev_buf : m_event_input_buffers)
+        {
+            ev_buf->insert(*ev_in++);
+        }
+    }
+
+    struct process_task
+    {
+        pipelined_processor& self;
+
+        void operator()() const
+        {
+            self.m_proc->process(self.m_process_context);
+        }
+    };
+
+    std::unique_ptr<processor> m_proc;
+
+    mipp::vector<buffer_t> m_input_buffers;
+    std::vector<slice<float>> m_inputs;
+    std::vector<std::reference_wrapper<slice<float> const>> m_input_refs;
+    mipp::vector<buffer_t> m_output_buffers;
+    std::vector<std::span<float>> m_outputs;
+    std::vector<slice<float>> m_results;
+
+    event_buffer_memory m_event_memory{1u << 16};
+    std::pmr::memory_resource* m_event_memory_resource{
+        &m_event_memory.memory_resource()};
+    std::vector<std::unique_ptr<abstract_event_buffer>> m_event_input_buffers;
+    event_input_buffers m_event_inputs;
+    event_output_buffers m_event_outputs;
+
+    process_context m_process_context{
+        .inputs = m_input_refs,
+        .outputs = m_outputs,
+        .results = m_results,
+        .event_inputs = m_event_inputs,
+        .event_outputs = m_event_outputs};
+
+    process_task const m_task{*this};
+
+    // destroyed first, waits for the thread to finish
+    rt_task_executor m_worker;
+};
+
+} // namespace
+
+auto
+make_pipelined_processor(
+    std::unique_ptr<processor> proc,
+    thread::configuration const& conf) -> std::unique_ptr<processor>
+{
+    BOOST_ASSERT(proc);
+    BOOST_ASSERT_MSG(!proc->folds_inputs(), "not supported");
+    return std::make_unique<pipelined_processor>(std::move(proc), conf);
+}
+
+} // namespace piejam::audio::engine
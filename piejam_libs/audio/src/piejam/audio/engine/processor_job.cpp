@@ -4,6 +4,7 @@
 
 #include <piejam/audio/engine/processor_job.h>
 
+#include <piejam/audio/engine/buffer_pass_counter.h>
 #include <piejam/audio/engine/processor.h>
 #include <piejam/audio/engine/thread_context.h>
 #include <piejam/audio/slice.h>
@@ -25,6 +26,13 @@ empty_result_ref() -> std::reference_wrapper<slice<float> const>
     return std::cref(res);
 }
 
+auto
+unit_factor_ref() -> std::reference_wrapper<float const>
+{
+    static float const factor{1.f};
+    return std::cref(factor);
+}
+
 void
 verify_process_context(
     [[maybe_unused]] processor const& proc,
@@ -35,6 +43,12 @@ verify_process_context(
     BOOST_ASSERT(proc.num_outputs() == ctx.results.size());
     BOOST_ASSERT(proc.event_inputs().size() == ctx.event_inputs.size());
     BOOST_ASSERT(proc.event_outputs().size() == ctx.event_outputs.size());
+    BOOST_ASSERT(
+        ctx.input_factors.size() == (proc.folds_inputs() ? ctx.inputs.size()
+                                                         : std::size_t{}));
+    BOOST_ASSERT(
+        ctx.result_factors.empty() ||
+        ctx.result_factors.size() == ctx.results.size());
     BOOST_ASSERT(std::ranges::all_of(ctx.inputs, [&](slice<float> const& b) {
         return b.is_constant() || (b.span().size() == ctx.buffer_size &&
                                    mipp::isAligned(b.span().data()));
@@ -62,14 +76,26 @@ verify_process_context(
 
 } // namespace
 
-processor_job::processor_job(processor& proc)
+processor_job::processor_job(
+    processor& proc,
+    buffer_pass_counter* const buffer_pass_counter)
     : m_proc(proc)
     , m_output_buffers(m_proc.num_outputs(), output_buffer_t{})
     , m_inputs(m_proc.num_inputs(), empty_result_ref())
     , m_outputs(m_output_buffers.begin(), m_output_buffers.end())
     , m_results(m_proc.num_outputs())
+    , m_input_factors(
+          m_proc.folds_inputs() ? m_proc.num_inputs() : 0,
+          unit_factor_ref())
+    , m_result_factors(m_proc.num_outputs(), 1.f)
     , m_process_context(
-          {m_inputs, m_outputs, m_results, m_event_inputs, m_event_outputs})
+          {.inputs = m_inputs,
+           .outputs = m_outputs,
+           .results = m_results,
+           .event_inputs = m_event_inputs,
+           .event_outputs = m_event_outputs,
+           .input_factors = m_input_factors})
+    , m_buffer_pass_counter(buffer_pass_counter)
 {
     BOOST_ASSERT((std::ranges::all_of(m_output_buffers, [](auto const& b) {
         return mipp::isAligned(b.data());
@@ -92,6 +118,12 @@ processor_job::result_ref(std::size_t const index) const -> slice<float> const&
     return m_results[index];
 }
 
+auto
+processor_job::result_factor_ref(std::size_t const index) const -> float const&
+{
+    return m_result_factors[index];
+}
+
 auto
 processor_job::event_result_ref(std::size_t const index)
     -> abstract_event_buffer const&
@@ -100,10 +132,24 @@ processor_job::event_result_ref(std::size_t const index)
 }
 
 void
-processor_job::connect_result(std::size_t const index, slice<float> const& res)
+processor_job::connect_result(
+    std::size_t const index,
+    slice<float> const& res,
+    float const& factor)
 {
     BOOST_ASSERT(index < m_inputs.size());
     m_inputs[index] = std::ref(res);
+
+    if (m_proc.folds_inputs())
+    {
+        m_input_factors[index] = std::ref(factor);
+    }
+}
+
+void
+processor_job::enable_result_folding()
+{
+    m_process_context.result_factors = m_result_factors;
 }
 
 void
@@ -138,8 +184,23 @@ processor_job::operator()(thread_context const& ctx)
     BOOST_ASSERT(ctx.event_memory);
     m_event_outputs.set_event_memory(ctx.event_memory);
 
+    std::ranges::fill(m_process_context.result_factors, 1.f);
+
     verify_process_context(m_proc, m_process_context);
     m_proc.process(m_process_context);
+
+    if (m_buffer_pass_counter)
+    {
+        std::size_t num_passes{};
+        for (std::size_t index = 0; index < m_results.size(); ++index)
+        {
+            slice<float> const& res = m_results[index];
+            num_passes += res.is_span() &&
+                          res.span().data() == m_outputs[index].data();
+        }
+
+        m_buffer_pass_counter->add(num_passes);
+    }
 }
 
 } // namespace piejam::audio::engine
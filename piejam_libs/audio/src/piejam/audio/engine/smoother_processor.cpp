@@ -7,12 +7,22 @@
 #include <piejam/audio/engine/event_input_buffers.h>
 #include <piejam/audio/engine/event_port.h>
 #include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/result_folding.h>
 #include <piejam/audio/engine/single_event_input_processor.h>
 #include <piejam/audio/slice.h>
+#include <piejam/audio/slice_algorithms.h>
 
 #include <boost/assert.hpp>
 
+#include <mipp.h>
+
 #include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace piejam::audio::engine
 {
@@ -20,17 +30,130 @@ namespace piejam::audio::engine
 namespace
 {
 
-class lut_smoother_processor final
-    : public named_processor
-    , public single_event_input_processor<lut_smoother_processor, float>
+// Down ramps walk the lut backwards. A reversed copy makes them contiguous,
+// like up ramps. The copies are shared by all smoothers using the same lut.
+auto
+reversed_lut(std::span<float const> const lut) -> std::span<float const>
+{
+    static std::mutex s_mutex;
+    static std::map<
+        std::pair<float const*, std::size_t>,
+        std::vector<float>>
+        s_reversed_luts;
+
+    std::lock_guard const lock{s_mutex};
+
+    auto [it, inserted] =
+        s_reversed_luts.try_emplace(std::pair{lut.data(), lut.size()});
+    if (inserted)
+    {
+        it->second.assign(lut.rbegin(), lut.rend());
+    }
+
+    return it->second;
+}
+
+// out = l * r * factor
+void
+multiply_unaligned(
+    std::span<float const> const l,
+    std::span<float const> const r,
+    float const factor,
+    std::span<float> const out) noexcept
+{
+    BOOST_ASSERT(l.size() == out.size());
+    BOOST_ASSERT(r.size() == out.size());
+
+    constexpr std::size_t N = mipp::N<float>();
+
+    mipp::Reg<float> const factor_reg(factor);
+
+    std::size_t i{};
+    for (; i + N <= out.size(); i += N)
+    {
+        mipp::Reg<float> l_reg;
+        mipp::Reg<float> r_reg;
+        l_reg.loadu(l.data() + i);
+        r_reg.loadu(r.data() + i);
+        (l_reg * r_reg * factor_reg).storeu(out.data() + i);
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = l[i] * r[i] * factor;
+    }
+}
+
+// out = l * r
+void
+multiply_unaligned(
+    std::span<float const> const l,
+    float const r,
+    std::span<float> const out) noexcept
+{
+    BOOST_ASSERT(l.size() == out.size());
+
+    constexpr std::size_t N = mipp::N<float>();
+
+    mipp::Reg<float> const r_reg(r);
+
+    std::size_t i{};
+    for (; i + N <= out.size(); i += N)
+    {
+        mipp::Reg<float> l_reg;
+        l_reg.loadu(l.data() + i);
+        (l_reg * r_reg).storeu(out.data() + i);
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = l[i] * r;
+    }
+}
+
+// out = in * gain, for a slice of any alignment
+void
+multiply_slice(
+    slice<float> const& in,
+    float const gain,
+    std::span<float> const out) noexcept
+{
+    if (in.is_constant())
+    {
+        std::ranges::fill(out, in.constant() * gain);
+    }
+    else
+    {
+        multiply_unaligned(in.span(), gain, out);
+    }
+}
+
+// out = in * ramp * factor, for a slice of any alignment
+void
+multiply_slice(
+    slice<float> const& in,
+    std::span<float const> const ramp,
+    float const factor,
+    std::span<float> const out) noexcept
+{
+    if (in.is_constant())
+    {
+        multiply_unaligned(ramp, in.constant() * factor, out);
+    }
+    else
+    {
+        multiply_unaligned(in.span(), ramp, factor, out);
+    }
+}
+
+// Walks a lut from the current value to the target, one entry per sample.
+// The ramp is linear in the lut domain.
+class lut_ramp
 {
 public:
-    lut_smoother_processor(
-        std::span<float const> lut,
-        float current,
-        std::string_view const name)
-        : named_processor{name}
-        , m_lut{lut}
+    lut_ramp(std::span<float const> const lut, float const current)
+        : m_lut{lut}
+        , m_reversed_lut{reversed_lut(lut)}
         , m_current{current}
         , m_target{current}
     {
@@ -39,6 +162,110 @@ public:
         BOOST_ASSERT(std::ranges::is_sorted(m_lut));
     }
 
+    [[nodiscard]]
+    auto is_running() const noexcept -> bool
+    {
+        return m_current != m_target;
+    }
+
+    [[nodiscard]]
+    auto current() const noexcept -> float
+    {
+        return m_current;
+    }
+
+    void set_target(float const target) noexcept
+    {
+        BOOST_ASSERT(m_lut.front() <= target && target <= m_lut.back());
+
+        m_target = target;
+
+        if (m_current < m_target)
+        {
+            m_current_index = idx_up(m_current);
+            m_target_index = idx_up(m_target);
+        }
+        else if (m_target < m_current)
+        {
+            m_current_index = idx_down(m_current);
+            m_target_index = idx_down(m_target);
+        }
+    }
+
+    // The next at most max_size values of the ramp. If fewer, the target is
+    // reached after them.
+    [[nodiscard]]
+    auto next(std::size_t const max_size) noexcept -> std::span<float const>
+    {
+        BOOST_ASSERT(max_size > 0);
+
+        std::span<float const> ramp;
+
+        if (m_current_index < m_target_index)
+        {
+            ramp = m_lut.subspan(
+                m_current_index,
+                std::min(max_size, m_target_index - m_current_index));
+            m_current_index += ramp.size();
+        }
+        else if (m_target_index < m_current_index)
+        {
+            ramp = m_reversed_lut.subspan(
+                m_lut.size() - m_current_index,
+                std::min(max_size, m_current_index - m_target_index));
+            m_current_index -= ramp.size();
+        }
+
+        m_current =
+            m_current_index == m_target_index ? m_target : ramp.back();
+
+        return ramp;
+    }
+
+private:
+    // first element > value
+    [[nodiscard]]
+    auto idx_up(float value) const noexcept -> std::size_t
+    {
+        return std::ranges::upper_bound(m_lut, value) - m_lut.begin();
+    }
+
+    // last element < value
+    [[nodiscard]]
+    auto idx_down(float value) const noexcept -> std::size_t
+    {
+        auto it = std::ranges::upper_bound(
+            m_lut.rbegin(),
+            m_lut.rend(),
+            value,
+            std::greater<>{});
+        return m_lut.size() - std::distance(m_lut.rbegin(), it);
+    }
+
+    std::span<float const> m_lut;
+    std::span<float const> m_reversed_lut;
+    float m_current;
+    float m_target;
+    std::size_t m_current_index{};
+    std::size_t m_target_index{};
+};
+
+class lut_smoother_processor final
+    : public named_processor
+    , public single_event_input_processor<lut_smoother_processor, float>
+{
+public:
+    lut_smoother_processor(
+        std::shared_ptr<lut_ramp> ramp,
+        std::string_view const name,
+        event_quantization const quantization)
+        : named_processor{name}
+        , single_event_input_processor{quantization}
+        , m_ramp{std::move(ramp)}
+    {
+        BOOST_ASSERT(m_ramp);
+    }
+
     auto type_name() const noexcept -> std::string_view override
     {
         return "smooth";
@@ -69,18 +296,28 @@ public:
     {
         ctx.results[0] = ctx.outputs[0];
 
+        m_block_constant = true;
+        m_block_value = m_ramp->current();
+
         process_sliced(ctx);
+
+        if (m_block_constant)
+        {
+            ctx.results[0] = m_block_value;
+        }
     }
 
     void process_buffer(process_context const& ctx)
     {
-        if (is_running())
+        m_block_constant = false;
+
+        if (m_ramp->is_running())
         {
             generate(ctx.outputs[0]);
         }
         else
         {
-            ctx.results[0] = m_current;
+            ctx.results[0] = m_ramp->current();
         }
     }
 
@@ -89,109 +326,238 @@ public:
         std::size_t const offset,
         std::size_t const count)
     {
-        auto it_out = std::next(ctx.outputs[0].begin(), offset);
+        if (m_block_constant)
+        {
+            if (!m_ramp->is_running() && m_ramp->current() == m_block_value)
+            {
+                // written later, if the block doesn't stay constant
+                return;
+            }
+
+            std::ranges::fill(ctx.outputs[0].first(offset), m_block_value);
+            m_block_constant = false;
+        }
 
-        if (is_running())
+        auto const out = ctx.outputs[0].subspan(offset, count);
+
+        if (m_ramp->is_running())
         {
-            generate(ctx.outputs[0].subspan(offset, count));
+            generate(out);
         }
         else
         {
-            std::ranges::fill_n(std::move(it_out), count, m_current);
+            std::ranges::fill(out, m_ramp->current());
         }
     }
 
     void process_event(process_context const&, event<float> const& ev)
     {
-        BOOST_ASSERT(m_lut.front() <= ev.value() && ev.value() <= m_lut.back());
+        m_ramp->set_target(ev.value());
+    }
 
-        m_target = ev.value();
+private:
+    void generate(std::span<float> const out)
+    {
+        auto const ramp = m_ramp->next(out.size());
+        std::ranges::copy(ramp, out.begin());
+        std::fill(
+            std::next(out.begin(), ramp.size()),
+            out.end(),
+            m_ramp->current());
+    }
 
-        if (m_current < m_target)
-        {
-            m_current_index = idx_up(m_current);
-            m_target_index = idx_up(m_target);
-        }
-        else if (m_target < m_current)
-        {
-            m_current_index = idx_down(m_current);
-            m_target_index = idx_down(m_target);
-        }
+    std::shared_ptr<lut_ramp> m_ramp;
+
+    // the block is constant, while the value doesn't change
+    bool m_block_constant{};
+    float m_block_value{};
+};
+
+// A lut smoother fused into the multiply stage it feeds. The smoothed gain is
+// applied to all channels, without writing it to a buffer.
+class lut_smoothed_multiply_processor final
+    : public named_processor
+    , public single_event_input_processor<
+          lut_smoothed_multiply_processor,
+          float>
+{
+public:
+    lut_smoothed_multiply_processor(
+        std::span<float const> lut,
+        float current,
+        std::size_t const num_channels,
+        std::string_view const name,
+        event_quantization const quantization)
+        : named_processor{name}
+        , single_event_input_processor{quantization}
+        , m_ramp{std::make_shared<lut_ramp>(lut, current)}
+        , m_num_channels{num_channels}
+    {
+        BOOST_ASSERT(m_num_channels > 0);
     }
 
-private:
-    [[nodiscard]]
-    auto is_running() const noexcept -> bool
+    auto type_name() const noexcept -> std::string_view override
     {
-        return m_current != m_target;
+        return "smooth_multiply";
     }
 
-    // first element > value
-    [[nodiscard]]
-    auto idx_up(float value) const noexcept -> std::size_t
+    auto num_inputs() const noexcept -> std::size_t override
     {
-        return std::ranges::upper_bound(m_lut, value) - m_lut.begin();
+        return m_num_channels;
     }
 
-    // last element < value
-    [[nodiscard]]
-    auto idx_down(float value) const noexcept -> std::size_t
+    auto num_outputs() const noexcept -> std::size_t override
     {
-        auto it = std::ranges::upper_bound(
-            m_lut.rbegin(),
-            m_lut.rend(),
-            value,
-            std::greater<>{});
-        return m_lut.size() - std::distance(m_lut.rbegin(), it);
+        return m_num_channels;
     }
 
-    void generate(std::span<float> out)
+    auto event_inputs() const noexcept -> event_ports override
     {
-        BOOST_ASSERT(!out.empty());
+        static std::array s_ports{event_port(std::in_place_type<float>, "ev")};
+        return s_ports;
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    auto folds_inputs() const noexcept -> bool override
+    {
+        return true;
+    }
+
+    void process(engine::process_context const& ctx) override
+    {
+        std::ranges::copy(ctx.outputs, ctx.results.begin());
 
-        bool const up = m_current_index < m_target_index;
-        bool const down = m_target_index < m_current_index;
+        m_block_constant = true;
+        m_block_value = m_ramp->current();
+
+        process_sliced(ctx);
+
+        if (m_block_constant)
+        {
+            multiply_constant(ctx, m_block_value);
+        }
+    }
 
-        auto num = std::min(
-            out.size(),
-            up ? m_target_index - m_current_index
-               : m_current_index - m_target_index);
+    void process_buffer(process_context const& ctx)
+    {
+        m_block_constant = false;
 
-        if (up)
+        if (m_ramp->is_running())
         {
-            auto first = m_lut.begin() + m_current_index;
-            auto last = first + num;
-            std::ranges::copy(first, last, out.begin());
-            m_current_index += num;
+            multiply_ramp(ctx, 0, ctx.buffer_size);
         }
-        else if (down)
+        else
         {
-            auto last = m_lut.begin() + m_current_index;
-            auto first = last - num;
-            std::ranges::reverse_copy(first, last, out.begin());
-            m_current_index -= num;
+            multiply_constant(ctx, m_ramp->current());
         }
+    }
 
-        if (m_current_index == m_target_index)
+    void process_slice(
+        process_context const& ctx,
+        std::size_t const offset,
+        std::size_t const count)
+    {
+        if (m_block_constant)
         {
-            m_current = m_target;
+            if (!m_ramp->is_running() && m_ramp->current() == m_block_value)
+            {
+                // written later, if the block doesn't stay constant
+                return;
+            }
 
-            if (num < out.size())
+            for (std::size_t ch = 0; ch < m_num_channels; ++ch)
             {
-                std::fill(out.begin() + num, out.end(), m_current);
+                multiply_slice(
+                    subslice(ctx.inputs[ch].get(), 0, offset),
+                    m_block_value * input_factor(ctx, ch),
+                    ctx.outputs[ch].first(offset));
             }
+
+            m_block_constant = false;
+        }
+
+        if (m_ramp->is_running())
+        {
+            multiply_ramp(ctx, offset, count);
         }
         else
         {
-            m_current = out.back();
+            for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+            {
+                multiply_slice(
+                    subslice(ctx.inputs[ch].get(), offset, count),
+                    m_ramp->current() * input_factor(ctx, ch),
+                    ctx.outputs[ch].subspan(offset, count));
+            }
         }
     }
 
-    std::span<float const> m_lut;
-    float m_current;
-    float m_target;
-    std::size_t m_current_index{};
-    std::size_t m_target_index{};
+    void process_event(process_context const&, event<float> const& ev)
+    {
+        m_ramp->set_target(ev.value());
+    }
+
+    // shared with the gain processor, which replaces it in a fused mixer
+    [[nodiscard]]
+    auto ramp() const noexcept -> std::shared_ptr<lut_ramp> const&
+    {
+        return m_ramp;
+    }
+
+private:
+    // constant gain for the whole block, folded or in place where possible
+    void multiply_constant(process_context const& ctx, float const gain)
+    {
+        for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+        {
+            set_scaled_result(
+                ctx,
+                ch,
+                ctx.inputs[ch].get(),
+                gain * input_factor(ctx, ch));
+        }
+    }
+
+    void multiply_ramp(
+        process_context const& ctx,
+        std::size_t const offset,
+        std::size_t const count)
+    {
+        auto const ramp = m_ramp->next(count);
+        std::size_t const rest = count - ramp.size();
+
+        for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+        {
+            slice<float> const& in = ctx.inputs[ch];
+            float const factor = input_factor(ctx, ch);
+            std::span<float> const out = ctx.outputs[ch].subspan(offset, count);
+
+            multiply_slice(
+                subslice(in, offset, ramp.size()),
+                ramp,
+                factor,
+                out.first(ramp.size()));
+
+            if (rest)
+            {
+                multiply_slice(
+                    subslice(in, offset + ramp.size(), rest),
+                    m_ramp->current() * factor,
+                    out.last(rest));
+            }
+        }
+    }
+
+    std::shared_ptr<lut_ramp> m_ramp;
+    std::size_t const m_num_channels;
+
+    // the block is constant, while the gain doesn't change
+    bool m_block_constant{};
+    float m_block_value{};
 };
 
 } // namespace
@@ -200,9 +566,52 @@ auto
 make_lut_smoother_processor(
     std::span<float const> lut,
     float current,
+    std::string_view name,
+    event_quantization const quantization) -> std::unique_ptr<processor>
+{
+    return std::make_unique<lut_smoother_processor>(
+        std::make_shared<lut_ramp>(lut, current),
+        name,
+        quantization);
+}
+
+auto
+make_lut_smoothed_multiply_processor(
+    std::span<float const> lut,
+    float current,
+    std::size_t num_channels,
+    std::string_view name,
+    event_quantization const quantization) -> std::unique_ptr<processor>
+{
+    return std::make_unique<lut_smoothed_multiply_processor>(
+        lut,
+        current,
+        num_channels,
+        name,
+        quantization);
+}
+
+bool
+is_lut_smoothed_multiply_processor(processor const& proc) noexcept
+{
+    return typeid(proc) == typeid(lut_smoothed_multiply_processor);
+}
+
+auto
+make_lut_smoothed_gain_processor(
+    processor const& lut_smoothed_multiply,
     std::string_view name) -> std::unique_ptr<processor>
 {
-    return std::make_unique<lut_smoother_processor>(lut, current, name);
+    BOOST_ASSERT(is_lut_smoothed_multiply_processor(lut_smoothed_multiply));
+
+    auto const& multiply =
+        static_cast<lut_smoothed_multiply_processor const&>(
+            lut_smoothed_multiply);
+
+    return std::make_unique<lut_smoother_processor>(
+        multiply.ramp(),
+        name,
+        multiply.quantization());
 }
 
 } // namespace piejam::audio::engine
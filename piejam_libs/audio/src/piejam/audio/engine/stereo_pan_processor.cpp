@@ -0,0 +1,394 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/stereo_pan_processor.h>
+
+#include <piejam/audio/dsp/pan.h>
+#include <piejam/audio/engine/event_input_buffers.h>
+#include <piejam/audio/engine/event_port.h>
+#include <piejam/audio/engine/lockstep_events.h>
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/result_folding.h>
+#include <piejam/audio/pair.h>
+#include <piejam/audio/slice.h>
+#include <piejam/audio/slice_algorithms.h>
+
+#include <mipp.h>
+
+#include <array>
+#include <numeric>
+#include <tuple>
+
+namespace piejam::audio::engine
+{
+
+namespace
+{
+
+using float_v = mipp::Reg<float>;
+
+// {1, 2, ..., N}
+auto
+lane_steps() -> float_v
+{
+    std::array<float, mipp::N<float>()> steps{};
+    std::iota(steps.begin(), steps.end(), 1.f);
+    float_v result;
+    result.loadu(steps.data());
+    return result;
+}
+
+// Moves linearly to the target within ramp_length samples. The first value is
+// taken over, there is nothing to ramp from.
+class linear_ramp
+{
+public:
+    static constexpr std::size_t ramp_length{512};
+
+    explicit linear_ramp(float const current) noexcept
+        : m_current{current}
+        , m_target{current}
+    {
+    }
+
+    [[nodiscard]]
+    auto is_running() const noexcept -> bool
+    {
+        return m_remaining > 0;
+    }
+
+    [[nodiscard]]
+    auto current() const noexcept -> float
+    {
+        return m_current;
+    }
+
+    [[nodiscard]]
+    auto target() const noexcept -> float
+    {
+        return m_target;
+    }
+
+    void init(float const value) noexcept
+    {
+        if (!m_initialized)
+        {
+            m_current = value;
+            m_target = value;
+            m_initialized = true;
+        }
+    }
+
+    void set_target(float const target) noexcept
+    {
+        if (target == m_target)
+        {
+            return;
+        }
+
+        m_target = target;
+        m_step = (m_target - m_current) / static_cast<float>(ramp_length);
+        m_remaining = ramp_length;
+    }
+
+    // The values of the next N samples.
+    [[nodiscard]]
+    auto next(float_v const& steps) noexcept -> float_v
+    {
+        float_v const values = float_v(m_current) + float_v(m_step) * steps;
+        bool const rising = m_step > 0.f;
+
+        advance(mipp::N<float>());
+
+        return rising ? mipp::min(values, float_v(m_target))
+                      : mipp::max(values, float_v(m_target));
+    }
+
+    // The value of the next sample.
+    [[nodiscard]]
+    auto next() noexcept -> float
+    {
+        advance(1);
+        return m_current;
+    }
+
+private:
+    void advance(std::size_t const num_samples) noexcept
+    {
+        if (num_samples < m_remaining)
+        {
+            m_current += m_step * static_cast<float>(num_samples);
+            m_remaining -= num_samples;
+        }
+        else
+        {
+            m_current = m_target;
+            m_step = 0.f;
+            m_remaining = 0;
+        }
+    }
+
+    float m_current;
+    float m_target;
+    float m_step{};
+    std::size_t m_remaining{};
+    bool m_initialized{};
+};
+
+auto
+load(slice<float> const& in, std::size_t const index) noexcept -> float_v
+{
+    if (in.is_constant())
+    {
+        return float_v(in.constant());
+    }
+
+    float_v result;
+    result.loadu(in.span().data() + index);
+    return result;
+}
+
+auto
+value(slice<float> const& in, std::size_t const index) noexcept -> float
+{
+    return in.is_constant() ? in.constant() : in.span()[index];
+}
+
+enum class stereo_law : bool
+{
+    pan,
+    balance,
+};
+
+template <stereo_law Law>
+class stereo_pan_processor final : public named_processor
+{
+    // a mono input feeds both outputs
+    static constexpr std::size_t right_input = Law == stereo_law::pan ? 0 : 1;
+
+public:
+    explicit stereo_pan_processor(std::string_view const name)
+        : named_processor{name}
+    {
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return Law == stereo_law::pan ? "stereo_pan" : "stereo_balance";
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return right_input + 1;
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return 2;
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        static std::array s_ports{
+            event_port(
+                std::in_place_type<float>,
+                Law == stereo_law::pan ? "pan" : "balance"),
+            event_port(std::in_place_type<float>, "gain")};
+        return s_ports;
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    auto folds_inputs() const noexcept -> bool override
+    {
+        return true;
+    }
+
+    void process(process_context const& ctx) override
+    {
+        event_buffer<float> const& position_buf =
+            ctx.event_inputs.get<float>(0);
+        event_buffer<float> const& gain_buf = ctx.event_inputs.get<float>(1);
+
+        if (position_buf.empty() && gain_buf.empty() && !is_running())
+        {
+            auto const gains =
+                stereo_gains(m_position.current(), m_gain.current());
+
+            set_scaled_result(
+                ctx,
+                0,
+                ctx.inputs[0],
+                gains.left * input_factor(ctx, 0));
+            set_scaled_result(
+                ctx,
+                1,
+                ctx.inputs[right_input],
+                gains.right * input_factor(ctx, right_input));
+            return;
+        }
+
+        if (!position_buf.empty())
+        {
+            m_position.init(position_buf.front().value());
+        }
+
+        if (!gain_buf.empty())
+        {
+            m_gain.init(gain_buf.front().value());
+        }
+
+        std::size_t offset{};
+        lockstep_events(
+            [&](std::size_t const ev_offset,
+                float const position,
+                float const gain) {
+                process_slice(ctx, offset, ev_offset - offset);
+                m_position.set_target(position);
+                m_gain.set_target(gain);
+                offset = ev_offset;
+            },
+            std::tuple{m_position.target(), m_gain.target()},
+            position_buf,
+            gain_buf);
+
+        process_slice(ctx, offset, ctx.buffer_size - offset);
+
+        ctx.results[0] = ctx.outputs[0];
+        ctx.results[1] = ctx.outputs[1];
+    }
+
+private:
+    template <class V>
+    static auto stereo_gains(V const position, V const gain) -> pair<V>
+    {
+        auto const law = [](V const x) {
+            if constexpr (Law == stereo_law::pan)
+            {
+                return dsp::sinusoidal_constant_power_pan<float, V>(x);
+            }
+            else
+            {
+                return dsp::stereo_balance<float, V>(x);
+            }
+        }(position);
+
+        return {law.left * gain, law.right * gain};
+    }
+
+    auto is_running() const noexcept -> bool
+    {
+        return m_position.is_running() || m_gain.is_running();
+    }
+
+    void process_slice(
+        process_context const& ctx,
+        std::size_t const offset,
+        std::size_t const count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        slice<float> const l_in = subslice(ctx.inputs[0].get(), offset, count);
+        slice<float> const r_in =
+            subslice(ctx.inputs[right_input].get(), offset, count);
+        std::span<float> const l_out = ctx.outputs[0].subspan(offset, count);
+        std::span<float> const r_out = ctx.outputs[1].subspan(offset, count);
+        float const l_factor = input_factor(ctx, 0);
+        float const r_factor = input_factor(ctx, right_input);
+
+        if (is_running())
+        {
+            apply(
+                l_in,
+                r_in,
+                l_out,
+                r_out,
+                [&]() {
+                    auto const gains = stereo_gains(
+                        m_position.next(m_lane_steps),
+                        m_gain.next(m_lane_steps));
+                    return pair{
+                        gains.left * float_v(l_factor),
+                        gains.right * float_v(r_factor)};
+                },
+                [&]() {
+                    auto const gains =
+                        stereo_gains(m_position.next(), m_gain.next());
+                    return pair{gains.left * l_factor, gains.right * r_factor};
+                });
+        }
+        else
+        {
+            auto const gains =
+                stereo_gains(m_position.current(), m_gain.current());
+            pair const gains_s{gains.left * l_factor, gains.right * r_factor};
+            pair const gains_v{float_v(gains_s.left), float_v(gains_s.right)};
+
+            apply(
+                l_in,
+                r_in,
+                l_out,
+                r_out,
+                [&]() { return gains_v; },
+                [&]() { return gains_s; });
+        }
+    }
+
+    // Both outputs in one pass, next_v and next_s yield the gains of the next
+    // N samples and of the next sample.
+    template <class NextV, class NextS>
+    static void apply(
+        slice<float> const& l_in,
+        slice<float> const& r_in,
+        std::span<float> const l_out,
+        std::span<float> const r_out,
+        NextV&& next_v,
+        NextS&& next_s)
+    {
+        constexpr std::size_t N = mipp::N<float>();
+
+        std::size_t i{};
+        for (; i + N <= l_out.size(); i += N)
+        {
+            pair<float_v> const gains = next_v();
+            (load(l_in, i) * gains.left).storeu(l_out.data() + i);
+            (load(r_in, i) * gains.right).storeu(r_out.data() + i);
+        }
+
+        for (; i < l_out.size(); ++i)
+        {
+            pair<float> const gains = next_s();
+            l_out[i] = value(l_in, i) * gains.left;
+            r_out[i] = value(r_in, i) * gains.right;
+        }
+    }
+
+    float_v const m_lane_steps{lane_steps()};
+    linear_ramp m_position{0.f};
+    linear_ramp m_gain{1.f};
+};
+
+} // namespace
+
+auto
+make_stereo_pan_processor(std::string_view const name)
+    -> std::unique_ptr<processor>
+{
+    return std::make_unique<stereo_pan_processor<stereo_law::pan>>(name);
+}
+
+auto
+make_stereo_balance_processor(std::string_view const name)
+    -> std::unique_ptr<processor>
+{
+    return std::make_unique<stereo_pan_processor<stereo_law::balance>>(name);
+}
+
+} // namespace piejam::audio::engine
@@ -0,0 +1,285 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/weighted_sum_processor.h>
+
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/engine/result_folding.h>
+#include <piejam/audio/slice.h>
+
+#include <piejam/functional/operators.h>
+#include <piejam/npos.h>
+
+#include <boost/assert.hpp>
+#include <boost/preprocessor/iteration/local.hpp>
+
+#include <mipp.h>
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+namespace
+{
+
+// A buffer multiplied by a constant gain.
+struct scaled_term
+{
+    std::span<float const> in;
+    float gain;
+};
+
+// The product of two buffers, scaled by a constant gain.
+struct product_term
+{
+    float const* in1;
+    float const* in2;
+    float gain;
+};
+
+template <class T, std::size_t NumTerms>
+using terms_t = std::conditional_t<
+    NumTerms != npos,
+    std::array<T, NumTerms>,
+    std::vector<T>>;
+
+template <std::size_t NumTerms>
+class weighted_sum_processor final : public named_processor
+{
+public:
+    weighted_sum_processor(std::string_view const name)
+        requires(NumTerms != npos)
+        : named_processor(name)
+        , m_num_terms(NumTerms)
+    {
+    }
+
+    weighted_sum_processor(
+        std::size_t const num_terms,
+        std::string_view const name)
+        requires(NumTerms == npos)
+        : named_processor(name)
+        , m_num_terms(num_terms)
+        , m_scaled(num_terms)
+        , m_products(num_terms)
+    {
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        using namespace std::string_view_literals;
+        return "weighted_sum"sv;
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return 2 * num_terms();
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return 1;
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    auto folds_inputs() const noexcept -> bool override
+    {
+        return true;
+    }
+
+    void process(process_context const& ctx) override
+    {
+        weighted_sum(ctx);
+    }
+
+private:
+    auto num_terms() const noexcept -> std::size_t
+    {
+        return NumTerms != npos ? NumTerms : m_num_terms;
+    }
+
+    template <std::size_t NumRegs>
+    static void accumulate(
+        std::span<scaled_term const> const scaled,
+        std::span<product_term const> const products,
+        float const offset,
+        float* const out,
+        std::size_t const frame) noexcept
+    {
+        constexpr std::size_t N = mipp::N<float>();
+
+        [&]<std::size_t... R>(std::index_sequence<R...>) {
+            std::array<mipp::Reg<float>, NumRegs> acc{
+                (static_cast<void>(R), mipp::Reg<float>(offset))...};
+
+            for (scaled_term const& t : scaled)
+            {
+                mipp::Reg<float> const gain(t.gain);
+                ((acc[R] = mipp::fmadd(
+                      mipp::Reg<float>(t.in.data() + frame + R * N),
+                      gain,
+                      acc[R])),
+                 ...);
+            }
+
+            for (product_term const& t : products)
+            {
+                mipp::Reg<float> const gain(t.gain);
+                ((acc[R] = mipp::fmadd(
+                      mipp::Reg<float>(t.in1 + frame + R * N) * gain,
+                      mipp::Reg<float>(t.in2 + frame + R * N),
+                      acc[R])),
+                 ...);
+            }
+
+            (acc[R].store(out + R * N), ...);
+        }(std::make_index_sequence<NumRegs>{});
+    }
+
+    void weighted_sum(process_context const& ctx)
+    {
+        // constant terms are folded into the offset, terms with a constant
+        // factor are scaled buffers, silent ones are dropped. The factors of
+        // folded inputs are applied to the gains of the terms.
+        float offset{};
+        std::size_t num_scaled{};
+        std::size_t num_products{};
+
+        for (std::size_t term = 0; term < num_terms(); ++term)
+        {
+            slice<float> const& l = ctx.inputs[2 * term];
+            slice<float> const& r = ctx.inputs[2 * term + 1];
+            float const factor = input_factor(ctx, 2 * term) *
+                                 input_factor(ctx, 2 * term + 1);
+
+            if (l.is_constant() && r.is_constant())
+            {
+                offset += l.constant() * r.constant() * factor;
+            }
+            else if (l.is_constant() || r.is_constant())
+            {
+                auto const& [c, buf] = l.is_constant()
+                                           ? std::tie(l, r)
+                                           : std::tie(r, l);
+                if (float const gain = c.constant() * factor; gain != 0.f)
+                {
+                    m_scaled[num_scaled++] = {.in = buf.span(), .gain = gain};
+                }
+            }
+            else
+            {
+                m_products[num_products++] = {
+                    .in1 = l.span().data(),
+                    .in2 = r.span().data(),
+                    .gain = factor};
+            }
+        }
+
+        if (num_scaled == 0 && num_products == 0)
+        {
+            ctx.results[0] = offset;
+            return;
+        }
+
+        // a single scaled buffer is passed through or folded, if possible
+        if (num_scaled == 1 && num_products == 0 && offset == 0.f)
+        {
+            set_scaled_result(ctx, 0, m_scaled[0].in, m_scaled[0].gain);
+            return;
+        }
+
+        std::span<float> const out = ctx.outputs[0];
+        BOOST_ASSERT(out.size() % mipp::N<float>() == 0);
+
+        auto const scaled = std::span{m_scaled}.first(num_scaled);
+        auto const products = std::span{m_products}.first(num_products);
+
+        // several registers at once, so the sums don't wait on each other
+        constexpr std::size_t unrolled = 4 * mipp::N<float>();
+
+        std::size_t frame{};
+        for (; frame + unrolled <= out.size(); frame += unrolled)
+        {
+            accumulate<4>(scaled, products, offset, out.data() + frame, frame);
+        }
+
+        for (; frame < out.size(); frame += mipp::N<float>())
+        {
+            accumulate<1>(scaled, products, offset, out.data() + frame, frame);
+        }
+
+        ctx.results[0] = out;
+    }
+
+    std::size_t const m_num_terms{};
+    terms_t<scaled_term, NumTerms> m_scaled;
+    terms_t<product_term, NumTerms> m_products;
+};
+
+} // namespace
+
+#define PIEJAM_MAX_NUM_FIXED_TERMS_WEIGHTED_SUM_PROCESSOR 8
+
+auto
+make_weighted_sum_processor(
+    std::size_t const num_terms,
+    std::string_view const name) -> std::unique_ptr<processor>
+{
+    switch (num_terms)
+    {
+
+#define BOOST_PP_LOCAL_LIMITS                                                  \
+    (1, PIEJAM_MAX_NUM_FIXED_TERMS_WEIGHTED_SUM_PROCESSOR)
+#define BOOST_PP_LOCAL_MACRO(n)                                                \
+    case n:                                                                    \
+        return std::make_unique<weighted_sum_processor<n>>(name);
+#include BOOST_PP_LOCAL_ITERATE()
+
+        default:
+            BOOST_ASSERT(num_terms > 0);
+            return std::make_unique<weighted_sum_processor<npos>>(
+                num_terms,
+                name);
+    }
+}
+
+bool
+is_weighted_sum_processor(processor const& proc) noexcept
+{
+    static std::array weighted_sum_processor_typeids{
+
+#define BOOST_PP_LOCAL_LIMITS                                                  \
+    (1, PIEJAM_MAX_NUM_FIXED_TERMS_WEIGHTED_SUM_PROCESSOR)
+#define BOOST_PP_LOCAL_MACRO(n)                                                \
+    std::type_index(typeid(weighted_sum_processor<n>)),
+#include BOOST_PP_LOCAL_ITERATE()
+
+        std::type_index(typeid(weighted_sum_processor<npos>))};
+
+    return std::ranges::any_of(
+        weighted_sum_processor_typeids,
+        equal_to(std::type_index(typeid(proc))));
+}
+
+#undef PIEJAM_MAX_NUM_FIXED_TERMS_WEIGHTED_SUM_PROCESSOR
+
+} // namespace piejam::audio::engine
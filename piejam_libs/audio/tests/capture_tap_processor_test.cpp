@@ -0,0 +1,148 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/capture_tap_processor.h>
+
+#include <piejam/audio/engine/event_input_buffers.h>
+#include <piejam/audio/engine/event_output_buffers.h>
+#include <piejam/audio/engine/frame_clock.h>
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/slice.h>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace piejam::audio::engine::test
+{
+
+struct capture_tap_processor_test : testing::Test
+{
+    capture_tap_processor_test()
+    {
+        ctx.inputs = ins;
+    }
+
+    // The input carries the engine frame index as sample value.
+    template <class... Taps>
+    void process_period(Taps&... taps)
+    {
+        for (std::size_t i = 0; i < in_buf.size(); ++i)
+        {
+            in_buf[i] = static_cast<float>(clock.now() + i);
+        }
+
+        (taps.process(ctx), ...);
+        clock.advance(ctx.buffer_size);
+    }
+
+    frame_clock clock;
+    event_input_buffers event_ins;
+    event_output_buffers event_outs;
+    alignas(mipp::RequiredAlignment) std::array<float, 8> in_buf{};
+    slice<float> in{in_buf};
+    std::array<std::reference_wrapper<slice<float> const>, 1> ins{
+        std::cref(in)};
+    process_context ctx{
+        .event_inputs = event_ins,
+        .event_outputs = event_outs,
+        .buffer_size = 8};
+    std::unique_ptr<capture_tap_processor> sut{
+        make_capture_tap_processor(clock, 1, 256)};
+};
+
+TEST_F(capture_tap_processor_test, properties)
+{
+    EXPECT_EQ(1u, sut->num_inputs());
+    EXPECT_EQ(0u, sut->num_outputs());
+    EXPECT_TRUE(sut->event_inputs().empty());
+    EXPECT_TRUE(sut->event_outputs().empty());
+}
+
+TEST_F(capture_tap_processor_test, captures_nothing_if_not_armed)
+{
+    process_period(*sut);
+    process_period(*sut);
+
+    EXPECT_TRUE(sut->consume().empty());
+}
+
+TEST_F(capture_tap_processor_test, starts_and_stops_on_the_armed_frames)
+{
+    sut->arm(capture_window{.start = 5, .stop = 19});
+
+    process_period(*sut);
+    process_period(*sut);
+    process_period(*sut);
+    process_period(*sut);
+
+    auto const captured = sut->consume();
+
+    ASSERT_EQ(1u, captured.size());
+    EXPECT_EQ(5u, captured[0].frame);
+    EXPECT_THAT(
+        captured[0].data.channels()[0],
+        testing::ElementsAre(
+            5.f,
+            6.f,
+            7.f,
+            8.f,
+            9.f,
+            10.f,
+            11.f,
+            12.f,
+            13.f,
+            14.f,
+            15.f,
+            16.f,
+            17.f,
+            18.f));
+}
+
+TEST_F(capture_tap_processor_test, taps_armed_in_different_periods_align)
+{
+    auto other = make_capture_tap_processor(clock, 1, 256);
+
+    capture_window const window{.start = 16, .stop = capture_window::open_end};
+
+    sut->arm(window);
+    process_period(*sut);
+    other->arm(window);
+    process_period(*sut, *other);
+    process_period(*sut, *other);
+
+    auto const captured = sut->consume();
+    auto const other_captured = other->consume();
+
+    ASSERT_EQ(1u, captured.size());
+    ASSERT_EQ(1u, other_captured.size());
+    EXPECT_EQ(16u, captured[0].frame);
+    EXPECT_EQ(16u, other_captured[0].frame);
+    EXPECT_EQ(8u, captured[0].data.num_frames());
+    EXPECT_EQ(8u, other_captured[0].data.num_frames());
+}
+
+TEST_F(capture_tap_processor_test, overflow_shows_up_as_gap)
+{
+    auto small = make_capture_tap_processor(clock, 1, 8);
+    small->arm(capture_window{.start = 0, .stop = capture_window::open_end});
+
+    process_period(*small);
+    process_period(*small); // dropped, the ring buffer is full
+
+    ASSERT_EQ(1u, small->consume().size());
+
+    process_period(*small);
+
+    auto const captured = small->consume();
+
+    ASSERT_EQ(1u, captured.size());
+    EXPECT_EQ(16u, captured[0].frame);
+    EXPECT_THAT(
+        captured[0].data.channels()[0],
+        testing::ElementsAre(16.f, 17.f, 18.f, 19.f, 20.f, 21.f, 22.f, 23.f));
+}
+
+} // namespace piejam::audio::engine::test
@@ -0,0 +1,222 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/biquad_bank.h>
+
+#include <piejam/audio/dsp/biquad_filter.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::dsp::test
+{
+
+namespace
+{
+
+constexpr float inv_sr = 1.f / 48000.f;
+constexpr float tolerance = 1e-5f;
+
+auto
+noise(std::size_t const size, unsigned const seed) -> std::vector<float>
+{
+    std::mt19937 gen{seed};
+    std::uniform_real_distribution<float> dist{-1.f, 1.f};
+
+    std::vector<float> result(size);
+    std::ranges::generate(result, [&]() { return dist(gen); });
+    return result;
+}
+
+auto
+section_coefficients(std::size_t const section, std::size_t const channel)
+    -> biquad<float>::coefficients
+{
+    // resonant and different in each lane, so mixed up lanes would show
+    return biquad_filter::make_lp_coefficients(
+        1000.f + 700.f * static_cast<float>(section) +
+            300.f * static_cast<float>(channel),
+        0.7f,
+        inv_sr);
+}
+
+// Reference: a scalar biquad per channel and section, in series.
+template <std::size_t NumChannels, std::size_t NumSections>
+auto
+process_scalar(std::array<std::vector<float>, NumChannels> signal)
+    -> std::array<std::vector<float>, NumChannels>
+{
+    for (std::size_t ch = 0; ch < NumChannels; ++ch)
+    {
+        for (std::size_t section = 0; section < NumSections; ++section)
+        {
+            biquad<float> filter{section_coefficients(section, ch)};
+            std::ranges::transform(
+                signal[ch],
+                signal[ch].begin(),
+                [&filter](float const x) { return filter.process(x); });
+        }
+    }
+
+    return signal;
+}
+
+template <std::size_t NumChannels, std::size_t NumSections>
+auto
+make_sut() -> biquad_bank<float, NumChannels, NumSections>
+{
+    biquad_bank<float, NumChannels, NumSections> sut;
+    for (std::size_t section = 0; section < NumSections; ++section)
+    {
+        for (std::size_t ch = 0; ch < NumChannels; ++ch)
+        {
+            sut.set_coefficients(
+                section,
+                ch,
+                section_coefficients(section, ch));
+        }
+    }
+    return sut;
+}
+
+// Processes the signal in blocks of the given sizes, in place.
+template <std::size_t NumChannels, std::size_t NumSections>
+auto
+process_bank(
+    std::array<std::vector<float>, NumChannels> signal,
+    std::span<std::size_t const> const block_sizes)
+    -> std::array<std::vector<float>, NumChannels>
+{
+    auto sut = make_sut<NumChannels, NumSections>();
+
+    std::size_t offset{};
+    for (std::size_t const block_size : block_sizes)
+    {
+        std::array<std::span<float const>, NumChannels> in;
+        std::array<std::span<float>, NumChannels> out;
+        for (std::size_t ch = 0; ch < NumChannels; ++ch)
+        {
+            out[ch] = std::span{signal[ch]}.subspan(offset, block_size);
+            in[ch] = out[ch];
+        }
+
+        sut.process(in, out);
+        offset += block_size;
+    }
+
+    return signal;
+}
+
+template <std::size_t NumChannels>
+auto
+make_signal(std::size_t const size)
+    -> std::array<std::vector<float>, NumChannels>
+{
+    std::array<std::vector<float>, NumChannels> result;
+    for (std::size_t ch = 0; ch < NumChannels; ++ch)
+    {
+        result[ch] = noise(size, static_cast<unsigned>(ch + 1));
+    }
+    return result;
+}
+
+template <std::size_t NumChannels, std::size_t NumSections>
+void
+expect_agreement(std::span<std::size_t const> const block_sizes)
+{
+    std::size_t const size = std::accumulate(
+        block_sizes.begin(),
+        block_sizes.end(),
+        std::size_t{});
+
+    auto const signal = make_signal<NumChannels>(size);
+    auto const expected = process_scalar<NumChannels, NumSections>(signal);
+    auto const actual =
+        process_bank<NumChannels, NumSections>(signal, block_sizes);
+
+    for (std::size_t ch = 0; ch < NumChannels; ++ch)
+    {
+        for (std::size_t frame = 0; frame < size; ++frame)
+        {
+            ASSERT_NEAR(expected[ch][frame], actual[ch][frame], tolerance)
+                << "channel " << ch << ", frame " << frame;
+        }
+    }
+}
+
+constexpr std::array one_block{std::size_t{1024}};
+constexpr std::array uneven_blocks{
+    std::size_t{1},
+    std::size_t{2},
+    std::size_t{3},
+    std::size_t{128},
+    std::size_t{61},
+    std::size_t{1},
+    std::size_t{300}};
+
+} // namespace
+
+TEST(biquad_bank, default_passes_through)
+{
+    auto signal = make_signal<2>(64);
+    auto const expected = signal;
+
+    biquad_bank<float, 2, 2> sut;
+    sut.process(
+        {std::span<float const>{signal[0]}, std::span<float const>{signal[1]}},
+        {std::span{signal[0]}, std::span{signal[1]}});
+
+    EXPECT_EQ(expected, signal);
+}
+
+TEST(biquad_bank, mono_agrees_with_scalar)
+{
+    expect_agreement<1, 1>(one_block);
+}
+
+TEST(biquad_bank, stereo_agrees_with_scalar)
+{
+    expect_agreement<2, 1>(one_block);
+}
+
+TEST(biquad_bank, stereo_cascade_agrees_with_scalar)
+{
+    expect_agreement<2, 2>(one_block);
+}
+
+TEST(biquad_bank, cascade_exceeding_a_register_agrees_with_scalar)
+{
+    expect_agreement<3, 3>(one_block);
+}
+
+TEST(biquad_bank, cascade_state_is_kept_between_uneven_blocks)
+{
+    expect_agreement<2, 2>(uneven_blocks);
+    expect_agreement<1, 4>(uneven_blocks);
+}
+
+TEST(biquad_bank, reset_clears_the_state)
+{
+    auto const signal = make_signal<1>(256);
+
+    auto sut = make_sut<1, 2>();
+
+    auto first = signal;
+    sut.process({std::span<float const>{first[0]}}, {std::span{first[0]}});
+
+    sut.reset();
+
+    auto second = signal;
+    sut.process({std::span<float const>{second[0]}}, {std::span{second[0]}});
+
+    EXPECT_EQ(first, second);
+}
+
+} // namespace piejam::audio::dsp::test
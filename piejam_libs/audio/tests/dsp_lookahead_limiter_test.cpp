@@ -0,0 +1,271 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/lookahead_limiter.h>
+
+#include <piejam/audio/dsp/true_peak_detector.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::dsp::test
+{
+
+namespace
+{
+
+constexpr std::size_t lookahead = 32;
+constexpr float tolerance = 1e-5f;
+
+auto
+noise(std::size_t const size, float const amplitude, unsigned const seed)
+    -> std::vector<float>
+{
+    std::mt19937 gen{seed};
+    std::uniform_real_distribution<float> dist{-amplitude, amplitude};
+
+    std::vector<float> result(size);
+    std::ranges::generate(result, [&]() { return dist(gen); });
+    return result;
+}
+
+// A quarter of the sample rate, shifted by 45 degrees. The samples are at
+// 1/sqrt(2) of the peaks, which are all between the samples.
+auto
+quarter_rate_sine(std::size_t const size, float const amplitude)
+    -> std::vector<float>
+{
+    std::vector<float> result(size);
+    for (std::size_t n = 0; n < size; ++n)
+    {
+        result[n] = amplitude * std::sin(
+                                    std::numbers::pi_v<float> / 2.f *
+                                        static_cast<float>(n) +
+                                    std::numbers::pi_v<float> / 4.f);
+    }
+    return result;
+}
+
+auto
+max_magnitude(std::span<float const> const buf) -> float
+{
+    return std::ranges::max(buf, {}, [](float x) { return std::abs(x); });
+}
+
+template <std::size_t NumChannels>
+void
+process(
+    lookahead_limiter<float, NumChannels>& sut,
+    std::array<std::vector<float>, NumChannels>& bufs,
+    std::size_t const period_size)
+{
+    for (std::size_t offset = 0; offset < bufs[0].size();
+         offset += period_size)
+    {
+        std::size_t const count =
+            std::min(period_size, bufs[0].size() - offset);
+
+        std::array<std::span<float const>, NumChannels> in;
+        std::array<std::span<float>, NumChannels> out;
+        for (std::size_t ch = 0; ch < NumChannels; ++ch)
+        {
+            out[ch] = std::span(bufs[ch]).subspan(offset, count);
+            in[ch] = out[ch];
+        }
+
+        sut.process(in, out);
+    }
+}
+
+} // namespace
+
+TEST(true_peak_detector, dc_passes_with_unity_gain)
+{
+    true_peak_detector<float> sut;
+
+    float peak{};
+    for (std::size_t n = 0; n < 32; ++n)
+    {
+        peak = sut(.5f);
+    }
+
+    EXPECT_NEAR(.5f, peak, tolerance);
+}
+
+TEST(true_peak_detector, finds_the_peaks_between_the_samples)
+{
+    auto const signal = quarter_rate_sine(256, 1.f);
+    ASSERT_NEAR(
+        std::numbers::sqrt2_v<float> / 2.f,
+        max_magnitude(signal),
+        1e-4f);
+
+    true_peak_detector<float> sut;
+    float true_peak{};
+    float sample_peak{};
+    for (std::size_t n = 0; n < signal.size(); ++n)
+    {
+        float const p = sut(signal[n]);
+        if (n >= 64)
+        {
+            true_peak = std::max(true_peak, p);
+        }
+    }
+
+    true_peak_detector<float> sample_sut;
+    for (float const x : signal)
+    {
+        sample_peak = std::max(sample_peak, sample_sut.sample_peak(x));
+    }
+
+    EXPECT_NEAR(1.f, true_peak, .02f);
+    EXPECT_NEAR(max_magnitude(signal), sample_peak, 1e-6f);
+}
+
+TEST(true_peak_detector, the_sample_itself_is_a_phase)
+{
+    auto const signal = noise(256, 1.f, 3);
+
+    true_peak_detector<float> sut;
+    for (std::size_t n = 0; n < signal.size(); ++n)
+    {
+        float const p = sut(signal[n]);
+        if (n >= true_peak_detector<float>::latency)
+        {
+            EXPECT_LE(
+                std::abs(signal[n - true_peak_detector<float>::latency]),
+                p + tolerance);
+        }
+    }
+}
+
+TEST(lookahead_limiter, signal_below_threshold_is_delayed)
+{
+    lookahead_limiter<float, 1> sut(lookahead);
+    sut.set_threshold(1.f);
+
+    auto const signal = noise(1000, .5f, 1);
+    std::array bufs{signal};
+
+    process(sut, bufs, 100);
+
+    std::size_t const latency = sut.latency();
+    EXPECT_EQ(lookahead + true_peak_detector<float>::latency, latency);
+    for (std::size_t n = 0; n < signal.size(); ++n)
+    {
+        ASSERT_FLOAT_EQ(n < latency ? 0.f : signal[n - latency], bufs[0][n])
+            << n;
+    }
+    EXPECT_FLOAT_EQ(1.f, sut.gain());
+}
+
+TEST(lookahead_limiter, output_does_not_exceed_the_threshold)
+{
+    lookahead_limiter<float, 2> sut(lookahead);
+    sut.set_threshold(.5f);
+    sut.set_release(.999f);
+    sut.set_true_peak(false);
+
+    std::array bufs{noise(4096, 2.f, 1), noise(4096, 1.f, 2)};
+
+    process(sut, bufs, 128);
+
+    EXPECT_LE(max_magnitude(bufs[0]), .5f + tolerance);
+    EXPECT_LE(max_magnitude(bufs[1]), .5f + tolerance);
+    EXPECT_GT(max_magnitude(bufs[0]), .45f);
+}
+
+TEST(lookahead_limiter, channels_are_linked)
+{
+    lookahead_limiter<float, 2> sut(lookahead);
+    sut.set_threshold(.5f);
+    sut.set_true_peak(false);
+
+    std::array bufs{
+        std::vector<float>(512, 1.f),
+        std::vector<float>(512, .25f)};
+
+    process(sut, bufs, 512);
+
+    EXPECT_NEAR(.5f, bufs[0].back(), tolerance);
+    EXPECT_NEAR(.125f, bufs[1].back(), tolerance);
+}
+
+TEST(lookahead_limiter, attack_ramps_over_the_lookahead)
+{
+    lookahead_limiter<float, 1> sut(lookahead);
+    sut.set_threshold(.5f);
+    sut.set_true_peak(false);
+
+    constexpr std::size_t peak_start = 100;
+    std::array bufs{std::vector<float>(256, .25f)};
+    std::fill(
+        std::next(bufs[0].begin(), peak_start),
+        bufs[0].end(),
+        1.f);
+
+    process(sut, bufs, 256);
+
+    // the gain is ramped down over the lookahead preceding the peak
+    std::size_t const peak_out = peak_start + sut.latency();
+    std::size_t const ramp_start = peak_out - lookahead;
+    EXPECT_FLOAT_EQ(.25f, bufs[0][ramp_start - 1]);
+    for (std::size_t n = ramp_start; n < peak_out; ++n)
+    {
+        EXPECT_LT(bufs[0][n], bufs[0][n - 1]);
+    }
+    // the averaging window is one longer than the lookahead
+    float const ramp_step = .5f / static_cast<float>(lookahead + 1);
+    EXPECT_NEAR(
+        .25f * (1.f - ramp_step * lookahead),
+        bufs[0][peak_out - 1],
+        tolerance);
+    EXPECT_NEAR(.5f, bufs[0][peak_out], tolerance);
+}
+
+TEST(lookahead_limiter, gain_is_released_after_the_peak)
+{
+    lookahead_limiter<float, 1> sut(lookahead);
+    sut.set_threshold(.5f);
+    sut.set_release(.99f);
+    sut.set_true_peak(false);
+
+    std::array bufs{std::vector<float>(4096, .1f)};
+    bufs[0][100] = 1.f;
+
+    process(sut, bufs, 256);
+
+    EXPECT_NEAR(.5f, bufs[0][100 + sut.latency()], tolerance);
+    EXPECT_NEAR(.1f, bufs[0].back(), tolerance);
+    EXPECT_NEAR(1.f, sut.gain(), tolerance);
+}
+
+TEST(lookahead_limiter, true_peaks_are_limited)
+{
+    auto const signal = quarter_rate_sine(2048, .6f);
+
+    lookahead_limiter<float, 1> sample_sut(lookahead);
+    sample_sut.set_threshold(.5f);
+    sample_sut.set_true_peak(false);
+    std::array sample_bufs{signal};
+    process(sample_sut, sample_bufs, 256);
+
+    lookahead_limiter<float, 1> true_peak_sut(lookahead);
+    true_peak_sut.set_threshold(.5f);
+    std::array true_peak_bufs{signal};
+    process(true_peak_sut, true_peak_bufs, 256);
+
+    // the samples are below the threshold, only the true peaks aren't
+    EXPECT_FLOAT_EQ(1.f, sample_sut.gain());
+    EXPECT_NEAR(.5f / .6f, true_peak_sut.gain(), .01f);
+}
+
+} // namespace piejam::audio::dsp::test
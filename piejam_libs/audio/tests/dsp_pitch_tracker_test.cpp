@@ -0,0 +1,114 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/pitch_tracker.h>
+
+#include <piejam/numeric/generators/sine.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace piejam::audio::dsp::test
+{
+
+namespace
+{
+
+constexpr std::size_t window_size{8192};
+constexpr std::size_t block_size{512};
+constexpr sample_rate sr{48000};
+
+auto
+feed(pitch_tracker& sut, float const freq, std::size_t const num_samples)
+    -> float
+{
+    numeric::generators::sine<float> gen{freq, sr.as<float>()};
+    std::vector<float> block(block_size);
+
+    float result{};
+    for (std::size_t n = 0; n < num_samples; n += block_size)
+    {
+        std::ranges::generate(block, std::ref(gen));
+        result = sut.process(block);
+    }
+
+    return result;
+}
+
+} // namespace
+
+// test param: frequency
+struct pitch_tracker_test : public testing::TestWithParam<float>
+{
+    pitch_tracker sut{window_size, sr};
+};
+
+TEST_P(pitch_tracker_test, locks_on_steady_tone)
+{
+    float const result = feed(sut, GetParam(), 4 * window_size);
+
+    EXPECT_TRUE(sut.locked());
+    EXPECT_NEAR(GetParam(), result, 0.5);
+}
+
+static auto s_test_frequencies = testing::Values(
+    27.5f,
+    41.2f,
+    55.f,
+    82.41f,
+    110.f,
+    146.83f,
+    196.f,
+    246.94f,
+    329.63f,
+    440.f,
+    659.26f,
+    880.f,
+    1318.51f);
+
+INSTANTIATE_TEST_SUITE_P(all, pitch_tracker_test, s_test_frequencies);
+
+TEST(pitch_tracker, silence_is_not_detected)
+{
+    pitch_tracker sut{window_size, sr};
+    feed(sut, 440.f, 2 * window_size);
+
+    std::vector<float> silence(block_size);
+    float result{};
+    for (std::size_t n = 0; n < 2 * window_size; n += block_size)
+    {
+        result = sut.process(silence);
+    }
+
+    EXPECT_FALSE(sut.locked());
+    EXPECT_EQ(0.f, result);
+}
+
+TEST(pitch_tracker, follows_small_pitch_change_while_locked)
+{
+    pitch_tracker sut{window_size, sr};
+    feed(sut, 440.f, 2 * window_size);
+    ASSERT_TRUE(sut.locked());
+
+    float const result = feed(sut, 452.f, 2 * window_size);
+
+    EXPECT_TRUE(sut.locked());
+    EXPECT_NEAR(452.f, result, 0.5);
+}
+
+TEST(pitch_tracker, relocks_on_large_pitch_change)
+{
+    pitch_tracker sut{window_size, sr};
+    feed(sut, 440.f, 2 * window_size);
+    ASSERT_TRUE(sut.locked());
+
+    float const result = feed(sut, 659.26f, 2 * window_size);
+
+    EXPECT_TRUE(sut.locked());
+    EXPECT_NEAR(659.26f, result, 0.5);
+}
+
+} // namespace piejam::audio::dsp::test
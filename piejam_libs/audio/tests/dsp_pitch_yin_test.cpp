@@ -40,6 +40,21 @@ TEST_P(pitch_yin_test, simple)
     EXPECT_NEAR(GetParam(), result, 0.5);
 }
 
+TEST_P(pitch_yin_test, fft)
+{
+    pitch_yin_fft sut{buffer_size};
+    auto result = sut(signal, sr);
+
+    EXPECT_NEAR(GetParam(), result, 0.5);
+}
+
+TEST_P(pitch_yin_test, fft_agrees_with_direct)
+{
+    pitch_yin_fft sut{buffer_size};
+
+    EXPECT_NEAR(pitch_yin<float>(signal, sr), sut(signal, sr), 0.01);
+}
+
 static auto s_test_frequencies = testing::Values(
     27.5f,
     30.87f,
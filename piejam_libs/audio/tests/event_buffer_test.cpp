@@ -87,4 +87,29 @@ TEST(event_buffer, clear)
     EXPECT_EQ(0, sut.size());
 }
 
+TEST(event_buffer, insert_copies_of_the_events_of_another_buffer)
+{
+    std::pmr::memory_resource* event_memory = std::pmr::get_default_resource();
+    event_buffer<float> other(event_memory);
+    other.insert(7, 23.f);
+    other.insert(3, 58.f);
+
+    event_buffer<float> sut(event_memory);
+    sut.insert(5, 77.f);
+    static_cast<abstract_event_buffer&>(sut).insert(other);
+
+    ASSERT_EQ(3u, sut.size());
+    EXPECT_EQ(2u, other.size());
+
+    auto it = sut.begin();
+    EXPECT_EQ(3u, it->offset());
+    EXPECT_FLOAT_EQ(58.f, it->value());
+    ++it;
+    EXPECT_EQ(5u, it->offset());
+    EXPECT_FLOAT_EQ(77.f, it->value());
+    ++it;
+    EXPECT_EQ(7u, it->offset());
+    EXPECT_FLOAT_EQ(23.f, it->value());
+}
+
 } // namespace piejam::audio::engine::test
@@ -0,0 +1,51 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/event_quantization.h>
+
+#include <gtest/gtest.h>
+
+namespace piejam::audio::engine::test
+{
+
+TEST(event_quantization, period_rate_events_quantize_a_period_to_its_start)
+{
+    EXPECT_EQ(0u, period_rate_events.quantize(0));
+    EXPECT_EQ(0u, period_rate_events.quantize(max_period_size.value() - 1));
+}
+
+TEST(event_quantization, granularity_is_valid_up_to_the_largest_period)
+{
+    EXPECT_FALSE(event_quantization{0}.is_valid());
+    EXPECT_TRUE(sample_accurate_events.is_valid());
+    EXPECT_TRUE(period_rate_events.is_valid());
+    EXPECT_FALSE(event_quantization{max_period_size.value() + 1}.is_valid());
+}
+
+TEST(event_quantization, no_overhead_is_sample_accurate)
+{
+    EXPECT_EQ(sample_accurate_events, event_quantization_for_overhead(0., 1.));
+}
+
+TEST(event_quantization, small_overhead_is_sample_accurate)
+{
+    EXPECT_EQ(sample_accurate_events, event_quantization_for_overhead(.1, 1.));
+}
+
+TEST(event_quantization, overhead_is_bounded_by_the_granularity)
+{
+    // an overhead of two samples needs 16 samples to stay below an eighth
+    EXPECT_EQ(event_quantization{16}, event_quantization_for_overhead(2., 1.));
+    EXPECT_EQ(
+        event_quantization{32},
+        event_quantization_for_overhead(2.5, 1.));
+}
+
+TEST(event_quantization, huge_overhead_results_in_period_rate_events)
+{
+    EXPECT_EQ(period_rate_events, event_quantization_for_overhead(1e6, 1.));
+    EXPECT_EQ(period_rate_events, event_quantization_for_overhead(1., 0.));
+}
+
+} // namespace piejam::audio::engine::test
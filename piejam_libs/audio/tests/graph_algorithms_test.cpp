@@ -13,10 +13,15 @@
 #include <piejam/audio/engine/graph_generic_algorithms.h>
 #include <piejam/audio/engine/identity_processor.h>
 #include <piejam/audio/engine/mix_processor.h>
+#include <piejam/audio/engine/multiply_processor.h>
+#include <piejam/audio/engine/smoother_processor.h>
+#include <piejam/audio/engine/weighted_sum_processor.h>
 #include <piejam/audio/slice.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 
 namespace piejam::audio::engine::test
@@ -46,6 +51,146 @@ TEST(finalize_graph, connect_to_already_connected_will_insert_a_mixer)
     EXPECT_TRUE(has_audio_wire(result, {*mixers.front(), 0}, {dst, 0}));
 }
 
+TEST(finalize_graph, mixer_fed_by_gain_stages_is_fused_into_a_weighted_sum)
+{
+    fake_processor src1{"src1", 0, 1};
+    fake_processor src2{"src2", 0, 1};
+    fake_processor gain1{"gain1", 0, 1};
+    fake_processor gain2{"gain2", 0, 1};
+    auto amp1 = make_multiply_processor(2);
+    auto amp2 = make_multiply_processor(2);
+    fake_processor dst{"dst", 1, 0};
+    graph sut;
+    sut.audio.insert({src1, 0}, {*amp1, 0});
+    sut.audio.insert({gain1, 0}, {*amp1, 1});
+    sut.audio.insert({src2, 0}, {*amp2, 0});
+    sut.audio.insert({gain2, 0}, {*amp2, 1});
+    sut.audio.insert({*amp1, 0}, {dst, 0});
+    sut.audio.insert({*amp2, 0}, {dst, 0});
+
+    auto [result, mixers] = finalize_graph(sut);
+
+    ASSERT_EQ(1u, mixers.size());
+    auto& fused = *mixers.front();
+    EXPECT_TRUE(is_weighted_sum_processor(fused));
+    EXPECT_EQ(4u, fused.num_inputs());
+    EXPECT_EQ(5u, result.audio.size());
+    EXPECT_TRUE(has_audio_wire(result, {fused, 0}, {dst, 0}));
+
+    // the order of the terms follows the order of the mixer inputs
+    std::size_t const term1 =
+        has_audio_wire(result, {src1, 0}, {fused, 0}) ? 0 : 1;
+    std::size_t const term2 = 1 - term1;
+    EXPECT_TRUE(has_audio_wire(result, {src1, 0}, {fused, 2 * term1}));
+    EXPECT_TRUE(has_audio_wire(result, {gain1, 0}, {fused, 2 * term1 + 1}));
+    EXPECT_TRUE(has_audio_wire(result, {src2, 0}, {fused, 2 * term2}));
+    EXPECT_TRUE(has_audio_wire(result, {gain2, 0}, {fused, 2 * term2 + 1}));
+}
+
+TEST(finalize_graph, gain_stage_with_other_outputs_is_not_fused)
+{
+    fake_processor src1{"src1", 0, 1};
+    fake_processor src2{"src2", 0, 1};
+    auto amp1 = make_multiply_processor(2);
+    auto amp2 = make_multiply_processor(2);
+    fake_processor dst{"dst", 1, 0};
+    fake_processor meter{"meter", 1, 0};
+    graph sut;
+    sut.audio.insert({src1, 0}, {*amp1, 0});
+    sut.audio.insert({src2, 0}, {*amp2, 0});
+    sut.audio.insert({*amp1, 0}, {dst, 0});
+    sut.audio.insert({*amp2, 0}, {dst, 0});
+    sut.audio.insert({*amp2, 0}, {meter, 0});
+
+    auto [result, mixers] = finalize_graph(sut);
+
+    ASSERT_EQ(1u, mixers.size());
+    EXPECT_TRUE(is_mix_processor(*mixers.front()));
+    EXPECT_TRUE(has_audio_wire(result, {*amp2, 0}, {meter, 0}));
+    EXPECT_TRUE(has_audio_wire(result, {*mixers.front(), 0}, {dst, 0}));
+}
+
+TEST(finalize_graph, mixer_fed_by_lut_smoothed_multipliers_is_fused)
+{
+    constexpr std::array gain_lut{0.f, 0.5f, 1.f};
+    fake_processor src1{"src1", 0, 2};
+    fake_processor src2{"src2", 0, 2};
+    fake_processor param{
+        "param",
+        0,
+        0,
+        {},
+        {event_port(std::in_place_type<float>)}};
+    auto amp1 = make_lut_smoothed_multiply_processor(gain_lut, 1.f, 2);
+    auto amp2 = make_lut_smoothed_multiply_processor(gain_lut, 1.f, 2);
+    fake_processor dst{"dst", 2, 0};
+    graph sut;
+    for (std::size_t ch = 0; ch < 2; ++ch)
+    {
+        sut.audio.insert({src1, ch}, {*amp1, ch});
+        sut.audio.insert({src2, ch}, {*amp2, ch});
+        sut.audio.insert({*amp1, ch}, {dst, ch});
+        sut.audio.insert({*amp2, ch}, {dst, ch});
+    }
+    sut.event.insert({param, 0}, {*amp1, 0});
+
+    auto [result, mixers] = finalize_graph(sut);
+
+    // a weighted sum per channel and a gain processor per multiplier
+    ASSERT_EQ(4u, mixers.size());
+    EXPECT_EQ(2, std::ranges::count_if(mixers, [](auto const& proc) {
+                  return is_weighted_sum_processor(*proc);
+              }));
+    EXPECT_TRUE(std::ranges::none_of(result.audio, [&](auto const& wire) {
+        return &wire.first.proc.get() == amp1.get() ||
+               &wire.second.proc.get() == amp1.get() ||
+               &wire.first.proc.get() == amp2.get() ||
+               &wire.second.proc.get() == amp2.get();
+    }));
+    EXPECT_FALSE(has_event_wire(result, {param, 0}, {*amp1, 0}));
+    ASSERT_EQ(1u, result.event.size());
+
+    processor& gain1 = result.event.begin()->second.proc;
+    for (std::size_t ch = 0; ch < 2; ++ch)
+    {
+        auto const fused = connected_source(result, {dst, ch});
+        ASSERT_TRUE(fused);
+        EXPECT_TRUE(is_weighted_sum_processor(fused->proc));
+
+        std::size_t const term =
+            has_audio_wire(result, {src1, ch}, {fused->proc, 0}) ? 0 : 1;
+        EXPECT_TRUE(
+            has_audio_wire(result, {src1, ch}, {fused->proc, 2 * term}));
+        EXPECT_TRUE(
+            has_audio_wire(result, {gain1, 0}, {fused->proc, 2 * term + 1}));
+    }
+}
+
+TEST(finalize_graph, lut_smoothed_multiplier_is_only_fused_as_a_whole)
+{
+    constexpr std::array gain_lut{0.f, 0.5f, 1.f};
+    fake_processor src1{"src1", 0, 2};
+    fake_processor src2{"src2", 0, 1};
+    auto amp1 = make_lut_smoothed_multiply_processor(gain_lut, 1.f, 2);
+    auto amp2 = make_lut_smoothed_multiply_processor(gain_lut, 1.f, 1);
+    fake_processor dst{"dst", 2, 0};
+    graph sut;
+    sut.audio.insert({src1, 0}, {*amp1, 0});
+    sut.audio.insert({src1, 1}, {*amp1, 1});
+    sut.audio.insert({src2, 0}, {*amp2, 0});
+    sut.audio.insert({*amp1, 0}, {dst, 0});
+    sut.audio.insert({*amp2, 0}, {dst, 0});
+    sut.audio.insert({*amp1, 1}, {dst, 1});
+
+    auto [result, mixers] = finalize_graph(sut);
+
+    // the right channel of amp1 isn't mixed, so amp1 stays
+    ASSERT_EQ(1u, mixers.size());
+    EXPECT_TRUE(is_mix_processor(*mixers.front()));
+    EXPECT_TRUE(has_audio_wire(result, {*amp1, 0}, {*mixers.front(), 0}));
+    EXPECT_TRUE(has_audio_wire(result, {*amp1, 1}, {dst, 1}));
+}
+
 TEST(remove_event_identity_processors, identity_without_output)
 {
     using namespace testing;
@@ -4,18 +4,24 @@
 
 #include "processor_mock.h"
 
+#include <piejam/audio/engine/buffer_pass_counter.h>
 #include <piejam/audio/engine/dag.h>
 #include <piejam/audio/engine/dag_executor.h>
 #include <piejam/audio/engine/event_input_buffers.h>
 #include <piejam/audio/engine/event_output_buffers.h>
 #include <piejam/audio/engine/event_port.h>
 #include <piejam/audio/engine/graph.h>
+#include <piejam/audio/engine/graph_algorithms.h>
 #include <piejam/audio/engine/graph_to_dag.h>
 #include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/engine/smoother_processor.h>
 #include <piejam/audio/engine/thread_context.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+
 namespace piejam::audio::engine::test
 {
 
@@ -222,4 +228,124 @@ TEST(graph_to_dag, event_output_buffer_is_cleared_after_dag_run)
     EXPECT_TRUE(ev_buf->empty());
 }
 
+namespace
+{
+
+constexpr std::array gain_lut{0.f, 0.25f, 0.5f, 0.75f, 1.f};
+
+void
+write_buffer(process_context const& ctx)
+{
+    std::ranges::fill(ctx.outputs[0], 0.5f);
+    ctx.results[0] = ctx.outputs[0];
+}
+
+auto
+input_is(float const expected)
+{
+    return [=](process_context const& ctx) {
+        return ctx.inputs.size() == 1 && ctx.inputs[0].get().is_span() &&
+               std::ranges::all_of(
+                   ctx.inputs[0].get().span(),
+                   [=](float const x) { return x == expected; });
+    };
+}
+
+} // namespace
+
+TEST(graph_to_dag, chain_of_static_gains_is_folded_into_one_multiply)
+{
+    ::testing::NiceMock<processor_mock> in_proc;
+    auto gain1 = make_lut_smoothed_multiply_processor(gain_lut, 0.5f, 1);
+    auto gain2 = make_lut_smoothed_multiply_processor(gain_lut, 0.25f, 1);
+    ::testing::NiceMock<processor_mock> out_proc;
+
+    graph g;
+
+    using namespace testing;
+
+    ON_CALL(in_proc, num_outputs()).WillByDefault(Return(1));
+    ON_CALL(out_proc, num_inputs()).WillByDefault(Return(1));
+    g.audio.insert({in_proc, 0}, {*gain1, 0});
+    g.audio.insert({*gain1, 0}, {*gain2, 0});
+    g.audio.insert({*gain2, 0}, {out_proc, 0});
+
+    buffer_pass_counter passes;
+    auto d = graph_to_dag(g, &passes).make_runnable();
+
+    EXPECT_CALL(in_proc, process(_)).WillRepeatedly(Invoke(write_buffer));
+    EXPECT_CALL(out_proc, process(Truly(input_is(0.0625f)))).Times(2);
+
+    (*d)(8);
+    EXPECT_EQ(2u, passes.exchange());
+
+    (*d)(8);
+    EXPECT_EQ(2u, passes.exchange());
+}
+
+TEST(graph_to_dag, result_feeding_a_non_folding_processor_is_not_folded)
+{
+    ::testing::NiceMock<processor_mock> in_proc;
+    auto gain1 = make_lut_smoothed_multiply_processor(gain_lut, 0.5f, 1);
+    auto gain2 = make_lut_smoothed_multiply_processor(gain_lut, 0.25f, 1);
+    ::testing::NiceMock<processor_mock> out_proc1;
+    ::testing::NiceMock<processor_mock> out_proc2;
+
+    graph g;
+
+    using namespace testing;
+
+    ON_CALL(in_proc, num_outputs()).WillByDefault(Return(1));
+    ON_CALL(out_proc1, num_inputs()).WillByDefault(Return(1));
+    ON_CALL(out_proc2, num_inputs()).WillByDefault(Return(1));
+    g.audio.insert({in_proc, 0}, {*gain1, 0});
+    g.audio.insert({*gain1, 0}, {out_proc1, 0});
+    g.audio.insert({*gain1, 0}, {*gain2, 0});
+    g.audio.insert({*gain2, 0}, {out_proc2, 0});
+
+    buffer_pass_counter passes;
+    auto d = graph_to_dag(g, &passes).make_runnable();
+
+    EXPECT_CALL(in_proc, process(_)).WillOnce(Invoke(write_buffer));
+    EXPECT_CALL(out_proc1, process(Truly(input_is(0.25f)))).Times(1);
+    EXPECT_CALL(out_proc2, process(Truly(input_is(0.0625f)))).Times(1);
+
+    (*d)(8);
+    EXPECT_EQ(3u, passes.exchange());
+}
+
+TEST(graph_to_dag, mixed_lut_smoothed_multipliers_are_summed_in_one_pass)
+{
+    ::testing::NiceMock<processor_mock> in_proc;
+    auto gain1 = make_lut_smoothed_multiply_processor(gain_lut, 0.5f, 1);
+    auto gain2 = make_lut_smoothed_multiply_processor(gain_lut, 0.25f, 1);
+    ::testing::NiceMock<processor_mock> out_proc;
+
+    graph g;
+
+    using namespace testing;
+
+    ON_CALL(in_proc, num_outputs()).WillByDefault(Return(1));
+    ON_CALL(out_proc, num_inputs()).WillByDefault(Return(1));
+    g.audio.insert({in_proc, 0}, {*gain1, 0});
+    g.audio.insert({in_proc, 0}, {*gain2, 0});
+    g.audio.insert({*gain1, 0}, {out_proc, 0});
+    g.audio.insert({*gain2, 0}, {out_proc, 0});
+
+    auto [final_graph, mixers] = finalize_graph(g);
+
+    buffer_pass_counter passes;
+    auto d = graph_to_dag(final_graph, &passes).make_runnable();
+
+    EXPECT_CALL(in_proc, process(_)).WillRepeatedly(Invoke(write_buffer));
+    EXPECT_CALL(out_proc, process(Truly(input_is(0.375f)))).Times(2);
+
+    // the input and the weighted sum, the gains stay constant
+    (*d)(8);
+    EXPECT_EQ(2u, passes.exchange());
+
+    (*d)(8);
+    EXPECT_EQ(2u, passes.exchange());
+}
+
 } // namespace piejam::audio::engine::test
@@ -0,0 +1,91 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/period_delay_processor.h>
+
+#include <piejam/audio/engine/processor.h>
+#include <piejam/audio/engine/processor_test_environment.h>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace piejam::audio::engine::test
+{
+
+TEST(period_delay_processor, properties)
+{
+    auto sut = make_period_delay_processor(2, 1);
+
+    EXPECT_EQ(2u, sut->num_inputs());
+    EXPECT_EQ(2u, sut->num_outputs());
+    EXPECT_TRUE(sut->event_inputs().empty());
+    EXPECT_TRUE(sut->event_outputs().empty());
+}
+
+TEST(period_delay_processor, first_periods_are_silent)
+{
+    auto sut = make_period_delay_processor(1, 2);
+    processor_test_environment env(*sut, 4);
+    env.audio_inputs[0] = 1.f;
+
+    for (std::size_t period = 0; period < 2; ++period)
+    {
+        sut->process(env.ctx);
+
+        ASSERT_TRUE(env.audio_results[0].is_constant());
+        EXPECT_FLOAT_EQ(0.f, env.audio_results[0].constant());
+    }
+}
+
+TEST(period_delay_processor, input_is_delayed_by_the_periods)
+{
+    auto sut = make_period_delay_processor(1, 2);
+    processor_test_environment env(*sut, 4);
+
+    alignas(mipp::RequiredAlignment) std::array in_buf{1.f, 2.f, 3.f, 4.f};
+    env.audio_inputs[0] = std::span<float const>(in_buf);
+    sut->process(env.ctx);
+
+    env.audio_inputs[0] = 5.f;
+    sut->process(env.ctx);
+
+    // the input buffer may be reused by the engine
+    in_buf.fill(0.f);
+    env.audio_inputs[0] = 6.f;
+    sut->process(env.ctx);
+
+    ASSERT_TRUE(env.audio_results[0].is_span());
+    EXPECT_THAT(
+        env.audio_results[0].span(),
+        testing::ElementsAre(1.f, 2.f, 3.f, 4.f));
+
+    sut->process(env.ctx);
+
+    ASSERT_TRUE(env.audio_results[0].is_constant());
+    EXPECT_FLOAT_EQ(5.f, env.audio_results[0].constant());
+}
+
+TEST(period_delay_processor, changed_period_size_pads_with_silence)
+{
+    auto sut = make_period_delay_processor(1, 1);
+    processor_test_environment env(*sut, 4);
+
+    alignas(mipp::RequiredAlignment) std::array in_buf{1.f, 2.f};
+    env.ctx.buffer_size = 2;
+    env.audio_inputs[0] = std::span<float const>(in_buf);
+    sut->process(env.ctx);
+
+    env.ctx.buffer_size = 4;
+    env.audio_inputs[0] = 0.f;
+    sut->process(env.ctx);
+
+    ASSERT_TRUE(env.audio_results[0].is_span());
+    EXPECT_THAT(
+        env.audio_results[0].span(),
+        testing::ElementsAre(1.f, 2.f, 0.f, 0.f));
+}
+
+} // namespace piejam::audio::engine::test
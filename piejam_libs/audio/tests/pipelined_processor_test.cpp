@@ -0,0 +1,182 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/pipelined_processor.h>
+
+#include <piejam/audio/engine/event_input_buffers.h>
+#include <piejam/audio/engine/event_port.h>
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/engine/processor_test_environment.h>
+#include <piejam/thread/configuration.h>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+
+namespace piejam::audio::engine::test
+{
+
+namespace
+{
+
+// Multiplies the input with the last gain event, passes it through with unity
+// gain. Remembers the thread it was processed on.
+class gain_processor final : public named_processor
+{
+public:
+    explicit gain_processor(std::atomic<std::thread::id>& process_thread)
+        : named_processor("gain")
+        , m_process_thread(process_thread)
+    {
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return "gain";
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return 1;
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return 1;
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        static std::array const s_ports{
+            event_port(std::in_place_type<float>, "gain")};
+        return s_ports;
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    void process(process_context const& ctx) override
+    {
+        m_process_thread = std::this_thread::get_id();
+
+        for (event<float> const& ev : ctx.event_inputs.get<float>(0))
+        {
+            m_gain = ev.value();
+        }
+
+        slice<float> const& in = ctx.inputs[0];
+        if (in.is_constant())
+        {
+            ctx.results[0] = in.constant() * m_gain;
+        }
+        else if (m_gain == 1.f)
+        {
+            ctx.results[0] = in;
+        }
+        else
+        {
+            std::ranges::transform(
+                in.span(),
+                ctx.outputs[0].begin(),
+                [this](float const x) { return x * m_gain; });
+            ctx.results[0] = ctx.outputs[0];
+        }
+    }
+
+private:
+    std::atomic<std::thread::id>& m_process_thread;
+    float m_gain{1.f};
+};
+
+} // namespace
+
+struct pipelined_processor_test : testing::Test
+{
+    std::atomic<std::thread::id> process_thread;
+    std::unique_ptr<processor> sut{make_pipelined_processor(
+        std::make_unique<gain_processor>(process_thread),
+        thread::configuration{})};
+    processor_test_environment env{*sut, 4};
+};
+
+TEST_F(pipelined_processor_test, properties)
+{
+    EXPECT_EQ("gain", sut->name());
+    EXPECT_EQ(1u, sut->num_inputs());
+    EXPECT_EQ(1u, sut->num_outputs());
+    EXPECT_EQ(1u, sut->event_inputs().size());
+    EXPECT_TRUE(sut->event_outputs().empty());
+}
+
+TEST_F(pipelined_processor_test, first_period_is_silent)
+{
+    env.audio_inputs[0] = 1.f;
+
+    sut->process(env.ctx);
+
+    ASSERT_TRUE(env.audio_results[0].is_constant());
+    EXPECT_FLOAT_EQ(0.f, env.audio_results[0].constant());
+}
+
+TEST_F(pipelined_processor_test, results_are_one_period_behind)
+{
+    alignas(mipp::RequiredAlignment) std::array in_buf{1.f, 2.f, 3.f, 4.f};
+    env.audio_inputs[0] = std::span<float const>(in_buf);
+    env.insert_input_event(0, 0, 2.f);
+
+    sut->process(env.ctx);
+
+    // the input buffer may be reused by the engine
+    in_buf.fill(0.f);
+    env.audio_inputs[0] = 1.f;
+
+    sut->process(env.ctx);
+
+    ASSERT_TRUE(env.audio_results[0].is_span());
+    EXPECT_THAT(
+        env.audio_results[0].span(),
+        testing::ElementsAre(2.f, 4.f, 6.f, 8.f));
+
+    sut->process(env.ctx);
+
+    ASSERT_TRUE(env.audio_results[0].is_constant());
+    EXPECT_FLOAT_EQ(2.f, env.audio_results[0].constant());
+}
+
+TEST_F(pipelined_processor_test, passed_through_inputs_are_copied)
+{
+    alignas(mipp::RequiredAlignment) std::array in_buf1{1.f, 2.f, 3.f, 4.f};
+    alignas(mipp::RequiredAlignment) std::array in_buf2{5.f, 6.f, 7.f, 8.f};
+
+    env.audio_inputs[0] = std::span<float const>(in_buf1);
+    sut->process(env.ctx);
+
+    env.audio_inputs[0] = std::span<float const>(in_buf2);
+    sut->process(env.ctx);
+
+    ASSERT_TRUE(env.audio_results[0].is_span());
+    EXPECT_THAT(
+        env.audio_results[0].span(),
+        testing::ElementsAre(1.f, 2.f, 3.f, 4.f));
+}
+
+TEST_F(pipelined_processor_test, processes_on_another_thread)
+{
+    env.audio_inputs[0] = 1.f;
+
+    sut->process(env.ctx);
+    sut->process(env.ctx);
+
+    EXPECT_NE(std::thread::id{}, process_thread.load());
+    EXPECT_NE(std::this_thread::get_id(), process_thread.load());
+}
+
+} // namespace piejam::audio::engine::test
@@ -0,0 +1,201 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/single_event_input_processor.h>
+
+#include <piejam/audio/engine/event_port.h>
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/processor_test_environment.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace piejam::audio::engine::test
+{
+
+namespace
+{
+
+// Records the calls made by process_sliced.
+class recording_processor final
+    : public named_processor
+    , public single_event_input_processor<recording_processor, float>
+{
+public:
+    explicit recording_processor(
+        event_quantization const quantization = sample_accurate_events)
+        : named_processor{"recording"}
+        , single_event_input_processor{quantization}
+    {
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return "recording";
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return 0;
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return 0;
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        static std::array s_ports{event_port(std::in_place_type<float>, "ev")};
+        return s_ports;
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    void process(process_context const& ctx) override
+    {
+        process_sliced(ctx);
+    }
+
+    void process_buffer(process_context const& ctx)
+    {
+        calls.push_back(std::format("buffer {}", ctx.buffer_size));
+    }
+
+    void process_slice(
+        process_context const&,
+        std::size_t const offset,
+        std::size_t const count)
+    {
+        calls.push_back(std::format("slice {} {}", offset, count));
+    }
+
+    void process_event(process_context const&, event<float> const& ev)
+    {
+        calls.push_back(std::format("event {}", ev.value()));
+    }
+
+    std::vector<std::string> calls;
+};
+
+} // namespace
+
+TEST(single_event_input_processor, no_events_process_the_whole_buffer)
+{
+    recording_processor sut(event_quantization{16});
+    processor_test_environment test_env{sut, 64};
+
+    sut.process(test_env.ctx);
+
+    EXPECT_THAT(sut.calls, testing::ElementsAre("buffer 64"));
+}
+
+TEST(single_event_input_processor, sample_accurate_slices_at_every_event)
+{
+    recording_processor sut;
+    processor_test_environment test_env{sut, 64};
+
+    test_env.insert_input_event(0, 3, 1.f);
+    test_env.insert_input_event(0, 5, 2.f);
+    test_env.insert_input_event(0, 5, 3.f);
+
+    sut.process(test_env.ctx);
+
+    EXPECT_THAT(
+        sut.calls,
+        testing::ElementsAre(
+            "slice 0 3",
+            "event 1",
+            "slice 3 2",
+            "event 2",
+            "event 3",
+            "slice 5 59"));
+}
+
+TEST(single_event_input_processor, quantized_events_are_rounded_down)
+{
+    recording_processor sut(event_quantization{16});
+    processor_test_environment test_env{sut, 64};
+
+    test_env.insert_input_event(0, 20, 1.f);
+    test_env.insert_input_event(0, 47, 2.f);
+
+    sut.process(test_env.ctx);
+
+    EXPECT_THAT(
+        sut.calls,
+        testing::ElementsAre(
+            "slice 0 16",
+            "event 1",
+            "slice 16 16",
+            "event 2",
+            "slice 32 32"));
+}
+
+TEST(single_event_input_processor, quantized_events_on_a_boundary_coalesce)
+{
+    recording_processor sut(event_quantization{16});
+    processor_test_environment test_env{sut, 64};
+
+    test_env.insert_input_event(0, 17, 1.f);
+    test_env.insert_input_event(0, 18, 2.f);
+    test_env.insert_input_event(0, 31, 3.f);
+    test_env.insert_input_event(0, 32, 4.f);
+
+    sut.process(test_env.ctx);
+
+    EXPECT_THAT(
+        sut.calls,
+        testing::ElementsAre(
+            "slice 0 16",
+            "event 3",
+            "slice 16 16",
+            "event 4",
+            "slice 32 32"));
+}
+
+TEST(single_event_input_processor, quantized_events_on_first_boundary)
+{
+    recording_processor sut(event_quantization{16});
+    processor_test_environment test_env{sut, 64};
+
+    test_env.insert_input_event(0, 1, 1.f);
+    test_env.insert_input_event(0, 15, 2.f);
+
+    sut.process(test_env.ctx);
+
+    EXPECT_THAT(sut.calls, testing::ElementsAre("event 2", "buffer 64"));
+}
+
+TEST(single_event_input_processor, quantized_slices_are_bounded)
+{
+    recording_processor sut(control_rate_events);
+    processor_test_environment test_env{sut, 128};
+
+    for (std::size_t offset = 1; offset < 128; ++offset)
+    {
+        test_env.insert_input_event(0, offset, static_cast<float>(offset));
+    }
+
+    sut.process(test_env.ctx);
+
+    EXPECT_EQ(
+        128 / control_rate_events.granularity,
+        static_cast<std::size_t>(
+            std::ranges::count_if(sut.calls, [](std::string const& call) {
+                return call.starts_with("slice");
+            })));
+    EXPECT_EQ("slice 112 16", sut.calls.back());
+}
+
+} // namespace piejam::audio::engine::test
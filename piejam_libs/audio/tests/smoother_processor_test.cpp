@@ -12,11 +12,16 @@
 #include <piejam/audio/engine/processor.h>
 #include <piejam/audio/slice.h>
 
+#include <piejam/numeric/dB_lut.h>
 #include <piejam/numeric/mipp.h>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 namespace piejam::audio::engine::test
 {
 
@@ -345,4 +350,334 @@ TEST_F(smoother_processor_test, smooth_exact_to_exact)
         testing::ElementsAre(0.4f, 0.3f, 0.3f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f));
 }
 
+// The scalar lut walk, one sample per step, to check the generated ramps
+// against.
+auto
+reference_ramp(
+    std::span<float const> const lut,
+    float const current,
+    float const target,
+    std::size_t const size) -> std::vector<float>
+{
+    std::vector<float> ramp;
+
+    if (current < target)
+    {
+        auto it = std::ranges::upper_bound(lut, current);
+        auto const end = std::ranges::upper_bound(lut, target);
+        for (; it != end && ramp.size() < size; ++it)
+        {
+            ramp.push_back(*it);
+        }
+    }
+    else if (target < current)
+    {
+        auto it = std::ranges::upper_bound(
+            lut.rbegin(),
+            lut.rend(),
+            current,
+            std::greater<>{});
+        auto const end = std::ranges::upper_bound(
+            lut.rbegin(),
+            lut.rend(),
+            target,
+            std::greater<>{});
+        for (; it != end && ramp.size() < size; ++it)
+        {
+            ramp.push_back(*it);
+        }
+    }
+
+    ramp.resize(size, target);
+    return ramp;
+}
+
+struct smoother_processor_dB_lut_test : public smoother_processor_test
+{
+    static constexpr std::size_t num_periods{200};
+
+    auto render(processor& sut, float const target) -> std::vector<float>
+    {
+        std::vector<float> rendered;
+
+        ev_in_buf.insert(3, target);
+
+        for (std::size_t period = 0; period < num_periods; ++period)
+        {
+            sut.process(ctx);
+            ev_in_buf.clear();
+
+            if (ctx.results[0].is_constant())
+            {
+                rendered.insert(
+                    rendered.end(),
+                    buffer_size,
+                    ctx.results[0].constant());
+            }
+            else
+            {
+                rendered.insert(
+                    rendered.end(),
+                    ctx.results[0].span().begin(),
+                    ctx.results[0].span().end());
+            }
+        }
+
+        return rendered;
+    }
+
+    std::span<float const> dB_lut{numeric::dB_lut<float, -120.f, 24.f, 1024>};
+};
+
+TEST_F(smoother_processor_dB_lut_test, long_ramp_up_matches_the_lut_walk)
+{
+    float const current = 0.001f;
+    float const target = 8.f;
+    auto sut = make_lut_smoother_processor(dB_lut, current);
+
+    auto const rendered = render(*sut, target);
+
+    auto expected = reference_ramp(
+        dB_lut,
+        current,
+        target,
+        rendered.size() - 3);
+    expected.insert(expected.begin(), 3, current);
+
+    EXPECT_EQ(expected, rendered);
+    EXPECT_EQ(target, rendered.back());
+}
+
+TEST_F(smoother_processor_dB_lut_test, long_ramp_down_matches_the_lut_walk)
+{
+    float const current = 12.f;
+    float const target = 0.f;
+    auto sut = make_lut_smoother_processor(dB_lut, current);
+
+    auto const rendered = render(*sut, target);
+
+    auto expected = reference_ramp(
+        dB_lut,
+        current,
+        target,
+        rendered.size() - 3);
+    expected.insert(expected.begin(), 3, current);
+
+    EXPECT_EQ(expected, rendered);
+    EXPECT_EQ(target, rendered.back());
+}
+
+TEST_F(smoother_processor_test, without_events_result_is_constant)
+{
+    auto sut = make_lut_smoother_processor(lut, 0.27f);
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(ctx.results[0].is_constant());
+    EXPECT_EQ(0.27f, ctx.results[0].constant());
+}
+
+TEST_F(smoother_processor_test, event_with_current_value_result_is_constant)
+{
+    auto sut = make_lut_smoother_processor(lut, 0.27f);
+
+    ev_in_buf.insert(3, 0.27f);
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(ctx.results[0].is_constant());
+    EXPECT_EQ(0.27f, ctx.results[0].constant());
+}
+
+TEST_F(smoother_processor_test, result_is_constant_after_ramp_finished)
+{
+    auto sut = make_lut_smoother_processor(lut, 0.27f);
+
+    ev_in_buf.insert(0, 0.45f);
+    sut->process(ctx);
+    ev_in_buf.clear();
+
+    ASSERT_TRUE(ctx.results[0].is_span());
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(ctx.results[0].is_constant());
+    EXPECT_EQ(0.45f, ctx.results[0].constant());
+}
+
+auto
+at(slice<float> const& s, std::size_t const frame) -> float
+{
+    return s.is_constant() ? s.constant() : s.span()[frame];
+}
+
+struct lut_smoothed_multiply_processor_test : public smoother_processor_test
+{
+    // the same ramp, rendered by a smoother and multiplied separately
+    void expect_smoother_times_input(float const current)
+    {
+        auto smoother = make_lut_smoother_processor(lut, current);
+        auto sut = make_lut_smoothed_multiply_processor(lut, current, 2);
+
+        alignas(mipp::RequiredAlignment)
+            std::array<float, buffer_size> gain_buf{};
+        std::array<std::span<float>, 1> gain_outputs{gain_buf};
+        std::array<slice<float>, 1> gain_results{gain_outputs[0]};
+        smoother->process(
+            {.outputs = gain_outputs,
+             .results = gain_results,
+             .event_inputs = ev_ins,
+             .event_outputs = ev_outs,
+             .buffer_size = buffer_size});
+
+        std::array<std::reference_wrapper<slice<float> const>, 2> inputs{
+            in[0],
+            in[1]};
+        std::array<std::span<float>, 2> outputs{out_bufs[0], out_bufs[1]};
+        std::array<slice<float>, 2> results{outputs[0], outputs[1]};
+        sut->process(
+            {.inputs = inputs,
+             .outputs = outputs,
+             .results = results,
+             .event_inputs = ev_ins,
+             .event_outputs = ev_outs,
+             .buffer_size = buffer_size});
+
+        for (std::size_t ch = 0; ch < 2; ++ch)
+        {
+            for (std::size_t frame = 0; frame < buffer_size; ++frame)
+            {
+                EXPECT_FLOAT_EQ(
+                    at(gain_results[0], frame) * at(in[ch], frame),
+                    at(results[ch], frame));
+            }
+        }
+    }
+
+    alignas(mipp::RequiredAlignment) std::array<float, buffer_size> in_buf{
+        .1f,
+        -.2f,
+        .3f,
+        -.4f,
+        .5f,
+        -.6f,
+        .7f,
+        -.8f};
+    std::array<slice<float>, 2> in{slice<float>(in_buf), slice<float>(.5f)};
+    alignas(mipp::RequiredAlignment)
+        std::array<std::array<float, buffer_size>, 2> out_bufs{};
+};
+
+TEST_F(lut_smoothed_multiply_processor_test, smooth_up)
+{
+    ev_in_buf.insert(0, 0.75f);
+
+    expect_smoother_times_input(0.27f);
+}
+
+TEST_F(lut_smoothed_multiply_processor_test, smooth_down_mid_buffer)
+{
+    ev_in_buf.insert(3, 0.27f);
+
+    expect_smoother_times_input(0.77f);
+}
+
+TEST_F(lut_smoothed_multiply_processor_test, smooth_up_and_down)
+{
+    ev_in_buf.insert(1, 0.75f);
+    ev_in_buf.insert(5, 0.27f);
+
+    expect_smoother_times_input(0.5f);
+}
+
+TEST_F(lut_smoothed_multiply_processor_test, short_ramp_inside_entry)
+{
+    ev_in_buf.insert(2, 0.28f);
+
+    expect_smoother_times_input(0.27f);
+}
+
+TEST_F(lut_smoothed_multiply_processor_test, without_events)
+{
+    expect_smoother_times_input(0.27f);
+}
+
+TEST_F(
+    lut_smoothed_multiply_processor_test,
+    unity_gain_will_point_to_the_input)
+{
+    auto sut = make_lut_smoothed_multiply_processor(lut, 1.f, 1);
+
+    std::array<std::reference_wrapper<slice<float> const>, 1> inputs{in[0]};
+    std::array<std::span<float>, 1> outputs{out_bufs[0]};
+    std::array<slice<float>, 1> results{outputs[0]};
+    sut->process(
+        {.inputs = inputs,
+         .outputs = outputs,
+         .results = results,
+         .event_inputs = ev_ins,
+         .event_outputs = ev_outs,
+         .buffer_size = buffer_size});
+
+    ASSERT_TRUE(results[0].is_span());
+    EXPECT_EQ(in_buf.data(), results[0].span().data());
+}
+
+TEST_F(lut_smoothed_multiply_processor_test, zero_gain_results_in_silence)
+{
+    auto sut = make_lut_smoothed_multiply_processor(lut, 0.f, 1);
+
+    ev_in_buf.insert(5, 0.f);
+
+    std::array<std::reference_wrapper<slice<float> const>, 1> inputs{in[0]};
+    std::array<std::span<float>, 1> outputs{out_bufs[0]};
+    std::array<slice<float>, 1> results{outputs[0]};
+    sut->process(
+        {.inputs = inputs,
+         .outputs = outputs,
+         .results = results,
+         .event_inputs = ev_ins,
+         .event_outputs = ev_outs,
+         .buffer_size = buffer_size});
+
+    ASSERT_TRUE(results[0].is_constant());
+    EXPECT_EQ(0.f, results[0].constant());
+}
+
+TEST_F(lut_smoothed_multiply_processor_test, gain_processor_continues_ramp)
+{
+    auto multiply = make_lut_smoothed_multiply_processor(lut, 0.27f, 1);
+    auto sut = make_lut_smoothed_gain_processor(*multiply);
+
+    ev_in_buf.insert(4, 0.75f);
+
+    std::array<std::reference_wrapper<slice<float> const>, 1> inputs{in[1]};
+    std::array<std::span<float>, 1> mul_outputs{out_bufs[0]};
+    std::array<slice<float>, 1> mul_results{mul_outputs[0]};
+    multiply->process(
+        {.inputs = inputs,
+         .outputs = mul_outputs,
+         .results = mul_results,
+         .event_inputs = ev_ins,
+         .event_outputs = ev_outs,
+         .buffer_size = buffer_size});
+
+    ev_in_buf.clear();
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(ctx.results[0].is_span());
+    EXPECT_THAT(
+        ctx.results[0].span(),
+        testing::ElementsAre(
+            0.7f,
+            0.75f,
+            0.75f,
+            0.75f,
+            0.75f,
+            0.75f,
+            0.75f,
+            0.75f));
+}
+
 } // namespace piejam::audio::engine::test
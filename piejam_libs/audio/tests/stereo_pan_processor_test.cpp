@@ -0,0 +1,135 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/stereo_pan_processor.h>
+
+#include <piejam/audio/dsp/pan.h>
+#include <piejam/audio/engine/processor.h>
+#include <piejam/audio/engine/processor_test_environment.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace piejam::audio::engine::test
+{
+
+TEST(stereo_pan_processor, constant_input_without_events)
+{
+    auto sut = make_stereo_pan_processor();
+    processor_test_environment test_env{*sut, 64};
+    test_env.audio_inputs[0] = slice<float>(1.f);
+
+    sut->process(test_env.ctx);
+
+    auto const gains = dsp::sinusoidal_constant_power_pan(0.f);
+    ASSERT_TRUE(test_env.audio_results[0].is_constant());
+    ASSERT_TRUE(test_env.audio_results[1].is_constant());
+    EXPECT_FLOAT_EQ(gains.left, test_env.audio_results[0].constant());
+    EXPECT_FLOAT_EQ(gains.right, test_env.audio_results[1].constant());
+}
+
+TEST(stereo_pan_processor, static_gains_are_folded_into_the_results)
+{
+    auto sut = make_stereo_pan_processor();
+    processor_test_environment test_env{*sut, 64};
+    std::vector<float> in_buf(64, .5f);
+    test_env.audio_inputs[0] = slice<float>(in_buf);
+    float const in_factor{2.f};
+    std::array<std::reference_wrapper<float const>, 1> input_factors{
+        in_factor};
+    std::array result_factors{1.f, 1.f};
+    test_env.ctx.input_factors = input_factors;
+    test_env.ctx.result_factors = result_factors;
+
+    sut->process(test_env.ctx);
+
+    auto const gains = dsp::sinusoidal_constant_power_pan(0.f);
+    ASSERT_TRUE(test_env.audio_results[0].is_span());
+    ASSERT_TRUE(test_env.audio_results[1].is_span());
+    EXPECT_EQ(in_buf.data(), test_env.audio_results[0].span().data());
+    EXPECT_EQ(in_buf.data(), test_env.audio_results[1].span().data());
+    EXPECT_FLOAT_EQ(2.f * gains.left, result_factors[0]);
+    EXPECT_FLOAT_EQ(2.f * gains.right, result_factors[1]);
+}
+
+TEST(stereo_pan_processor, pan_event_ramps_along_the_pan_law)
+{
+    auto sut = make_stereo_pan_processor();
+    processor_test_environment test_env{*sut, 1024};
+    test_env.audio_inputs[0] = slice<float>(1.f);
+    test_env.insert_input_event(0, 0, 0.f);
+    test_env.insert_input_event(0, 3, 1.f);
+
+    sut->process(test_env.ctx);
+
+    ASSERT_TRUE(test_env.audio_results[0].is_span());
+    ASSERT_TRUE(test_env.audio_results[1].is_span());
+    auto const out_l = test_env.audio_results[0].span();
+    auto const out_r = test_env.audio_results[1].span();
+
+    auto const start = dsp::sinusoidal_constant_power_pan(0.f);
+    EXPECT_FLOAT_EQ(start.left, out_l[0]);
+    EXPECT_FLOAT_EQ(start.right, out_r[2]);
+
+    // halfway through the ramp
+    auto const half = dsp::sinusoidal_constant_power_pan(.5f);
+    EXPECT_NEAR(half.left, out_l[3 + 255], 1e-5f);
+    EXPECT_NEAR(half.right, out_r[3 + 255], 1e-5f);
+
+    auto const end = dsp::sinusoidal_constant_power_pan(1.f);
+    for (std::size_t i = 3 + 511; i < 1024; ++i)
+    {
+        EXPECT_FLOAT_EQ(end.left, out_l[i]);
+        EXPECT_FLOAT_EQ(end.right, out_r[i]);
+    }
+}
+
+TEST(stereo_pan_processor, balance_and_gain_events)
+{
+    auto sut = make_stereo_balance_processor();
+    processor_test_environment test_env{*sut, 1024};
+    test_env.audio_inputs[0] = slice<float>(1.f);
+    test_env.audio_inputs[1] = slice<float>(.5f);
+    test_env.insert_input_event(0, 0, -.5f);
+    test_env.insert_input_event(1, 0, .5f);
+
+    sut->process(test_env.ctx);
+
+    ASSERT_TRUE(test_env.audio_results[0].is_span());
+    ASSERT_TRUE(test_env.audio_results[1].is_span());
+    auto const out_l = test_env.audio_results[0].span();
+    auto const out_r = test_env.audio_results[1].span();
+
+    auto const end = dsp::stereo_balance(-.5f);
+    for (std::size_t i = 511; i < 1024; ++i)
+    {
+        EXPECT_FLOAT_EQ(.5f * end.left, out_l[i]);
+        EXPECT_FLOAT_EQ(.5f * .5f * end.right, out_r[i]);
+    }
+}
+
+TEST(stereo_pan_processor, first_events_are_taken_over_without_ramp)
+{
+    auto sut = make_stereo_pan_processor();
+    processor_test_environment test_env{*sut, 64};
+    test_env.audio_inputs[0] = slice<float>(1.f);
+    test_env.insert_input_event(0, 0, -1.f);
+    test_env.insert_input_event(1, 0, .5f);
+
+    sut->process(test_env.ctx);
+
+    auto const gains = dsp::sinusoidal_constant_power_pan(-1.f);
+    ASSERT_TRUE(test_env.audio_results[0].is_span());
+    ASSERT_TRUE(test_env.audio_results[1].is_span());
+    for (std::size_t i = 0; i < 64; ++i)
+    {
+        EXPECT_FLOAT_EQ(.5f * gains.left, test_env.audio_results[0].span()[i]);
+        EXPECT_FLOAT_EQ(.5f * gains.right, test_env.audio_results[1].span()[i]);
+    }
+}
+
+} // namespace piejam::audio::engine::test
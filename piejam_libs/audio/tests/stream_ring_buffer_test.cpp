@@ -86,6 +86,27 @@ TEST(stream_ring_buffer, consume_multi_channel)
         testing::ElementsAre(23.f, 23.f, 23.f, 23.f));
 }
 
+TEST(stream_ring_buffer, consume_only_up_to_max_frames)
+{
+    stream_ring_buffer<float> buf(1, 6);
+
+    std::array ch0_data{0.f, 1.f, 2.f, 3.f};
+    slice<float> slice0{ch0_data};
+
+    std::array inputs{std::cref(slice0)};
+
+    ASSERT_EQ(4u, buf.write(inputs, 4));
+    ASSERT_EQ(2u, buf.write(inputs, 2));
+
+    EXPECT_THAT(
+        buf.consume(3).channels()[0],
+        testing::ElementsAre(0.f, 1.f, 2.f));
+    EXPECT_THAT(
+        buf.consume(2).channels()[0],
+        testing::ElementsAre(3.f, 0.f));
+    EXPECT_THAT(buf.consume().channels()[0], testing::ElementsAre(1.f));
+}
+
 TEST(stream_ring_buffer, consume_on_border_will_call_the_functor_twice)
 {
     stream_ring_buffer<float> buf(2, 6);
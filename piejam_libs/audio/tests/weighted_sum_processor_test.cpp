@@ -0,0 +1,265 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/weighted_sum_processor.h>
+
+#include <piejam/audio/engine/event_input_buffers.h>
+#include <piejam/audio/engine/event_output_buffers.h>
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/engine/processor.h>
+#include <piejam/audio/slice.h>
+
+#include <mipp.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::engine::test
+{
+
+struct weighted_sum_processor_2_terms : public ::testing::Test
+{
+    constexpr static auto const buffer_size = 8;
+    slice<float> x1;
+    slice<float> g1;
+    slice<float> x2;
+    slice<float> g2;
+    std::array<std::reference_wrapper<slice<float> const>, 4> inputs{
+        x1,
+        g1,
+        x2,
+        g2};
+    alignas(mipp::RequiredAlignment) std::array<float, buffer_size> out_buf{};
+    std::array<std::span<float>, 1> outputs{out_buf};
+    std::array<slice<float>, 1> results{outputs[0]};
+    event_input_buffers ev_ins;
+    event_output_buffers ev_outs{};
+    process_context ctx{inputs, outputs, results, ev_ins, ev_outs, buffer_size};
+
+    alignas(mipp::RequiredAlignment)
+        std::array<float, buffer_size> x1_buf{.1f, .2f, .3f, .4f, .5f, .6f};
+    alignas(mipp::RequiredAlignment)
+        std::array<float, buffer_size> x2_buf{.9f, .8f, .7f, .6f, .5f, .4f};
+    alignas(mipp::RequiredAlignment)
+        std::array<float, buffer_size> g_buf{1.f, .9f, .8f, .7f, .6f, .5f};
+
+    std::unique_ptr<processor> sut{make_weighted_sum_processor(2)};
+};
+
+TEST_F(weighted_sum_processor_2_terms, constants_result_in_constant)
+{
+    x1 = {.5f};
+    g1 = {.25f};
+    x2 = {.2f};
+    g2 = {2.f};
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(results[0].is_constant());
+    EXPECT_FLOAT_EQ(.5f * .25f + .2f * 2.f, results[0].constant());
+}
+
+TEST_F(weighted_sum_processor_2_terms, silent_terms_result_in_silence)
+{
+    x1 = {x1_buf};
+    x2 = {x2_buf};
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(results[0].is_constant());
+    EXPECT_FLOAT_EQ(0.f, results[0].constant());
+}
+
+TEST_F(
+    weighted_sum_processor_2_terms,
+    single_buffer_with_unity_gain_will_point_to_the_input_buffer)
+{
+    x1 = {x1_buf};
+    g1 = {1.f};
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(results[0].is_span());
+    EXPECT_EQ(x1_buf.data(), results[0].span().data());
+    EXPECT_EQ(x1_buf.size(), results[0].span().size());
+}
+
+TEST_F(
+    weighted_sum_processor_2_terms,
+    input_factors_are_applied_to_the_terms)
+{
+    float const x1_factor{.5f};
+    float const g2_factor{4.f};
+    float const unit{1.f};
+    std::array<std::reference_wrapper<float const>, 4> factors{
+        x1_factor,
+        unit,
+        unit,
+        g2_factor};
+    ctx.input_factors = factors;
+
+    x1 = {x1_buf};
+    g1 = {.5f};
+    x2 = {x2_buf};
+    g2 = {g_buf};
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(results[0].is_span());
+    for (std::size_t i = 0; i < buffer_size; ++i)
+    {
+        EXPECT_FLOAT_EQ(
+            x1_buf[i] * .5f * .5f + x2_buf[i] * g_buf[i] * 4.f,
+            out_buf[i]);
+    }
+}
+
+TEST_F(
+    weighted_sum_processor_2_terms,
+    single_scaled_buffer_is_folded_if_the_result_may_be_folded)
+{
+    float const x1_factor{.5f};
+    float const unit{1.f};
+    std::array<std::reference_wrapper<float const>, 4> factors{
+        x1_factor,
+        unit,
+        unit,
+        unit};
+    ctx.input_factors = factors;
+    std::array result_factors{1.f};
+    ctx.result_factors = result_factors;
+
+    x1 = {x1_buf};
+    g1 = {.5f};
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(results[0].is_span());
+    EXPECT_EQ(x1_buf.data(), results[0].span().data());
+    EXPECT_FLOAT_EQ(.25f, result_factors[0]);
+}
+
+TEST_F(
+    weighted_sum_processor_2_terms,
+    buffers_with_constant_gains_are_summed_into_the_output)
+{
+    x1 = {x1_buf};
+    g1 = {.5f};
+    x2 = {x2_buf};
+    g2 = {.25f};
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(results[0].is_span());
+    ASSERT_EQ(out_buf.data(), results[0].span().data());
+    for (std::size_t i = 0; i < buffer_size; ++i)
+    {
+        EXPECT_FLOAT_EQ(x1_buf[i] * .5f + x2_buf[i] * .25f, out_buf[i]);
+    }
+}
+
+TEST_F(
+    weighted_sum_processor_2_terms,
+    gain_may_be_either_factor_and_a_buffer)
+{
+    g1 = {.5f};
+    x1 = {x1_buf};
+    x2 = {x2_buf};
+    g2 = {g_buf};
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(results[0].is_span());
+    for (std::size_t i = 0; i < buffer_size; ++i)
+    {
+        EXPECT_FLOAT_EQ(x1_buf[i] * .5f + x2_buf[i] * g_buf[i], out_buf[i]);
+    }
+}
+
+TEST_F(weighted_sum_processor_2_terms, constant_term_is_added_as_offset)
+{
+    x1 = {x1_buf};
+    g1 = {g_buf};
+    x2 = {.5f};
+    g2 = {.5f};
+
+    sut->process(ctx);
+
+    ASSERT_TRUE(results[0].is_span());
+    for (std::size_t i = 0; i < buffer_size; ++i)
+    {
+        EXPECT_FLOAT_EQ(x1_buf[i] * g_buf[i] + .25f, out_buf[i]);
+    }
+}
+
+TEST(weighted_sum_processor, sum_of_nine_terms)
+{
+    auto sut = make_weighted_sum_processor(9);
+
+    constexpr auto buffer_size = 8u;
+
+    alignas(mipp::RequiredAlignment) std::array<float, buffer_size> in_buf;
+    in_buf.fill(0.23f);
+    slice<float> const in_buf_slice(in_buf);
+    slice<float> const gain(0.5f);
+
+    std::vector<std::reference_wrapper<slice<float> const>> in;
+    for (std::size_t term = 0; term < 9; ++term)
+    {
+        in.emplace_back(in_buf_slice);
+        in.emplace_back(term % 2 ? gain : in_buf_slice);
+    }
+
+    alignas(mipp::RequiredAlignment) std::array<float, buffer_size> out_buf{};
+    std::vector<std::span<float>> out{out_buf};
+    std::vector<slice<float>> result{out[0]};
+
+    sut->process({in, out, result, {}, {}, buffer_size});
+
+    ASSERT_TRUE(result[0].is_span());
+    for (auto const v : result[0].span())
+    {
+        EXPECT_FLOAT_EQ(5 * 0.23f * 0.23f + 4 * 0.23f * 0.5f, v);
+    }
+}
+
+struct weighted_sum_processor_properties_test
+    : ::testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(weighted_sum_processor_properties_test, is_weighted_sum_processor)
+{
+    EXPECT_TRUE(
+        is_weighted_sum_processor(*make_weighted_sum_processor(GetParam())));
+}
+
+TEST_P(weighted_sum_processor_properties_test, num_inputs)
+{
+    EXPECT_EQ(
+        2 * GetParam(),
+        make_weighted_sum_processor(GetParam())->num_inputs());
+}
+
+TEST_P(weighted_sum_processor_properties_test, num_outputs)
+{
+    EXPECT_EQ(1u, make_weighted_sum_processor(GetParam())->num_outputs());
+}
+
+TEST_P(weighted_sum_processor_properties_test, event_ports)
+{
+    auto sut = make_weighted_sum_processor(GetParam());
+    EXPECT_TRUE(sut->event_inputs().empty());
+    EXPECT_TRUE(sut->event_outputs().empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    verify,
+    weighted_sum_processor_properties_test,
+    testing::Range<std::size_t>(1u, 10u));
+
+} // namespace piejam::audio::engine::test
@@ -0,0 +1,98 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+import QtQuick.Controls.Material 2.15
+import QtQuick.Layouts 1.15
+
+import PieJam.Controls 1.0
+import PieJam.Dialogs 1.0
+import PieJam.FxChainControls 1.0
+import PieJam.FxModules.Models 1.0 as PJFxModels
+import PieJam.ParameterControls 1.0
+
+SubscribableItem {
+    id: root
+
+    property PJFxModels.FxFilePlayer model: null
+
+    property bool active: true
+
+    implicitWidth: 636
+
+    RowLayout {
+        anchors.fill: parent
+
+        ColumnLayout {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+
+            Label {
+                Layout.fillWidth: true
+
+                text: root.model && root.model.fileName !== "" ? root.model.fileName : "--"
+
+                font.pixelSize: 24
+                font.bold: true
+                elide: Text.ElideMiddle
+                horizontalAlignment: Qt.AlignHCenter
+            }
+
+            RowLayout {
+                Layout.alignment: Qt.AlignHCenter
+
+                Button {
+                    Layout.preferredWidth: 96
+                    Layout.preferredHeight: 48
+
+                    text: qsTr("Open")
+
+                    onClicked: openFileDialog.open()
+                }
+
+                ParameterToggleButton {
+                    Layout.preferredWidth: 96
+                    Layout.preferredHeight: 48
+
+                    model: root.model ? root.model.play : null
+
+                    text: qsTr("Play")
+                    Material.accent: Material.Green
+                }
+
+                ParameterToggleButton {
+                    Layout.preferredWidth: 96
+                    Layout.preferredHeight: 48
+
+                    model: root.model ? root.model.loop : null
+
+                    text: qsTr("Loop")
+                }
+            }
+
+            Item {
+                Layout.fillHeight: true
+            }
+        }
+
+        ParameterControl {
+            Layout.fillHeight: true
+
+            paramModel: root.model ? root.model.gain : null
+        }
+    }
+
+    OpenFileDialog {
+        id: openFileDialog
+
+        model: root.model ? root.model.fileDialog : null
+        title: qsTr("Open File")
+
+        onSelected: {
+            root.model.loadFile(openFileDialog.selectedPath)
+            openFileDialog.resetSelection()
+        }
+    }
+}
@@ -79,26 +79,38 @@ public:
         using namespace audio::engine::endpoint_ports;
         engine::connect_event(
             g,
-            *m_mute_left_param_proc,
+            *m_pan_left_param_proc,
             from<0>,
             *m_left_pan,
             to<0>);
         engine::connect_event(
             g,
-            *m_pan_left_param_proc,
+            *m_mute_left_param_proc,
+            from<0>,
+            *m_left_mute_gain_proc,
+            to<0>);
+        engine::connect_event(
+            g,
+            *m_left_mute_gain_proc,
             from<0>,
             *m_left_pan,
             to<1>);
 
         engine::connect_event(
             g,
-            *m_mute_right_param_proc,
+            *m_pan_right_param_proc,
             from<0>,
             *m_right_pan,
             to<0>);
         engine::connect_event(
             g,
-            *m_pan_right_param_proc,
+            *m_mute_right_param_proc,
+            from<0>,
+            *m_right_mute_gain_proc,
+            to<0>);
+        engine::connect_event(
+            g,
+            *m_right_mute_gain_proc,
             from<0>,
             *m_right_pan,
             to<1>);
@@ -115,14 +127,14 @@ private:
     std::shared_ptr<audio::engine::processor> m_mute_right_param_proc;
     std::shared_ptr<audio::engine::processor> m_pan_left_param_proc;
     std::shared_ptr<audio::engine::processor> m_pan_right_param_proc;
+    std::unique_ptr<audio::engine::processor> m_left_mute_gain_proc{
+        audio::engine::make_mute_gain_processor("left_pan")};
+    std::unique_ptr<audio::engine::processor> m_right_mute_gain_proc{
+        audio::engine::make_mute_gain_processor("right_pan")};
     std::unique_ptr<audio::engine::component> m_left_pan{
-        audio::components::make_pan(
-            audio::engine::make_mute_pan_processor("left_pan"),
-            "left_pan")};
+        audio::components::make_pan("left_pan")};
     std::unique_ptr<audio::engine::component> m_right_pan{
-        audio::components::make_pan(
-            audio::engine::make_mute_pan_processor("right_pan"),
-            "right_pan")};
+        audio::components::make_pan("right_pan")};
     std::array<audio::engine::graph_endpoint, 2> const m_inputs{
         audio::engine::in_endpoint(*m_left_pan, 0),
         audio::engine::in_endpoint(*m_right_pan, 0)};
@@ -0,0 +1,152 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "file_player_component.h"
+
+#include "file_player_module.h"
+#include "file_player_processor.h"
+#include "prefetch_stream.h"
+#include "prefetcher.h"
+
+#include <piejam/audio/components/amplifier.h>
+#include <piejam/audio/engine/component.h>
+#include <piejam/audio/engine/graph.h>
+#include <piejam/audio/engine/graph_generic_algorithms.h>
+#include <piejam/audio/engine/mix_processor.h>
+#include <piejam/audio/types.h>
+#include <piejam/runtime/fx/module.h>
+#include <piejam/runtime/internal_fx_component_factory.h>
+#include <piejam/runtime/parameter/map.h>
+#include <piejam/runtime/parameter_processor_factory.h>
+
+#include <format>
+#include <vector>
+
+namespace piejam::fx_modules::file_player
+{
+
+namespace
+{
+
+// The played file is mixed to the input signal.
+class component final : public audio::engine::component
+{
+public:
+    component(
+        runtime::fx::module const& fx_mod,
+        std::shared_ptr<prefetch_stream> stream,
+        runtime::parameter_processor_factory& proc_factory,
+        std::string_view const name)
+        : m_play_param_proc{proc_factory.find_or_make_processor(
+              fx_mod.parameters->at(parameter_key::play),
+              std::format("file_player_play {}", name))}
+        , m_loop_param_proc{proc_factory.find_or_make_processor(
+              fx_mod.parameters->at(parameter_key::loop),
+              std::format("file_player_loop {}", name))}
+        , m_gain_param_proc{proc_factory.find_or_make_processor(
+              fx_mod.parameters->at(parameter_key::gain),
+              std::format("file_player_gain {}", name))}
+        , m_amplifier{audio::components::make_amplifier(
+              stream->num_channels(),
+              std::format("file_player {}", name))}
+        , m_player{make_file_player_processor(
+              std::move(stream),
+              std::format("file_player {}", name))}
+    {
+        for (std::size_t ch = 0; ch < m_player->num_outputs(); ++ch)
+        {
+            auto& mix_proc = m_mix_procs.emplace_back(
+                audio::engine::make_mix_processor(
+                    2,
+                    std::format("file_player {}", name)));
+
+            m_inputs.push_back(audio::engine::in_endpoint(*mix_proc, 0));
+            m_outputs.push_back(audio::engine::out_endpoint(*mix_proc, 0));
+        }
+    }
+
+    auto inputs() const -> endpoints override
+    {
+        return m_inputs;
+    }
+
+    auto outputs() const -> endpoints override
+    {
+        return m_outputs;
+    }
+
+    auto event_inputs() const -> endpoints override
+    {
+        return {};
+    }
+
+    auto event_outputs() const -> endpoints override
+    {
+        return {};
+    }
+
+    void connect(audio::engine::graph& g) const override
+    {
+        using namespace audio::engine::endpoint_ports;
+
+        m_amplifier->connect(g);
+
+        audio::engine::connect_event(
+            g,
+            *m_play_param_proc,
+            from<0>,
+            *m_player,
+            to<0>);
+
+        audio::engine::connect_event(
+            g,
+            *m_loop_param_proc,
+            from<0>,
+            *m_player,
+            to<1>);
+
+        audio::engine::connect_event(
+            g,
+            *m_gain_param_proc,
+            from<0>,
+            *m_amplifier,
+            to<0>);
+
+        audio::engine::connect(g, *m_player, *m_amplifier);
+
+        for (std::size_t ch = 0; ch < m_mix_procs.size(); ++ch)
+        {
+            g.audio.insert(
+                audio::engine::out_endpoint(*m_amplifier, ch),
+                audio::engine::in_endpoint(*m_mix_procs[ch], 1));
+        }
+    }
+
+private:
+    std::shared_ptr<audio::engine::processor> m_play_param_proc;
+    std::shared_ptr<audio::engine::processor> m_loop_param_proc;
+    std::shared_ptr<audio::engine::processor> m_gain_param_proc;
+    std::unique_ptr<audio::engine::component> m_amplifier;
+    std::unique_ptr<audio::engine::processor> m_player;
+    std::vector<std::unique_ptr<audio::engine::processor>> m_mix_procs;
+    std::vector<audio::engine::graph_endpoint> m_inputs;
+    std::vector<audio::engine::graph_endpoint> m_outputs;
+};
+
+} // namespace
+
+auto
+make_component(runtime::internal_fx_component_factory_args const& args)
+    -> std::unique_ptr<audio::engine::component>
+{
+    return std::make_unique<component>(
+        args.fx_mod,
+        find_or_make_stream(
+            args.fx_mod_id,
+            audio::num_channels(args.fx_mod.bus_type)),
+        args.param_procs,
+        args.name);
+}
+
+} // namespace piejam::fx_modules::file_player
@@ -0,0 +1,46 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "file_player_internal_id.h"
+
+#include "file_player_component.h"
+#include "file_player_module.h"
+#include "gui/FxFilePlayer.h"
+
+#include "../module_registration.h"
+
+namespace piejam::fx_modules::file_player
+{
+
+void
+init()
+{
+    static std::once_flag s_init;
+    std::call_once(s_init, []() {
+        PIEJAM_FX_MODULES_MODEL(gui::FxFilePlayer, "FxFilePlayer");
+        internal_id();
+    });
+}
+
+auto
+internal_id() -> runtime::fx::internal_id
+{
+    using namespace std::string_literals;
+
+    static auto const id = register_module(
+        module_registration{
+            .available_for_mono = true,
+            .persistence_name = "file_player"s,
+            .fx_module_factory = &make_module,
+            .fx_component_factory = &make_component,
+            .fx_browser_entry_name = "File Player",
+            .fx_browser_entry_description =
+                "Play back a recording or a backing track.",
+            .fx_module_content_factory =
+                &piejam::gui::model::makeFxModule<gui::FxFilePlayer>,
+            .viewSource = "/PieJam/FxModules/FilePlayerView.qml"});
+    return id;
+}
+
+} // namespace piejam::fx_modules::file_player
@@ -0,0 +1,152 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "file_player_processor.h"
+
+#include "prefetch_stream.h"
+
+#include <piejam/audio/engine/event_input_buffers.h>
+#include <piejam/audio/engine/event_port.h>
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/engine/single_event_input_processor.h>
+#include <piejam/audio/slice.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace piejam::fx_modules::file_player
+{
+
+namespace
+{
+
+class file_player_processor final
+    : public audio::engine::named_processor
+    , public audio::engine::
+          single_event_input_processor<file_player_processor, bool>
+{
+public:
+    file_player_processor(
+        std::shared_ptr<prefetch_stream> stream,
+        std::string_view const name)
+        : named_processor{name}
+        , m_stream{std::move(stream)}
+    {
+        BOOST_ASSERT(m_stream);
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return "file_player";
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return 0;
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return m_stream->num_channels();
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        static std::array const s_ports{
+            audio::engine::event_port(std::in_place_type<bool>, "play"),
+            audio::engine::event_port(std::in_place_type<bool>, "loop")};
+        return s_ports;
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    void process(audio::engine::process_context const& ctx) override
+    {
+        for (auto const& ev : ctx.event_inputs.get<bool>(1))
+        {
+            m_stream->set_loop(ev.value());
+        }
+
+        if (!m_playing && ctx.event_inputs.get<bool>(0).empty())
+        {
+            m_stream->skip_stale();
+            std::ranges::fill(ctx.results, 0.f);
+            return;
+        }
+
+        std::ranges::copy(ctx.outputs, ctx.results.begin());
+
+        process_sliced(ctx);
+    }
+
+    void process_buffer(audio::engine::process_context const& ctx)
+    {
+        process_slice(ctx, 0, ctx.buffer_size);
+    }
+
+    void process_slice(
+        audio::engine::process_context const& ctx,
+        std::size_t const offset,
+        std::size_t const count)
+    {
+        std::size_t const read =
+            m_playing ? m_stream->read(ctx.outputs, offset, count) : 0;
+
+        if (read < count)
+        {
+            for (std::span<float> const out : ctx.outputs)
+            {
+                std::fill_n(
+                    std::next(out.begin(), offset + read),
+                    count - read,
+                    0.f);
+            }
+        }
+
+        if (m_playing && m_stream->at_end())
+        {
+            m_playing = false;
+            m_stream->cue();
+        }
+    }
+
+    void process_event(
+        audio::engine::process_context const&,
+        audio::engine::event<bool> const& ev)
+    {
+        if (ev.value() == m_playing)
+        {
+            return;
+        }
+
+        m_playing = ev.value();
+
+        if (!m_playing)
+        {
+            m_stream->cue();
+        }
+    }
+
+private:
+    std::shared_ptr<prefetch_stream> m_stream;
+    bool m_playing{};
+};
+
+} // namespace
+
+auto
+make_file_player_processor(
+    std::shared_ptr<prefetch_stream> stream,
+    std::string_view const name) -> std::unique_ptr<audio::engine::processor>
+{
+    return std::make_unique<file_player_processor>(std::move(stream), name);
+}
+
+} // namespace piejam::fx_modules::file_player
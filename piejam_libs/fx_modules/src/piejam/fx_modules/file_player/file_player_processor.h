@@ -0,0 +1,26 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/engine/fwd.h>
+
+#include <memory>
+#include <string_view>
+
+namespace piejam::fx_modules::file_player
+{
+
+class prefetch_stream;
+
+// audio out: num_channels of the stream
+// event in: play, loop
+//
+// Playback starts on play and rewinds on stop. At the end of the file it
+// stops until play is toggled.
+auto make_file_player_processor(
+    std::shared_ptr<prefetch_stream>,
+    std::string_view name = {}) -> std::unique_ptr<audio::engine::processor>;
+
+} // namespace piejam::fx_modules::file_player
@@ -0,0 +1,470 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "file_source.h"
+
+#include <piejam/audio/pcm_convert.h>
+#include <piejam/audio/pcm_sample_type.h>
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <sndfile.hh>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace piejam::fx_modules::file_player
+{
+
+namespace
+{
+
+// The kernel is asked to read this far ahead of the prefetch position.
+constexpr std::size_t read_ahead_size{4 * 1024 * 1024};
+
+// The format and the start of the sample data are expected within the
+// beginning of the file, other files are read with libsndfile.
+constexpr std::size_t max_header_size{64 * 1024};
+
+enum class sample_format
+{
+    s16,
+    s24,
+    s32,
+    f32,
+};
+
+struct wave_layout
+{
+    sample_format format{};
+    std::size_t num_channels{};
+    audio::sample_rate sample_rate;
+    std::size_t bytes_per_frame{};
+    std::size_t data_offset{};
+    std::size_t num_frames{};
+};
+
+auto
+to_sample_format(std::uint16_t const format_tag, std::uint16_t const bits)
+    -> std::optional<sample_format>
+{
+    constexpr std::uint16_t pcm{0x0001};
+    constexpr std::uint16_t ieee_float{0x0003};
+
+    if (format_tag == pcm)
+    {
+        switch (bits)
+        {
+            case 16:
+                return sample_format::s16;
+            case 24:
+                return sample_format::s24;
+            case 32:
+                return sample_format::s32;
+            default:
+                return std::nullopt;
+        }
+    }
+
+    if (format_tag == ieee_float && bits == 32)
+    {
+        return sample_format::f32;
+    }
+
+    return std::nullopt;
+}
+
+// Finds the format and the sample data of a RIFF or RF64 wave file in its
+// header. The data size is cut to the file size, so the part of an
+// interrupted recording, which was committed, can be played back.
+auto
+parse_wave(
+    std::span<unsigned char const> const header,
+    std::size_t const file_size) -> std::optional<wave_layout>
+{
+    BOOST_ASSERT(header.size() <= file_size);
+
+    auto const tag_at = [header](std::size_t const pos) {
+        return std::string_view{
+            reinterpret_cast<char const*>(header.data()) + pos,
+            4};
+    };
+
+    if (header.size() < 12 ||
+        (tag_at(0) != "RIFF" && tag_at(0) != "RF64") || tag_at(8) != "WAVE")
+    {
+        return std::nullopt;
+    }
+
+    bool const rf64 = tag_at(0) == "RF64";
+    std::optional<std::uint64_t> ds64_data_size;
+    std::optional<sample_format> format;
+    std::uint16_t num_channels{};
+    std::uint32_t sample_rate{};
+    std::uint16_t block_align{};
+
+    std::size_t pos{12};
+    while (pos + 8 <= header.size())
+    {
+        auto const id = tag_at(pos);
+        std::uint64_t size = boost::endian::load_little_u32(&header[pos + 4]);
+        std::size_t const body = pos + 8;
+        std::size_t const available = header.size() - body;
+
+        if (id == "ds64" && size >= 24 && available >= 24)
+        {
+            ds64_data_size = boost::endian::load_little_u64(&header[body + 8]);
+        }
+        else if (id == "fmt " && size >= 16 && available >= 16)
+        {
+            std::uint16_t format_tag =
+                boost::endian::load_little_u16(&header[body]);
+            num_channels = boost::endian::load_little_u16(&header[body + 2]);
+            sample_rate = boost::endian::load_little_u32(&header[body + 4]);
+            block_align = boost::endian::load_little_u16(&header[body + 12]);
+            auto const bits = boost::endian::load_little_u16(&header[body + 14]);
+
+            // WAVE_FORMAT_EXTENSIBLE, the sub format starts with the tag
+            if (format_tag == 0xfffe && size >= 26 && available >= 26)
+            {
+                format_tag = boost::endian::load_little_u16(&header[body + 24]);
+            }
+
+            format = to_sample_format(format_tag, bits);
+
+            if (!format || num_channels == 0 ||
+                block_align != num_channels * (bits / 8))
+            {
+                return std::nullopt;
+            }
+        }
+        else if (id == "data")
+        {
+            if (!format)
+            {
+                return std::nullopt;
+            }
+
+            if (rf64 && size == 0xffffffff && ds64_data_size)
+            {
+                size = *ds64_data_size;
+            }
+
+            return wave_layout{
+                .format = *format,
+                .num_channels = num_channels,
+                .sample_rate = audio::sample_rate{sample_rate},
+                .bytes_per_frame = block_align,
+                .data_offset = body,
+                .num_frames = static_cast<std::size_t>(std::min<std::uint64_t>(
+                                  size,
+                                  file_size - body)) /
+                              block_align,
+            };
+        }
+
+        // a chunk can't reach beyond the file, this also keeps the position
+        // from overflowing
+        if (size > file_size - body)
+        {
+            return std::nullopt;
+        }
+
+        pos = body + static_cast<std::size_t>(size) + (size & 1);
+    }
+
+    return std::nullopt;
+}
+
+template <audio::pcm_format F>
+void
+convert_pcm(unsigned char const* src, std::span<float> const dst) noexcept
+{
+    using sample_t = audio::pcm_sample_t<F>;
+
+    for (float& sample : dst)
+    {
+        sample_t pcm;
+        std::memcpy(&pcm, src, sizeof(sample_t));
+        sample = audio::pcm_convert::from<F>(pcm);
+        src += sizeof(sample_t);
+    }
+}
+
+void
+convert_float(unsigned char const* src, std::span<float> const dst) noexcept
+{
+    for (float& sample : dst)
+    {
+        sample = std::bit_cast<float>(boost::endian::load_little_u32(src));
+        src += sizeof(float);
+    }
+}
+
+// The samples are read with pread, so a file, which is truncated while it is
+// played, ends early instead of faulting. The kernel is asked to read ahead,
+// so the reads are served from the page cache mostly.
+class wave_file_source final : public file_source
+{
+public:
+    wave_file_source(
+        int const fd,
+        std::size_t const file_size,
+        wave_layout const& layout) noexcept
+        : m_fd{fd}
+        , m_file_size{file_size}
+        , m_layout{layout}
+    {
+        ::posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    wave_file_source(wave_file_source const&) = delete;
+
+    ~wave_file_source() override
+    {
+        ::close(m_fd);
+    }
+
+    auto operator=(wave_file_source const&) -> wave_file_source& = delete;
+
+    auto num_channels() const noexcept -> std::size_t override
+    {
+        return m_layout.num_channels;
+    }
+
+    auto num_frames() const noexcept -> std::size_t override
+    {
+        return m_layout.num_frames;
+    }
+
+    auto sample_rate() const noexcept -> audio::sample_rate override
+    {
+        return m_layout.sample_rate;
+    }
+
+    auto read(std::size_t const frame, std::span<float> const interleaved)
+        -> std::size_t override
+    {
+        BOOST_ASSERT(frame <= m_layout.num_frames);
+        BOOST_ASSERT(interleaved.size() % m_layout.num_channels == 0);
+
+        std::size_t const offset =
+            m_layout.data_offset + frame * m_layout.bytes_per_frame;
+
+        read_ahead(offset);
+
+        m_bytes.resize(
+            std::min(
+                interleaved.size() / m_layout.num_channels,
+                m_layout.num_frames - frame) *
+            m_layout.bytes_per_frame);
+
+        std::size_t const num_frames =
+            pread_all(offset) / m_layout.bytes_per_frame;
+
+        auto const samples =
+            interleaved.first(num_frames * m_layout.num_channels);
+        unsigned char const* const src = m_bytes.data();
+
+        switch (m_layout.format)
+        {
+            case sample_format::s16:
+                convert_pcm<audio::pcm_format::s16_le>(src, samples);
+                break;
+
+            case sample_format::s24:
+                convert_pcm<audio::pcm_format::s24_3le>(src, samples);
+                break;
+
+            case sample_format::s32:
+                convert_pcm<audio::pcm_format::s32_le>(src, samples);
+                break;
+
+            case sample_format::f32:
+                convert_float(src, samples);
+                break;
+        }
+
+        return num_frames;
+    }
+
+private:
+    // Returns the number of read bytes, less than requested, if the file
+    // ends early or can't be read.
+    auto pread_all(std::size_t offset) noexcept -> std::size_t
+    {
+        std::size_t done{};
+        while (done < m_bytes.size())
+        {
+            ssize_t const res = ::pread(
+                m_fd,
+                m_bytes.data() + done,
+                m_bytes.size() - done,
+                static_cast<off_t>(offset));
+
+            if (res < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (res <= 0)
+            {
+                break;
+            }
+
+            done += static_cast<std::size_t>(res);
+            offset += static_cast<std::size_t>(res);
+        }
+
+        return done;
+    }
+
+    void read_ahead(std::size_t const offset) noexcept
+    {
+        // re-advise, when half of the advised range is consumed
+        if (offset >= m_advised_begin &&
+            offset + read_ahead_size / 2 < m_advised_end)
+        {
+            return;
+        }
+
+        m_advised_begin = offset;
+        m_advised_end = std::min(offset + read_ahead_size, m_file_size);
+
+        ::posix_fadvise(
+            m_fd,
+            static_cast<off_t>(m_advised_begin),
+            static_cast<off_t>(m_advised_end - m_advised_begin),
+            POSIX_FADV_WILLNEED);
+    }
+
+    int m_fd;
+    std::size_t m_file_size;
+    wave_layout m_layout;
+    std::vector<unsigned char> m_bytes;
+    std::size_t m_advised_begin{};
+    std::size_t m_advised_end{};
+};
+
+class sndfile_source final : public file_source
+{
+public:
+    explicit sndfile_source(std::filesystem::path const& file)
+        : m_file{file.c_str()}
+    {
+        if (m_file.rawHandle() == nullptr || m_file.channels() <= 0)
+        {
+            throw std::system_error(
+                std::make_error_code(std::errc::invalid_argument),
+                m_file.strError());
+        }
+    }
+
+    auto num_channels() const noexcept -> std::size_t override
+    {
+        return static_cast<std::size_t>(m_file.channels());
+    }
+
+    auto num_frames() const noexcept -> std::size_t override
+    {
+        return static_cast<std::size_t>(m_file.frames());
+    }
+
+    auto sample_rate() const noexcept -> audio::sample_rate override
+    {
+        return audio::sample_rate{
+            static_cast<unsigned>(m_file.samplerate())};
+    }
+
+    auto read(std::size_t const frame, std::span<float> const interleaved)
+        -> std::size_t override
+    {
+        BOOST_ASSERT(interleaved.size() % num_channels() == 0);
+
+        auto const position = static_cast<sf_count_t>(frame);
+        if (m_position != position)
+        {
+            m_position = m_file.seek(position, SEEK_SET);
+
+            if (m_position != position)
+            {
+                return 0;
+            }
+        }
+
+        sf_count_t const num_frames = m_file.readf(
+            interleaved.data(),
+            static_cast<sf_count_t>(interleaved.size() / num_channels()));
+        m_position += num_frames;
+
+        return static_cast<std::size_t>(num_frames);
+    }
+
+private:
+    SndfileHandle m_file;
+    sf_count_t m_position{};
+};
+
+// Returns nullptr, if the file isn't a wave file with a supported format.
+auto
+open_wave_file(std::filesystem::path const& file)
+    -> std::unique_ptr<file_source>
+{
+    int const fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category());
+    }
+
+    struct stat st{};
+    std::array<unsigned char, max_header_size> header{};
+    ssize_t const header_size =
+        ::fstat(fd, &st) == 0 ? ::pread(fd, header.data(), header.size(), 0)
+                              : -1;
+
+    if (header_size > 0)
+    {
+        std::size_t const file_size = std::max(
+            static_cast<std::size_t>(st.st_size),
+            static_cast<std::size_t>(header_size));
+
+        if (auto const layout = parse_wave(
+                std::span{header}.first(static_cast<std::size_t>(header_size)),
+                file_size))
+        {
+            return std::make_unique<wave_file_source>(fd, file_size, *layout);
+        }
+    }
+
+    ::close(fd);
+    return nullptr;
+}
+
+} // namespace
+
+auto
+open_file_source(std::filesystem::path const& file)
+    -> std::unique_ptr<file_source>
+{
+    if (auto source = open_wave_file(file))
+    {
+        return source;
+    }
+
+    return std::make_unique<sndfile_source>(file);
+}
+
+} // namespace piejam::fx_modules::file_player
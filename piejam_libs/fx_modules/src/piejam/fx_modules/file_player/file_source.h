@@ -0,0 +1,43 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/sample_rate.h>
+
+#include <filesystem>
+#include <memory>
+#include <span>
+
+namespace piejam::fx_modules::file_player
+{
+
+//! Frames of an audio file. Only accessed from the prefetch thread.
+class file_source
+{
+public:
+    virtual ~file_source() = default;
+
+    [[nodiscard]]
+    virtual auto num_channels() const noexcept -> std::size_t = 0;
+
+    [[nodiscard]]
+    virtual auto num_frames() const noexcept -> std::size_t = 0;
+
+    [[nodiscard]]
+    virtual auto sample_rate() const noexcept -> audio::sample_rate = 0;
+
+    //! Reads interleaved frames, starting at frame. Returns the number of
+    //! read frames.
+    virtual auto read(std::size_t frame, std::span<float> interleaved)
+        -> std::size_t = 0;
+};
+
+//! Wave files with 16, 24 or 32 bit PCM or 32 bit float samples are read
+//! directly, other files are read with libsndfile.
+//! throws std::system_error, if the file can't be opened.
+auto open_file_source(std::filesystem::path const&)
+    -> std::unique_ptr<file_source>;
+
+} // namespace piejam::fx_modules::file_player
@@ -0,0 +1,84 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "FxFilePlayer.h"
+
+#include "../file_player_internal_id.h"
+#include "../file_player_module.h"
+#include "../prefetch_stream.h"
+#include "../prefetcher.h"
+
+#include <piejam/gui/model/BoolParameter.h>
+#include <piejam/gui/model/FileDialog.h>
+#include <piejam/gui/model/FloatParameter.h>
+#include <piejam/runtime/locations.h>
+#include <piejam/runtime/parameter/map.h>
+
+#include <QStandardPaths>
+
+namespace piejam::fx_modules::file_player::gui
+{
+
+using namespace piejam::gui::model;
+
+namespace
+{
+
+auto
+recordingsDir() -> std::filesystem::path
+{
+    return runtime::locations{
+        .home_dir = QStandardPaths::writableLocation(
+                        QStandardPaths::StandardLocation::HomeLocation)
+                        .toStdString(),
+        .config_dir = {},
+    }
+        .recordings_dir;
+}
+
+} // namespace
+
+struct FxFilePlayer::Impl
+{
+    std::shared_ptr<prefetch_stream> stream;
+};
+
+FxFilePlayer::FxFilePlayer(
+    runtime::state_access const& state_access,
+    runtime::fx::module_id const fx_mod_id)
+    : FxModule{state_access, fx_mod_id}
+    , m_impl{make_pimpl<Impl>(find_or_make_stream(
+          fx_mod_id,
+          busType() == BusType::Mono ? 1 : 2))}
+    , m_play{&addModel<BoolParameter>(
+          parameters().get<runtime::bool_parameter_id>(parameter_key::play))}
+    , m_loop{&addModel<BoolParameter>(
+          parameters().get<runtime::bool_parameter_id>(parameter_key::loop))}
+    , m_gain{&addModel<FloatParameter>(
+          parameters().get<runtime::float_parameter_id>(parameter_key::gain))}
+    , m_fileDialog{&addQObject<FileDialog>(recordingsDir(), ".wav")}
+{
+}
+
+auto
+FxFilePlayer::type() const noexcept -> FxModuleType
+{
+    return {.id = internal_id()};
+}
+
+void
+FxFilePlayer::loadFile(FilePath const& file)
+{
+    m_impl->stream->load(file.path);
+    setFileName(QString::fromStdString(file.path.stem().string()));
+}
+
+void
+FxFilePlayer::onSubscribe()
+{
+    setFileName(
+        QString::fromStdString(m_impl->stream->file().stem().string()));
+}
+
+} // namespace piejam::fx_modules::file_player::gui
@@ -0,0 +1,41 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/gui/PropertyMacros.h>
+#include <piejam/gui/model/FilePath.h>
+#include <piejam/gui/model/FxModule.h>
+#include <piejam/gui/model/SubscribableModel.h>
+#include <piejam/gui/model/fwd.h>
+
+#include <piejam/runtime/fx/fwd.h>
+
+namespace piejam::fx_modules::file_player::gui
+{
+
+class FxFilePlayer final : public piejam::gui::model::FxModule
+{
+    Q_OBJECT
+
+    PIEJAM_GUI_MODEL_PIMPL
+
+    PIEJAM_GUI_CONSTANT_PROPERTY(piejam::gui::model::BoolParameter*, play)
+    PIEJAM_GUI_CONSTANT_PROPERTY(piejam::gui::model::BoolParameter*, loop)
+    PIEJAM_GUI_CONSTANT_PROPERTY(piejam::gui::model::FloatParameter*, gain)
+    PIEJAM_GUI_CONSTANT_PROPERTY(piejam::gui::model::FileDialog*, fileDialog)
+    PIEJAM_GUI_PROPERTY(QString, fileName, setFileName)
+
+public:
+    FxFilePlayer(runtime::state_access const&, runtime::fx::module_id);
+
+    auto type() const noexcept -> piejam::gui::model::FxModuleType override;
+
+    Q_INVOKABLE void loadFile(piejam::gui::model::FilePath const&);
+
+private:
+    void onSubscribe() override;
+};
+
+} // namespace piejam::fx_modules::file_player::gui
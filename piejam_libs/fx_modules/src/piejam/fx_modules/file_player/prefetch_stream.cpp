@@ -0,0 +1,289 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "prefetch_stream.h"
+
+#include "file_source.h"
+
+#include <spdlog/spdlog.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <system_error>
+
+namespace piejam::fx_modules::file_player
+{
+
+prefetch_stream::prefetch_stream(
+    std::size_t const num_channels,
+    std::size_t const num_blocks)
+    : m_num_channels{num_channels}
+    , m_blocks(num_blocks)
+    , m_filled{num_blocks}
+    , m_free{num_blocks}
+{
+    BOOST_ASSERT(num_channels > 0);
+    BOOST_ASSERT(num_blocks > 0);
+
+    for (block& b : m_blocks)
+    {
+        b.samples.resize(num_channels * block_frames);
+        BOOST_VERIFY(m_free.push(&b));
+    }
+}
+
+prefetch_stream::~prefetch_stream() = default;
+
+void
+prefetch_stream::load(std::filesystem::path file)
+{
+    std::lock_guard const lock{m_load_mutex};
+    m_loaded_file = file;
+    m_pending_file = std::move(file);
+}
+
+auto
+prefetch_stream::file() const -> std::filesystem::path
+{
+    std::lock_guard const lock{m_load_mutex};
+    return m_loaded_file;
+}
+
+void
+prefetch_stream::cue() noexcept
+{
+    m_cue.store(++m_current_cue, std::memory_order_release);
+    m_at_end = false;
+
+    skip_stale();
+}
+
+void
+prefetch_stream::set_loop(bool const loop) noexcept
+{
+    m_loop.store(loop, std::memory_order_relaxed);
+}
+
+auto
+prefetch_stream::is_stale(block const& b) const noexcept -> bool
+{
+    return b.cue != m_current_cue ||
+           b.file != m_file.load(std::memory_order_acquire);
+}
+
+void
+prefetch_stream::release_current() noexcept
+{
+    BOOST_ASSERT(m_current);
+    BOOST_VERIFY(m_free.push(m_current));
+    m_current = nullptr;
+    m_current_offset = 0;
+}
+
+void
+prefetch_stream::skip_stale() noexcept
+{
+    if (m_current && is_stale(*m_current))
+    {
+        release_current();
+    }
+
+    while (m_filled.read_available() > 0 && is_stale(*m_filled.front()))
+    {
+        block* b{};
+        m_filled.pop(b);
+        BOOST_VERIFY(m_free.push(b));
+    }
+}
+
+auto
+prefetch_stream::read(
+    std::span<std::span<float> const> const outputs,
+    std::size_t const offset,
+    std::size_t const num_frames) noexcept -> std::size_t
+{
+    BOOST_ASSERT(outputs.size() == m_num_channels);
+
+    std::size_t copied{};
+
+    while (copied < num_frames && !m_at_end)
+    {
+        if (m_current && is_stale(*m_current))
+        {
+            release_current();
+        }
+
+        if (!m_current)
+        {
+            if (!m_filled.pop(m_current))
+            {
+                m_current = nullptr;
+                break;
+            }
+
+            continue;
+        }
+
+        std::size_t const count = std::min(
+            m_current->num_frames - m_current_offset,
+            num_frames - copied);
+
+        for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+        {
+            std::copy_n(
+                std::next(
+                    m_current->samples.begin(),
+                    ch * block_frames + m_current_offset),
+                count,
+                std::next(outputs[ch].begin(), offset + copied));
+        }
+
+        copied += count;
+        m_current_offset += count;
+
+        if (m_current_offset == m_current->num_frames)
+        {
+            m_at_end = m_current->end;
+            release_current();
+        }
+    }
+
+    if (copied < num_frames && !m_at_end)
+    {
+        m_underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return copied;
+}
+
+auto
+prefetch_stream::prefetch() -> bool
+{
+    open_pending_file();
+
+    bool filled{};
+
+    while (true)
+    {
+        // a new cue restarts at the beginning, even in the middle of a loop
+        if (auto const cue = m_cue.load(std::memory_order_acquire);
+            cue != m_prefetched_cue)
+        {
+            m_prefetched_cue = cue;
+            m_position = 0;
+            m_source_at_end = !m_source;
+        }
+
+        block* b{};
+        if (m_source_at_end || !m_free.pop(b))
+        {
+            break;
+        }
+
+        fill(*b, m_prefetched_cue);
+        BOOST_VERIFY(m_filled.push(b));
+        filled = true;
+    }
+
+    return filled;
+}
+
+void
+prefetch_stream::open_pending_file()
+{
+    std::optional<std::filesystem::path> file;
+
+    {
+        std::lock_guard const lock{m_load_mutex};
+        file.swap(m_pending_file);
+    }
+
+    if (!file)
+    {
+        return;
+    }
+
+    try
+    {
+        m_source = open_file_source(*file);
+
+        spdlog::info(
+            "File player: {}, {} channels, {} Hz",
+            file->string(),
+            m_source->num_channels(),
+            m_source->sample_rate().value());
+    }
+    catch (std::system_error const& err)
+    {
+        spdlog::error(
+            "File player: could not open {}: {}",
+            file->string(),
+            err.what());
+        m_source.reset();
+    }
+
+    m_interleaved.resize(
+        block_frames * (m_source ? m_source->num_channels() : 0));
+    m_position = 0;
+    m_source_at_end = !m_source;
+
+    // invalidates the blocks of the previous file
+    m_file.store(++m_source_file, std::memory_order_release);
+}
+
+void
+prefetch_stream::fill(block& b, std::uint64_t const cue)
+{
+    BOOST_ASSERT(m_source);
+
+    std::size_t const num_source_channels = m_source->num_channels();
+    std::size_t const num_source_frames = m_source->num_frames();
+
+    b.cue = cue;
+    b.file = m_source_file;
+    b.end = false;
+
+    std::size_t frames{};
+    while (frames < block_frames && !m_source_at_end)
+    {
+        std::size_t const count = m_source->read(
+            m_position,
+            std::span{m_interleaved}.first(
+                (block_frames - frames) * num_source_channels));
+
+        for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+        {
+            std::size_t const source_ch =
+                std::min(ch, num_source_channels - 1);
+            auto out = std::next(b.samples.begin(), ch * block_frames + frames);
+
+            for (std::size_t frame = 0; frame < count; ++frame)
+            {
+                *out++ = m_interleaved[frame * num_source_channels + source_ch];
+            }
+        }
+
+        frames += count;
+        m_position += count;
+
+        // a read error ends the playback like the end of the file
+        if (count == 0 || m_position >= num_source_frames)
+        {
+            if (count != 0 && m_loop.load(std::memory_order_relaxed))
+            {
+                m_position = 0;
+            }
+            else
+            {
+                m_source_at_end = true;
+                b.end = true;
+            }
+        }
+    }
+
+    b.num_frames = frames;
+}
+
+} // namespace piejam::fx_modules::file_player
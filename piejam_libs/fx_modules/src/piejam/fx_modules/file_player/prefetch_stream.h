@@ -0,0 +1,147 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace piejam::fx_modules::file_player
+{
+
+class file_source;
+
+//! Streams an audio file from the prefetch thread to the audio thread.
+//!
+//! The prefetch thread reads the file ahead into a pool of blocks and passes
+//! the filled blocks through a lock-free queue. The audio thread copies the
+//! frames out of the blocks and hands the blocks back through a second
+//! queue, so it never touches the file or allocates. While stopped, the
+//! blocks stay filled from the start of the file, so playback starts
+//! without delay.
+//!
+//! Rewinding and loading a file don't wait for the prefetch thread. The
+//! blocks carry the cue and the file they were read for, stale blocks are
+//! skipped by the audio thread.
+class prefetch_stream
+{
+public:
+    static constexpr std::size_t block_frames{1024};
+    static constexpr std::size_t default_num_blocks{128};
+
+    //! The file channels are mapped to the output channels by index. If the
+    //! file has less channels, the last one is repeated.
+    explicit prefetch_stream(
+        std::size_t num_channels,
+        std::size_t num_blocks = default_num_blocks);
+    ~prefetch_stream();
+
+    [[nodiscard]]
+    auto num_channels() const noexcept -> std::size_t
+    {
+        return m_num_channels;
+    }
+
+    //! Control thread. The file is opened on the prefetch thread.
+    void load(std::filesystem::path);
+
+    //! Control thread. The file, which was loaded last.
+    [[nodiscard]]
+    auto file() const -> std::filesystem::path;
+
+    //! Audio thread. Rewinds to the start of the file.
+    void cue() noexcept;
+
+    //! Audio thread. The file is looped by the prefetch thread, so changing
+    //! the loop mode only affects the frames, which aren't prefetched yet.
+    void set_loop(bool) noexcept;
+
+    //! Audio thread. Copies the next frames into the outputs, starting at
+    //! offset. Returns the number of copied frames, which is less than
+    //! requested, if the end of the file was reached or the prefetch thread
+    //! didn't keep up.
+    auto read(
+        std::span<std::span<float> const> outputs,
+        std::size_t offset,
+        std::size_t num_frames) noexcept -> std::size_t;
+
+    //! Audio thread. True, after the last frame of the file was read.
+    [[nodiscard]]
+    auto at_end() const noexcept -> bool
+    {
+        return m_at_end;
+    }
+
+    //! Audio thread. Hands stale blocks back while not reading, so the
+    //! prefetch thread can refill them.
+    void skip_stale() noexcept;
+
+    //! Audio thread. Number of reads, which couldn't be served completely.
+    [[nodiscard]]
+    auto underruns() const noexcept -> std::size_t
+    {
+        return m_underruns.load(std::memory_order_relaxed);
+    }
+
+    //! Prefetch thread. Returns true, if blocks were filled.
+    auto prefetch() -> bool;
+
+private:
+    struct block
+    {
+        std::uint64_t cue{};
+        std::uint64_t file{};
+        std::size_t num_frames{};
+        bool end{};
+        std::vector<float> samples;
+    };
+
+    [[nodiscard]]
+    auto is_stale(block const&) const noexcept -> bool;
+
+    void release_current() noexcept;
+
+    void open_pending_file();
+    void fill(block&, std::uint64_t cue);
+
+    std::size_t const m_num_channels;
+
+    std::vector<block> m_blocks;
+    boost::lockfree::spsc_queue<block*> m_filled;
+    boost::lockfree::spsc_queue<block*> m_free;
+
+    std::atomic_uint64_t m_cue{};
+    std::atomic_uint64_t m_file{};
+    std::atomic_bool m_loop{};
+    std::atomic_size_t m_underruns{};
+
+    // audio thread
+    std::uint64_t m_current_cue{};
+    block* m_current{};
+    std::size_t m_current_offset{};
+    bool m_at_end{};
+
+    // control thread
+    mutable std::mutex m_load_mutex;
+    std::filesystem::path m_loaded_file;
+    std::optional<std::filesystem::path> m_pending_file;
+
+    // prefetch thread
+    std::unique_ptr<file_source> m_source;
+    std::uint64_t m_source_file{};
+    std::uint64_t m_prefetched_cue{};
+    std::size_t m_position{};
+    bool m_source_at_end{true};
+    std::vector<float> m_interleaved;
+};
+
+} // namespace piejam::fx_modules::file_player
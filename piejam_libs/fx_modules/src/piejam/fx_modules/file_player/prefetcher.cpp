@@ -0,0 +1,126 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "prefetcher.h"
+
+#include "prefetch_stream.h"
+
+#include <piejam/thread/configuration.h>
+#include <piejam/thread/sleep_for.h>
+
+#include <boost/container/flat_map.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace piejam::fx_modules::file_player
+{
+
+namespace
+{
+
+// Much shorter than the prefetched duration, so a stream is refilled long
+// before it runs dry.
+constexpr std::chrono::milliseconds poll_interval{10};
+
+class prefetcher
+{
+public:
+    auto find_or_make_stream(
+        runtime::fx::module_id const fx_mod_id,
+        std::size_t const num_channels) -> std::shared_ptr<prefetch_stream>
+    {
+        std::lock_guard const lock{m_mutex};
+
+        if (!m_thread.joinable())
+        {
+            m_thread = std::jthread{
+                [this](std::stop_token stoken) { run(stoken); }};
+        }
+
+        auto& entry = m_streams[fx_mod_id];
+        auto stream = entry.lock();
+
+        if (!stream || stream->num_channels() != num_channels)
+        {
+            stream = std::make_shared<prefetch_stream>(num_channels);
+            entry = stream;
+        }
+
+        return stream;
+    }
+
+private:
+    void run(std::stop_token const& stoken)
+    {
+        thread::configuration{
+            .affinity = std::nullopt,
+            .realtime_priority = std::nullopt,
+            .name = "file_player"}
+            .apply();
+
+        std::vector<std::shared_ptr<prefetch_stream>> streams;
+
+        while (!stoken.stop_requested())
+        {
+            collect_streams(streams);
+
+            bool busy{};
+            for (auto const& stream : streams)
+            {
+                busy |= stream->prefetch();
+            }
+
+            // the last reference to a stream might be released here
+            streams.clear();
+
+            if (!busy)
+            {
+                thread::sleep_for(stoken, poll_interval);
+            }
+        }
+    }
+
+    void collect_streams(std::vector<std::shared_ptr<prefetch_stream>>& result)
+    {
+        std::lock_guard const lock{m_mutex};
+
+        for (auto it = m_streams.begin(); it != m_streams.end();)
+        {
+            if (auto stream = it->second.lock())
+            {
+                result.push_back(std::move(stream));
+                ++it;
+            }
+            else
+            {
+                it = m_streams.erase(it);
+            }
+        }
+    }
+
+    std::mutex m_mutex;
+    boost::container::flat_map<
+        runtime::fx::module_id,
+        std::weak_ptr<prefetch_stream>>
+        m_streams;
+
+    // declared last, so the thread is stopped before the members are gone
+    std::jthread m_thread;
+};
+
+} // namespace
+
+auto
+find_or_make_stream(
+    runtime::fx::module_id const fx_mod_id,
+    std::size_t const num_channels) -> std::shared_ptr<prefetch_stream>
+{
+    static prefetcher s_prefetcher;
+    return s_prefetcher.find_or_make_stream(fx_mod_id, num_channels);
+}
+
+} // namespace piejam::fx_modules::file_player
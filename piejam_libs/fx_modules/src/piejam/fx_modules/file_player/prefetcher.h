@@ -0,0 +1,28 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/entity_id.h>
+#include <piejam/runtime/fx/fwd.h>
+
+#include <memory>
+
+namespace piejam::fx_modules::file_player
+{
+
+class prefetch_stream;
+
+//! Returns the stream of a file player module. The stream lives as long as
+//! it is referenced, e.g. by the processor or the gui model, so a loaded
+//! file survives rebuilding the audio graph.
+//!
+//! All streams are served by a single prefetch thread, which is started
+//! with the first stream. It refills the streams round-robin and sleeps,
+//! when there is nothing to do, so many players share one thread and the
+//! disk is read in large sequential chunks.
+auto find_or_make_stream(runtime::fx::module_id, std::size_t num_channels)
+    -> std::shared_ptr<prefetch_stream>;
+
+} // namespace piejam::fx_modules::file_player
@@ -6,13 +6,13 @@
 
 #include "filter_module.h"
 
+#include <piejam/audio/dsp/biquad_bank.h>
 #include <piejam/audio/dsp/biquad_filter.h>
 #include <piejam/audio/engine/component.h>
 #include <piejam/audio/engine/event_converter_processor.h>
 #include <piejam/audio/engine/graph.h>
 #include <piejam/audio/engine/graph_endpoint.h>
 #include <piejam/audio/engine/graph_generic_algorithms.h>
-#include <piejam/audio/engine/identity_processor.h>
 #include <piejam/audio/engine/named_processor.h>
 #include <piejam/audio/engine/single_event_input_processor.h>
 #include <piejam/audio/sample_rate.h>
@@ -23,6 +23,11 @@
 #include <piejam/runtime/parameter/map.h>
 #include <piejam/runtime/parameter_processor_factory.h>
 
+#include <boost/hof/match.hpp>
+
+#include <algorithm>
+#include <array>
+
 namespace piejam::fx_modules::filter
 {
 
@@ -31,34 +36,37 @@ namespace
 
 using coeffs_t = audio::dsp::biquad<float>::coefficients;
 
+// The filters are cascades of two sections.
+using cascade_coeffs_t = std::array<coeffs_t, 2>;
+
 auto
 make_coefficent_converter_processor(audio::sample_rate const sample_rate)
 {
     using namespace std::string_view_literals;
     static constexpr std::array s_input_names{"type"sv, "cutoff"sv, "res"sv};
-    static constexpr std::array s_output_names{"coeffs1"sv, "coeffs2"sv};
+    static constexpr std::array s_output_names{"coeffs"sv};
     return audio::engine::make_event_converter_processor(
         [inv_sr = 1.f / sample_rate.as<float>()](
             int const type,
             float const cutoff,
-            float const res) {
+            float const res) -> cascade_coeffs_t {
             using namespace audio::dsp::biquad_filter;
 
             switch (static_cast<filter::type>(type))
             {
                 case type::lp2:
-                    return std::tuple{
+                    return cascade_coeffs_t{
                         make_lp_coefficients(cutoff, res, inv_sr),
                         coeffs_t{}};
 
                 case type::lp4:
                 {
                     auto coeffs = make_lp_coefficients(cutoff, res, inv_sr);
-                    return std::tuple{coeffs, coeffs};
+                    return cascade_coeffs_t{coeffs, coeffs};
                 }
 
                 case type::bp2:
-                    return std::tuple{
+                    return cascade_coeffs_t{
                         make_bp_coefficients(cutoff, res, inv_sr),
                         coeffs_t{}};
 
@@ -77,30 +85,30 @@ make_coefficent_converter_processor(audio::sample_rate const sample_rate)
 
                     float const res_bp = std::lerp(0.f, 0.03152f, res);
 
-                    return std::tuple{
+                    return cascade_coeffs_t{
                         make_hp_coefficients(fc_low, res_bp, inv_sr),
                         make_lp_coefficients(fc_high, res_bp, inv_sr),
                     };
                 }
 
                 case type::hp2:
-                    return std::tuple{
+                    return cascade_coeffs_t{
                         make_hp_coefficients(cutoff, res, inv_sr),
                         coeffs_t{}};
 
                 case type::hp4:
                 {
                     auto coeffs = make_hp_coefficients(cutoff, res, inv_sr);
-                    return std::tuple{coeffs, coeffs};
+                    return cascade_coeffs_t{coeffs, coeffs};
                 }
 
                 case type::br:
-                    return std::tuple{
+                    return cascade_coeffs_t{
                         make_br_coefficients(cutoff, res, inv_sr),
                         coeffs_t{}};
 
                 default:
-                    return std::tuple{coeffs_t{}, coeffs_t{}};
+                    return cascade_coeffs_t{};
             }
         },
         s_input_names,
@@ -108,13 +116,21 @@ make_coefficent_converter_processor(audio::sample_rate const sample_rate)
         "make_coeff");
 }
 
+template <std::size_t NumChannels>
 class processor final
     : public audio::engine::named_processor
-    , public audio::engine::single_event_input_processor<processor, coeffs_t>
+    , public audio::engine::single_event_input_processor<
+          processor<NumChannels>,
+          cascade_coeffs_t>
 {
 public:
+    // Coefficient changes are applied at control rate, the biquad state
+    // carries over between the slices anyway.
     processor(std::string_view const name)
         : named_processor(name)
+        , audio::engine::
+              single_event_input_processor<processor, cascade_coeffs_t>(
+                  audio::engine::control_rate_events)
     {
     }
 
@@ -125,18 +141,19 @@ public:
 
     auto num_inputs() const noexcept -> std::size_t override
     {
-        return 1;
+        return NumChannels;
     }
 
     auto num_outputs() const noexcept -> std::size_t override
     {
-        return 1;
+        return NumChannels;
     }
 
     auto event_inputs() const noexcept -> event_ports override
     {
-        static std::array s_ports{
-            audio::engine::event_port{std::in_place_type<coeffs_t>, "coeffs"}};
+        static std::array s_ports{audio::engine::event_port{
+            std::in_place_type<cascade_coeffs_t>,
+            "coeffs"}};
         return s_ports;
     }
 
@@ -147,77 +164,56 @@ public:
 
     void process(audio::engine::process_context const& ctx) override
     {
-        ctx.results[0] = ctx.outputs[0];
+        std::ranges::copy(ctx.outputs, ctx.results.begin());
 
-        process_sliced(ctx);
+        this->process_sliced(ctx);
     }
 
     void process_buffer(audio::engine::process_context const& ctx)
     {
-        visit(
-            [this, out = ctx.outputs[0]](auto const in) { process(in, out); },
-            ctx.inputs[0].get());
+        process_slice(ctx, 0, ctx.buffer_size);
     }
 
+    // All channels are filtered at once, constant inputs are expanded into
+    // the output buffers and filtered in place.
     void process_slice(
         audio::engine::process_context const& ctx,
         std::size_t const offset,
         std::size_t const count)
     {
-        visit(
-            [this, out = ctx.outputs[0].subspan(offset, count)](auto const in) {
-                process(in, out);
-            },
-            subslice(ctx.inputs[0].get(), offset, count));
+        std::array<std::span<float const>, NumChannels> in;
+        std::array<std::span<float>, NumChannels> out;
+
+        for (std::size_t ch = 0; ch < NumChannels; ++ch)
+        {
+            out[ch] = ctx.outputs[ch].subspan(offset, count);
+            in[ch] = visit(
+                boost::hof::match(
+                    [&](float const c) -> std::span<float const> {
+                        std::ranges::fill(out[ch], c);
+                        return out[ch];
+                    },
+                    [](audio::slice<float>::span_t const buf) {
+                        return buf;
+                    }),
+                subslice(ctx.inputs[ch].get(), offset, count));
+        }
+
+        m_biquads.process(in, out);
     }
 
     void process_event(
         audio::engine::process_context const& /*ctx*/,
-        audio::engine::event<coeffs_t> const& ev)
+        audio::engine::event<cascade_coeffs_t> const& ev)
     {
-        m_biquad.coeffs = ev.value();
+        m_biquads.set_coefficients(0, ev.value()[0]);
+        m_biquads.set_coefficients(1, ev.value()[1]);
     }
 
 private:
-    void process(float const c, std::span<float> out)
-    {
-        std::ranges::generate(out, [this, c]() { return m_biquad.process(c); });
-    }
-
-    void process(audio::slice<float>::span_t const in, std::span<float> out)
-    {
-        std::ranges::transform(in, out.begin(), [this](float const s) {
-            return m_biquad.process(s);
-        });
-    }
-
-    audio::dsp::biquad<float> m_biquad;
+    audio::dsp::biquad_bank<float, NumChannels, 2> m_biquads;
 };
 
-template <std::size_t NumChannels>
-[[nodiscard]]
-constexpr auto
-filter_channel_name(std::size_t ch)
-{
-    using namespace std::string_view_literals;
-    switch (NumChannels)
-    {
-        case 2:
-            switch (ch)
-            {
-                case 0:
-                    return "filter L"sv;
-                case 1:
-                    return "filter R"sv;
-                default:
-                    return "filter"sv;
-            }
-
-        default:
-            return "filter"sv;
-    }
-}
-
 template <std::size_t... Channel>
 class component final : public audio::engine::component
 {
@@ -283,37 +279,12 @@ public:
             *m_coeffs_proc,
             to<2>);
 
-        (audio::engine::connect_event(
-             g,
-             *m_coeffs_proc,
-             from<0>,
-             *m_filter1_procs[Channel],
-             to<0>),
-         ...);
-
-        (audio::engine::connect_event(
-             g,
-             *m_coeffs_proc,
-             from<1>,
-             *m_filter2_procs[Channel],
-             to<0>),
-         ...);
-
-        (audio::engine::connect(
-             g,
-             *m_input_procs[Channel],
-             from<0>,
-             *m_filter1_procs[Channel],
-             to<0>),
-         ...);
-
-        (audio::engine::connect(
-             g,
-             *m_filter1_procs[Channel],
-             from<0>,
-             *m_filter2_procs[Channel],
-             to<0>),
-         ...);
+        audio::engine::connect_event(
+            g,
+            *m_coeffs_proc,
+            from<0>,
+            *m_filter_proc,
+            to<0>);
     }
 
 private:
@@ -321,27 +292,16 @@ private:
     std::shared_ptr<audio::engine::processor> m_cutoff_input_proc;
     std::shared_ptr<audio::engine::processor> m_resonance_input_proc;
     std::unique_ptr<audio::engine::processor> m_coeffs_proc;
-    std::array<std::unique_ptr<audio::engine::processor>, num_channels>
-        m_input_procs{
-            ((void)Channel, audio::engine::make_identity_processor())...};
-    std::array<std::unique_ptr<audio::engine::processor>, num_channels>
-        m_filter1_procs{
-            ((void)Channel,
-             std::make_unique<processor>(
-                 filter_channel_name<num_channels>(Channel)))...};
-    std::array<std::unique_ptr<audio::engine::processor>, num_channels>
-        m_filter2_procs{
-            ((void)Channel,
-             std::make_unique<processor>(
-                 filter_channel_name<num_channels>(Channel)))...};
+    std::unique_ptr<audio::engine::processor> m_filter_proc{
+        std::make_unique<processor<num_channels>>("filter")};
     std::array<audio::engine::graph_endpoint, num_channels> m_inputs{
         audio::engine::graph_endpoint{
-            .proc = *m_input_procs[Channel],
-            .port = 0}...};
+            .proc = *m_filter_proc,
+            .port = Channel}...};
     std::array<audio::engine::graph_endpoint, num_channels> m_outputs{
         audio::engine::graph_endpoint{
-            .proc = *m_filter2_procs[Channel],
-            .port = 0}...};
+            .proc = *m_filter_proc,
+            .port = Channel}...};
     std::array<audio::engine::graph_endpoint, 3> m_event_inputs{
         audio::engine::graph_endpoint{.proc = *m_type_input_proc, .port = 0},
         audio::engine::graph_endpoint{.proc = *m_cutoff_input_proc, .port = 0},
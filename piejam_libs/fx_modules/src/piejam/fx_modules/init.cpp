@@ -21,7 +21,7 @@ namespace piejam::fx_modules
 {
 
 #define PIEJAM_FX_MODULES_LIST                                                 \
-    (dual_pan)(filter)(scope)(spectrum)(tuner)(utility)
+    (dual_pan)(file_player)(filter)(limiter)(scope)(spectrum)(tuner)(utility)
 
 #define PIEJAM_DECLARE_FX_MODULE_INIT(rec, macro, name)                        \
     namespace name                                                             \
@@ -0,0 +1,20 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "FxLimiter.h"
+
+#include "../limiter_internal_id.h"
+
+namespace piejam::fx_modules::limiter::gui
+{
+
+using namespace piejam::gui::model;
+
+auto
+FxLimiter::type() const noexcept -> FxModuleType
+{
+    return {.id = internal_id()};
+}
+
+} // namespace piejam::fx_modules::limiter::gui
@@ -0,0 +1,285 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "limiter_component.h"
+
+#include "limiter_module.h"
+
+#include <piejam/audio/dsp/lookahead_limiter.h>
+#include <piejam/audio/engine/component.h>
+#include <piejam/audio/engine/event_converter_processor.h>
+#include <piejam/audio/engine/graph.h>
+#include <piejam/audio/engine/graph_endpoint.h>
+#include <piejam/audio/engine/graph_generic_algorithms.h>
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/single_event_input_processor.h>
+#include <piejam/audio/sample_rate.h>
+#include <piejam/audio/slice_algorithms.h>
+#include <piejam/runtime/fx/module.h>
+#include <piejam/runtime/internal_fx_component_factory.h>
+#include <piejam/runtime/parameter/map.h>
+#include <piejam/runtime/parameter_processor_factory.h>
+
+#include <boost/hof/match.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace piejam::fx_modules::limiter
+{
+
+namespace
+{
+
+struct settings
+{
+    float threshold{1.f};
+    float release_coeff{};
+    bool true_peak{true};
+};
+
+auto
+make_settings_converter_processor(audio::sample_rate const sample_rate)
+{
+    using namespace std::string_view_literals;
+    static constexpr std::array s_input_names{
+        "threshold"sv,
+        "release"sv,
+        "true_peak"sv};
+    static constexpr std::array s_output_names{"settings"sv};
+    return audio::engine::make_event_converter_processor(
+        [sr = sample_rate.as<float>()](
+            float const threshold,
+            float const release_ms,
+            bool const true_peak) -> settings {
+            return settings{
+                .threshold = threshold,
+                .release_coeff = std::exp(-1000.f / (release_ms * sr)),
+                .true_peak = true_peak,
+            };
+        },
+        s_input_names,
+        s_output_names,
+        "limiter_settings");
+}
+
+template <std::size_t NumChannels>
+class processor final
+    : public audio::engine::named_processor
+    , public audio::engine::
+          single_event_input_processor<processor<NumChannels>, settings>
+{
+public:
+    // The limiter reacts to the peaks within the lookahead, settings changes
+    // are applied at control rate.
+    processor(audio::sample_rate const sample_rate, std::string_view const name)
+        : named_processor(name)
+        , audio::engine::single_event_input_processor<processor, settings>(
+              audio::engine::control_rate_events)
+        , m_limiter(sample_rate.samples_for_duration(lookahead))
+    {
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return "limiter";
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return NumChannels;
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return NumChannels;
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        static std::array s_ports{audio::engine::event_port{
+            std::in_place_type<settings>,
+            "settings"}};
+        return s_ports;
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    void process(audio::engine::process_context const& ctx) override
+    {
+        std::ranges::copy(ctx.outputs, ctx.results.begin());
+
+        this->process_sliced(ctx);
+    }
+
+    void process_buffer(audio::engine::process_context const& ctx)
+    {
+        process_slice(ctx, 0, ctx.buffer_size);
+    }
+
+    // Constant inputs are expanded into the output buffers and limited in
+    // place. Silence has to pass through the delay as well.
+    void process_slice(
+        audio::engine::process_context const& ctx,
+        std::size_t const offset,
+        std::size_t const count)
+    {
+        std::array<std::span<float const>, NumChannels> in;
+        std::array<std::span<float>, NumChannels> out;
+
+        for (std::size_t ch = 0; ch < NumChannels; ++ch)
+        {
+            out[ch] = ctx.outputs[ch].subspan(offset, count);
+            in[ch] = visit(
+                boost::hof::match(
+                    [&](float const c) -> std::span<float const> {
+                        std::ranges::fill(out[ch], c);
+                        return out[ch];
+                    },
+                    [](audio::slice<float>::span_t const buf) {
+                        return buf;
+                    }),
+                subslice(ctx.inputs[ch].get(), offset, count));
+        }
+
+        m_limiter.process(in, out);
+    }
+
+    void process_event(
+        audio::engine::process_context const& /*ctx*/,
+        audio::engine::event<settings> const& ev)
+    {
+        m_limiter.set_threshold(ev.value().threshold);
+        m_limiter.set_release(ev.value().release_coeff);
+        m_limiter.set_true_peak(ev.value().true_peak);
+    }
+
+private:
+    audio::dsp::lookahead_limiter<float, NumChannels> m_limiter;
+};
+
+template <std::size_t... Channel>
+class component final : public audio::engine::component
+{
+    static constexpr std::size_t num_channels = sizeof...(Channel);
+
+public:
+    component(runtime::internal_fx_component_factory_args const& args)
+        : m_threshold_input_proc(args.param_procs.find_or_make_processor(
+              args.fx_mod.parameters->at(parameter_key::threshold),
+              "threshold"))
+        , m_release_input_proc(args.param_procs.find_or_make_processor(
+              args.fx_mod.parameters->at(parameter_key::release),
+              "release"))
+        , m_true_peak_input_proc(args.param_procs.find_or_make_processor(
+              args.fx_mod.parameters->at(parameter_key::true_peak),
+              "true_peak"))
+        , m_settings_proc(make_settings_converter_processor(args.sample_rate))
+        , m_limiter_proc(
+              std::make_unique<processor<num_channels>>(
+                  args.sample_rate,
+                  "limiter"))
+    {
+    }
+
+    auto inputs() const -> endpoints override
+    {
+        return m_inputs;
+    }
+
+    auto outputs() const -> endpoints override
+    {
+        return m_outputs;
+    }
+
+    auto event_inputs() const -> endpoints override
+    {
+        return {};
+    }
+
+    auto event_outputs() const -> endpoints override
+    {
+        return {};
+    }
+
+    void connect(audio::engine::graph& g) const override
+    {
+        using namespace audio::engine::endpoint_ports;
+
+        audio::engine::connect_event(
+            g,
+            *m_threshold_input_proc,
+            from<0>,
+            *m_settings_proc,
+            to<0>);
+
+        audio::engine::connect_event(
+            g,
+            *m_release_input_proc,
+            from<0>,
+            *m_settings_proc,
+            to<1>);
+
+        audio::engine::connect_event(
+            g,
+            *m_true_peak_input_proc,
+            from<0>,
+            *m_settings_proc,
+            to<2>);
+
+        audio::engine::connect_event(
+            g,
+            *m_settings_proc,
+            from<0>,
+            *m_limiter_proc,
+            to<0>);
+    }
+
+private:
+    std::shared_ptr<audio::engine::processor> m_threshold_input_proc;
+    std::shared_ptr<audio::engine::processor> m_release_input_proc;
+    std::shared_ptr<audio::engine::processor> m_true_peak_input_proc;
+    std::unique_ptr<audio::engine::processor> m_settings_proc;
+    std::unique_ptr<audio::engine::processor> m_limiter_proc;
+    std::array<audio::engine::graph_endpoint, num_channels> m_inputs{
+        audio::engine::graph_endpoint{
+            .proc = *m_limiter_proc,
+            .port = Channel}...};
+    std::array<audio::engine::graph_endpoint, num_channels> m_outputs{
+        audio::engine::graph_endpoint{
+            .proc = *m_limiter_proc,
+            .port = Channel}...};
+};
+
+template <std::size_t... Channel>
+auto
+make_component(
+    runtime::internal_fx_component_factory_args const& args,
+    std::index_sequence<Channel...>)
+    -> std::unique_ptr<audio::engine::component>
+{
+    return std::make_unique<component<Channel...>>(args);
+}
+
+} // namespace
+
+auto
+make_component(runtime::internal_fx_component_factory_args const& args)
+    -> std::unique_ptr<audio::engine::component>
+{
+    switch (args.fx_mod.bus_type)
+    {
+        case audio::bus_type::mono:
+            return make_component(args, std::make_index_sequence<1>{});
+
+        case audio::bus_type::stereo:
+            return make_component(args, std::make_index_sequence<2>{});
+    }
+}
+
+} // namespace piejam::fx_modules::limiter
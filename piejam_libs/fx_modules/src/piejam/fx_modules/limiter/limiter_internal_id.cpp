@@ -0,0 +1,46 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "limiter_internal_id.h"
+
+#include "gui/FxLimiter.h"
+#include "limiter_component.h"
+#include "limiter_module.h"
+
+#include "../module_registration.h"
+
+namespace piejam::fx_modules::limiter
+{
+
+void
+init()
+{
+    static std::once_flag s_init;
+    std::call_once(s_init, []() {
+        PIEJAM_FX_MODULES_MODEL(gui::FxLimiter, "FxLimiter");
+        internal_id();
+    });
+}
+
+auto
+internal_id() -> runtime::fx::internal_id
+{
+    using namespace std::string_literals;
+
+    static auto const id = register_module(
+        module_registration{
+            .available_for_mono = true,
+            .persistence_name = "limiter"s,
+            .fx_module_factory = &make_module,
+            .fx_component_factory = &make_component,
+            .fx_browser_entry_name = "Limiter",
+            .fx_browser_entry_description =
+                "Limit the peaks of an audio signal, with lookahead.",
+            .fx_module_content_factory =
+                &piejam::gui::model::makeFxModule<gui::FxLimiter>,
+            .viewSource = "/PieJam/FxChainControls/GenericFxModuleView.qml"});
+    return id;
+}
+
+} // namespace piejam::fx_modules::limiter
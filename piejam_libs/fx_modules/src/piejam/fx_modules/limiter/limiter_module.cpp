@@ -0,0 +1,81 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "limiter_module.h"
+
+#include "limiter_internal_id.h"
+
+#include <piejam/numeric/dB_convert.h>
+#include <piejam/runtime/bool_parameter.h>
+#include <piejam/runtime/float_parameter.h>
+#include <piejam/runtime/fx/module.h>
+#include <piejam/runtime/internal_fx_module_factory.h>
+#include <piejam/runtime/parameter/map.h>
+#include <piejam/runtime/parameter_factory.h>
+
+#include <format>
+
+namespace piejam::fx_modules::limiter
+{
+
+namespace
+{
+
+auto
+to_release_string(float const ms) -> std::string
+{
+    return ms < 100.f ? std::format("{:.1f} ms", ms)
+                      : std::format("{:.0f} ms", ms);
+}
+
+} // namespace
+
+auto
+make_module(runtime::internal_fx_module_factory_args const& args)
+    -> runtime::fx::module
+{
+    using namespace std::string_literals;
+
+    runtime::parameter_factory params_factory{args.params};
+
+    return runtime::fx::module{
+        .fx_instance_id = internal_id(),
+        .name = box("Limiter"s),
+        .bus_type = args.bus_type,
+        .parameters =
+            box(runtime::parameters_map{
+                std::in_place_type<parameter_key>,
+                {
+                    {parameter_key::threshold,
+                     params_factory.make_parameter(
+                         runtime::make_float_parameter(
+                             {
+                                 .name = "Threshold",
+                                 .default_value = numeric::from_dB(-1.f),
+                             },
+                             runtime::dB_float_parameter_range<-24.f, 0.f>())
+                             .set_value_to_string(
+                                 &runtime::default_float_to_dB_string))},
+                    {parameter_key::release,
+                     params_factory.make_parameter(
+                         runtime::make_float_parameter(
+                             {
+                                 .name = "Release",
+                                 .default_value = 100.f,
+                             },
+                             runtime::logarithmic_float_parameter_range<
+                                 10.f,
+                                 1000.f>())
+                             .set_value_to_string(&to_release_string))},
+                    {parameter_key::true_peak,
+                     params_factory.make_parameter(
+                         runtime::make_bool_parameter({
+                             .name = "True Peak",
+                             .default_value = true,
+                         }))},
+                }}),
+        .streams = {}};
+}
+
+} // namespace piejam::fx_modules::limiter
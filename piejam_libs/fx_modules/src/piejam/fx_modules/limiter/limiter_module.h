@@ -0,0 +1,29 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/fwd.h>
+#include <piejam/runtime/fx/fwd.h>
+
+#include <chrono>
+
+namespace piejam::fx_modules::limiter
+{
+
+enum class parameter_key : runtime::parameter::key
+{
+    threshold,
+    release,
+    true_peak,
+};
+
+// The output is delayed by the lookahead and the latency of the true peak
+// detection.
+inline constexpr std::chrono::duration<float, std::milli> lookahead{1.5f};
+
+auto make_module(runtime::internal_fx_module_factory_args const&)
+    -> runtime::fx::module;
+
+} // namespace piejam::fx_modules::limiter
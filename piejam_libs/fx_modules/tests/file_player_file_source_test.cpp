@@ -0,0 +1,61 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "wave_file.h"
+
+#include <piejam/fx_modules/file_player/file_source.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace piejam::fx_modules::file_player::test
+{
+
+struct file_player_file_source_test : testing::Test
+{
+    std::filesystem::path file{
+        std::filesystem::temp_directory_path() /
+        "piejam_file_player_file_source_test.wav"};
+
+    ~file_player_file_source_test() override
+    {
+        std::filesystem::remove(file);
+    }
+};
+
+TEST_F(file_player_file_source_test, wave_file_is_read)
+{
+    std::vector<float> const samples{0.5f, -0.5f, 0.25f, -0.25f};
+    write_wave_file(file, 2, samples);
+
+    auto sut = open_file_source(file);
+    ASSERT_EQ(sut->num_channels(), 2u);
+    ASSERT_EQ(sut->num_frames(), 2u);
+    EXPECT_EQ(sut->sample_rate(), audio::sample_rate{48000});
+
+    std::vector<float> result(4);
+    ASSERT_EQ(sut->read(0, result), 2u);
+    EXPECT_EQ(result, samples);
+
+    ASSERT_EQ(sut->read(1, std::span{result}.first(2)), 1u);
+    EXPECT_EQ(result[0], 0.25f);
+}
+
+TEST_F(file_player_file_source_test, truncated_file_ends_early)
+{
+    std::vector<float> const samples(1000, 0.5f);
+    write_wave_file(file, 1, samples);
+
+    auto sut = open_file_source(file);
+    ASSERT_EQ(sut->num_frames(), 1000u);
+
+    std::filesystem::resize_file(file, 44 + 100 * sizeof(float));
+
+    std::vector<float> result(1000);
+    EXPECT_EQ(sut->read(0, result), 100u);
+    EXPECT_EQ(sut->read(500, std::span{result}.first(10)), 0u);
+}
+
+} // namespace piejam::fx_modules::file_player::test
@@ -0,0 +1,171 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "wave_file.h"
+
+#include <piejam/fx_modules/file_player/prefetch_stream.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+namespace piejam::fx_modules::file_player::test
+{
+
+namespace
+{
+
+constexpr std::size_t num_frames{3000};
+
+auto
+make_samples(float const offset) -> std::vector<float>
+{
+    std::vector<float> result(num_frames);
+    for (std::size_t frame = 0; frame < num_frames; ++frame)
+    {
+        result[frame] = offset + static_cast<float>(frame) / num_frames;
+    }
+    return result;
+}
+
+} // namespace
+
+// The prefetch thread and the audio thread are played by the test.
+struct file_player_prefetch_stream_test : testing::Test
+{
+    std::filesystem::path dir{
+        std::filesystem::temp_directory_path() /
+        "piejam_file_player_prefetch_stream_test"};
+    std::filesystem::path file_a{dir / "a.wav"};
+    std::filesystem::path file_b{dir / "b.wav"};
+    std::vector<float> samples_a{make_samples(0.f)};
+    std::vector<float> samples_b{make_samples(-1.f)};
+
+    prefetch_stream sut{1, 4};
+
+    std::vector<float> out = std::vector<float>(num_frames);
+
+    file_player_prefetch_stream_test()
+    {
+        std::filesystem::create_directories(dir);
+        write_wave_file(file_a, 1, samples_a);
+        write_wave_file(file_b, 1, samples_b);
+    }
+
+    ~file_player_prefetch_stream_test() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    auto read(std::size_t const frames) -> std::size_t
+    {
+        std::array const outputs{std::span{out}};
+        return sut.read(outputs, 0, frames);
+    }
+};
+
+TEST_F(file_player_prefetch_stream_test, loaded_file_is_read_to_the_end)
+{
+    sut.load(file_a);
+
+    std::size_t frames{};
+    while (!sut.at_end())
+    {
+        sut.prefetch();
+
+        std::array const outputs{std::span{out}};
+        frames += sut.read(outputs, frames, num_frames - frames);
+    }
+
+    EXPECT_EQ(frames, num_frames);
+    EXPECT_EQ(out, samples_a);
+    EXPECT_EQ(sut.file(), file_a);
+}
+
+TEST_F(file_player_prefetch_stream_test, cue_restarts_at_the_beginning)
+{
+    sut.load(file_a);
+    sut.prefetch();
+    ASSERT_EQ(read(100), 100u);
+
+    sut.cue();
+    sut.prefetch();
+
+    ASSERT_EQ(read(10), 10u);
+    EXPECT_EQ(out[0], samples_a[0]);
+    EXPECT_EQ(out[9], samples_a[9]);
+}
+
+TEST_F(file_player_prefetch_stream_test, blocks_prefetched_before_cue_are_stale)
+{
+    sut.load(file_a);
+    sut.prefetch();
+    ASSERT_EQ(read(100), 100u);
+
+    sut.cue();
+
+    EXPECT_EQ(read(10), 0u);
+    EXPECT_EQ(sut.underruns(), 1u);
+}
+
+TEST_F(file_player_prefetch_stream_test, cue_after_end_of_file_plays_again)
+{
+    sut.load(file_a);
+
+    while (!sut.at_end())
+    {
+        sut.prefetch();
+        read(num_frames);
+    }
+
+    sut.cue();
+    EXPECT_FALSE(sut.at_end());
+
+    sut.prefetch();
+    ASSERT_EQ(read(10), 10u);
+    EXPECT_EQ(out[0], samples_a[0]);
+}
+
+TEST_F(file_player_prefetch_stream_test, loaded_file_replaces_prefetched_one)
+{
+    sut.load(file_a);
+    sut.prefetch();
+    ASSERT_EQ(read(100), 100u);
+
+    sut.load(file_b);
+    sut.prefetch();
+
+    // the blocks of the previous file are handed back to be refilled
+    sut.skip_stale();
+    sut.prefetch();
+
+    ASSERT_EQ(read(10), 10u);
+    EXPECT_EQ(out[0], samples_b[0]);
+    EXPECT_EQ(out[9], samples_b[9]);
+    EXPECT_EQ(sut.file(), file_b);
+}
+
+TEST_F(file_player_prefetch_stream_test, only_the_file_loaded_last_is_opened)
+{
+    sut.load(file_a);
+    sut.load(file_b);
+    sut.prefetch();
+
+    ASSERT_EQ(read(10), 10u);
+    EXPECT_EQ(out[0], samples_b[0]);
+}
+
+TEST_F(file_player_prefetch_stream_test, missing_file_plays_nothing)
+{
+    sut.load(file_a);
+    sut.prefetch();
+
+    sut.load(dir / "missing.wav");
+    sut.prefetch();
+
+    EXPECT_EQ(read(10), 0u);
+}
+
+} // namespace piejam::fx_modules::file_player::test
@@ -0,0 +1,71 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "wave_file.h"
+
+#include <piejam/fx_modules/file_player/prefetch_stream.h>
+#include <piejam/fx_modules/file_player/prefetcher.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace piejam::fx_modules::file_player::test
+{
+
+TEST(file_player_prefetcher, stream_is_shared_per_module)
+{
+    auto const fx_mod_id = runtime::fx::module_id::generate();
+
+    auto const stream = find_or_make_stream(fx_mod_id, 2);
+    EXPECT_EQ(find_or_make_stream(fx_mod_id, 2), stream);
+    EXPECT_NE(
+        find_or_make_stream(runtime::fx::module_id::generate(), 2),
+        stream);
+}
+
+TEST(file_player_prefetcher, stream_with_other_channels_is_replaced)
+{
+    auto const fx_mod_id = runtime::fx::module_id::generate();
+
+    auto const stream = find_or_make_stream(fx_mod_id, 1);
+    auto const replaced = find_or_make_stream(fx_mod_id, 2);
+
+    EXPECT_NE(replaced, stream);
+    EXPECT_EQ(replaced->num_channels(), 2u);
+}
+
+TEST(file_player_prefetcher, loaded_file_is_prefetched_in_background)
+{
+    auto const file = std::filesystem::temp_directory_path() /
+                      "piejam_file_player_prefetcher_test.wav";
+    std::vector<float> const samples(100, 0.5f);
+    write_wave_file(file, 1, samples);
+
+    auto const stream =
+        find_or_make_stream(runtime::fx::module_id::generate(), 1);
+    stream->load(file);
+
+    std::vector<float> out(samples.size());
+    std::array const outputs{std::span{out}};
+
+    std::size_t frames{};
+    auto const deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (!stream->at_end() && std::chrono::steady_clock::now() < deadline)
+    {
+        frames += stream->read(outputs, frames, out.size() - frames);
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    std::filesystem::remove(file);
+
+    EXPECT_EQ(frames, samples.size());
+    EXPECT_EQ(out, samples);
+}
+
+} // namespace piejam::fx_modules::file_player::test
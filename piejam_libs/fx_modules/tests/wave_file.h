@@ -0,0 +1,66 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+
+namespace piejam::fx_modules::file_player::test
+{
+
+// Writes a wave file with 32 bit float samples at 48 kHz.
+inline void
+write_wave_file(
+    std::filesystem::path const& file,
+    std::size_t const num_channels,
+    std::span<float const> const interleaved)
+{
+    auto const data_size =
+        static_cast<std::uint32_t>(interleaved.size() * sizeof(float));
+    auto const block_align =
+        static_cast<std::uint16_t>(num_channels * sizeof(float));
+
+    std::array<unsigned char, 44> header{};
+    auto const tag = [&header](std::size_t const pos, char const* id) {
+        std::copy_n(id, 4, header.begin() + static_cast<std::ptrdiff_t>(pos));
+    };
+
+    tag(0, "RIFF");
+    boost::endian::store_little_u32(&header[4], 36 + data_size);
+    tag(8, "WAVE");
+    tag(12, "fmt ");
+    boost::endian::store_little_u32(&header[16], 16);
+    boost::endian::store_little_u16(&header[20], 3); // ieee float
+    boost::endian::store_little_u16(
+        &header[22],
+        static_cast<std::uint16_t>(num_channels));
+    boost::endian::store_little_u32(&header[24], 48000);
+    boost::endian::store_little_u32(&header[28], 48000 * block_align);
+    boost::endian::store_little_u16(&header[32], block_align);
+    boost::endian::store_little_u16(&header[34], 32);
+    tag(36, "data");
+    boost::endian::store_little_u32(&header[40], data_size);
+
+    std::ofstream out{file, std::ios::binary | std::ios::trunc};
+    out.write(reinterpret_cast<char const*>(header.data()), header.size());
+
+    for (float const sample : interleaved)
+    {
+        std::array<unsigned char, 4> bytes{};
+        boost::endian::store_little_u32(
+            bytes.data(),
+            std::bit_cast<std::uint32_t>(sample));
+        out.write(reinterpret_cast<char const*>(bytes.data()), bytes.size());
+    }
+}
+
+} // namespace piejam::fx_modules::file_player::test
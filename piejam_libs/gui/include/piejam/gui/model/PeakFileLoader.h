@@ -0,0 +1,48 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/gui/model/Waveform.h>
+
+#include <piejam/pimpl.h>
+
+#include <filesystem>
+
+namespace piejam::gui::model
+{
+
+//! Draws the waveform of a recording from its peak file.
+//!
+//! Each pixel is taken from the coarsest level, which still has a bucket per
+//! pixel. So a pixel merges at most about 16 buckets, as long as it covers
+//! less than 16 buckets of the coarsest level (65536 * 16 frames). Zoomed out
+//! further, the buckets per pixel grow with the zoom.
+class PeakFileLoader
+{
+public:
+    //! throws std::system_error, if the recording has no valid peak file.
+    explicit PeakFileLoader(std::filesystem::path const& audioFile);
+
+    [[nodiscard]]
+    auto numChannels() const noexcept -> std::size_t;
+
+    [[nodiscard]]
+    auto numFrames() const noexcept -> std::size_t;
+
+    //! One min/max pair per pixel, for the frames [firstFrame, lastFrame).
+    //! Pixels behind the end of the recording are silent.
+    [[nodiscard]]
+    auto waveform(
+        std::size_t channel,
+        std::size_t firstFrame,
+        std::size_t lastFrame,
+        std::size_t numPixels) const -> Waveform;
+
+private:
+    struct Impl;
+    pimpl<Impl> m_impl;
+};
+
+} // namespace piejam::gui::model
@@ -4,34 +4,43 @@
 
 #pragma once
 
-#include <piejam/algorithm/shift_push_back.h>
 #include <piejam/audio/sample_rate.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
 #include <vector>
 
 namespace piejam::gui::model
 {
 
+// The pitch detection runs on a shared analysis thread. Processing hands the
+// samples over and returns the latest detected frequency, so the result lags
+// at most one call behind.
 class PitchGenerator
 {
 public:
+    // Size of the analysis window, its inverse dft plan is prepared ahead.
+    static constexpr std::size_t windowSize{8192};
+
     explicit PitchGenerator(audio::sample_rate);
 
     template <class Samples>
     auto process(Samples const& samples) -> float
     {
-        algorithm::shift_push_back(m_signal, samples);
-        m_captured_samples += std::ranges::size(samples);
-        return process();
+        std::vector<float> copy;
+        copy.reserve(std::ranges::size(samples));
+        std::ranges::copy(samples, std::back_inserter(copy));
+        return analyze(copy);
     }
 
 private:
-    auto process() -> float;
+    auto analyze(std::span<float const>) -> float;
 
-    std::vector<float> m_signal;
-    std::size_t m_captured_samples{};
-    float m_last_frequency{};
-    audio::sample_rate m_sample_rate;
+    struct Analysis;
+    std::shared_ptr<Analysis> m_analysis;
 };
 
 } // namespace piejam::gui::model
@@ -37,6 +37,22 @@ public:
 
     Q_ENUM(StartupSession)
 
+    enum class RecordingFormat : bool
+    {
+        Wav,
+        Flac,
+    };
+
+    Q_ENUM(RecordingFormat)
+
+    enum class RecordingLayout : bool
+    {
+        FilePerTrack,
+        SingleFile,
+    };
+
+    Q_ENUM(RecordingLayout)
+
 private:
     PIEJAM_GUI_PROPERTY(NewSessionType, newSessionType, setRotation)
     PIEJAM_GUI_PROPERTY(QString, currentSession, setCurrentSession)
@@ -45,6 +61,8 @@ private:
         piejam::gui::model::FileDialog*,
         sessionFileDialog)
     PIEJAM_GUI_PROPERTY(bool, isSessionModified, setSessionModified)
+    PIEJAM_GUI_PROPERTY(RecordingFormat, recordingFormat, setRecordingFormat)
+    PIEJAM_GUI_PROPERTY(RecordingLayout, recordingLayout, setRecordingLayout)
 
 public:
     explicit SessionSettings(
@@ -62,6 +80,8 @@ public:
     Q_INVOKABLE void saveSession(piejam::gui::model::FilePath const&);
 
     Q_INVOKABLE void switchStartupSession(StartupSession);
+    Q_INVOKABLE void switchRecordingFormat(RecordingFormat);
+    Q_INVOKABLE void switchRecordingLayout(RecordingLayout);
 
 private:
     void onSubscribe() override;
@@ -11,27 +11,40 @@
 #include <piejam/audio/fwd.h>
 #include <piejam/pimpl.h>
 
+#include <algorithm>
+#include <ranges>
 #include <vector>
 
 namespace piejam::gui::model
 {
 
+enum class SpectrumMode
+{
+    // One DFT over the latest block, one data point per bin.
+    Bins,
+    // Averaged half-overlapping segments (Welch), reduced to log-spaced
+    // bands.
+    Analyzer,
+};
+
 class SpectrumGenerator
 {
 public:
     explicit SpectrumGenerator(
         audio::sample_rate,
-        DFTResolution = DFTResolution::Low);
+        DFTResolution = DFTResolution::Low,
+        SpectrumMode = SpectrumMode::Analyzer);
 
     template <class Samples>
     auto process(Samples const& samples) -> SpectrumDataPoints
     {
         algorithm::shift_push_back(m_dftPrepareBuffer, samples);
-        return process();
+        return process(
+            std::min(std::ranges::size(samples), m_dftPrepareBuffer.size()));
     }
 
 private:
-    auto process() -> SpectrumDataPoints;
+    auto process(std::size_t numNewSamples) -> SpectrumDataPoints;
 
     struct Impl;
     pimpl<Impl> m_impl;
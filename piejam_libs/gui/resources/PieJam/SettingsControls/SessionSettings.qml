@@ -291,6 +291,66 @@ SubscribableItem {
             }
         }
 
+        Frame {
+            Layout.fillWidth: true
+            Layout.preferredHeight: 144
+
+            spacing: 0
+
+            ColumnLayout {
+                anchors.fill: parent
+
+                Label {
+                    Layout.fillWidth: true
+
+                    textFormat: Text.PlainText
+                    font.pixelSize: 18
+
+                    text: qsTr("Recording")
+                }
+
+                RowLayout {
+                    Layout.fillWidth: true
+
+                    RadioButton {
+                        text: "WAV"
+
+                        checked: root.model && root.model.recordingFormat === PJModels.SessionSettings.RecordingFormat.Wav
+
+                        onClicked: root.model.switchRecordingFormat(PJModels.SessionSettings.RecordingFormat.Wav)
+                    }
+
+                    RadioButton {
+                        text: "FLAC"
+
+                        checked: root.model && root.model.recordingFormat === PJModels.SessionSettings.RecordingFormat.Flac
+
+                        onClicked: root.model.switchRecordingFormat(PJModels.SessionSettings.RecordingFormat.Flac)
+                    }
+                }
+
+                RowLayout {
+                    Layout.fillWidth: true
+
+                    RadioButton {
+                        text: "File per track"
+
+                        checked: root.model && root.model.recordingLayout === PJModels.SessionSettings.RecordingLayout.FilePerTrack
+
+                        onClicked: root.model.switchRecordingLayout(PJModels.SessionSettings.RecordingLayout.FilePerTrack)
+                    }
+
+                    RadioButton {
+                        text: "Single file"
+
+                        checked: root.model && root.model.recordingLayout === PJModels.SessionSettings.RecordingLayout.SingleFile
+
+                        onClicked: root.model.switchRecordingLayout(PJModels.SessionSettings.RecordingLayout.SingleFile)
+                    }
+                }
+            }
+        }
+
         Item {
             Layout.fillWidth: true
             Layout.fillHeight: true
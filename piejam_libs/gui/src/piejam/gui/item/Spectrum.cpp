@@ -86,6 +86,7 @@ struct Spectrum::Impl
         float const height)
     {
         std::vector<QPointF> result;
+        result.reserve(dataPoints.size());
 
         for (auto const& dataPoint : dataPoints)
         {
@@ -0,0 +1,117 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/gui/model/PeakFileLoader.h>
+
+#include <piejam/runtime/recorder/peak_file.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace piejam::gui::model
+{
+
+namespace
+{
+
+auto
+toY(std::int16_t const value) noexcept -> float
+{
+    return std::clamp(static_cast<float>(value) / 32767.f, -1.f, 1.f);
+}
+
+} // namespace
+
+struct PeakFileLoader::Impl
+{
+    runtime::recorder::peak_file peaks;
+};
+
+PeakFileLoader::PeakFileLoader(std::filesystem::path const& audioFile)
+    : m_impl{make_pimpl<Impl>(
+          runtime::recorder::peak_file{
+              runtime::recorder::peak_file_path(audioFile)})}
+{
+}
+
+auto
+PeakFileLoader::numChannels() const noexcept -> std::size_t
+{
+    return m_impl->peaks.num_channels();
+}
+
+auto
+PeakFileLoader::numFrames() const noexcept -> std::size_t
+{
+    return m_impl->peaks.num_frames();
+}
+
+auto
+PeakFileLoader::waveform(
+    std::size_t const channel,
+    std::size_t const firstFrame,
+    std::size_t const lastFrame,
+    std::size_t const numPixels) const -> Waveform
+{
+    BOOST_ASSERT(channel < numChannels());
+    BOOST_ASSERT(firstFrame <= lastFrame);
+
+    Waveform result;
+    result.reserve(numPixels);
+
+    if (numPixels == 0)
+    {
+        return result;
+    }
+
+    auto const& peaks = m_impl->peaks;
+
+    double const framesPerPixel =
+        static_cast<double>(lastFrame - firstFrame) /
+        static_cast<double>(numPixels);
+    std::size_t const level = runtime::recorder::peak_level_for(framesPerPixel);
+    std::size_t const framesPerBucket =
+        runtime::recorder::peak_level_frames_per_bucket[level];
+    std::size_t const numBuckets = peaks.num_buckets(level);
+
+    for (std::size_t pixel = 0; pixel < numPixels; ++pixel)
+    {
+        std::size_t const pixelFirstFrame =
+            firstFrame + static_cast<std::size_t>(pixel * framesPerPixel);
+        std::size_t const pixelLastFrame = std::max(
+            firstFrame +
+                static_cast<std::size_t>((pixel + 1) * framesPerPixel),
+            pixelFirstFrame + 1);
+
+        std::size_t const firstBucket = pixelFirstFrame / framesPerBucket;
+        std::size_t const lastBucket = std::min(
+            (pixelLastFrame + framesPerBucket - 1) / framesPerBucket,
+            numBuckets);
+
+        if (firstBucket >= lastBucket)
+        {
+            result.push_back(0.f, 0.f);
+            continue;
+        }
+
+        std::int16_t min{std::numeric_limits<std::int16_t>::max()};
+        std::int16_t max{std::numeric_limits<std::int16_t>::min()};
+
+        for (std::size_t bucket = firstBucket; bucket < lastBucket; ++bucket)
+        {
+            auto const& p = peaks.peaks(level, bucket)[channel];
+            min = std::min(min, p.min);
+            max = std::max(max, p.max);
+        }
+
+        result.push_back(toY(min), toY(max));
+    }
+
+    return result;
+}
+
+} // namespace piejam::gui::model
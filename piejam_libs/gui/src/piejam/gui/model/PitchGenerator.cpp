@@ -4,8 +4,12 @@
 
 #include <piejam/gui/model/PitchGenerator.h>
 
-#include <piejam/audio/dsp/pitch_yin.h>
-#include <piejam/numeric/simd/rms.h>
+#include <piejam/audio/dsp/pitch_tracker.h>
+#include <piejam/thread/worker.h>
+
+#include <atomic>
+#include <mutex>
+#include <utility>
 
 namespace piejam::gui::model
 {
@@ -13,36 +17,94 @@ namespace piejam::gui::model
 namespace
 {
 
-inline constexpr std::size_t windowSize{8192};
-inline constexpr std::size_t captureSize{4096};
+auto
+analysisThread() -> thread::worker&
+{
+    static thread::worker s_worker{thread::configuration{
+        .affinity = std::nullopt,
+        .realtime_priority = std::nullopt,
+        .name = "analysis"}};
+    return s_worker;
+}
 
 } // namespace
 
-PitchGenerator::PitchGenerator(audio::sample_rate sample_rate)
-    : m_signal(windowSize)
-    , m_sample_rate{sample_rate}
+struct PitchGenerator::Analysis
 {
-}
+    explicit Analysis(audio::sample_rate sample_rate)
+        : tracker{windowSize, sample_rate}
+    {
+    }
 
-auto
-PitchGenerator::process() -> float
-{
-    if (m_captured_samples >= captureSize)
+    // Returns true, if the analysis needs to be scheduled.
+    auto push(std::span<float const> const samples) -> bool
     {
-        if (numeric::simd::rms(m_signal) < 0.001f) // -60 dB
+        std::lock_guard const lock{mutex};
+
+        pending.insert(pending.end(), samples.begin(), samples.end());
+
+        // the tracker can't use more than a window, if the analysis lags
+        // behind
+        if (pending.size() > windowSize)
         {
-            m_last_frequency = 0.f;
+            pending.erase(
+                pending.begin(),
+                std::next(
+                    pending.begin(),
+                    static_cast<std::ptrdiff_t>(pending.size() - windowSize)));
         }
-        else
+
+        return !std::exchange(scheduled, true);
+    }
+
+    // Called on the analysis thread.
+    void run()
+    {
+        while (true)
         {
-            m_last_frequency =
-                audio::dsp::pitch_yin<float>(m_signal, m_sample_rate);
+            {
+                std::lock_guard const lock{mutex};
+
+                if (pending.empty())
+                {
+                    scheduled = false;
+                    return;
+                }
+
+                std::swap(samples, pending);
+                pending.clear();
+            }
+
+            frequency.store(
+                tracker.process(samples),
+                std::memory_order_relaxed);
         }
+    }
+
+    audio::dsp::pitch_tracker tracker;
+    std::vector<float> samples;
+
+    std::mutex mutex;
+    std::vector<float> pending;
+    bool scheduled{};
+
+    std::atomic<float> frequency{};
+};
 
-        m_captured_samples %= captureSize;
+PitchGenerator::PitchGenerator(audio::sample_rate sample_rate)
+    : m_analysis{std::make_shared<Analysis>(sample_rate)}
+{
+}
+
+auto
+PitchGenerator::analyze(std::span<float const> const samples) -> float
+{
+    if (m_analysis->push(samples))
+    {
+        analysisThread().post([analysis = m_analysis]() { analysis->run(); });
     }
 
-    return m_last_frequency;
+    return m_analysis->frequency.load(std::memory_order_relaxed);
 }
 
 } // namespace piejam::gui::model
@@ -7,6 +7,7 @@
 #include <piejam/gui/model/FileDialog.h>
 
 #include <piejam/enum.h>
+#include <piejam/runtime/actions/recording.h>
 #include <piejam/runtime/actions/session_actions.h>
 #include <piejam/runtime/selectors.h>
 
@@ -68,6 +69,18 @@ SessionSettings::onSubscribe()
     observe(
         runtime::selectors::select_session_modified,
         std::bind_front(&SessionSettings::setSessionModified, this));
+
+    observe(
+        runtime::selectors::select_recording_format,
+        [this](runtime::recording_format const recording_format) {
+            setRecordingFormat(bool_enum_to<RecordingFormat>(recording_format));
+        });
+
+    observe(
+        runtime::selectors::select_recording_layout,
+        [this](runtime::recording_layout const recording_layout) {
+            setRecordingLayout(bool_enum_to<RecordingLayout>(recording_layout));
+        });
 }
 
 void
@@ -132,4 +145,20 @@ SessionSettings::switchStartupSession(StartupSession startupSession)
     dispatch(action);
 }
 
+void
+SessionSettings::switchRecordingFormat(RecordingFormat recordingFormat)
+{
+    runtime::actions::set_recording_format action;
+    action.format = bool_enum_to<runtime::recording_format>(recordingFormat);
+    dispatch(action);
+}
+
+void
+SessionSettings::switchRecordingLayout(RecordingLayout recordingLayout)
+{
+    runtime::actions::set_recording_layout action;
+    action.layout = bool_enum_to<runtime::recording_layout>(recordingLayout);
+    dispatch(action);
+}
+
 } // namespace piejam::gui::model
@@ -4,16 +4,19 @@
 
 #include <piejam/gui/model/SpectrumGenerator.h>
 
-#include <piejam/algorithm/transform_to_vector.h>
 #include <piejam/audio/sample_rate.h>
-#include <piejam/numeric/dB_convert.h>
 #include <piejam/numeric/dft.h>
 #include <piejam/numeric/generators/cosine_window.h>
+#include <piejam/numeric/simd/math.h>
+#include <piejam/numeric/simd/norm.h>
 #include <piejam/range/iota.h>
 
 #include <boost/assert.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <numeric>
 #include <vector>
 
 namespace piejam::gui::model
@@ -22,6 +25,14 @@ namespace piejam::gui::model
 namespace
 {
 
+constexpr float s_minBandFrequency{10.f};
+constexpr float s_maxBandFrequency{20000.f};
+constexpr float s_bandsPerOctave{24.f};
+
+constexpr std::size_t s_numAveragedSegments{4};
+
+constexpr float s_minLevel{1.e-20f};
+
 auto
 dftForResolution(DFTResolution const resolution) -> numeric::dft&
 {
@@ -54,14 +65,68 @@ dftForResolution(DFTResolution const resolution) -> numeric::dft&
     }
 }
 
+// Half-open range of dft bins, which are combined into one band.
+struct Band
+{
+    std::size_t firstBin{};
+    std::size_t lastBin{};
+
+    constexpr auto operator==(Band const&) const noexcept -> bool = default;
+};
+
+auto
+makeBands(std::size_t const numBins, float const binSize) -> std::vector<Band>
+{
+    BOOST_ASSERT(numBins > 1);
+
+    auto const toBin = [=](float const frequency) {
+        return std::min(
+            static_cast<std::size_t>(std::lround(frequency / binSize)),
+            numBins);
+    };
+
+    float const bandRatio = std::exp2(1.f / s_bandsPerOctave);
+    float const halfBandRatio = std::sqrt(bandRatio);
+    float const maxFrequency = std::min(
+        s_maxBandFrequency,
+        static_cast<float>(numBins - 1) * binSize);
+
+    std::vector<Band> bands;
+
+    for (float center = s_minBandFrequency; center <= maxFrequency;
+         center *= bandRatio)
+    {
+        Band band{
+            .firstBin =
+                std::clamp(toBin(center / halfBandRatio), 1uz, numBins - 1),
+            .lastBin = toBin(center * halfBandRatio)};
+        band.lastBin = std::max(band.lastBin, band.firstBin + 1);
+
+        // bands narrower than a bin collapse onto the same bin
+        if (bands.empty() || bands.back() != band)
+        {
+            bands.push_back(band);
+        }
+    }
+
+    return bands;
+}
+
 } // namespace
 
 struct SpectrumGenerator::Impl
 {
-    explicit Impl(audio::sample_rate sample_rate, DFTResolution dftResolution)
-        : m_dft{dftForResolution(dftResolution)}
+    Impl(
+        audio::sample_rate sample_rate,
+        DFTResolution dftResolution,
+        SpectrumMode mode)
+        : m_mode{mode}
+        , m_dft{dftForResolution(dftResolution)}
         , m_window(m_dft.size())
-        , m_dataPoints(m_dft.output_size())
+        , m_segmentPowers(
+              mode == SpectrumMode::Analyzer ? s_numAveragedSegments : 1,
+              std::vector<float>(m_dft.output_size()))
+        , m_averagedPower(m_dft.output_size())
     {
         std::ranges::generate(
             m_window,
@@ -69,10 +134,32 @@ struct SpectrumGenerator::Impl
 
         float const binSize =
             sample_rate.as<float>() / static_cast<float>(m_dft.size());
-        for (std::size_t const i : range::iota(m_dft.output_size()))
+
+        switch (m_mode)
         {
-            m_dataPoints[i].frequency_Hz = static_cast<float>(i) * binSize;
+            case SpectrumMode::Bins:
+                m_dataPoints.resize(m_dft.output_size());
+                for (std::size_t const i : range::iota(m_dft.output_size()))
+                {
+                    m_dataPoints[i].frequency_Hz =
+                        static_cast<float>(i) * binSize;
+                }
+                break;
+
+            case SpectrumMode::Analyzer:
+                m_bands = makeBands(m_dft.output_size(), binSize);
+                m_dataPoints.resize(m_bands.size());
+                for (std::size_t const i : range::iota(m_bands.size()))
+                {
+                    Band const& band = m_bands[i];
+                    m_dataPoints[i].frequency_Hz =
+                        static_cast<float>(band.firstBin + band.lastBin - 1) *
+                        0.5f * binSize;
+                }
+                break;
         }
+
+        m_levels_dB.resize(m_dataPoints.size());
     }
 
     static constexpr auto envelope(float const prev, float const in) noexcept
@@ -82,62 +169,194 @@ struct SpectrumGenerator::Impl
         return in > prev ? in : in + 0.85f * (prev - in);
     }
 
-    auto process(std::span<float const> samples) -> SpectrumDataPoints
+    [[nodiscard]]
+    auto historySize() const noexcept -> std::size_t
+    {
+        return m_dft.size() + (m_segmentPowers.size() - 1) * hopSize();
+    }
+
+    [[nodiscard]]
+    auto hopSize() const noexcept -> std::size_t
+    {
+        return m_dft.size() / 2;
+    }
+
+    auto process(std::span<float const> history, std::size_t numNewSamples)
+        -> SpectrumDataPoints
+    {
+        BOOST_ASSERT(history.size() == historySize());
+
+        switch (m_mode)
+        {
+            case SpectrumMode::Bins:
+                return processBins(history);
+
+            case SpectrumMode::Analyzer:
+                return processAnalyzer(history, numNewSamples);
+        }
+
+        return m_dataPoints;
+    }
+
+    void computePower(std::span<float const> segment, std::span<float> power)
     {
-        BOOST_ASSERT(samples.size() == m_window.size());
-        BOOST_ASSERT(samples.size() == m_dft.input_buffer().size());
+        BOOST_ASSERT(segment.size() == m_window.size());
+        BOOST_ASSERT(segment.size() == m_dft.input_buffer().size());
 
         std::transform(
-            samples.begin(),
-            samples.end(),
+            segment.begin(),
+            segment.end(),
             m_window.begin(),
             m_dft.input_buffer().begin(),
             std::multiplies<>{});
 
         auto const spectrum = m_dft.process();
 
-        BOOST_ASSERT(spectrum.size() == m_dft.output_size());
+        BOOST_ASSERT(spectrum.size() == power.size());
+        numeric::simd::norm(spectrum, power);
+    }
+
+    auto processBins(std::span<float const> history) -> SpectrumDataPoints
+    {
+        std::span<float> const power = m_segmentPowers.front();
+        computePower(history.last(m_dft.size()), power);
+
         BOOST_ASSERT(m_dataPoints.size() == m_dft.output_size());
 
         auto const dft_size = static_cast<float>(m_dft.size());
         auto const two_div_dft_size = 2.f / dft_size;
 
-        constexpr auto min_level = 1.e-20f;
-
-        m_dataPoints[0].level =
-            envelope(m_dataPoints[0].level, std::abs(spectrum[0]) / dft_size);
-        m_dataPoints[0].level_dB =
-            numeric::to_dB(m_dataPoints[0].level, min_level);
+        m_dataPoints[0].level = envelope(
+            m_dataPoints[0].level,
+            std::sqrt(power[0]) / dft_size);
 
         for (std::size_t i = 1, e = m_dft.output_size(); i < e; ++i)
         {
             m_dataPoints[i].level = envelope(
                 m_dataPoints[i].level,
-                std::abs(spectrum[i]) * two_div_dft_size);
-            m_dataPoints[i].level_dB =
-                numeric::to_dB(m_dataPoints[i].level, min_level);
+                std::sqrt(power[i]) * two_div_dft_size);
         }
 
+        updateLevels_dB();
+
         return m_dataPoints;
     }
 
+    auto processAnalyzer(
+        std::span<float const> history,
+        std::size_t numNewSamples) -> SpectrumDataPoints
+    {
+        std::size_t const hop = hopSize();
+        std::size_t const maxSegments = m_segmentPowers.size();
+
+        m_pendingSamples =
+            std::min(m_pendingSamples + numNewSamples, history.size());
+
+        std::size_t const numSegments =
+            std::min(m_pendingSamples / hop, maxSegments);
+
+        // Nothing new to average, the bands from the last frame still hold.
+        if (numSegments == 0)
+        {
+            return m_dataPoints;
+        }
+
+        m_pendingSamples -= numSegments * hop;
+
+        for (std::size_t k = numSegments; k-- > 0;)
+        {
+            computePower(
+                history.subspan(
+                    history.size() - m_dft.size() - k * hop,
+                    m_dft.size()),
+                m_segmentPowers[m_nextSegment]);
+
+            m_nextSegment = (m_nextSegment + 1) % maxSegments;
+            m_numFilledSegments = std::min(m_numFilledSegments + 1, maxSegments);
+        }
+
+        std::ranges::copy(m_segmentPowers.front(), m_averagedPower.begin());
+        for (std::size_t i = 1; i < m_numFilledSegments; ++i)
+        {
+            std::ranges::transform(
+                m_averagedPower,
+                m_segmentPowers[i],
+                m_averagedPower.begin(),
+                std::plus<>{});
+        }
+
+        auto const two_div_dft_size = 2.f / static_cast<float>(m_dft.size());
+        auto const amplitude_scale =
+            two_div_dft_size /
+            std::sqrt(static_cast<float>(m_numFilledSegments));
+
+        BOOST_ASSERT(m_dataPoints.size() == m_bands.size());
+
+        for (std::size_t const i : range::iota(m_bands.size()))
+        {
+            Band const& band = m_bands[i];
+
+            float const bandPower =
+                std::reduce(
+                    std::next(m_averagedPower.begin(), band.firstBin),
+                    std::next(m_averagedPower.begin(), band.lastBin)) /
+                static_cast<float>(band.lastBin - band.firstBin);
+
+            m_dataPoints[i].level = envelope(
+                m_dataPoints[i].level,
+                std::sqrt(bandPower) * amplitude_scale);
+        }
+
+        updateLevels_dB();
+
+        return m_dataPoints;
+    }
+
+    // All levels at once, the conversion vectorizes.
+    void updateLevels_dB()
+    {
+        std::ranges::transform(
+            m_dataPoints,
+            m_levels_dB.begin(),
+            &SpectrumDataPoint::level);
+
+        numeric::simd::to_dB(m_levels_dB, m_levels_dB, s_minLevel);
+
+        for (std::size_t const i : range::iota(m_dataPoints.size()))
+        {
+            m_dataPoints[i].level_dB = m_levels_dB[i];
+        }
+    }
+
+    SpectrumMode m_mode;
     numeric::dft& m_dft;
     std::vector<float> m_window;
+
+    std::vector<std::vector<float>> m_segmentPowers;
+    std::vector<float> m_averagedPower;
+    std::size_t m_nextSegment{};
+    std::size_t m_numFilledSegments{};
+    std::size_t m_pendingSamples{};
+
+    std::vector<Band> m_bands;
     std::vector<SpectrumDataPoint> m_dataPoints;
+    std::vector<float> m_levels_dB;
 };
 
 SpectrumGenerator::SpectrumGenerator(
     audio::sample_rate sample_rate,
-    DFTResolution dftResolution)
-    : m_impl{make_pimpl<Impl>(sample_rate, dftResolution)}
-    , m_dftPrepareBuffer(m_impl->m_dft.size())
+    DFTResolution dftResolution,
+    SpectrumMode mode)
+    : m_impl{make_pimpl<Impl>(sample_rate, dftResolution, mode)}
+    , m_dftPrepareBuffer(m_impl->historySize())
 {
 }
 
 auto
-SpectrumGenerator::process() -> SpectrumDataPoints
+SpectrumGenerator::process(std::size_t const numNewSamples)
+    -> SpectrumDataPoints
 {
-    return m_impl->process(m_dftPrepareBuffer);
+    return m_impl->process(m_dftPrepareBuffer, numNewSamples);
 }
 
 } // namespace piejam::gui::model
@@ -0,0 +1,176 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/gui/model/PeakFileLoader.h>
+
+#include <piejam/runtime/recorder/peak_file.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace piejam::gui::model::test
+{
+
+namespace
+{
+
+using runtime::recorder::num_peak_levels;
+using runtime::recorder::peak;
+using runtime::recorder::peak_level_frames_per_bucket;
+
+using levels_t = std::array<std::vector<peak>, num_peak_levels>;
+
+// Mono peak file, a level without buckets is left out, as in an interrupted
+// file.
+void
+writePeakFile(
+    std::filesystem::path const& audioFile,
+    std::size_t const numFrames,
+    levels_t const& levels)
+{
+    runtime::recorder::peak_file_header header{
+        .num_channels = 1,
+        .sample_rate = audio::sample_rate{48000},
+        .num_frames = numFrames,
+    };
+
+    std::size_t offset{runtime::recorder::peak_file_header::size};
+    for (std::size_t level = 0; level < num_peak_levels; ++level)
+    {
+        header.num_buckets[level] = levels[level].size();
+        header.offsets[level] = offset;
+        offset += levels[level].size() * sizeof(peak);
+    }
+
+    std::ofstream out{
+        runtime::recorder::peak_file_path(audioFile),
+        std::ios::binary};
+
+    auto const headerBytes = header.encode();
+    out.write(
+        reinterpret_cast<char const*>(headerBytes.data()),
+        static_cast<std::streamsize>(headerBytes.size()));
+
+    for (auto const& level : levels)
+    {
+        out.write(
+            reinterpret_cast<char const*>(level.data()),
+            static_cast<std::streamsize>(level.size() * sizeof(peak)));
+    }
+}
+
+// Every bucket of a level holds the same peak.
+auto
+uniformLevel(
+    std::size_t const numFrames,
+    std::size_t const level,
+    std::int16_t const value) -> std::vector<peak>
+{
+    std::size_t const framesPerBucket = peak_level_frames_per_bucket[level];
+    return std::vector<peak>(
+        (numFrames + framesPerBucket - 1) / framesPerBucket,
+        peak{.min = static_cast<std::int16_t>(-value), .max = value});
+}
+
+auto
+uniformWaveform(std::size_t const numPixels, std::int16_t const value)
+    -> Waveform
+{
+    float const y = static_cast<float>(value) / 32767.f;
+
+    Waveform result;
+    for (std::size_t pixel = 0; pixel < numPixels; ++pixel)
+    {
+        result.push_back(-y, y);
+    }
+
+    return result;
+}
+
+} // namespace
+
+struct PeakFileLoaderTest : testing::Test
+{
+    std::filesystem::path audioFile{
+        std::filesystem::temp_directory_path() /
+        "piejam_PeakFileLoader_test.wav"};
+
+    ~PeakFileLoaderTest() override
+    {
+        std::filesystem::remove(runtime::recorder::peak_file_path(audioFile));
+    }
+};
+
+TEST_F(PeakFileLoaderTest, level_is_chosen_by_zoom)
+{
+    // the levels differ, to tell which one is drawn
+    constexpr std::size_t numFrames{4 * 65536};
+    writePeakFile(
+        audioFile,
+        numFrames,
+        {uniformLevel(numFrames, 0, 100),
+         uniformLevel(numFrames, 1, 200),
+         uniformLevel(numFrames, 2, 300)});
+
+    PeakFileLoader const sut{audioFile};
+    EXPECT_EQ(sut.numChannels(), 1u);
+    EXPECT_EQ(sut.numFrames(), numFrames);
+
+    // 64, 256, 4096 and 65536 frames per pixel
+    EXPECT_EQ(sut.waveform(0, 0, numFrames, 4096), uniformWaveform(4096, 100));
+    EXPECT_EQ(sut.waveform(0, 0, numFrames, 1024), uniformWaveform(1024, 100));
+    EXPECT_EQ(sut.waveform(0, 0, numFrames, 64), uniformWaveform(64, 200));
+    EXPECT_EQ(sut.waveform(0, 0, numFrames, 4), uniformWaveform(4, 300));
+
+    // a section zoomed in
+    EXPECT_EQ(
+        sut.waveform(0, 65536, 2 * 65536, 16),
+        uniformWaveform(16, 200));
+}
+
+TEST_F(PeakFileLoaderTest, pixels_past_the_end_are_silent)
+{
+    constexpr std::size_t numFrames{1000};
+    writePeakFile(
+        audioFile,
+        numFrames,
+        {uniformLevel(numFrames, 0, 100),
+         uniformLevel(numFrames, 1, 100),
+         uniformLevel(numFrames, 2, 100)});
+
+    PeakFileLoader const sut{audioFile};
+
+    // 256 frames per pixel, the last bucket is partial
+    auto expected = uniformWaveform(4, 100);
+    expected.push_back(0.f, 0.f);
+    expected.push_back(0.f, 0.f);
+    expected.push_back(0.f, 0.f);
+    expected.push_back(0.f, 0.f);
+
+    EXPECT_EQ(sut.waveform(0, 0, 2048, 8), expected);
+    EXPECT_EQ(sut.waveform(0, 4096, 8192, 2), uniformWaveform(2, 0));
+}
+
+TEST_F(PeakFileLoaderTest, interrupted_file_is_drawn_from_the_finest_level)
+{
+    constexpr std::size_t numFrames{2 * 65536};
+    auto finest = uniformLevel(numFrames, 0, 100);
+    finest[300] = peak{.min = -5000, .max = 5000};
+    writePeakFile(audioFile, numFrames, {std::move(finest), {}, {}});
+
+    PeakFileLoader const sut{audioFile};
+    EXPECT_EQ(sut.numFrames(), numFrames);
+
+    // the coarser levels are built, bucket 300 is in the second pixel
+    Waveform expected = uniformWaveform(1, 100);
+    expected.push_back(-5000.f / 32767.f, 5000.f / 32767.f);
+
+    EXPECT_EQ(sut.waveform(0, 0, numFrames, 2), expected);
+}
+
+} // namespace piejam::gui::model::test
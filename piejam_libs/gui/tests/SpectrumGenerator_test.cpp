@@ -0,0 +1,82 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/gui/model/SpectrumGenerator.h>
+
+#include <piejam/audio/sample_rate.h>
+#include <piejam/numeric/generators/sine.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace piejam::gui::model::test
+{
+
+namespace
+{
+
+constexpr audio::sample_rate sample_rate{48000u};
+
+auto
+sine(float frequency, std::size_t size) -> std::vector<float>
+{
+    std::vector<float> result(size);
+    std::ranges::generate(
+        result,
+        numeric::generators::sine<float>{
+            frequency,
+            sample_rate.as<float>(),
+            1.f});
+    return result;
+}
+
+} // namespace
+
+TEST(SpectrumGenerator, analyzer_reduces_to_log_spaced_bands)
+{
+    SpectrumGenerator sut{
+        sample_rate,
+        DFTResolution::VeryHigh,
+        SpectrumMode::Analyzer};
+
+    auto const dataPoints = sut.process(sine(1000.f, 1024));
+
+    EXPECT_LT(dataPoints.size(), 300u);
+    EXPECT_TRUE(std::ranges::is_sorted(
+        dataPoints,
+        std::less<>{},
+        &SpectrumDataPoint::frequency_Hz));
+}
+
+TEST(SpectrumGenerator, analyzer_peak_is_at_sine_frequency)
+{
+    SpectrumGenerator sut{
+        sample_rate,
+        DFTResolution::Medium,
+        SpectrumMode::Analyzer};
+
+    auto const dataPoints = sut.process(sine(1000.f, 16384));
+
+    auto const peak =
+        std::ranges::max_element(dataPoints, {}, &SpectrumDataPoint::level);
+    ASSERT_NE(peak, dataPoints.end());
+
+    // within a 1/24 octave band
+    EXPECT_NEAR(1000.f, peak->frequency_Hz, 1000.f * 0.03f);
+    EXPECT_GT(peak->level_dB, -12.f);
+}
+
+TEST(SpectrumGenerator, bins_emits_one_data_point_per_bin)
+{
+    SpectrumGenerator sut{sample_rate, DFTResolution::Low, SpectrumMode::Bins};
+
+    auto const dataPoints = sut.process(sine(1000.f, 2048));
+
+    EXPECT_EQ(1025u, dataPoints.size());
+}
+
+} // namespace piejam::gui::model::test
@@ -6,6 +6,8 @@
 
 #include <piejam/ladspa/fwd.h>
 
+#include <piejam/audio/engine/fwd.h>
+
 #include <span>
 
 namespace piejam::ladspa
@@ -22,6 +24,12 @@ public:
     [[nodiscard]]
     virtual auto control_inputs(instance_id const&) const
         -> std::span<port_descriptor const> = 0;
+
+    //! Default event quantization for the instance, from the measured
+    //! overhead of its run calls.
+    [[nodiscard]]
+    virtual auto measure_event_quantization(instance_id const&) const
+        -> audio::engine::event_quantization = 0;
 };
 
 } // namespace piejam::ladspa
@@ -32,7 +32,14 @@ public:
     auto control_inputs(instance_id const&) const
         -> std::span<port_descriptor const> override;
 
-    auto make_processor(instance_id const&, audio::sample_rate)
+    [[nodiscard]]
+    auto measure_event_quantization(instance_id const&) const
+        -> audio::engine::event_quantization override;
+
+    auto make_processor(
+        instance_id const&,
+        audio::sample_rate,
+        audio::engine::event_quantization)
         -> std::unique_ptr<audio::engine::processor> override;
 
 private:
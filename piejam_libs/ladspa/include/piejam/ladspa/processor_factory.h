@@ -19,7 +19,10 @@ class processor_factory
 public:
     virtual ~processor_factory() = default;
 
-    virtual auto make_processor(instance_id const&, audio::sample_rate)
+    virtual auto make_processor(
+        instance_id const&,
+        audio::sample_rate,
+        audio::engine::event_quantization)
         -> std::unique_ptr<audio::engine::processor> = 0;
 };
 
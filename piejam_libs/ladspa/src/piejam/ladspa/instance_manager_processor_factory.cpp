@@ -7,6 +7,7 @@
 #include <piejam/ladspa/plugin.h>
 #include <piejam/ladspa/plugin_descriptor.h>
 
+#include <piejam/audio/engine/event_quantization.h>
 #include <piejam/audio/engine/processor.h>
 #include <piejam/audio/sample_rate.h>
 #include <piejam/entity_id_hash.h>
@@ -56,15 +57,28 @@ instance_manager_processor_factory::control_inputs(instance_id const& id) const
     return {};
 }
 
+auto
+instance_manager_processor_factory::measure_event_quantization(
+    instance_id const& id) const -> audio::engine::event_quantization
+{
+    if (auto it = m_instances.find(id); it != m_instances.end())
+    {
+        return it->second->measure_event_quantization();
+    }
+
+    return audio::engine::sample_accurate_events;
+}
+
 auto
 instance_manager_processor_factory::make_processor(
     instance_id const& id,
-    audio::sample_rate const sample_rate)
+    audio::sample_rate const sample_rate,
+    audio::engine::event_quantization const event_quantization)
     -> std::unique_ptr<audio::engine::processor>
 {
     if (auto it = m_instances.find(id); it != m_instances.end())
     {
-        return it->second->make_processor(sample_rate);
+        return it->second->make_processor(sample_rate, event_quantization);
     }
 
     return {};
@@ -10,6 +10,7 @@
 #include <piejam/algorithm/transform_to_vector.h>
 #include <piejam/audio/engine/event_input_buffers.h>
 #include <piejam/audio/engine/event_port.h>
+#include <piejam/audio/engine/event_quantization.h>
 #include <piejam/audio/engine/process_context.h>
 #include <piejam/audio/engine/processor.h>
 #include <piejam/audio/period_size.h>
@@ -28,6 +29,7 @@
 #include <boost/numeric/conversion/cast.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <stdexcept>
 #include <variant>
@@ -406,18 +408,23 @@ private:
     advance_t m_advance{};
 };
 
+// The plugin is run once per slice between the control input events, so
+// every event costs another connect_port and run call. With a coarser event
+// quantization, events closer together share a slice and the last one wins.
 class processor final : public audio::engine::processor
 {
 public:
     processor(
         plugin_instance instance,
         std::string_view name,
+        audio::engine::event_quantization const event_quantization,
         std::span<port_descriptor const> audio_inputs,
         std::span<port_descriptor const> audio_outputs,
         std::span<port_descriptor const> control_inputs,
         std::span<port_descriptor const> control_outputs)
         : m_instance(std::move(instance))
         , m_name(name)
+        , m_event_quantization(event_quantization)
         , m_input_port_indices(audio_inputs.size())
         , m_output_port_indices(audio_outputs.size())
         , m_event_inputs(to_event_ports(control_inputs))
@@ -510,7 +517,7 @@ public:
         std::size_t offset{};
         while (offset < ctx.buffer_size)
         {
-            std::size_t const min_offset = std::min(
+            std::size_t const min_offset = quantize(
                 std::ranges::min(
                     m_control_inputs,
                     std::less<>{},
@@ -554,7 +561,8 @@ public:
 
             for (control_input& ci : m_control_inputs)
             {
-                while (min_offset == ci.offset())
+                while (ci.offset() < ctx.buffer_size &&
+                       m_event_quantization.quantize(ci.offset()) == min_offset)
                 {
                     ci.advance();
                 }
@@ -567,8 +575,18 @@ public:
     }
 
 private:
+    // Offsets past the buffer, npos if there are no more events, are clamped
+    // to the buffer size.
+    auto quantize(std::size_t const offset, std::size_t const buffer_size)
+        const noexcept -> std::size_t
+    {
+        return offset < buffer_size ? m_event_quantization.quantize(offset)
+                                    : buffer_size;
+    }
+
     plugin_instance m_instance;
     std::string m_name;
+    audio::engine::event_quantization m_event_quantization;
     std::vector<unsigned long> m_input_port_indices{};
     std::vector<unsigned long> m_output_port_indices{};
     std::vector<audio::engine::event_port> m_event_inputs;
@@ -656,7 +674,114 @@ public:
         return m_ports.input.control;
     }
 
-    auto make_processor(audio::sample_rate const sample_rate) const
+    auto measure_event_quantization() const
+        -> audio::engine::event_quantization override
+    {
+        LADSPA_Handle handle = m_ladspa_desc->instantiate(
+            m_ladspa_desc,
+            measurement_sample_rate.value());
+        if (!handle)
+        {
+            return audio::engine::sample_accurate_events;
+        }
+
+        plugin_instance instance(*m_ladspa_desc, handle);
+
+        // silent audio and the default control values
+        std::size_t const num_audio_ports =
+            m_ports.input.audio.size() + m_ports.output.audio.size();
+        std::vector<float> audio_buffer(
+            num_audio_ports * audio::max_period_size.value());
+        float* audio_data = audio_buffer.data();
+        for (auto const* ports : {&m_ports.input.audio, &m_ports.output.audio})
+        {
+            for (port_descriptor const& pd : *ports)
+            {
+                instance.connect_port(pd.index, audio_data);
+                audio_data += audio::max_period_size.value();
+            }
+        }
+
+        std::vector<float> control_values;
+        control_values.reserve(
+            m_ports.input.control.size() + m_ports.output.control.size());
+        for (port_descriptor const& pd : m_ports.input.control)
+        {
+            instance.connect_port(
+                pd.index,
+                &control_values.emplace_back(std::visit(
+                    [](auto const& port) {
+                        return static_cast<float>(port.default_value);
+                    },
+                    pd.type_desc)));
+        }
+
+        for (port_descriptor const& pd : m_ports.output.control)
+        {
+            instance.connect_port(pd.index, &control_values.emplace_back());
+        }
+
+        instance.activate();
+
+        using clock = std::chrono::steady_clock;
+
+        // Runs the instance num_samples at a time, in batches of batch_size
+        // runs, until max_runs are done or the deadline has passed. Returns
+        // the nanoseconds per sample.
+        auto const time_runs = [&](std::size_t const max_runs,
+                                   std::size_t const num_samples,
+                                   std::size_t const batch_size,
+                                   clock::time_point const deadline) {
+            auto const start = clock::now();
+            auto now = start;
+            std::size_t num_runs{};
+            do
+            {
+                for (std::size_t n = 0; n < batch_size; ++n)
+                {
+                    instance.run(static_cast<unsigned long>(num_samples));
+                }
+
+                num_runs += batch_size;
+                now = clock::now();
+            } while (num_runs < max_runs && now < deadline);
+
+            return std::chrono::duration<double, std::nano>(now - start)
+                       .count() /
+                   static_cast<double>(num_runs * num_samples);
+        };
+
+        // The measurement runs on the thread inserting the plugin, so it is
+        // bounded in time. Heavy plugins get fewer runs, their overhead per
+        // run is small compared to their cost per sample anyway.
+        auto const start = clock::now();
+
+        // warm up the caches
+        time_runs(1, audio::max_period_size.value(), 1, start);
+
+        // whole periods vs. one run per sample
+        double const cost_per_sample = time_runs(
+            num_period_runs,
+            audio::max_period_size.value(),
+            1,
+            start + measurement_time_budget / 2);
+        double const cost_per_run = time_runs(
+            audio::max_period_size.value(),
+            1,
+            single_sample_batch_size,
+            start + measurement_time_budget);
+
+        instance.deactivate();
+        instance.cleanup();
+
+        return audio::engine::event_quantization_for_overhead(
+            cost_per_run - cost_per_sample,
+            cost_per_sample);
+    }
+
+    auto make_processor(
+        audio::sample_rate const sample_rate,
+        audio::engine::event_quantization const event_quantization) const
         -> std::unique_ptr<audio::engine::processor> override
     {
         if (LADSPA_Handle handle =
@@ -665,6 +790,7 @@ public:
             return std::make_unique<processor>(
                 plugin_instance(*m_ladspa_desc, handle),
                 m_pd.name,
+                event_quantization,
                 m_ports.input.audio,
                 m_ports.output.audio,
                 m_ports.input.control,
@@ -675,6 +801,12 @@ public:
     }
 
 private:
+    // the overhead of a run call hardly depends on the sample rate
+    static constexpr audio::sample_rate measurement_sample_rate{48000u};
+    static constexpr std::chrono::milliseconds measurement_time_budget{10};
+    static constexpr std::size_t num_period_runs{8};
+    static constexpr std::size_t single_sample_batch_size{64};
+
     static auto throw_if_null(LADSPA_Descriptor const* d)
         -> LADSPA_Descriptor const*
     {
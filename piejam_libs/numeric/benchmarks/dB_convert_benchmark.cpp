@@ -0,0 +1,101 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/numeric/dB_convert.h>
+#include <piejam/numeric/simd/math.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+namespace piejam::numeric
+{
+
+namespace
+{
+
+// levels from -120 dB to 0 dB
+auto
+random_levels(std::size_t const size) -> std::vector<float>
+{
+    std::srand(std::time(nullptr));
+
+    std::vector<float> result(size);
+    std::ranges::generate(result, []() {
+        return from_dB(
+            -120.f * static_cast<float>(std::rand()) /
+            static_cast<float>(RAND_MAX));
+    });
+    return result;
+}
+
+} // namespace
+
+static void
+BM_to_dB_scalar(benchmark::State& state)
+{
+    auto const in = random_levels(state.range(0));
+    std::vector<float> out(in.size());
+
+    for (auto _ : state)
+    {
+        std::ranges::transform(in, out.begin(), [](float const x) {
+            return to_dB(x, 1e-20f);
+        });
+        benchmark::ClobberMemory();
+    }
+}
+
+static void
+BM_to_dB_simd(benchmark::State& state)
+{
+    auto const in = random_levels(state.range(0));
+    std::vector<float> out(in.size());
+
+    for (auto _ : state)
+    {
+        simd::to_dB(in, out, 1e-20f);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void
+BM_from_dB_scalar(benchmark::State& state)
+{
+    std::vector<float> in = random_levels(state.range(0));
+    std::ranges::transform(in, in.begin(), [](float x) { return to_dB(x); });
+    std::vector<float> out(in.size());
+
+    for (auto _ : state)
+    {
+        std::ranges::transform(in, out.begin(), [](float const x) {
+            return from_dB(x);
+        });
+        benchmark::ClobberMemory();
+    }
+}
+
+static void
+BM_from_dB_simd(benchmark::State& state)
+{
+    std::vector<float> in = random_levels(state.range(0));
+    std::ranges::transform(in, in.begin(), [](float x) { return to_dB(x); });
+    std::vector<float> out(in.size());
+
+    for (auto _ : state)
+    {
+        simd::from_dB(in, out);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_to_dB_scalar)->RangeMultiplier(4)->Range(64, 8192);
+BENCHMARK(BM_to_dB_simd)->RangeMultiplier(4)->Range(64, 8192);
+BENCHMARK(BM_from_dB_scalar)->RangeMultiplier(4)->Range(64, 8192);
+BENCHMARK(BM_from_dB_simd)->RangeMultiplier(4)->Range(64, 8192);
+
+} // namespace piejam::numeric
@@ -0,0 +1,59 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/numeric/dft.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <complex>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+namespace piejam::numeric
+{
+
+static void
+BM_dft(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    dft sut(state.range(0));
+
+    std::ranges::generate(sut.input_buffer(), []() {
+        return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+    });
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sut.process());
+    }
+}
+
+static void
+BM_dft_inverse(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    dft sut(state.range(0));
+
+    std::ranges::generate(sut.input_buffer(), []() {
+        return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+    });
+    auto const spectrum = sut.process();
+    std::vector<std::complex<float>> const in(spectrum.begin(), spectrum.end());
+
+    for (auto _ : state)
+    {
+        // the inverse destroys its input
+        std::ranges::copy(in, sut.output_buffer().begin());
+        benchmark::DoNotOptimize(sut.process_inverse());
+    }
+}
+
+BENCHMARK(BM_dft)->RangeMultiplier(2)->Range(256, 8192);
+BENCHMARK(BM_dft_inverse)->RangeMultiplier(2)->Range(256, 8192);
+
+} // namespace piejam::numeric
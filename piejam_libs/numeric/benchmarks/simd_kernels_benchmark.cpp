@@ -0,0 +1,124 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/numeric/simd/isa.h>
+#include <piejam/numeric/simd/kernels.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+namespace piejam::numeric::simd
+{
+
+constexpr auto min_period_size = 16;
+constexpr auto max_period_size = 1024;
+
+static auto
+select(benchmark::State& state, isa_level const level) -> bool
+{
+    if (!select_isa_level(level))
+    {
+        state.SkipWithError("isa level not supported");
+        return false;
+    }
+
+    return true;
+}
+
+static auto
+random_buffer(std::size_t const size) -> std::vector<float>
+{
+    std::srand(std::time(nullptr));
+
+    std::vector<float> buf(size);
+    for (auto& x : buf)
+    {
+        x = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+    }
+    return buf;
+}
+
+static void
+BM_simd_kernels_multiply(benchmark::State& state, isa_level const level)
+{
+    if (!select(state, level))
+    {
+        return;
+    }
+
+    auto const l = random_buffer(state.range(0));
+    auto const r = random_buffer(state.range(0));
+    std::vector<float> out(state.range(0));
+
+    for (auto _ : state)
+    {
+        kernels().multiply(l.data(), r.data(), out.data(), out.size());
+        benchmark::ClobberMemory();
+    }
+
+    select_isa_level(detect_isa_level());
+}
+
+static void
+BM_simd_kernels_sum_of_squares(benchmark::State& state, isa_level const level)
+{
+    if (!select(state, level))
+    {
+        return;
+    }
+
+    auto const in = random_buffer(state.range(0));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            kernels().sum_of_squares(in.data(), in.size()));
+    }
+
+    select_isa_level(detect_isa_level());
+}
+
+// stereo interleaved
+static void
+BM_simd_kernels_s32_to_float(benchmark::State& state, isa_level const level)
+{
+    if (!select(state, level))
+    {
+        return;
+    }
+
+    std::vector<std::int32_t> in(2 * state.range(0), 1 << 20);
+    std::vector<float> out(state.range(0));
+
+    for (auto _ : state)
+    {
+        kernels().s32_to_float(in.data(), 2, out.data(), out.size());
+        benchmark::ClobberMemory();
+    }
+
+    select_isa_level(detect_isa_level());
+}
+
+#define PIEJAM_SIMD_KERNELS_BENCHMARK(name, level)                             \
+    BENCHMARK_CAPTURE(name, level, isa_level::level)                           \
+        ->RangeMultiplier(4)                                                   \
+        ->Range(min_period_size, max_period_size)
+
+PIEJAM_SIMD_KERNELS_BENCHMARK(BM_simd_kernels_multiply, generic);
+PIEJAM_SIMD_KERNELS_BENCHMARK(BM_simd_kernels_multiply, avx2);
+PIEJAM_SIMD_KERNELS_BENCHMARK(BM_simd_kernels_multiply, neon);
+PIEJAM_SIMD_KERNELS_BENCHMARK(BM_simd_kernels_sum_of_squares, generic);
+PIEJAM_SIMD_KERNELS_BENCHMARK(BM_simd_kernels_sum_of_squares, avx2);
+PIEJAM_SIMD_KERNELS_BENCHMARK(BM_simd_kernels_sum_of_squares, neon);
+PIEJAM_SIMD_KERNELS_BENCHMARK(BM_simd_kernels_s32_to_float, generic);
+PIEJAM_SIMD_KERNELS_BENCHMARK(BM_simd_kernels_s32_to_float, avx2);
+PIEJAM_SIMD_KERNELS_BENCHMARK(BM_simd_kernels_s32_to_float, neon);
+
+#undef PIEJAM_SIMD_KERNELS_BENCHMARK
+
+} // namespace piejam::numeric::simd
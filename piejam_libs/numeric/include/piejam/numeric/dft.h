@@ -23,9 +23,15 @@ public:
     auto input_buffer() const noexcept -> std::span<float>;
     [[nodiscard]]
     auto output_size() const noexcept -> std::size_t;
+    [[nodiscard]]
+    auto output_buffer() const noexcept -> std::span<std::complex<float>>;
 
     auto process() -> std::span<std::complex<float> const>;
 
+    // Unnormalized inverse transform of output_buffer() into input_buffer().
+    // The contents of output_buffer() are destroyed.
+    auto process_inverse() -> std::span<float const>;
+
 private:
     struct impl;
     std::unique_ptr<impl> m_impl;
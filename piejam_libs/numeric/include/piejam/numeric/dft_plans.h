@@ -0,0 +1,32 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+// Plans used by numeric::dft are created once per size and shared between all
+// dft instances and threads. Since planning is expensive, the accumulated
+// FFTW wisdom can be persisted and plans can be created ahead of time.
+namespace piejam::numeric::dft_plans
+{
+
+enum class direction : bool
+{
+    forward,
+    inverse,
+};
+
+// Returns false, if the wisdom file doesn't exist or couldn't be read.
+auto import_wisdom(std::filesystem::path const&) -> bool;
+auto export_wisdom(std::filesystem::path const&) -> bool;
+
+// Creates the plans for the given sizes, if they don't exist yet. Can be
+// called from a background thread.
+void prepare(
+    std::span<std::size_t const> sizes,
+    direction = direction::forward);
+
+} // namespace piejam::numeric::dft_plans
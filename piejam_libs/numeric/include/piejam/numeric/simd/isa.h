@@ -0,0 +1,46 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// The kernels in simd/kernels.h are compiled for several instruction sets.
+// The best one the cpu supports is selected on first use, from CPUID on x86
+// and HWCAP on arm.
+namespace piejam::numeric::simd
+{
+
+enum class isa_level : std::uint8_t
+{
+    generic, // baseline of the build target, includes NEON on aarch64
+    avx2,    // x86_64 with AVX2 and FMA
+    neon,    // 32 bit arm with NEON
+};
+
+[[nodiscard]]
+auto to_string(isa_level) noexcept -> std::string_view;
+
+// The levels the kernels are compiled for, in ascending order.
+[[nodiscard]]
+auto compiled_isa_levels() noexcept -> std::span<isa_level const>;
+
+// Returns true, if the level is compiled in and the cpu supports it.
+[[nodiscard]]
+auto is_supported(isa_level) noexcept -> bool;
+
+// The best supported level.
+[[nodiscard]]
+auto detect_isa_level() noexcept -> isa_level;
+
+[[nodiscard]]
+auto active_isa_level() noexcept -> isa_level;
+
+// Forces the kernels of a level, e.g. to test each one. Returns false and
+// keeps the active level, if the level is not supported.
+auto select_isa_level(isa_level) noexcept -> bool;
+
+} // namespace piejam::numeric::simd
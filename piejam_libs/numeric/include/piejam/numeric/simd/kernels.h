@@ -0,0 +1,95 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace piejam::numeric::simd
+{
+
+// Hot loops, compiled once per isa_level. The pointers don't need to be
+// aligned. Strides are in samples.
+struct kernel_table
+{
+    // out = l + r
+    void (*add)(
+        float const* l,
+        float const* r,
+        float* out,
+        std::size_t size) noexcept;
+
+    // out = in + c
+    void (*add_constant)(
+        float const* in,
+        float c,
+        float* out,
+        std::size_t size) noexcept;
+
+    // out = l * r
+    void (*multiply)(
+        float const* l,
+        float const* r,
+        float* out,
+        std::size_t size) noexcept;
+
+    // out = in * c
+    void (*multiply_constant)(
+        float const* in,
+        float c,
+        float* out,
+        std::size_t size) noexcept;
+
+    // sum of in^2
+    float (*sum_of_squares)(float const* in, std::size_t size) noexcept;
+
+    // sum of (l - r)^2
+    float (*sqr_difference_sum)(
+        float const* l,
+        float const* r,
+        std::size_t size) noexcept;
+
+    // native endian pcm samples to float in [-1, 1)
+    void (*s16_to_float)(
+        std::int16_t const* in,
+        std::ptrdiff_t in_stride,
+        float* out,
+        std::size_t size) noexcept;
+
+    void (*s32_to_float)(
+        std::int32_t const* in,
+        std::ptrdiff_t in_stride,
+        float* out,
+        std::size_t size) noexcept;
+
+    // out = 20 log10(in), -inf where in <= min_lin, see simd/math.h
+    void (*to_dB)(
+        float const* in,
+        float min_lin,
+        float* out,
+        std::size_t size) noexcept;
+
+    // out = 10^(in / 20), see simd/math.h
+    void (*from_dB)(float const* in, float* out, std::size_t size) noexcept;
+
+    // float to native endian pcm samples, clamped to [-1, 1)
+    void (*float_to_s16)(
+        float const* in,
+        std::int16_t* out,
+        std::ptrdiff_t out_stride,
+        std::size_t size) noexcept;
+
+    void (*float_to_s32)(
+        float const* in,
+        std::int32_t* out,
+        std::ptrdiff_t out_stride,
+        std::size_t size) noexcept;
+};
+
+// The kernels of the active isa_level.
+[[nodiscard]]
+auto kernels() noexcept -> kernel_table const&;
+
+} // namespace piejam::numeric::simd
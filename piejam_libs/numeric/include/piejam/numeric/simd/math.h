@@ -4,14 +4,45 @@
 
 #pragma once
 
+#include <piejam/numeric/simd/kernels.h>
+
 #include <mipp.h>
 
+#include <boost/assert.hpp>
 #include <boost/hof/lift.hpp>
 
+#include <span>
+
 namespace piejam::numeric::simd
 {
 
 inline constexpr auto abs = BOOST_HOF_LIFT(mipp::abs);
 inline constexpr auto max = BOOST_HOF_LIFT(mipp::max);
 
+// Vectorized numeric::to_dB(lin, min_lin), using a polynomial log2. The
+// absolute error is below 1e-5 dB, plus 1e-5 dB per 100 dB of distance from
+// 0 dB. Values below the smallest normal float are converted as if they were
+// it. lin and dB may be the same.
+inline void
+to_dB(
+    std::span<float const> const lin,
+    std::span<float> const dB,
+    float const min_lin = 0.f) noexcept
+{
+    BOOST_ASSERT(lin.size() == dB.size());
+    BOOST_ASSERT(min_lin >= 0.f);
+    kernels().to_dB(lin.data(), min_lin, dB.data(), dB.size());
+}
+
+// Vectorized numeric::from_dB, using a polynomial exp2. The relative error is
+// below 1e-6 within +-200 dB, beyond it grows with the rounding of the scaled
+// dB value. Results below -758 dB are flushed to zero. dB and lin may be the
+// same.
+inline void
+from_dB(std::span<float const> const dB, std::span<float> const lin) noexcept
+{
+    BOOST_ASSERT(dB.size() == lin.size());
+    kernels().from_dB(dB.data(), lin.data(), lin.size());
+}
+
 } // namespace piejam::numeric::simd
@@ -0,0 +1,57 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/numeric/mipp.h>
+
+#include <boost/assert.hpp>
+
+#include <complex>
+#include <concepts>
+#include <span>
+
+namespace piejam::numeric::simd
+{
+
+namespace detail
+{
+
+struct norm_fn
+{
+    // Squared magnitudes of interleaved complex values. Input and output don't
+    // need to be aligned.
+    template <std::floating_point T>
+    void operator()(
+        std::span<std::complex<T> const> const in,
+        std::span<T> const out) const noexcept
+    {
+        BOOST_ASSERT(in.size() == out.size());
+
+        constexpr std::size_t N = mipp::N<T>();
+
+        auto const* in_data = reinterpret_cast<T const*>(in.data());
+        std::size_t const main_size = (in.size() / N) * N;
+
+        for (std::size_t i = 0; i < main_size; i += N)
+        {
+            mipp::Reg<T> lo = mipp::loadu(in_data + 2 * i);
+            mipp::Reg<T> hi = mipp::loadu(in_data + 2 * i + N);
+
+            mipp::Regx2<T> const re_im = mipp::deinterleave(lo * lo, hi * hi);
+            mipp::storeu(out.data() + i, re_im[0] + re_im[1]);
+        }
+
+        for (std::size_t i = main_size; i < in.size(); ++i)
+        {
+            out[i] = std::norm(in[i]);
+        }
+    }
+};
+
+} // namespace detail
+
+inline constexpr detail::norm_fn norm{};
+
+} // namespace piejam::numeric::simd
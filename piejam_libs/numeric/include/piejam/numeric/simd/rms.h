@@ -5,12 +5,14 @@
 #pragma once
 
 #include <piejam/numeric/mipp_iterator.h>
+#include <piejam/numeric/simd/kernels.h>
 #include <piejam/numeric/pow_n.h>
 
 #include <cmath>
 #include <concepts>
 #include <numeric>
 #include <ranges>
+#include <type_traits>
 
 namespace piejam::numeric::simd
 {
@@ -31,17 +33,28 @@ struct rms_fn
             return T{};
         }
 
-        auto const rng = mipp_range(std::span{in});
-
-        return std::sqrt(
-            mipp::sum(
-                std::transform_reduce(
-                    std::ranges::begin(rng),
-                    std::ranges::end(rng),
-                    mipp::Reg<T>(T{}),
-                    std::plus<>{},
-                    pow_n<2>)) /
-            std::ranges::size(in));
+        if constexpr (std::is_same_v<T, float>)
+        {
+            return std::sqrt(
+                kernels().sum_of_squares(
+                    std::ranges::data(in),
+                    std::ranges::size(in)) /
+                std::ranges::size(in));
+        }
+        else
+        {
+            auto const rng = mipp_range(std::span{in});
+
+            return std::sqrt(
+                mipp::sum(
+                    std::transform_reduce(
+                        std::ranges::begin(rng),
+                        std::ranges::end(rng),
+                        mipp::Reg<T>(T{}),
+                        std::plus<>{},
+                        pow_n<2>)) /
+                std::ranges::size(in));
+        }
     }
 };
 
@@ -0,0 +1,99 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace piejam::numeric
+{
+
+//! Maximum of the last window_size values, in amortized O(1) per value.
+//!
+//! A monotonic deque keeps the candidates for the maximum, their values are
+//! decreasing from front to back. A pushed value removes all the candidates
+//! it dominates, the front expires when it leaves the window. The deque is
+//! stored in a ring of window_size entries, pushing never allocates.
+template <class T>
+class sliding_max
+{
+public:
+    explicit sliding_max(std::size_t const window_size)
+        : m_entries(window_size)
+    {
+        BOOST_ASSERT(window_size > 0);
+    }
+
+    [[nodiscard]]
+    auto window_size() const noexcept -> std::size_t
+    {
+        return m_entries.size();
+    }
+
+    //! Pushes a value and returns the maximum of the window ending with it.
+    [[nodiscard]]
+    auto operator()(T const& x) noexcept -> T
+    {
+        if (m_size != 0 && m_entries[m_front].index + window_size() <= m_index)
+        {
+            m_front = next(m_front);
+            --m_size;
+        }
+
+        while (m_size != 0 && !(x < m_entries[back()].value))
+        {
+            --m_size;
+        }
+
+        m_entries[m_size == 0 ? m_front : next(back())] = {m_index, x};
+        ++m_size;
+        ++m_index;
+
+        return m_entries[m_front].value;
+    }
+
+    //! The maximum of the current window.
+    [[nodiscard]]
+    auto max() const noexcept -> T const&
+    {
+        BOOST_ASSERT(m_size != 0);
+        return m_entries[m_front].value;
+    }
+
+    void reset() noexcept
+    {
+        m_front = 0;
+        m_size = 0;
+    }
+
+private:
+    struct entry
+    {
+        std::size_t index{};
+        T value{};
+    };
+
+    [[nodiscard]]
+    auto next(std::size_t const pos) const noexcept -> std::size_t
+    {
+        return pos + 1 == window_size() ? 0 : pos + 1;
+    }
+
+    [[nodiscard]]
+    auto back() const noexcept -> std::size_t
+    {
+        std::size_t const pos = m_front + m_size - 1;
+        return pos < window_size() ? pos : pos - window_size();
+    }
+
+    std::vector<entry> m_entries;
+    std::size_t m_front{};
+    std::size_t m_size{};
+    std::size_t m_index{};
+};
+
+} // namespace piejam::numeric
@@ -3,11 +3,15 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <piejam/numeric/dft.h>
+#include <piejam/numeric/dft_plans.h>
 
 #include <fftw3.h>
 
 #include <boost/assert.hpp>
 
+#include <map>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace piejam::numeric
@@ -41,34 +45,126 @@ struct fftwf_plan_deleter
     }
 };
 
-} // namespace
+static_assert(sizeof(std::complex<float>) == sizeof(fftwf_complex));
 
-struct dft::impl
+template <class T>
+using fftwf_vector = std::vector<T, fftwf_allocator<T>>;
+using fftwf_real_vector = fftwf_vector<float>;
+using fftwf_complex_vector = fftwf_vector<std::complex<float>>;
+using fftwf_plan_unique_ptr =
+    std::unique_ptr<std::remove_pointer_t<fftwf_plan>, fftwf_plan_deleter>;
+
+// The FFTW planner isn't thread-safe, executing a plan is. Plans are created
+// on scratch buffers and executed on the buffers of the dft instances. All
+// buffers come from fftwf_malloc and therefore share the alignment.
+//
+// Planning is serialized by its own mutex and happens outside of the cache
+// mutex, so looking up an existing plan never waits for a plan which is
+// being created ahead in the background.
+class plan_cache
 {
-    static_assert(sizeof(std::complex<float>) == sizeof(fftwf_complex));
+public:
+    static auto instance() -> plan_cache&
+    {
+        static plan_cache s_instance;
+        return s_instance;
+    }
+
+    using direction = dft_plans::direction;
+
+    auto get(std::size_t const size, direction const dir = direction::forward)
+        -> fftwf_plan
+    {
+        if (fftwf_plan const plan = find(size, dir))
+        {
+            return plan;
+        }
+
+        std::lock_guard planner_lock{m_planner_mutex};
+
+        // might have been created while waiting for the planner
+        if (fftwf_plan const plan = find(size, dir))
+        {
+            return plan;
+        }
+
+        auto plan = make_plan(size, dir);
+
+        std::lock_guard lock{m_mutex};
+        return m_plans.emplace(std::pair{size, dir}, std::move(plan))
+            .first->second.get();
+    }
+
+    auto import_wisdom(std::filesystem::path const& file) -> bool
+    {
+        std::lock_guard planner_lock{m_planner_mutex};
+        return fftwf_import_wisdom_from_filename(file.c_str()) != 0;
+    }
+
+    auto export_wisdom(std::filesystem::path const& file) -> bool
+    {
+        std::lock_guard planner_lock{m_planner_mutex};
+        return fftwf_export_wisdom_to_filename(file.c_str()) != 0;
+    }
 
-    template <class T>
-    using fftwf_vector = std::vector<T, fftwf_allocator<T>>;
-    using fftwf_real_vector = fftwf_vector<float>;
-    using fftwf_complex_vector = fftwf_vector<std::complex<float>>;
-    using fftwf_plan_unique_ptr =
-        std::unique_ptr<std::remove_pointer_t<fftwf_plan>, fftwf_plan_deleter>;
+private:
+    static auto make_plan(std::size_t const size, direction const dir)
+        -> fftwf_plan_unique_ptr
+    {
+        fftwf_real_vector real(size);
+        fftwf_complex_vector complex(size / 2 + 1);
+
+        switch (dir)
+        {
+            case direction::forward:
+                return fftwf_plan_unique_ptr{fftwf_plan_dft_r2c_1d(
+                    static_cast<int>(size),
+                    real.data(),
+                    reinterpret_cast<fftwf_complex*>(complex.data()),
+                    FFTW_PATIENT)};
+
+            case direction::inverse:
+                return fftwf_plan_unique_ptr{fftwf_plan_dft_c2r_1d(
+                    static_cast<int>(size),
+                    reinterpret_cast<fftwf_complex*>(complex.data()),
+                    real.data(),
+                    FFTW_PATIENT)};
+        }
+
+        return nullptr;
+    }
+
+    auto find(std::size_t const size, direction const dir) -> fftwf_plan
+    {
+        std::lock_guard lock{m_mutex};
 
+        auto const it = m_plans.find({size, dir});
+        return it != m_plans.end() ? it->second.get() : nullptr;
+    }
+
+    std::mutex m_planner_mutex;
+    std::mutex m_mutex;
+    std::map<std::pair<std::size_t, direction>, fftwf_plan_unique_ptr>
+        m_plans;
+};
+
+} // namespace
+
+struct dft::impl
+{
     std::size_t input_size{};
     std::size_t output_size{input_size / 2 + 1};
 
     fftwf_real_vector in_buffer{fftwf_real_vector(input_size)};
     fftwf_complex_vector out_buffer{fftwf_complex_vector(output_size)};
-    fftwf_plan_unique_ptr plan{fftwf_plan_dft_r2c_1d(
-        input_size,
-        in_buffer.data(),
-        reinterpret_cast<fftwf_complex*>(out_buffer.data()),
-        FFTW_MEASURE)};
+    fftwf_plan plan{plan_cache::instance().get(input_size)};
+    fftwf_plan inverse_plan{};
 };
 
 dft::dft(std::size_t const size)
     : m_impl(std::make_unique<impl>(size))
 {
+    BOOST_ASSERT(m_impl->plan);
 }
 
 dft::~dft() = default;
@@ -91,11 +187,63 @@ dft::output_size() const noexcept -> std::size_t
     return m_impl->output_size;
 }
 
+auto
+dft::output_buffer() const noexcept -> std::span<std::complex<float>>
+{
+    return m_impl->out_buffer;
+}
+
 auto
 dft::process() -> std::span<std::complex<float> const>
 {
-    fftwf_execute(m_impl->plan.get());
+    fftwf_execute_dft_r2c(
+        m_impl->plan,
+        m_impl->in_buffer.data(),
+        reinterpret_cast<fftwf_complex*>(m_impl->out_buffer.data()));
     return m_impl->out_buffer;
 }
 
+auto
+dft::process_inverse() -> std::span<float const>
+{
+    if (!m_impl->inverse_plan)
+    {
+        m_impl->inverse_plan = plan_cache::instance().get(
+            m_impl->input_size,
+            plan_cache::direction::inverse);
+    }
+
+    fftwf_execute_dft_c2r(
+        m_impl->inverse_plan,
+        reinterpret_cast<fftwf_complex*>(m_impl->out_buffer.data()),
+        m_impl->in_buffer.data());
+    return m_impl->in_buffer;
+}
+
+namespace dft_plans
+{
+
+auto
+import_wisdom(std::filesystem::path const& file) -> bool
+{
+    return plan_cache::instance().import_wisdom(file);
+}
+
+auto
+export_wisdom(std::filesystem::path const& file) -> bool
+{
+    return plan_cache::instance().export_wisdom(file);
+}
+
+void
+prepare(std::span<std::size_t const> const sizes, direction const dir)
+{
+    for (std::size_t const size : sizes)
+    {
+        plan_cache::instance().get(size, dir);
+    }
+}
+
+} // namespace dft_plans
+
 } // namespace piejam::numeric
@@ -0,0 +1,156 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/numeric/simd/isa.h>
+
+#include "kernel_tables.h"
+
+#include <piejam/numeric/simd/kernels.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <tuple>
+
+#if defined(PIEJAM_NUMERIC_SIMD_NEON)
+#include <sys/auxv.h>
+#endif
+
+namespace piejam::numeric::simd
+{
+
+namespace
+{
+
+struct isa_kernels
+{
+    isa_level level;
+    kernel_table const* table;
+};
+
+constexpr std::array s_compiled{
+    isa_kernels{isa_level::generic, &kernels_generic::table},
+#if defined(PIEJAM_NUMERIC_SIMD_AVX2)
+    isa_kernels{isa_level::avx2, &kernels_avx2::table},
+#endif
+#if defined(PIEJAM_NUMERIC_SIMD_NEON)
+    isa_kernels{isa_level::neon, &kernels_neon::table},
+#endif
+};
+
+constexpr auto s_compiled_levels = std::apply(
+    [](auto const&... k) { return std::array{k.level...}; },
+    s_compiled);
+
+auto
+cpu_supports(isa_level const level) noexcept -> bool
+{
+    switch (level)
+    {
+        case isa_level::generic:
+            return true;
+
+        case isa_level::avx2:
+#if defined(__x86_64__)
+            return __builtin_cpu_supports("avx2") &&
+                   __builtin_cpu_supports("fma");
+#else
+            return false;
+#endif
+
+        case isa_level::neon:
+#if defined(PIEJAM_NUMERIC_SIMD_NEON)
+            return (getauxval(AT_HWCAP) & HWCAP_ARM_NEON) != 0;
+#else
+            return false;
+#endif
+    }
+
+    return false;
+}
+
+auto
+find(isa_level const level) noexcept -> isa_kernels const*
+{
+    auto it = std::ranges::find(s_compiled, level, &isa_kernels::level);
+    return it != s_compiled.end() ? &*it : nullptr;
+}
+
+// Selected on first use, the kernels are only switched by tests.
+auto
+active() noexcept -> std::atomic<isa_kernels const*>&
+{
+    static std::atomic<isa_kernels const*> s_active{
+        find(detect_isa_level())};
+    return s_active;
+}
+
+} // namespace
+
+auto
+to_string(isa_level const level) noexcept -> std::string_view
+{
+    switch (level)
+    {
+        case isa_level::generic:
+            return "generic";
+        case isa_level::avx2:
+            return "avx2";
+        case isa_level::neon:
+            return "neon";
+    }
+
+    return "unknown";
+}
+
+auto
+compiled_isa_levels() noexcept -> std::span<isa_level const>
+{
+    return s_compiled_levels;
+}
+
+auto
+is_supported(isa_level const level) noexcept -> bool
+{
+    return find(level) && cpu_supports(level);
+}
+
+auto
+detect_isa_level() noexcept -> isa_level
+{
+    auto it = std::ranges::find_if(
+        s_compiled.rbegin(),
+        s_compiled.rend(),
+        [](isa_kernels const& k) { return cpu_supports(k.level); });
+    BOOST_ASSERT(it != s_compiled.rend());
+    return it->level;
+}
+
+auto
+active_isa_level() noexcept -> isa_level
+{
+    return active().load(std::memory_order_relaxed)->level;
+}
+
+auto
+select_isa_level(isa_level const level) noexcept -> bool
+{
+    if (!is_supported(level))
+    {
+        return false;
+    }
+
+    active().store(find(level), std::memory_order_relaxed);
+    return true;
+}
+
+auto
+kernels() noexcept -> kernel_table const&
+{
+    return *active().load(std::memory_order_relaxed)->table;
+}
+
+} // namespace piejam::numeric::simd
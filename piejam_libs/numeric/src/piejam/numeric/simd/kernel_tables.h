@@ -0,0 +1,28 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/numeric/simd/kernels.h>
+
+// Defined by the kernels_<level>.cpp, which are compiled for the target.
+namespace piejam::numeric::simd
+{
+
+namespace kernels_generic
+{
+extern kernel_table const table;
+} // namespace kernels_generic
+
+namespace kernels_avx2
+{
+extern kernel_table const table;
+} // namespace kernels_avx2
+
+namespace kernels_neon
+{
+extern kernel_table const table;
+} // namespace kernels_neon
+
+} // namespace piejam::numeric::simd
@@ -0,0 +1,8 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define PIEJAM_NUMERIC_SIMD_KERNELS_NAMESPACE kernels_generic
+#define PIEJAM_NUMERIC_SIMD_KERNELS_VECTOR_SIZE 16
+
+#include "kernels_impl.h"
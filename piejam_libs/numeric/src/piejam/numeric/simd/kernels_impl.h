@@ -0,0 +1,532 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Kernels of one isa_level. Included once per level by a translation unit,
+// which is compiled with the flags of that level, after defining:
+//   PIEJAM_NUMERIC_SIMD_KERNELS_NAMESPACE - namespace of the level
+//   PIEJAM_NUMERIC_SIMD_KERNELS_VECTOR_SIZE - register size in bytes
+//
+// The kernels use the compiler's vector extensions rather than MIPP. MIPP
+// selects its instructions by the flags of the translation unit, several
+// levels of it in one binary would break the one definition rule. Everything
+// here lives in the namespace of the level, so nothing is shared between the
+// levels at link time.
+
+#include "kernel_tables.h"
+
+#include <piejam/numeric/simd/kernels.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <utility>
+
+#if !defined(PIEJAM_NUMERIC_SIMD_KERNELS_NAMESPACE) ||                         \
+    !defined(PIEJAM_NUMERIC_SIMD_KERNELS_VECTOR_SIZE)
+#error "define the namespace and vector size of the kernels"
+#endif
+
+namespace piejam::numeric::simd::PIEJAM_NUMERIC_SIMD_KERNELS_NAMESPACE
+{
+
+namespace
+{
+
+constexpr std::size_t vector_size{PIEJAM_NUMERIC_SIMD_KERNELS_VECTOR_SIZE};
+
+using float_v = float __attribute__((vector_size(vector_size)));
+using int32_v = std::int32_t __attribute__((vector_size(vector_size)));
+using double_v = double __attribute__((vector_size(2 * vector_size)));
+
+constexpr std::size_t N = sizeof(float_v) / sizeof(float);
+
+[[nodiscard]]
+auto
+load(float const* const p) noexcept -> float_v
+{
+    float_v v;
+    __builtin_memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+void
+store(float* const p, float_v const v) noexcept
+{
+    __builtin_memcpy(p, &v, sizeof(v));
+}
+
+[[nodiscard]]
+auto
+broadcast(float const x) noexcept -> float_v
+{
+    return float_v{} + x;
+}
+
+[[nodiscard]]
+auto
+horizontal_sum(float_v const v) noexcept -> float
+{
+    float sum{};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        sum += v[i];
+    }
+    return sum;
+}
+
+[[nodiscard]]
+auto
+clamp(float_v const v, float_v const lo, float_v const hi) noexcept -> float_v
+{
+    float_v const lower = v < lo ? lo : v;
+    return lower > hi ? hi : lower;
+}
+
+template <class Op>
+void
+transform(
+    float const* const l,
+    float const* const r,
+    float* const out,
+    std::size_t const size,
+    Op const op) noexcept
+{
+    std::size_t i{};
+    for (; i + N <= size; i += N)
+    {
+        store(out + i, op(load(l + i), load(r + i)));
+    }
+
+    for (; i < size; ++i)
+    {
+        out[i] = op(l[i], r[i]);
+    }
+}
+
+template <class Op>
+void
+transform(
+    float const* const in,
+    float const c,
+    float* const out,
+    std::size_t const size,
+    Op const op) noexcept
+{
+    float_v const c_v = broadcast(c);
+
+    std::size_t i{};
+    for (; i + N <= size; i += N)
+    {
+        store(out + i, op(load(in + i), c_v));
+    }
+
+    for (; i < size; ++i)
+    {
+        out[i] = op(in[i], c);
+    }
+}
+
+// Two accumulators, so the additions don't wait on each other.
+template <class Term>
+[[nodiscard]]
+auto
+accumulate(std::size_t const size, Term const term) noexcept -> float
+{
+    float_v acc0{};
+    float_v acc1{};
+
+    std::size_t i{};
+    for (; i + 2 * N <= size; i += 2 * N)
+    {
+        acc0 += term(i);
+        acc1 += term(i + N);
+    }
+
+    for (; i + N <= size; i += N)
+    {
+        acc0 += term(i);
+    }
+
+    return horizontal_sum(acc0 + acc1);
+}
+
+void
+add(float const* const l,
+    float const* const r,
+    float* const out,
+    std::size_t const size) noexcept
+{
+    transform(l, r, out, size, [](auto a, auto b) { return a + b; });
+}
+
+void
+add_constant(
+    float const* const in,
+    float const c,
+    float* const out,
+    std::size_t const size) noexcept
+{
+    transform(in, c, out, size, [](auto a, auto b) { return a + b; });
+}
+
+void
+multiply(
+    float const* const l,
+    float const* const r,
+    float* const out,
+    std::size_t const size) noexcept
+{
+    transform(l, r, out, size, [](auto a, auto b) { return a * b; });
+}
+
+void
+multiply_constant(
+    float const* const in,
+    float const c,
+    float* const out,
+    std::size_t const size) noexcept
+{
+    transform(in, c, out, size, [](auto a, auto b) { return a * b; });
+}
+
+auto
+sum_of_squares(float const* const in, std::size_t const size) noexcept
+    -> float
+{
+    float sum = accumulate(size, [in](std::size_t const i) {
+        float_v const v = load(in + i);
+        return v * v;
+    });
+
+    for (std::size_t i = size - size % N; i < size; ++i)
+    {
+        sum += in[i] * in[i];
+    }
+
+    return sum;
+}
+
+auto
+sqr_difference_sum(
+    float const* const l,
+    float const* const r,
+    std::size_t const size) noexcept -> float
+{
+    float sum = accumulate(size, [l, r](std::size_t const i) {
+        float_v const d = load(l + i) - load(r + i);
+        return d * d;
+    });
+
+    for (std::size_t i = size - size % N; i < size; ++i)
+    {
+        float const d = l[i] - r[i];
+        sum += d * d;
+    }
+
+    return sum;
+}
+
+// Applies op to all of in. The tail is padded to a whole vector, so it gets
+// the same results as the rest.
+template <class Op>
+void
+transform_padded(
+    float const* const in,
+    float* const out,
+    std::size_t const size,
+    Op const op) noexcept
+{
+    std::size_t i{};
+    for (; i + N <= size; i += N)
+    {
+        store(out + i, op(load(in + i)));
+    }
+
+    if (i < size)
+    {
+        std::size_t const tail_size = (size - i) * sizeof(float);
+
+        float_v tail = broadcast(1.f);
+        __builtin_memcpy(&tail, in + i, tail_size);
+        tail = op(tail);
+        __builtin_memcpy(out + i, &tail, tail_size);
+    }
+}
+
+// log2 of positive normal x. With x = m 2^e and m in [sqrt(1/2), sqrt(2)):
+//   log2(m) = 2/ln(2) atanh(u), u = (m - 1)/(m + 1), |u| < 0.172
+// The atanh series is cut after u^9, the rest is below 2e-8.
+[[nodiscard]]
+auto
+log2(float_v const x) noexcept -> float_v
+{
+    constexpr std::int32_t sqrt_half_bits{0x3f3504f3};
+    constexpr float c1 = 2.f / std::numbers::ln2_v<float>;
+    constexpr float c3 = c1 / 3.f;
+    constexpr float c5 = c1 / 5.f;
+    constexpr float c7 = c1 / 7.f;
+    constexpr float c9 = c1 / 9.f;
+
+    auto const bits = std::bit_cast<int32_v>(x);
+    int32_v const e = (bits - sqrt_half_bits) >> 23;
+    auto const m = std::bit_cast<float_v>(bits - (e << 23));
+
+    float_v const u = (m - 1.f) / (m + 1.f);
+    float_v const u2 = u * u;
+
+    return __builtin_convertvector(e, float_v) +
+           u * (c1 + u2 * (c3 + u2 * (c5 + u2 * (c7 + u2 * c9))));
+}
+
+// 2^x, with x = n + f, n integral and |f| <= 1/2:
+//   2^f = e^(f ln(2)), as taylor polynomial up to the 6th power,
+//   the rest is below 2e-7 relative.
+// Results below 2^-126 are flushed to zero.
+[[nodiscard]]
+auto
+exp2(float_v const x) noexcept -> float_v
+{
+    constexpr float ln2 = std::numbers::ln2_v<float>;
+    constexpr float c1 = ln2;
+    constexpr float c2 = c1 * ln2 / 2.f;
+    constexpr float c3 = c2 * ln2 / 3.f;
+    constexpr float c4 = c3 * ln2 / 4.f;
+    constexpr float c5 = c4 * ln2 / 5.f;
+    constexpr float c6 = c5 * ln2 / 6.f;
+
+    float_v const clamped = clamp(x, broadcast(-126.f), broadcast(127.f));
+    int32_v const n = __builtin_convertvector(
+        clamped < 0.f ? clamped - 0.5f : clamped + 0.5f,
+        int32_v);
+    float_v const f = clamped - __builtin_convertvector(n, float_v);
+
+    float_v const p =
+        1.f + f * (c1 + f * (c2 + f * (c3 + f * (c4 + f * (c5 + f * c6)))));
+    auto const scale = std::bit_cast<float_v>((n + 127) << 23);
+
+    return x < -126.f ? float_v{} : p * scale;
+}
+
+void
+to_dB(
+    float const* const in,
+    float const min_lin,
+    float* const out,
+    std::size_t const size) noexcept
+{
+    constexpr float dB_per_octave = 20.f * std::numbers::ln2_v<float> /
+                                    std::numbers::ln10_v<float>;
+
+    float_v const min_v = broadcast(min_lin);
+    float_v const min_normal = broadcast(std::numeric_limits<float>::min());
+    float_v const neg_inf = broadcast(-std::numeric_limits<float>::infinity());
+
+    transform_padded(in, out, size, [&](float_v const lin) {
+        float_v const dB =
+            log2(lin < min_normal ? min_normal : lin) * dB_per_octave;
+        return lin <= min_v ? neg_inf : dB;
+    });
+}
+
+void
+from_dB(
+    float const* const in,
+    float* const out,
+    std::size_t const size) noexcept
+{
+    constexpr float octaves_per_dB = std::numbers::ln10_v<float> /
+                                     (20.f * std::numbers::ln2_v<float>);
+
+    transform_padded(in, out, size, [](float_v const dB) {
+        return exp2(dB * octaves_per_dB);
+    });
+}
+
+// The conversions match audio::pcm_convert exactly: scaling by a power of two
+// is exact, s32 is scaled in double precision.
+
+constexpr float s16_scale{32768.f};
+constexpr float s16_max{32767.f / s16_scale};
+constexpr double s32_scale{2147483648.};
+constexpr double s32_max{2147483647. / s32_scale};
+
+// Built as one vector from the lanes. Writing the lanes one by one goes
+// through the stack and stalls on the store forwarding.
+template <class Sample, std::size_t... Lane>
+[[nodiscard]]
+auto
+gather(
+    Sample const* const in,
+    std::ptrdiff_t const stride,
+    std::size_t const i,
+    std::index_sequence<Lane...>) noexcept -> int32_v
+{
+    return int32_v{in[static_cast<std::ptrdiff_t>(i + Lane) * stride]...};
+}
+
+template <class Sample>
+[[nodiscard]]
+auto
+gather(
+    Sample const* const in,
+    std::ptrdiff_t const stride,
+    std::size_t const i) noexcept -> int32_v
+{
+    return gather(in, stride, i, std::make_index_sequence<N>{});
+}
+
+template <class Sample>
+void
+scatter(
+    int32_v const v,
+    Sample* const out,
+    std::ptrdiff_t const stride,
+    std::size_t const i) noexcept
+{
+    for (std::size_t lane = 0; lane < N; ++lane)
+    {
+        out[static_cast<std::ptrdiff_t>(i + lane) * stride] =
+            static_cast<Sample>(v[lane]);
+    }
+}
+
+void
+s16_to_float(
+    std::int16_t const* const in,
+    std::ptrdiff_t const in_stride,
+    float* const out,
+    std::size_t const size) noexcept
+{
+    float_v const scale = broadcast(1.f / s16_scale);
+
+    std::size_t i{};
+    for (; i + N <= size; i += N)
+    {
+        store(
+            out + i,
+            __builtin_convertvector(gather(in, in_stride, i), float_v) *
+                scale);
+    }
+
+    for (; i < size; ++i)
+    {
+        out[i] = static_cast<float>(in[static_cast<std::ptrdiff_t>(i) *
+                                       in_stride]) /
+                 s16_scale;
+    }
+}
+
+void
+s32_to_float(
+    std::int32_t const* const in,
+    std::ptrdiff_t const in_stride,
+    float* const out,
+    std::size_t const size) noexcept
+{
+    double_v const scale = double_v{} + 1. / s32_scale;
+
+    std::size_t i{};
+    for (; i + N <= size; i += N)
+    {
+        store(
+            out + i,
+            __builtin_convertvector(
+                __builtin_convertvector(gather(in, in_stride, i), double_v) *
+                    scale,
+                float_v));
+    }
+
+    for (; i < size; ++i)
+    {
+        out[i] = static_cast<float>(
+            static_cast<double>(
+                in[static_cast<std::ptrdiff_t>(i) * in_stride]) /
+            s32_scale);
+    }
+}
+
+void
+float_to_s16(
+    float const* const in,
+    std::int16_t* const out,
+    std::ptrdiff_t const out_stride,
+    std::size_t const size) noexcept
+{
+    float_v const lo = broadcast(-1.f);
+    float_v const hi = broadcast(s16_max);
+    float_v const scale = broadcast(s16_scale);
+
+    std::size_t i{};
+    for (; i + N <= size; i += N)
+    {
+        scatter(
+            __builtin_convertvector(
+                clamp(load(in + i), lo, hi) * scale,
+                int32_v),
+            out,
+            out_stride,
+            i);
+    }
+
+    for (; i < size; ++i)
+    {
+        float const x = in[i] < -1.f ? -1.f : in[i];
+        out[static_cast<std::ptrdiff_t>(i) * out_stride] =
+            static_cast<std::int16_t>((x > s16_max ? s16_max : x) * s16_scale);
+    }
+}
+
+void
+float_to_s32(
+    float const* const in,
+    std::int32_t* const out,
+    std::ptrdiff_t const out_stride,
+    std::size_t const size) noexcept
+{
+    double_v const lo = double_v{} - 1.;
+    double_v const hi = double_v{} + s32_max;
+    double_v const scale = double_v{} + s32_scale;
+
+    std::size_t i{};
+    for (; i + N <= size; i += N)
+    {
+        double_v const x = __builtin_convertvector(load(in + i), double_v);
+        double_v const lower = x < lo ? lo : x;
+        scatter(
+            __builtin_convertvector((lower > hi ? hi : lower) * scale, int32_v),
+            out,
+            out_stride,
+            i);
+    }
+
+    for (; i < size; ++i)
+    {
+        double const x = static_cast<double>(in[i]) < -1.
+                             ? -1.
+                             : static_cast<double>(in[i]);
+        out[static_cast<std::ptrdiff_t>(i) * out_stride] =
+            static_cast<std::int32_t>((x > s32_max ? s32_max : x) * s32_scale);
+    }
+}
+
+} // namespace
+
+kernel_table const table{
+    .add = &add,
+    .add_constant = &add_constant,
+    .multiply = &multiply,
+    .multiply_constant = &multiply_constant,
+    .sum_of_squares = &sum_of_squares,
+    .sqr_difference_sum = &sqr_difference_sum,
+    .s16_to_float = &s16_to_float,
+    .s32_to_float = &s32_to_float,
+    .to_dB = &to_dB,
+    .from_dB = &from_dB,
+    .float_to_s16 = &float_to_s16,
+    .float_to_s32 = &float_to_s32,
+};
+
+} // namespace piejam::numeric::simd::PIEJAM_NUMERIC_SIMD_KERNELS_NAMESPACE
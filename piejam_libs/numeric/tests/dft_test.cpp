@@ -0,0 +1,96 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/numeric/dft.h>
+#include <piejam/numeric/dft_plans.h>
+#include <piejam/numeric/generators/sine.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <vector>
+
+namespace piejam::numeric::test
+{
+
+TEST(dft, sine_peak_is_in_expected_bin)
+{
+    dft sut{1024};
+
+    // 16 periods in 1024 samples
+    std::ranges::generate(
+        sut.input_buffer(),
+        generators::sine<float>{16.f, 1024.f});
+
+    auto const spectrum = sut.process();
+    ASSERT_EQ(sut.output_size(), spectrum.size());
+
+    auto const peak = std::ranges::max_element(
+        spectrum,
+        {},
+        [](std::complex<float> const& c) { return std::abs(c); });
+    EXPECT_EQ(16, std::distance(spectrum.begin(), peak));
+    EXPECT_NEAR(512.f, std::abs(*peak), 0.01f);
+}
+
+TEST(dft, instances_of_same_size_compute_independently)
+{
+    dft a{256};
+    dft b{256};
+
+    std::ranges::fill(a.input_buffer(), 1.f);
+    std::ranges::fill(b.input_buffer(), 0.f);
+
+    auto const spectrum_a = a.process();
+    auto const spectrum_b = b.process();
+
+    EXPECT_FLOAT_EQ(256.f, std::abs(spectrum_a[0]));
+    EXPECT_FLOAT_EQ(0.f, std::abs(spectrum_b[0]));
+}
+
+TEST(dft, inverse_restores_input_scaled_by_size)
+{
+    dft sut{512};
+
+    std::ranges::generate(
+        sut.input_buffer(),
+        generators::sine<float>{5.f, 512.f, 0.5f});
+    std::vector<float> const expected(
+        sut.input_buffer().begin(),
+        sut.input_buffer().end());
+
+    sut.process();
+    auto const result = sut.process_inverse();
+
+    ASSERT_EQ(expected.size(), result.size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_NEAR(expected[i], result[i] / 512.f, 1.e-5f);
+    }
+}
+
+TEST(dft_plans, export_and_import_wisdom)
+{
+    static constexpr std::array sizes{128uz, 512uz};
+    dft_plans::prepare(sizes);
+    dft_plans::prepare(sizes, dft_plans::direction::inverse);
+
+    auto const file = std::filesystem::temp_directory_path() /
+                      "piejam_numeric_test_fftw.wisdom";
+
+    ASSERT_TRUE(dft_plans::export_wisdom(file));
+    EXPECT_TRUE(dft_plans::import_wisdom(file));
+
+    std::filesystem::remove(file);
+}
+
+TEST(dft_plans, import_from_non_existing_file_fails)
+{
+    EXPECT_FALSE(dft_plans::import_wisdom(
+        std::filesystem::temp_directory_path() / "piejam_does_not_exist"));
+}
+
+} // namespace piejam::numeric::test
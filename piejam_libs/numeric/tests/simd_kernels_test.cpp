@@ -0,0 +1,239 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/numeric/simd/isa.h>
+#include <piejam/numeric/simd/kernels.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+namespace piejam::numeric::simd::test
+{
+
+TEST(simd_isa, detected_level_is_supported)
+{
+    EXPECT_TRUE(is_supported(detect_isa_level()));
+}
+
+TEST(simd_isa, generic_is_always_compiled_and_supported)
+{
+    EXPECT_EQ(isa_level::generic, compiled_isa_levels().front());
+    EXPECT_TRUE(is_supported(isa_level::generic));
+}
+
+TEST(simd_isa, selecting_unsupported_level_keeps_active_level)
+{
+    auto const active = active_isa_level();
+
+    for (auto const level :
+         {isa_level::generic, isa_level::avx2, isa_level::neon})
+    {
+        if (!is_supported(level))
+        {
+            EXPECT_FALSE(select_isa_level(level));
+            EXPECT_EQ(active, active_isa_level());
+        }
+    }
+}
+
+// test param: isa level, size, misalignment in floats
+struct simd_kernels_test
+    : public testing::TestWithParam<
+          std::tuple<isa_level, std::size_t, std::size_t>>
+{
+    void SetUp() override
+    {
+        if (!select_isa_level(level))
+        {
+            GTEST_SKIP() << to_string(level) << " not supported";
+        }
+
+        for (std::size_t i = 0; i < l_buf.size(); ++i)
+        {
+            auto const x = static_cast<float>(i);
+            l_buf[i] = std::sin(x * 0.37f);
+            r_buf[i] = std::cos(x * 0.11f) * 0.5f;
+        }
+    }
+
+    void TearDown() override
+    {
+        select_isa_level(detect_isa_level());
+    }
+
+    isa_level const level{std::get<0>(GetParam())};
+    std::size_t const size{std::get<1>(GetParam())};
+    std::size_t const offset{std::get<2>(GetParam())};
+
+    std::vector<float> l_buf = std::vector<float>(size + offset);
+    std::vector<float> r_buf = std::vector<float>(size + offset);
+    std::vector<float> out_buf = std::vector<float>(size + offset);
+
+    float const* l{l_buf.data() + offset};
+    float const* r{r_buf.data() + offset};
+    float* out{out_buf.data() + offset};
+};
+
+TEST_P(simd_kernels_test, add)
+{
+    kernels().add(l, r, out, size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        EXPECT_EQ(l[i] + r[i], out[i]);
+    }
+}
+
+TEST_P(simd_kernels_test, add_constant)
+{
+    kernels().add_constant(l, 0.25f, out, size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        EXPECT_EQ(l[i] + 0.25f, out[i]);
+    }
+}
+
+TEST_P(simd_kernels_test, multiply)
+{
+    kernels().multiply(l, r, out, size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        EXPECT_EQ(l[i] * r[i], out[i]);
+    }
+}
+
+TEST_P(simd_kernels_test, multiply_constant)
+{
+    kernels().multiply_constant(l, -0.75f, out, size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        EXPECT_EQ(l[i] * -0.75f, out[i]);
+    }
+}
+
+TEST_P(simd_kernels_test, sum_of_squares)
+{
+    double expected{};
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        expected += static_cast<double>(l[i]) * static_cast<double>(l[i]);
+    }
+
+    EXPECT_NEAR(
+        expected,
+        static_cast<double>(kernels().sum_of_squares(l, size)),
+        1e-5 * (expected + 1.));
+}
+
+TEST_P(simd_kernels_test, sqr_difference_sum)
+{
+    double expected{};
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        double const d = static_cast<double>(l[i]) - static_cast<double>(r[i]);
+        expected += d * d;
+    }
+
+    EXPECT_NEAR(
+        expected,
+        static_cast<double>(kernels().sqr_difference_sum(l, r, size)),
+        1e-5 * (expected + 1.));
+}
+
+TEST_P(simd_kernels_test, s16_round_trip_with_stride)
+{
+    constexpr std::ptrdiff_t stride{3};
+
+    std::vector<std::int16_t> pcm(size * stride);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        pcm[i * stride] = static_cast<std::int16_t>(
+            static_cast<int>(i * 2711) % 65536 - 32768);
+    }
+
+    kernels().s16_to_float(pcm.data(), stride, out, size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        EXPECT_EQ(static_cast<float>(pcm[i * stride]) / 32768.f, out[i]);
+    }
+
+    std::vector<std::int16_t> back(size * stride);
+    kernels().float_to_s16(out, back.data(), stride, size);
+
+    EXPECT_EQ(pcm, back);
+}
+
+TEST_P(simd_kernels_test, s32_round_trip_with_stride)
+{
+    constexpr std::ptrdiff_t stride{2};
+
+    std::vector<std::int32_t> pcm(size * stride);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        // exactly representable as float
+        pcm[i * stride] = static_cast<std::int32_t>(
+            (static_cast<std::int64_t>(i * 2711) % 65536 - 32768) << 16);
+    }
+
+    kernels().s32_to_float(pcm.data(), stride, out, size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        double const expected =
+            static_cast<double>(pcm[i * stride]) / 2147483648.;
+        EXPECT_EQ(static_cast<float>(expected), out[i]);
+    }
+
+    std::vector<std::int32_t> back(size * stride);
+    kernels().float_to_s32(out, back.data(), stride, size);
+
+    EXPECT_EQ(pcm, back);
+}
+
+TEST_P(simd_kernels_test, float_to_pcm_clamps)
+{
+    std::ranges::fill(out_buf, 0.f);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        out[i] = i % 2 ? 1.5f : -2.f;
+    }
+
+    std::vector<std::int16_t> s16(size);
+    kernels().float_to_s16(out, s16.data(), 1, size);
+
+    std::vector<std::int32_t> s32(size);
+    kernels().float_to_s32(out, s32.data(), 1, size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        EXPECT_EQ(
+            i % 2 ? std::numeric_limits<std::int16_t>::max()
+                  : std::numeric_limits<std::int16_t>::min(),
+            s16[i]);
+        EXPECT_EQ(
+            i % 2 ? std::numeric_limits<std::int32_t>::max()
+                  : std::numeric_limits<std::int32_t>::min(),
+            s32[i]);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    all,
+    simd_kernels_test,
+    testing::Combine(
+        testing::Values(isa_level::generic, isa_level::avx2, isa_level::neon),
+        testing::Values(0u, 1u, 7u, 8u, 33u, 1024u),
+        testing::Values(0u, 1u)));
+
+} // namespace piejam::numeric::simd::test
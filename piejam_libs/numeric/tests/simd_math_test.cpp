@@ -0,0 +1,191 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/numeric/simd/math.h>
+
+#include <piejam/numeric/dB_convert.h>
+#include <piejam/numeric/simd/isa.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace piejam::numeric::simd::test
+{
+
+namespace
+{
+
+// log spaced values from 10^min_exp to 10^max_exp, in steps of 1/64 decade,
+// plus a few odd values to cover the tails of the kernels
+auto
+log_spaced(int const min_exp, int const max_exp) -> std::vector<float>
+{
+    std::vector<float> result;
+    for (int i = min_exp * 64; i <= max_exp * 64; ++i)
+    {
+        result.push_back(
+            static_cast<float>(std::pow(10., static_cast<double>(i) / 64.)));
+    }
+    result.push_back(1.f);
+    result.push_back(0.5f);
+    result.push_back(0.70710677f);
+    return result;
+}
+
+auto
+dB_spaced(float const min_dB, float const max_dB) -> std::vector<float>
+{
+    std::vector<float> result;
+    for (float dB = min_dB; dB <= max_dB; dB += 0.37f)
+    {
+        result.push_back(dB);
+    }
+    result.push_back(0.f);
+    return result;
+}
+
+} // namespace
+
+struct simd_math_test : public testing::TestWithParam<isa_level>
+{
+    void SetUp() override
+    {
+        if (!select_isa_level(GetParam()))
+        {
+            GTEST_SKIP() << to_string(GetParam()) << " not supported";
+        }
+    }
+
+    void TearDown() override
+    {
+        select_isa_level(detect_isa_level());
+    }
+};
+
+TEST_P(simd_math_test, to_dB_error_is_bounded)
+{
+    auto const lin = log_spaced(-37, 37);
+    std::vector<float> dB(lin.size());
+
+    to_dB(lin, dB);
+
+    for (std::size_t i = 0; i < lin.size(); ++i)
+    {
+        double const expected = 20. * std::log10(static_cast<double>(lin[i]));
+        EXPECT_NEAR(
+            expected,
+            static_cast<double>(dB[i]),
+            1e-5 * (1. + std::abs(expected) / 100.))
+            << lin[i];
+    }
+}
+
+TEST_P(simd_math_test, to_dB_of_one_is_zero)
+{
+    std::vector<float> lin(5, 1.f);
+
+    to_dB(lin, lin);
+
+    for (float const dB : lin)
+    {
+        EXPECT_NEAR(0.f, dB, 1e-6f);
+    }
+}
+
+TEST_P(simd_math_test, to_dB_at_and_below_min_is_negative_infinity)
+{
+    std::vector<float> lin{0.f, 1e-20f, 1e-10f, 2e-10f, 0.f, 1e-11f, 1.f};
+    std::vector<float> dB(lin.size());
+
+    to_dB(lin, dB, 1e-10f);
+
+    for (std::size_t i = 0; i < lin.size(); ++i)
+    {
+        EXPECT_EQ(
+            std::isinf(numeric::to_dB(lin[i], 1e-10f)),
+            std::isinf(dB[i]))
+            << lin[i];
+    }
+}
+
+TEST_P(simd_math_test, to_dB_of_denormals_is_finite)
+{
+    std::vector<float> lin{std::numeric_limits<float>::denorm_min(), 1e-40f};
+    std::vector<float> dB(lin.size());
+
+    to_dB(lin, dB);
+
+    for (float const x : dB)
+    {
+        EXPECT_TRUE(std::isfinite(x));
+        EXPECT_LT(x, -750.f);
+    }
+}
+
+TEST_P(simd_math_test, from_dB_error_is_bounded)
+{
+    auto const dB = dB_spaced(-740.f, 760.f);
+    std::vector<float> lin(dB.size());
+
+    from_dB(dB, lin);
+
+    for (std::size_t i = 0; i < dB.size(); ++i)
+    {
+        double const expected = std::pow(10., static_cast<double>(dB[i]) / 20.);
+        EXPECT_NEAR(
+            1.,
+            static_cast<double>(lin[i]) / expected,
+            1e-6 * (1. + std::abs(static_cast<double>(dB[i])) / 200.))
+            << dB[i];
+    }
+}
+
+TEST_P(simd_math_test, from_dB_of_zero_is_one)
+{
+    std::vector<float> dB(9, 0.f);
+
+    from_dB(dB, dB);
+
+    for (float const lin : dB)
+    {
+        EXPECT_FLOAT_EQ(1.f, lin);
+    }
+}
+
+TEST_P(simd_math_test, from_dB_flushes_to_zero)
+{
+    std::vector<float> dB{-800.f, -1000.f, -1e30f};
+    std::vector<float> lin(dB.size(), 1.f);
+
+    from_dB(dB, lin);
+
+    for (float const x : lin)
+    {
+        EXPECT_EQ(0.f, x);
+    }
+}
+
+TEST_P(simd_math_test, round_trip)
+{
+    auto const lin = log_spaced(-8, 2);
+    std::vector<float> result(lin.size());
+
+    to_dB(lin, result);
+    from_dB(result, result);
+
+    for (std::size_t i = 0; i < lin.size(); ++i)
+    {
+        EXPECT_NEAR(1.f, result[i] / lin[i], 1e-5f) << lin[i];
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    all,
+    simd_math_test,
+    testing::Values(isa_level::generic, isa_level::avx2, isa_level::neon));
+
+} // namespace piejam::numeric::simd::test
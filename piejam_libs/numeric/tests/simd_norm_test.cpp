@@ -0,0 +1,44 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/numeric/simd/norm.h>
+
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <vector>
+
+namespace piejam::numeric::test
+{
+
+// test param: size
+struct simd_norm_test : public testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(simd_norm_test, equals_std_norm)
+{
+    std::vector<std::complex<float>> in(GetParam());
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = {
+            static_cast<float>(i) * 0.25f - 3.f,
+            1.5f - static_cast<float>(i) * 0.125f};
+    }
+
+    std::vector<float> out(in.size());
+    simd::norm(std::span<std::complex<float> const>{in}, std::span{out});
+
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(std::norm(in[i]), out[i]);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    all,
+    simd_norm_test,
+    testing::Values(0u, 1u, 3u, 4u, 8u, 17u, 1025u));
+
+} // namespace piejam::numeric::test
@@ -0,0 +1,88 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/numeric/sliding_max.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace piejam::numeric::test
+{
+
+TEST(sliding_max, window_of_one_is_identity)
+{
+    sliding_max<float> sut(1);
+
+    EXPECT_EQ(3.f, sut(3.f));
+    EXPECT_EQ(1.f, sut(1.f));
+    EXPECT_EQ(2.f, sut(2.f));
+}
+
+TEST(sliding_max, max_expires_after_window_size)
+{
+    sliding_max<float> sut(3);
+
+    EXPECT_EQ(5.f, sut(5.f));
+    EXPECT_EQ(5.f, sut(1.f));
+    EXPECT_EQ(5.f, sut(2.f));
+    EXPECT_EQ(2.f, sut(1.f));
+    EXPECT_EQ(2.f, sut(0.f));
+    EXPECT_EQ(1.f, sut(0.f));
+}
+
+TEST(sliding_max, decreasing_values_fill_the_window)
+{
+    sliding_max<int> sut(4);
+
+    for (int x = 10; x > 0; --x)
+    {
+        EXPECT_EQ(std::min(10, x + 3), sut(x));
+    }
+}
+
+TEST(sliding_max, equal_values_keep_the_latest)
+{
+    sliding_max<int> sut(2);
+
+    EXPECT_EQ(1, sut(1));
+    EXPECT_EQ(1, sut(1));
+    EXPECT_EQ(1, sut(1));
+    EXPECT_EQ(1, sut(0));
+    EXPECT_EQ(0, sut(0));
+}
+
+TEST(sliding_max, matches_brute_force)
+{
+    constexpr std::size_t window_size = 7;
+    sliding_max<int> sut(window_size);
+
+    std::srand(42);
+    std::vector<int> values(1000);
+    std::ranges::generate(values, [] { return std::rand() % 100; });
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        auto const first = i + 1 < window_size ? 0 : i + 1 - window_size;
+        ASSERT_EQ(
+            *std::max_element(
+                std::next(values.begin(), first),
+                std::next(values.begin(), i + 1)),
+            sut(values[i]))
+            << i;
+    }
+}
+
+TEST(sliding_max, reset_clears_the_window)
+{
+    sliding_max<float> sut(4);
+
+    EXPECT_EQ(5.f, sut(5.f));
+    sut.reset();
+    EXPECT_EQ(1.f, sut(1.f));
+}
+
+} // namespace piejam::numeric::test
@@ -0,0 +1,53 @@
+# SPDX-FileCopyrightText: 2020-2026 Dimitrij Kotrev
+#
+# SPDX-License-Identifier: CC0-1.0
+
+# Runs benchmark binaries and writes one json report per binary, tagged with
+# the git commit and the board, so results can be compared across both:
+#   <OUTPUT_DIR>/<binary>-<commit>-<board>.json
+#
+# cmake -DBENCHMARKS=<binaries> -DOUTPUT_DIR=<dir> -DSOURCE_DIR=<repo>
+#       [-DBENCHMARK_FILTER=<regex>] -P run_benchmarks.cmake
+
+execute_process(
+    COMMAND git rev-parse --short HEAD
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE commit
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET
+)
+if(NOT commit)
+    set(commit unknown)
+endif()
+
+# the device tree names the board on the Raspberry Pi
+if(EXISTS /proc/device-tree/model)
+    file(STRINGS /proc/device-tree/model board LIMIT_COUNT 1)
+else()
+    cmake_host_system_information(RESULT board QUERY OS_PLATFORM)
+endif()
+string(MAKE_C_IDENTIFIER "${board}" board_id)
+string(TOLOWER "${board_id}" board_id)
+
+set(extra_args "")
+if(BENCHMARK_FILTER)
+    list(APPEND extra_args "--benchmark_filter=${BENCHMARK_FILTER}")
+endif()
+
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+
+foreach(benchmark IN LISTS BENCHMARKS)
+    get_filename_component(name ${benchmark} NAME)
+    set(report ${OUTPUT_DIR}/${name}-${commit}-${board_id}.json)
+
+    execute_process(
+        COMMAND ${benchmark}
+            --benchmark_out=${report}
+            --benchmark_out_format=json
+            "--benchmark_context=git_commit=${commit},board=${board}"
+            ${extra_args}
+        COMMAND_ERROR_IS_FATAL ANY
+    )
+
+    message(STATUS "Benchmark report: ${report}")
+endforeach()
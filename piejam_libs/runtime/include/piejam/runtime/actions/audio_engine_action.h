@@ -17,7 +17,10 @@ struct audio_engine_action_visitor
           set_int_parameter,
           set_enum_parameter,
           request_audio_engine_sync,
-          request_info_update>
+          request_info_update,
+          start_recording,
+          stop_recording,
+          bounce_recording>
 {
 };
 
@@ -8,15 +8,18 @@
 #include <piejam/runtime/actions/recorder_action.h>
 #include <piejam/runtime/audio_stream.h>
 #include <piejam/runtime/fwd.h>
+#include <piejam/runtime/mixer_fwd.h>
 #include <piejam/runtime/parameters.h>
 #include <piejam/runtime/ui/action.h>
 #include <piejam/runtime/ui/cloneable_action.h>
 
+#include <piejam/audio/engine/capture.h>
 #include <piejam/entity_id.h>
 
 #include <boost/container/flat_map.hpp>
 
 #include <tuple>
+#include <vector>
 
 namespace piejam::runtime::actions
 {
@@ -43,6 +46,12 @@ struct audio_engine_sync_update final
     parameter_values_t values;
     boost::container::flat_map<audio_stream_id, audio_stream_buffer> streams;
 
+    //! Captured audio of the recorded mixer channels.
+    boost::container::flat_map<
+        mixer::channel_id,
+        std::vector<audio::engine::captured_frames>>
+        captures;
+
     template <class P>
     void push_back(
         parameter::id_t<P> const id,
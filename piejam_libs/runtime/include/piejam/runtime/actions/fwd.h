@@ -76,6 +76,9 @@ struct new_session;
 
 struct start_recording;
 struct stop_recording;
+struct bounce_recording;
+struct set_recording_format;
+struct set_recording_layout;
 
 struct shutdown;
 
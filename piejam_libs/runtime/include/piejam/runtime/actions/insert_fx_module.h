@@ -56,6 +56,7 @@ struct insert_ladspa_fx_module final
     ladspa::instance_id instance_id;
     ladspa::plugin_descriptor plugin_desc;
     std::span<ladspa::port_descriptor const> control_inputs;
+    audio::engine::event_quantization event_quantization;
     std::vector<parameter_value_assignment> initial_values;
     std::vector<parameter_midi_assignment> midi_assignments;
     bool show_fx_module{};
@@ -87,6 +88,7 @@ struct replace_missing_ladspa_fx_module final
                 ladspa::instance_id instance_id;
                 ladspa::plugin_descriptor plugin_desc;
                 std::span<ladspa::port_descriptor const> control_inputs;
+                audio::engine::event_quantization event_quantization;
             } ladspa_fx_instance;
         };
 
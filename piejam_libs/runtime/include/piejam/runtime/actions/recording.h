@@ -4,24 +4,58 @@
 
 #pragma once
 
+#include <piejam/runtime/actions/audio_engine_action.h>
 #include <piejam/runtime/actions/recorder_action.h>
 #include <piejam/runtime/fwd.h>
 #include <piejam/runtime/ui/action.h>
 #include <piejam/runtime/ui/cloneable_action.h>
 
+#include <cstdint>
+#include <filesystem>
+
 namespace piejam::runtime::actions
 {
 
 struct start_recording final
     : ui::cloneable_action<start_recording, action>
+    , visitable_audio_engine_action<start_recording>
     , visitable_recorder_action<start_recording>
 {
+    //! Engine frame, on which all tracks start. Set by the audio engine
+    //! middleware.
+    std::uint64_t start_frame{};
 };
 
 struct stop_recording final
     : ui::cloneable_action<stop_recording, action>
+    , visitable_audio_engine_action<stop_recording>
     , visitable_recorder_action<stop_recording>
 {
 };
 
+//! Renders a stereo mix of a recorded take in the background, see
+//! bounce_job.
+struct bounce_recording final
+    : ui::cloneable_action<bounce_recording, action>
+    , visitable_audio_engine_action<bounce_recording>
+{
+    std::filesystem::path take_dir;
+};
+
+struct set_recording_format final
+    : ui::cloneable_action<set_recording_format, reducible_action>
+{
+    void reduce(state&) const override;
+
+    runtime::recording_format format;
+};
+
+struct set_recording_layout final
+    : ui::cloneable_action<set_recording_layout, reducible_action>
+{
+    void reduce(state&) const override;
+
+    runtime::recording_layout layout;
+};
+
 } // namespace piejam::runtime::actions
@@ -0,0 +1,29 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/fwd.h>
+#include <piejam/runtime/fx/fwd.h>
+#include <piejam/runtime/ui/action.h>
+#include <piejam/runtime/ui/cloneable_action.h>
+
+#include <piejam/audio/engine/event_quantization.h>
+#include <piejam/entity_id.h>
+
+namespace piejam::runtime::actions
+{
+
+//! Sets how a loaded LADSPA fx applies its control input events: sample
+//! accurate, quantized, or once per period.
+struct set_ladspa_fx_event_quantization final
+    : ui::cloneable_action<set_ladspa_fx_event_quantization, reducible_action>
+{
+    fx::module_id fx_mod_id;
+    audio::engine::event_quantization event_quantization;
+
+    void reduce(state&) const override;
+};
+
+} // namespace piejam::runtime::actions
@@ -0,0 +1,28 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/fwd.h>
+#include <piejam/runtime/fx/fwd.h>
+#include <piejam/runtime/ui/action.h>
+#include <piejam/runtime/ui/cloneable_action.h>
+
+#include <piejam/entity_id.h>
+
+namespace piejam::runtime::actions
+{
+
+//! Sets if a loaded LADSPA fx is processed on its own thread, one period
+//! behind the rest of the mixer. The other paths are delayed to match.
+struct set_ladspa_fx_pipelined final
+    : ui::cloneable_action<set_ladspa_fx_pipelined, reducible_action>
+{
+    fx::module_id fx_mod_id;
+    bool pipelined{};
+
+    void reduce(state&) const override;
+};
+
+} // namespace piejam::runtime::actions
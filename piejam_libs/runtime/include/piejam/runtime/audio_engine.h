@@ -7,19 +7,23 @@
 #include <piejam/runtime/audio_stream.h>
 #include <piejam/runtime/fwd.h>
 #include <piejam/runtime/fx/ladspa_processor_factory.h>
+#include <piejam/runtime/mixer_fwd.h>
 
+#include <piejam/audio/engine/capture.h>
 #include <piejam/audio/fwd.h>
 #include <piejam/audio/pair.h>
 #include <piejam/audio/pcm_buffer_converter.h>
 #include <piejam/audio/types.h>
 #include <piejam/midi/fwd.h>
 #include <piejam/pimpl.h>
-#include <piejam/thread/fwd.h>
+#include <piejam/thread/configuration.h>
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <span>
+#include <vector>
 
 namespace piejam::runtime
 {
@@ -27,11 +31,14 @@ namespace piejam::runtime
 class audio_engine
 {
 public:
+    //! The pipelined LADSPA fx run on threads with the pipeline thread
+    //! configuration. Without it, they are processed inline.
     audio_engine(
         std::span<audio::engine::rt_task_executor> workers,
         audio::sample_rate,
         unsigned num_device_input_channels,
-        unsigned num_device_output_channels);
+        unsigned num_device_output_channels,
+        std::optional<thread::configuration> ladspa_pipeline_thread);
 
     template <class P>
     void set_parameter_value(parameter::id_t<P>, parameter::value_type_t<P>)
@@ -42,12 +49,29 @@ public:
     auto get_parameter_update(parameter::id_t<P>) const
         -> std::optional<parameter::value_type_t<P>>;
 
+    // Ids of parameters, which were changed by the engine since the last call.
+    [[nodiscard]]
+    auto get_changed_parameters() const -> std::vector<parameter_id>;
+
     [[nodiscard]]
     auto get_learned_midi() const -> std::optional<midi::external_event>;
 
     [[nodiscard]]
     auto get_stream(audio_stream_id) const -> audio_stream_buffer;
 
+    //! Engine frame of the period, which is processed now or next.
+    [[nodiscard]]
+    auto current_frame() const noexcept -> std::uint64_t;
+
+    //! Sets the window of engine frames, which the capture tap of the mixer
+    //! channel records.
+    void arm_capture(mixer::channel_id, audio::engine::capture_window const&)
+        const;
+
+    [[nodiscard]]
+    auto get_capture(mixer::channel_id) const
+        -> std::vector<audio::engine::captured_frames>;
+
     [[nodiscard]]
     auto rebuild(
         state const&,
@@ -7,6 +7,7 @@
 #include <piejam/runtime/actions/fwd.h>
 #include <piejam/runtime/fwd.h>
 #include <piejam/runtime/fx/ladspa_processor_factory.h>
+#include <piejam/runtime/mixer_fwd.h>
 
 #include <piejam/audio/fwd.h>
 #include <piejam/ladspa/fwd.h>
@@ -16,7 +17,10 @@
 
 #include <boost/container/flat_set.hpp>
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <span>
 #include <vector>
 
@@ -31,7 +35,8 @@ public:
         std::span<thread::configuration const> wt_configs,
         audio::sound_card_manager&,
         ladspa::processor_factory&,
-        std::unique_ptr<midi_input_controller>);
+        std::unique_ptr<midi_input_controller>,
+        std::vector<unsigned> background_cpus = {});
     audio_engine_middleware(audio_engine_middleware&&) noexcept = default;
     ~audio_engine_middleware();
 
@@ -55,6 +60,8 @@ private:
 
     void rebuild(state const&);
 
+    void finish_recording(middleware_functors const&);
+
     thread::configuration m_audio_thread_config;
     std::vector<audio::engine::rt_task_executor> m_workers;
 
@@ -65,6 +72,19 @@ private:
     std::unique_ptr<audio_engine> m_engine;
     std::unique_ptr<audio::io_process> m_io_process;
 
+    // offline rendering of recorded takes, on the background cpus
+    std::vector<unsigned> m_background_cpus;
+    std::unique_ptr<bounce_job> m_bounce_job;
+
+    // mixer channels, which are captured for recording
+    std::vector<mixer::channel_id> m_capture_channels;
+    std::uint64_t m_capture_start{};
+
+    // A stop is finished by the engine syncs, once the engine passed the
+    // stop frame.
+    std::optional<std::uint64_t> m_capture_stop;
+    std::chrono::steady_clock::time_point m_capture_stop_deadline;
+
     struct rebuild_tracker;
     pimpl<rebuild_tracker> m_rebuild_tracker;
 };
@@ -0,0 +1,64 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/fwd.h>
+#include <piejam/runtime/fx/ladspa_processor_factory.h>
+
+#include <piejam/pimpl.h>
+#include <piejam/thread/configuration.h>
+
+#include <filesystem>
+#include <span>
+
+namespace piejam::runtime
+{
+
+//! Renders a stereo mix of a recorded take, faster than realtime.
+//!
+//! The session is loaded into an own audio_engine, which runs on background
+//! threads with a low priority, while the live engine keeps running. The
+//! tracks of the take are fed in as the device inputs of the mixer channels,
+//! which recorded them. The tracks are recorded behind the fx chain, so the
+//! fx chains of these channels are bypassed. Their pan/balance, volume,
+//! mute and solo, and everything downstream, e.g. aux and main channel, are
+//! rendered as in the session. The mix is taken from the device outputs of
+//! the main channel.
+//!
+//! The first thread renders, the others are the workers of the engine.
+class bounce_job
+{
+public:
+    struct progress
+    {
+        std::size_t rendered_frames{};
+        std::size_t num_frames{};
+
+        //! Duration of the rendered audio per elapsed time.
+        double realtime_factor{};
+
+        bool finished{};
+    };
+
+    //! throws std::runtime_error, if the take can't be rendered.
+    bounce_job(
+        state const&,
+        fx::simple_ladspa_processor_factory const&,
+        std::filesystem::path const& take_dir,
+        std::filesystem::path const& mix_file,
+        std::span<thread::configuration const> threads = {});
+
+    //! Cancels the rendering, if it isn't finished yet.
+    ~bounce_job();
+
+    [[nodiscard]]
+    auto get_progress() const noexcept -> progress;
+
+private:
+    struct impl;
+    pimpl<impl> const m_impl;
+};
+
+} // namespace piejam::runtime
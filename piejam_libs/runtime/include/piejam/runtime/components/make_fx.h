@@ -9,21 +9,26 @@
 #include <piejam/runtime/fx/fwd.h>
 #include <piejam/runtime/fx/get_parameter_name.h>
 #include <piejam/runtime/fx/ladspa_processor_factory.h>
+#include <piejam/thread/configuration.h>
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string_view>
 
 namespace piejam::runtime::components
 {
 
+// A LADSPA fx is pipelined, if a pipeline thread is passed.
 auto make_fx(
+    fx::module_id,
     fx::module const&,
     fx::get_parameter_name const&,
     fx::simple_ladspa_processor_factory const&,
     parameter_processor_factory&,
     processors::stream_processor_factory&,
     audio::sample_rate,
+    std::optional<thread::configuration> const& ladspa_pipeline_thread,
     std::string_view name = {}) -> std::unique_ptr<audio::engine::component>;
 
 } // namespace piejam::runtime::components
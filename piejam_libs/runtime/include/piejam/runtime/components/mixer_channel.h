@@ -20,10 +20,12 @@ auto make_mixer_channel_input(mixer::channel const&)
     -> std::unique_ptr<audio::engine::component>;
 
 auto make_mixer_channel_output(
+    mixer::channel_id,
     mixer::channel const&,
     std::string_view channel_name,
     parameter_processor_factory&,
     processors::stream_processor_factory&,
+    processors::capture_tap_factory&,
     audio::sample_rate) -> std::unique_ptr<audio::engine::component>;
 
 auto make_mixer_channel_aux_send(
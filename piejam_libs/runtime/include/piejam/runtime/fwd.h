@@ -14,6 +14,7 @@ namespace piejam::runtime
 {
 
 class audio_engine;
+class bounce_job;
 struct state;
 struct selected_sound_card;
 class state_access;
@@ -44,6 +45,8 @@ enum class root_view_mode : int;
 enum class fx_browser_add_mode : int;
 
 enum class startup_session : bool;
+enum class recording_format : bool;
+enum class recording_layout : bool;
 
 struct internal_fx_module_factory_args;
 struct internal_fx_component_factory_args;
@@ -7,6 +7,7 @@
 #include <piejam/runtime/audio_stream.h>
 #include <piejam/runtime/parameters.h>
 
+#include <piejam/audio/engine/fwd.h>
 #include <piejam/fwd.h>
 #include <piejam/ladspa/fwd.h>
 
@@ -26,6 +27,11 @@ using unavailable_ladspa_plugins_t = boxed_map<entity_map<unavailable_ladspa>>;
 
 using ladspa_instances_t = boxed_map<
     boost::container::flat_map<ladspa::instance_id, ladspa::plugin_descriptor>>;
+using ladspa_event_quantizations_t = boxed_map<boost::container::flat_map<
+    ladspa::instance_id,
+    audio::engine::event_quantization>>;
+using pipelined_ladspa_instances_t =
+    box<boost::container::flat_set<ladspa::instance_id>>;
 
 using instance_id =
     std::variant<internal_id, ladspa::instance_id, unavailable_ladspa_id>;
@@ -7,10 +7,14 @@
 #include <piejam/runtime/fx/fwd.h>
 #include <piejam/runtime/fx/module.h>
 
+#include <piejam/audio/engine/event_quantization.h>
+#include <piejam/box.h>
 #include <piejam/boxed_map.h>
 #include <piejam/entity_id_hash.h>
 #include <piejam/entity_map.h>
 
+#include <boost/container/flat_set.hpp>
+
 namespace piejam::runtime::fx
 {
 
@@ -20,6 +24,8 @@ struct state
     active_modules_t active_modules;
 
     ladspa_instances_t ladspa_instances;
+    ladspa_event_quantizations_t ladspa_event_quantizations;
+    pipelined_ladspa_instances_t pipelined_ladspa_instances;
     unavailable_ladspa_plugins_t unavailable_ladspa_plugins;
 };
 
@@ -8,8 +8,10 @@
 #include <piejam/runtime/midi_assignment.h>
 #include <piejam/runtime/parameter/assignment.h>
 
+#include <piejam/audio/engine/event_quantization.h>
 #include <piejam/ladspa/fwd.h>
 
+#include <optional>
 #include <vector>
 
 namespace piejam::runtime::fx
@@ -21,6 +23,10 @@ struct unavailable_ladspa
     std::vector<parameter_value_assignment> parameter_values;
     std::vector<parameter_midi_assignment> midi_assignments;
 
+    // measured again on load, if not stored in the session
+    std::optional<audio::engine::event_quantization> event_quantization{};
+    bool pipelined{};
+
     auto operator==(unavailable_ladspa const&) const noexcept -> bool = default;
 };
 
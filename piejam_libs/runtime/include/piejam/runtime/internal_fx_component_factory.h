@@ -6,6 +6,7 @@
 
 #include <piejam/audio/engine/fwd.h>
 #include <piejam/audio/sample_rate.h>
+#include <piejam/entity_id.h>
 #include <piejam/registry_map.h>
 #include <piejam/runtime/fwd.h>
 #include <piejam/runtime/fx/fwd.h>
@@ -19,6 +20,7 @@ namespace piejam::runtime
 
 struct internal_fx_component_factory_args
 {
+    fx::module_id fx_mod_id;
     fx::module const& fx_mod;
     audio::sample_rate sample_rate;
     parameter_processor_factory& param_procs;
@@ -8,9 +8,11 @@
 #include <piejam/runtime/fwd.h>
 #include <piejam/runtime/fx/fwd.h>
 #include <piejam/runtime/fx/get_parameter_name.h>
+#include <piejam/thread/configuration.h>
 
 #include <functional>
 #include <memory>
+#include <optional>
 
 namespace piejam::runtime::ladspa_fx
 {
@@ -18,10 +20,14 @@ namespace piejam::runtime::ladspa_fx
 using processor_factory =
     std::function<std::unique_ptr<audio::engine::processor>()>;
 
+//! If a pipeline thread is passed, the processors run on it, one period
+//! behind.
 auto make_component(
     fx::module const&,
     fx::get_parameter_name const&,
     processor_factory const&,
-    parameter_processor_factory&) -> std::unique_ptr<audio::engine::component>;
+    parameter_processor_factory&,
+    std::optional<thread::configuration> const& pipeline_thread = std::nullopt)
+    -> std::unique_ptr<audio::engine::component>;
 
 } // namespace piejam::runtime::ladspa_fx
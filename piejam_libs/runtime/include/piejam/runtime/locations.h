@@ -16,6 +16,7 @@ struct locations
 
     std::filesystem::path log_file{home_dir / "piejam.log"};
     std::filesystem::path config_file{config_dir / "piejam.config"};
+    std::filesystem::path fftw_wisdom_file{config_dir / "fftw.wisdom"};
     std::filesystem::path last_session_file{home_dir / "last.pjs"};
     std::filesystem::path sessions_dir{home_dir / "sessions"};
     std::filesystem::path recordings_dir{home_dir / "recordings"};
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <piejam/runtime/recording_format.h>
+#include <piejam/runtime/recording_layout.h>
 #include <piejam/runtime/startup_session.h>
 
 #include <piejam/audio/period_size.h>
@@ -19,7 +21,7 @@
 namespace piejam::runtime::persistence
 {
 
-inline constexpr unsigned current_app_config_version = 0;
+inline constexpr unsigned current_app_config_version = 2;
 
 struct app_config
 {
@@ -30,6 +32,8 @@ struct app_config
     std::vector<std::string> enabled_midi_input_devices;
 
     std::size_t rec_session{};
+    runtime::recording_format rec_format{};
+    runtime::recording_layout rec_layout{};
 
     std::size_t display_rotation{};
 
@@ -19,6 +19,7 @@
 #include <nlohmann/json_fwd.hpp>
 
 #include <iosfwd>
+#include <optional>
 #include <string>
 #include <variant>
 #include <vector>
@@ -50,6 +51,12 @@ struct session
         std::string name;
         parameter_value_assignments preset;
         parameter_midi_assignments midi;
+
+        // granularity of the control input events, measured if not set
+        std::optional<std::size_t> event_granularity;
+
+        // processed one period behind, on its own thread
+        bool pipelined{};
     };
 
     struct fx_plugin : std::variant<std::monostate, internal_fx, ladspa_plugin>
@@ -0,0 +1,46 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/engine/fwd.h>
+#include <piejam/entity_id_hash.h>
+#include <piejam/runtime/mixer_fwd.h>
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+namespace piejam::runtime::processors
+{
+
+//! Creates the capture taps of the mixer channels, which are used for
+//! recording. All taps count frames on the same engine clock.
+class capture_tap_factory
+{
+public:
+    using processor_t = audio::engine::capture_tap_processor;
+    using processor_map =
+        std::unordered_map<mixer::channel_id, std::weak_ptr<processor_t>>;
+
+    explicit capture_tap_factory(audio::engine::frame_clock const&);
+    ~capture_tap_factory();
+
+    auto make_processor(
+        mixer::channel_id,
+        std::size_t num_channels,
+        std::size_t capacity_per_channel,
+        std::string_view name = {}) -> std::shared_ptr<processor_t>;
+
+    auto find_processor(mixer::channel_id) const
+        -> std::shared_ptr<processor_t>;
+
+    void clear_expired();
+
+private:
+    audio::engine::frame_clock const& m_clock;
+    processor_map m_procs;
+};
+
+} // namespace piejam::runtime::processors
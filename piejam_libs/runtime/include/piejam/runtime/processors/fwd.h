@@ -10,6 +10,7 @@ namespace piejam::runtime::processors
 template <class...>
 class parameter_processor_factory;
 
+class capture_tap_factory;
 class stream_processor_factory;
 
 } // namespace piejam::runtime::processors
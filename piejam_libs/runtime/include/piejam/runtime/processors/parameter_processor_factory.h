@@ -8,17 +8,21 @@
 
 #include <piejam/audio/engine/value_io_processor.h>
 #include <piejam/entity_id_hash.h>
+#include <piejam/thread/dirty_set.h>
 
 #include <boost/assert.hpp>
 #include <boost/mp11/list.hpp>
 #include <boost/mp11/tuple.hpp>
 
 #include <concepts>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <tuple>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace piejam::runtime::processors
 {
@@ -32,9 +36,17 @@ public:
         audio::engine::value_io_processor<parameter::value_type_t<P>>;
 
     template <class P>
-    using processor_map = std::unordered_map<
-        parameter::id_t<P>,
-        std::weak_ptr<parameter_processor<P>>>;
+    struct processor_entry
+    {
+        std::weak_ptr<parameter_processor<P>> proc;
+        std::size_t change_index{};
+    };
+
+    template <class P>
+    using processor_map =
+        std::unordered_map<parameter::id_t<P>, processor_entry<P>>;
+
+    using parameter_id = std::variant<parameter::id_t<Parameter>...>;
 
     template <class P>
     auto
@@ -67,9 +79,9 @@ public:
     void initialize(FindValue&& find_value) const
     {
         boost::mp11::tuple_for_each(m_procs, [&](auto&& procs) {
-            for (auto&& [id, weak_proc] : procs)
+            for (auto&& [id, entry] : procs)
             {
-                if (auto proc = weak_proc.lock())
+                if (auto proc = entry.proc.lock())
                 {
                     if (auto const value = find_value(id); value)
                     {
@@ -98,6 +110,19 @@ public:
         }
     }
 
+    // Visits only the ids of parameters, whose processors received a new
+    // value since the last call.
+    template <std::invocable<parameter_id const&> F>
+    void for_each_changed(F&& f)
+    {
+        m_changed.consume([&](std::size_t const index) {
+            if (auto const& id = m_changed_ids[index]; id)
+            {
+                std::invoke(f, *id);
+            }
+        });
+    }
+
     void clear_expired()
     {
         (clear_expired<Parameter>(), ...);
@@ -110,7 +135,17 @@ private:
     {
         BOOST_ASSERT(id.valid());
         auto proc = std::make_shared<parameter_processor<P>>(name);
-        std::get<processor_map<P>>(m_procs).insert_or_assign(id, proc);
+
+        auto& map = std::get<processor_map<P>>(m_procs);
+        auto it = map.find(id);
+        std::size_t const change_index =
+            it != map.end() ? it->second.change_index : acquire_change_index();
+        m_changed_ids[change_index] = parameter_id{id};
+        proc->set_change_flag(m_changed.get_flag(change_index));
+
+        map.insert_or_assign(
+            id,
+            processor_entry<P>{.proc = proc, .change_index = change_index});
         return proc;
     }
 
@@ -120,22 +155,39 @@ private:
     {
         auto const& map = std::get<processor_map<P>>(m_procs);
         auto it = map.find(id);
-        return it != map.end() ? it->second.lock() : nullptr;
+        return it != map.end() ? it->second.proc.lock() : nullptr;
     }
 
     template <class P>
-    static bool expired(typename processor_map<P>::value_type const& p) noexcept
+    void clear_expired()
     {
-        return p.second.expired();
+        std::erase_if(
+            std::get<processor_map<P>>(m_procs),
+            [this](auto const& p) {
+                if (!p.second.proc.expired())
+                {
+                    return false;
+                }
+
+                m_changed_ids[p.second.change_index].reset();
+                m_changed.release(p.second.change_index);
+                return true;
+            });
     }
 
-    template <class P>
-    void clear_expired()
+    auto acquire_change_index() -> std::size_t
     {
-        std::erase_if(std::get<processor_map<P>>(m_procs), &expired<P>);
+        std::size_t const index = m_changed.acquire();
+        if (index >= m_changed_ids.size())
+        {
+            m_changed_ids.resize(index + 1);
+        }
+        return index;
     }
 
     std::tuple<processor_map<Parameter>...> m_procs;
+    thread::dirty_set m_changed;
+    std::vector<std::optional<parameter_id>> m_changed_ids;
 };
 
 } // namespace piejam::runtime::processors
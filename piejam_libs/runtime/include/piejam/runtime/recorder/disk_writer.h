@@ -0,0 +1,84 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/recorder/file_writer.h>
+
+#include <piejam/audio/multichannel_view.h>
+#include <piejam/pimpl.h>
+#include <piejam/thread/configuration.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace piejam::runtime::recorder
+{
+
+//! Streams recorded tracks to disk on background threads.
+//!
+//! The producer pushes the audio of each track into a large lock-free ring
+//! buffer. The disk threads drain the rings in chunks of whole pages and
+//! append them to the track files. The tracks are distributed round-robin
+//! over the threads, so encoding files can run in parallel. Every pushed
+//! block carries the engine frame of its first sample. Missing frames, e.g.
+//! dropped by the engine, are detected from the frame index and filled with
+//! silence, so the tracks stay aligned. When a ring overflows or a write
+//! fails, the affected frames are dropped and counted. Frames dropped on
+//! overflow are replaced by silence on a later push, without being counted
+//! as a gap again.
+//! Every commit interval the written data is committed, so it survives a
+//! power loss. On closing, at the latest on destruction, the rings are
+//! drained completely and the files are closed.
+class disk_writer
+{
+public:
+    using channels_view = audio::multichannel_view<
+        float const,
+        audio::multichannel_layout_non_interleaved>;
+
+    using files_t = std::vector<std::unique_ptr<file_writer>>;
+
+    static constexpr std::chrono::milliseconds default_commit_interval{2000};
+
+    //! One thread per configuration is started, but not more than there are
+    //! files. Without configurations a single default thread is started.
+    disk_writer(
+        files_t,
+        std::uint64_t start_frame,
+        std::size_t ring_buffer_frames,
+        std::span<thread::configuration const> threads = {},
+        std::chrono::milliseconds commit_interval = default_commit_interval);
+
+    [[nodiscard]]
+    auto num_tracks() const noexcept -> std::size_t;
+
+    //! Must always be called from the same thread. Doesn't block or allocate.
+    //! The frames of a track must be pushed in ascending order. Returns false,
+    //! if the frames were dropped.
+    auto push(std::size_t track, std::uint64_t frame, channels_view) noexcept
+        -> bool;
+
+    //! Drains the rings and closes the files. Blocks until the disk threads
+    //! are done, nothing must be pushed afterwards. The counters remain
+    //! valid.
+    void close();
+
+    //! Sum over all tracks.
+    [[nodiscard]]
+    auto dropped_frames() const noexcept -> std::size_t;
+
+    //! Sum over all tracks, of the frames filled with silence.
+    [[nodiscard]]
+    auto gap_frames() const noexcept -> std::size_t;
+
+private:
+    struct impl;
+    pimpl<impl> const m_impl;
+};
+
+} // namespace piejam::runtime::recorder
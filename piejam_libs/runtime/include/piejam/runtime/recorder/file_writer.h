@@ -0,0 +1,59 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/recording_format.h>
+
+#include <piejam/audio/sample_rate.h>
+
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+namespace piejam::runtime::recorder
+{
+
+//! Appends interleaved audio to a recording file. Used from a single thread.
+class file_writer
+{
+public:
+    virtual ~file_writer() = default;
+
+    [[nodiscard]]
+    virtual auto num_channels() const noexcept -> std::size_t = 0;
+
+    //! Appends interleaved frames.
+    virtual auto write(std::span<float const> interleaved)
+        -> std::error_code = 0;
+
+    //! Makes the frames written so far durable, so they can be read after a
+    //! power loss. Expensive, meant to be called every few seconds.
+    virtual auto commit() -> std::error_code = 0;
+
+    //! Completes the file. Nothing can be written afterwards.
+    virtual auto close() -> std::error_code = 0;
+};
+
+[[nodiscard]]
+auto file_extension(recording_format) noexcept -> std::string_view;
+
+//! throws std::system_error, if the file can't be created.
+auto make_file_writer(
+    recording_format,
+    std::filesystem::path const&,
+    audio::sample_rate,
+    std::size_t num_channels) -> std::unique_ptr<file_writer>;
+
+//! Adds writing the peak file of the recording, see peak_writer. A peak file,
+//! which can't be created or written, is dropped, the recording isn't
+//! affected.
+auto with_peak_file(
+    std::unique_ptr<file_writer>,
+    std::filesystem::path const& file,
+    audio::sample_rate) -> std::unique_ptr<file_writer>;
+
+} // namespace piejam::runtime::recorder
@@ -0,0 +1,55 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/recorder/file_writer.h>
+
+#include <piejam/audio/sample_rate.h>
+
+#include <sndfile.hh>
+
+#include <filesystem>
+
+namespace piejam::runtime::recorder
+{
+
+//! Encodes 24 bit FLAC files on the fly.
+//!
+//! Encoding costs cpu time, but roughly halves the amount of data which has
+//! to go to the disk. Samples beyond full scale are clipped.
+class flac_writer final : public file_writer
+{
+public:
+    //! throws std::system_error, if the file can't be created.
+    flac_writer(
+        std::filesystem::path const&,
+        audio::sample_rate,
+        std::size_t num_channels);
+
+    ~flac_writer() override;
+
+    [[nodiscard]]
+    auto num_channels() const noexcept -> std::size_t override
+    {
+        return m_num_channels;
+    }
+
+    auto write(std::span<float const> interleaved) -> std::error_code override;
+
+    //! Syncs the encoded frames. The frames still buffered by the encoder
+    //! are not included. The stream info is completed on close only,
+    //! decoders handle the unknown length of a file cut off by a power loss.
+    auto commit() -> std::error_code override;
+
+    auto close() -> std::error_code override;
+
+private:
+    // owned by the writer, for syncing it
+    int m_fd{-1};
+    SndfileHandle m_file;
+    std::size_t m_num_channels{};
+};
+
+} // namespace piejam::runtime::recorder
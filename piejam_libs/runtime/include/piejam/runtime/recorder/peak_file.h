@@ -0,0 +1,133 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/sample_rate.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace piejam::runtime::recorder
+{
+
+//! Minimum and maximum of the samples of a bucket, scaled to 16 bit.
+struct peak
+{
+    std::int16_t min{};
+    std::int16_t max{};
+
+    auto operator==(peak const&) const noexcept -> bool = default;
+};
+
+inline constexpr std::size_t num_peak_levels{3};
+
+//! Each level has 16 times fewer buckets than the one before.
+inline constexpr std::array<std::size_t, num_peak_levels>
+    peak_level_frames_per_bucket{256, 4096, 65536};
+
+//! Header of a peak file. A level holds a bucket after the other, each bucket
+//! holds one peak per channel. The levels follow the header, the finest
+//! first. All values are little endian.
+struct peak_file_header
+{
+    static constexpr std::size_t size{128};
+
+    using bytes_t = std::array<unsigned char, size>;
+
+    std::size_t num_channels{};
+    audio::sample_rate sample_rate;
+    std::size_t num_frames{};
+    std::array<std::size_t, num_peak_levels> num_buckets{};
+    std::array<std::size_t, num_peak_levels> offsets{};
+
+    [[nodiscard]]
+    auto encode() const noexcept -> bytes_t;
+
+    [[nodiscard]]
+    static auto decode(bytes_t const&) noexcept
+        -> std::optional<peak_file_header>;
+};
+
+//! The peak file, which belongs to a recording.
+[[nodiscard]]
+auto peak_file_path(std::filesystem::path const& audio_file)
+    -> std::filesystem::path;
+
+//! The coarsest level, which has at most one bucket per pixel.
+[[nodiscard]]
+auto peak_level_for(double frames_per_pixel) noexcept -> std::size_t;
+
+//! Read-only view of a peak file, the file is memory mapped.
+//!
+//! A file, which wasn't closed, e.g. because the take was interrupted, only
+//! contains the committed buckets of the finest level. The coarser levels are
+//! then built from it in memory.
+class peak_file
+{
+public:
+    //! throws std::system_error, if the file can't be read or is invalid.
+    explicit peak_file(std::filesystem::path const&);
+    peak_file(peak_file&&) noexcept;
+    ~peak_file();
+
+    auto operator=(peak_file&&) noexcept -> peak_file&;
+
+    [[nodiscard]]
+    auto num_channels() const noexcept -> std::size_t
+    {
+        return m_header.num_channels;
+    }
+
+    [[nodiscard]]
+    auto sample_rate() const noexcept -> audio::sample_rate
+    {
+        return m_header.sample_rate;
+    }
+
+    [[nodiscard]]
+    auto num_frames() const noexcept -> std::size_t
+    {
+        return m_header.num_frames;
+    }
+
+    [[nodiscard]]
+    auto num_buckets(std::size_t const level) const noexcept -> std::size_t
+    {
+        return m_header.num_buckets[level];
+    }
+
+    //! All buckets of a level.
+    [[nodiscard]]
+    auto level(std::size_t const level) const noexcept
+        -> std::span<peak const>
+    {
+        return m_levels[level];
+    }
+
+    //! The peaks of all channels in a bucket.
+    [[nodiscard]]
+    auto peaks(std::size_t const level, std::size_t const bucket)
+        const noexcept -> std::span<peak const>
+    {
+        return m_levels[level].subspan(
+            bucket * m_header.num_channels,
+            m_header.num_channels);
+    }
+
+private:
+    void unmap() noexcept;
+
+    void* m_mapping{};
+    std::size_t m_mapping_size{};
+    peak_file_header m_header;
+    std::array<std::span<peak const>, num_peak_levels> m_levels{};
+    std::array<std::vector<peak>, num_peak_levels> m_built_levels{};
+};
+
+} // namespace piejam::runtime::recorder
@@ -0,0 +1,87 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/recorder/peak_file.h>
+
+#include <piejam/audio/sample_rate.h>
+
+#include <array>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace piejam::runtime::recorder
+{
+
+//! Writes the peak file of a recording, while it is being recorded.
+//!
+//! The peaks are built incrementally from the written frames. The finest
+//! level is appended to the file as its buckets complete, the coarser levels
+//! are small and kept in memory until the file is closed. A commit makes the
+//! complete buckets of the finest level durable, which is enough for a
+//! peak_file to rebuild the rest.
+class peak_writer
+{
+public:
+    //! throws std::system_error, if the file can't be created.
+    peak_writer(
+        std::filesystem::path const&,
+        audio::sample_rate,
+        std::size_t num_channels);
+    peak_writer(peak_writer&&) noexcept;
+    ~peak_writer();
+
+    auto operator=(peak_writer&&) noexcept -> peak_writer&;
+
+    [[nodiscard]]
+    auto num_channels() const noexcept -> std::size_t
+    {
+        return m_header.num_channels;
+    }
+
+    //! Adds interleaved frames.
+    auto write(std::span<float const> interleaved) -> std::error_code;
+
+    //! Updates the header to the complete buckets and syncs the file.
+    auto commit() -> std::error_code;
+
+    //! Writes the incomplete buckets and the coarser levels.
+    auto close() -> std::error_code;
+
+private:
+    struct level
+    {
+        std::vector<peak> bucket;
+        std::size_t num_merged{};
+        std::vector<peak> buckets;
+    };
+
+    void complete_bucket();
+    void merge(std::size_t level, std::span<peak const>);
+    void complete_level_bucket(std::size_t level);
+    auto write_pending() -> std::error_code;
+    auto write_header() -> std::error_code;
+
+    static constexpr int invalid = -1;
+
+    int m_fd{invalid};
+    peak_file_header m_header;
+    std::size_t m_num_frames{};
+
+    // the bucket of the finest level, which is being built
+    std::vector<float> m_min;
+    std::vector<float> m_max;
+    std::size_t m_bucket_frames{};
+
+    // complete buckets of the finest level, which aren't written yet
+    std::vector<peak> m_pending;
+
+    // the coarser levels, starting with the second one
+    std::array<level, num_peak_levels - 1> m_coarse_levels;
+};
+
+} // namespace piejam::runtime::recorder
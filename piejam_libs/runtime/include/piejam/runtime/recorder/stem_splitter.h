@@ -0,0 +1,47 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace piejam::runtime::recorder
+{
+
+struct stem
+{
+    std::string name;
+    std::size_t num_channels{};
+};
+
+//! Splits a multitrack file written by the wav_writer into one wave file per
+//! stem. The stems take the channels of the multitrack file in order.
+//!
+//! The multitrack file is read sequentially in big blocks and the samples are
+//! copied without conversion. Frames are taken from the file size, so a file
+//! with an incomplete header can be split as well. The peak file of the
+//! multitrack file is split along, if there is one.
+auto split_stems(
+    std::filesystem::path const& multitrack_file,
+    std::span<stem const>,
+    std::filesystem::path const& stems_dir) -> std::error_code;
+
+//! The stems are kept next to the multitrack file, until it is split. This
+//! way a split, which didn't happen because of a shutdown, can be resumed.
+auto stems_file_path(std::filesystem::path const& multitrack_file)
+    -> std::filesystem::path;
+
+auto save_stems(
+    std::filesystem::path const& multitrack_file,
+    std::span<stem const>) -> std::error_code;
+
+auto load_stems(std::filesystem::path const& multitrack_file)
+    -> std::optional<std::vector<stem>>;
+
+} // namespace piejam::runtime::recorder
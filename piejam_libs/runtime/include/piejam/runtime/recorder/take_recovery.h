@@ -0,0 +1,38 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace piejam::runtime::recorder
+{
+
+//! Remembers the take, which is being recorded, in the marker file. The
+//! marker is removed, once the take is finished. Finding it at startup means
+//! the take was interrupted, e.g. by a power loss.
+void mark_take_started(
+    std::filesystem::path const& marker_file,
+    std::filesystem::path const& take_dir);
+
+void mark_take_finished(std::filesystem::path const& marker_file);
+
+//! Returns the take named in the marker file and removes the marker.
+auto pop_interrupted_take(std::filesystem::path const& marker_file)
+    -> std::optional<std::filesystem::path>;
+
+//! Repairs the wave files of a take. FLAC files are out of scope, they are
+//! left as they are: the stream info of an interrupted file states an unknown
+//! length, which decoders handle, and the frames up to the last commit are
+//! durable.
+void repair_take(std::filesystem::path const& take_dir);
+
+//! Returns the multitrack files in the recordings directory, which still wait
+//! to be split into stems.
+auto find_pending_splits(std::filesystem::path const& recordings_dir)
+    -> std::vector<std::filesystem::path>;
+
+} // namespace piejam::runtime::recorder
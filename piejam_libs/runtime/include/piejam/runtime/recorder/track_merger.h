@@ -0,0 +1,85 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/multichannel_view.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace piejam::runtime::recorder
+{
+
+//! Merges the audio of several tracks into one multichannel stream.
+//!
+//! The tracks are delivered independently and may run ahead of each other by
+//! a few periods, only the frames available for every track are passed on.
+//! The blocks of a track are placed by their engine frame, missing frames
+//! are filled with silence. A track lagging behind by more than the maximum
+//! skew, e.g. because its stream vanished, is padded with silence too, its
+//! frames arriving later are skipped. Both count as gap.
+//! The pending frames are kept in ring storage, sized for twice the maximum
+//! skew. It only grows, if a track runs ahead further than that.
+class track_merger
+{
+public:
+    using channels_view = audio::multichannel_view<
+        float const,
+        audio::multichannel_layout_non_interleaved>;
+
+    track_merger(
+        std::vector<std::size_t> const& track_num_channels,
+        std::uint64_t start_frame,
+        std::size_t max_skew_frames);
+
+    [[nodiscard]]
+    auto num_channels() const noexcept -> std::size_t
+    {
+        return m_num_channels;
+    }
+
+    //! Engine frame of the next pulled frame.
+    [[nodiscard]]
+    auto next_frame() const noexcept -> std::uint64_t
+    {
+        return m_next_frame;
+    }
+
+    //! Frames filled with silence, summed over all tracks.
+    [[nodiscard]]
+    auto gap_frames() const noexcept -> std::size_t
+    {
+        return m_gap_frames;
+    }
+
+    void push(std::size_t track, std::uint64_t frame, channels_view);
+
+    //! Removes the frames, which are available for all tracks. The returned
+    //! view is valid until the next pull.
+    auto pull() -> channels_view;
+
+    //! Removes all frames, missing ones are filled with silence.
+    auto flush() -> channels_view;
+
+private:
+    auto pull(std::size_t num_frames) -> channels_view;
+    void reserve(std::size_t num_frames);
+
+    std::vector<std::size_t> m_track_channel_offsets;
+    std::size_t m_num_channels;
+    std::uint64_t m_next_frame;
+    std::size_t m_max_skew_frames;
+    std::size_t m_gap_frames{};
+
+    // Channel by channel, the frame at m_next_frame is at m_head.
+    std::size_t m_capacity;
+    std::size_t m_head{};
+    std::vector<float> m_ring;
+    std::vector<std::size_t> m_pending_frames;
+
+    std::vector<float> m_merged;
+};
+
+} // namespace piejam::runtime::recorder
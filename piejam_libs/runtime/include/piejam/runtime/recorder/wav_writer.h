@@ -0,0 +1,90 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/recorder/file_writer.h>
+
+#include <piejam/audio/sample_rate.h>
+#include <piejam/numeric/intx.h>
+
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace piejam::runtime::recorder
+{
+
+//! Writes 24 bit PCM wave files.
+//!
+//! The data chunk starts at a page boundary, so appending whole pages keeps
+//! every write aligned. Disk space is preallocated ahead of the write
+//! position, which keeps the file contiguous and lets a full disk show up
+//! early. The header is completed on commit() and close(). Files exceeding
+//! 4 GiB are turned into RF64.
+class wav_writer final : public file_writer
+{
+public:
+    //! Offset of the sample data in the file.
+    static constexpr std::size_t data_offset{4096};
+
+    //! throws std::system_error, if the file can't be created.
+    wav_writer(
+        std::filesystem::path const&,
+        audio::sample_rate,
+        std::size_t num_channels);
+    wav_writer(wav_writer&&) noexcept;
+    ~wav_writer() override;
+
+    auto operator=(wav_writer&&) noexcept -> wav_writer&;
+
+    [[nodiscard]]
+    auto sample_rate() const noexcept -> audio::sample_rate
+    {
+        return m_sample_rate;
+    }
+
+    [[nodiscard]]
+    auto num_channels() const noexcept -> std::size_t override
+    {
+        return m_num_channels;
+    }
+
+    [[nodiscard]]
+    auto num_frames() const noexcept -> std::size_t
+    {
+        return m_num_frames;
+    }
+
+    //! Appends interleaved frames.
+    auto write(std::span<float const> interleaved) -> std::error_code override;
+
+    //! Appends interleaved frames, which are already in the file format.
+    auto write_pcm(std::span<numeric::int24_io_t const> interleaved)
+        -> std::error_code;
+
+    //! Updates the header to the written frames and syncs the file.
+    auto commit() -> std::error_code override;
+
+    //! Completes the header and releases the unused preallocated space.
+    auto close() -> std::error_code override;
+
+    //! Completes the header of a file, which wasn't closed, e.g. because of a
+    //! power loss. A partially written frame at the end is cut off.
+    static auto repair(std::filesystem::path const&) -> std::error_code;
+
+private:
+    static constexpr int invalid = -1;
+
+    int m_fd{invalid};
+    audio::sample_rate m_sample_rate;
+    std::size_t m_num_channels{};
+    std::size_t m_num_frames{};
+    std::size_t m_allocated_size{};
+    bool m_preallocate{true};
+    std::vector<numeric::int24_io_t> m_pcm;
+};
+
+} // namespace piejam::runtime::recorder
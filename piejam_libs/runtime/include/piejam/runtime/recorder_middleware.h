@@ -9,6 +9,7 @@
 #include <piejam/pimpl.h>
 
 #include <filesystem>
+#include <vector>
 
 namespace piejam::runtime
 {
@@ -16,7 +17,11 @@ namespace piejam::runtime
 class recorder_middleware final
 {
 public:
-    explicit recorder_middleware(std::filesystem::path recordings_dir);
+    //! Encoders are pinned to the background cpus, which should be free of
+    //! audio threads.
+    recorder_middleware(
+        std::filesystem::path recordings_dir,
+        std::vector<unsigned> background_cpus);
 
     void operator()(middleware_functors const&, action const&);
 
@@ -0,0 +1,16 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+namespace piejam::runtime
+{
+
+enum class recording_format : bool
+{
+    wav,
+    flac,
+};
+
+} // namespace piejam::runtime
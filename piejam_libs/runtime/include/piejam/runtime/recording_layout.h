@@ -0,0 +1,19 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+namespace piejam::runtime
+{
+
+//! Recording into a single multitrack file trades the many small writes of
+//! concurrent track files for one sequential stream. The stems are split off
+//! in the background, after the recording stopped.
+enum class recording_layout : bool
+{
+    file_per_track,
+    single_file,
+};
+
+} // namespace piejam::runtime
@@ -233,6 +233,8 @@ extern selector<bool> const select_midi_learning;
 extern selector<fx::registry> const select_fx_registry;
 
 extern selector<bool> const select_recording;
+extern selector<recording_format> const select_recording_format;
+extern selector<recording_layout> const select_recording_layout;
 
 extern selector<std::size_t> const select_xruns;
 extern selector<float> const select_cpu_load;
@@ -21,6 +21,8 @@
 #include <piejam/runtime/parameter/assignment.h>
 #include <piejam/runtime/parameter/store.h>
 #include <piejam/runtime/parameters.h>
+#include <piejam/runtime/recording_format.h>
+#include <piejam/runtime/recording_layout.h>
 #include <piejam/runtime/root_view_mode.h>
 #include <piejam/runtime/selected_sound_card.h>
 #include <piejam/runtime/startup_session.h>
@@ -75,6 +77,9 @@ struct state
     bool recording{};
     std::size_t rec_session{};
     std::size_t rec_take{};
+    runtime::recording_format rec_format{runtime::recording_format::wav};
+    runtime::recording_layout rec_layout{
+        runtime::recording_layout::file_per_track};
 
     std::size_t xruns{};
     float cpu_load{};
@@ -142,6 +147,7 @@ auto insert_ladspa_fx_module(
     ladspa::instance_id,
     ladspa::plugin_descriptor const&,
     std::span<ladspa::port_descriptor const> control_inputs,
+    audio::engine::event_quantization,
     std::span<parameter_value_assignment const> initial_values,
     std::span<parameter_midi_assignment const> midi_assigns) -> fx::module_id;
 
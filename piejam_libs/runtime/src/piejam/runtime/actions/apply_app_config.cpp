@@ -13,6 +13,8 @@ void
 apply_app_config::reduce(state& st) const
 {
     st.rec_session = conf.rec_session;
+    st.rec_format = conf.rec_format;
+    st.rec_layout = conf.rec_layout;
     st.display_rotation = conf.display_rotation;
     st.startup_session = conf.startup_session;
     st.current_session = conf.last_session_file;
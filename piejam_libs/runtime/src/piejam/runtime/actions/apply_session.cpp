@@ -83,14 +83,28 @@ apply_mixer_fx_chain(
                         fx.midi);
                 },
                 [&](persistence::session::ladspa_plugin const& ladspa_plug) {
+                    fx::unavailable_ladspa unavail{
+                        .plugin_id = ladspa_plug.id,
+                        .parameter_values = ladspa_plug.preset,
+                        .midi_assignments = ladspa_plug.midi,
+                        .pipelined = ladspa_plug.pipelined};
+                    // an invalid granularity is dropped, it is measured
+                    // again on load then
+                    if (ladspa_plug.event_granularity)
+                    {
+                        audio::engine::event_quantization const quantization{
+                            *ladspa_plug.event_granularity};
+                        if (quantization.is_valid())
+                        {
+                            unavail.event_quantization = quantization;
+                        }
+                    }
+
                     return runtime::insert_missing_ladspa_fx_module(
                         st,
                         channel_id,
                         npos,
-                        fx::unavailable_ladspa{
-                            .plugin_id = ladspa_plug.id,
-                            .parameter_values = ladspa_plug.preset,
-                            .midi_assignments = ladspa_plug.midi},
+                        unavail,
                         ladspa_plug.name);
                 },
                 [](auto const&) -> fx::module_id {
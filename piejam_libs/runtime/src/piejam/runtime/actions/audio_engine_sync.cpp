@@ -39,7 +39,7 @@ audio_engine_sync_update::empty() const noexcept -> bool
 {
     return !tuple::for_each_until(values, [](auto const& vs) {
         return vs.empty();
-    }) && streams.empty();
+    }) && streams.empty() && captures.empty();
 }
 
 } // namespace piejam::runtime::actions
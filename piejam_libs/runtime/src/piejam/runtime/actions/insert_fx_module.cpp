@@ -42,6 +42,7 @@ insert_ladspa_fx_module::reduce(state& st) const
         instance_id,
         plugin_desc,
         control_inputs,
+        event_quantization,
         initial_values,
         midi_assignments);
 
@@ -88,9 +89,16 @@ replace_missing_ladspa_fx_module::reduce(state& st) const
                 ladspa_instance.instance_id,
                 ladspa_instance.plugin_desc,
                 ladspa_instance.control_inputs,
+                ladspa_instance.event_quantization,
                 unavail.parameter_values,
                 unavail.midi_assignments);
 
+            if (unavail.pipelined)
+            {
+                st.fx_state.pipelined_ladspa_instances.lock()->insert(
+                    ladspa_instance.instance_id);
+            }
+
             // transfer active state
             st.params.at(st.fx_state.active_modules.at(fx_mod_id))
                 .set(st.params.at(st.fx_state.active_modules.at(prev_fx_mod_id))
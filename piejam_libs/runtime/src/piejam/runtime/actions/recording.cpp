@@ -0,0 +1,24 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/actions/recording.h>
+
+#include <piejam/runtime/state.h>
+
+namespace piejam::runtime::actions
+{
+
+void
+set_recording_format::reduce(state& st) const
+{
+    st.rec_format = format;
+}
+
+void
+set_recording_layout::reduce(state& st) const
+{
+    st.rec_layout = layout;
+}
+
+} // namespace piejam::runtime::actions
@@ -0,0 +1,28 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/actions/set_ladspa_fx_event_quantization.h>
+
+#include <piejam/runtime/state.h>
+
+#include <boost/assert.hpp>
+
+namespace piejam::runtime::actions
+{
+
+void
+set_ladspa_fx_event_quantization::reduce(state& st) const
+{
+    BOOST_ASSERT(event_quantization.granularity > 0);
+
+    auto const& fx_mod = st.fx_state.modules.at(fx_mod_id);
+    if (auto const* const id =
+            std::get_if<ladspa::instance_id>(&fx_mod.fx_instance_id))
+    {
+        st.fx_state.ladspa_event_quantizations.assign(*id, event_quantization);
+        st.session_modified = true;
+    }
+}
+
+} // namespace piejam::runtime::actions
@@ -0,0 +1,33 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/actions/set_ladspa_fx_pipelined.h>
+
+#include <piejam/runtime/state.h>
+
+namespace piejam::runtime::actions
+{
+
+void
+set_ladspa_fx_pipelined::reduce(state& st) const
+{
+    auto const& fx_mod = st.fx_state.modules.at(fx_mod_id);
+    if (auto const* const id =
+            std::get_if<ladspa::instance_id>(&fx_mod.fx_instance_id))
+    {
+        auto instances = st.fx_state.pipelined_ladspa_instances.lock();
+        if (pipelined)
+        {
+            instances->insert(*id);
+        }
+        else
+        {
+            instances->erase(*id);
+        }
+
+        st.session_modified = true;
+    }
+}
+
+} // namespace piejam::runtime::actions
@@ -12,6 +12,7 @@
 #include <piejam/runtime/fx/module.h>
 #include <piejam/runtime/mixer.h>
 #include <piejam/runtime/parameter_processor_factory.h>
+#include <piejam/runtime/processors/capture_tap_factory.h>
 #include <piejam/runtime/processors/midi_assignment_processor.h>
 #include <piejam/runtime/processors/midi_input_processor.h>
 #include <piejam/runtime/processors/midi_learn_processor.h>
@@ -23,9 +24,12 @@
 #include <piejam/algorithm/for_each_adjacent.h>
 #include <piejam/algorithm/transform_to_vector.h>
 #include <piejam/asserted.h>
+#include <piejam/audio/components/period_delay.h>
+#include <piejam/audio/engine/capture_tap_processor.h>
 #include <piejam/audio/engine/component.h>
 #include <piejam/audio/engine/dag.h>
 #include <piejam/audio/engine/dag_executor.h>
+#include <piejam/audio/engine/frame_clock.h>
 #include <piejam/audio/engine/graph.h>
 #include <piejam/audio/engine/graph_algorithms.h>
 #include <piejam/audio/engine/graph_generic_algorithms.h>
@@ -114,6 +118,15 @@ struct component_map
     component_ptr solo_switch;
 
     components_t<fx::module_id> fx_modules;
+
+    // the LADSPA fx components are remade, when their event quantization
+    // changes or they are (un)pipelined
+    fx::ladspa_event_quantizations_t ladspa_event_quantizations;
+    fx::pipelined_ladspa_instances_t pipelined_ladspa_instances;
+
+    // delays the paths which join pipelined ones, so they stay aligned
+    components_t<mixer::channel_id> mixer_output_delays;
+    components_t<mixer_aux_send_key> mixer_aux_send_delays;
 };
 
 template <class T>
@@ -129,7 +142,8 @@ make_mixer_components(
     mixer::state const& mixer_state,
     parameter::store const& params,
     parameter_processor_factory& param_procs,
-    processors::stream_processor_factory& stream_procs)
+    processors::stream_processor_factory& stream_procs,
+    processors::capture_tap_factory& capture_taps)
 {
     for (auto const& [mixer_channel_id, mixer_channel] : mixer_state.channels)
     {
@@ -155,10 +169,12 @@ make_mixer_components(
             comps.mixer_outputs.emplace(
                 mixer_channel_id,
                 components::make_mixer_channel_output(
+                    mixer_channel_id,
                     mixer_channel,
                     *strings.at(mixer_channel.name),
                     param_procs,
                     stream_procs,
+                    capture_taps,
                     sample_rate));
         }
 
@@ -212,6 +228,7 @@ make_fx_chain_components(
     fx::state const& fx_state,
     parameter::store const& params,
     fx::simple_ladspa_processor_factory const& ladspa_fx_proc_factory,
+    std::optional<thread::configuration> const& ladspa_pipeline_thread,
     parameter_processor_factory& param_procs,
     processors::stream_processor_factory& stream_procs)
 {
@@ -224,6 +241,30 @@ make_fx_chain_components(
             param_id);
     };
 
+    auto is_pipelined = [&](fx::module const& fx_mod) {
+        auto const* const id =
+            std::get_if<ladspa::instance_id>(&fx_mod.fx_instance_id);
+        return id && fx_state.pipelined_ladspa_instances->contains(*id);
+    };
+
+    auto ladspa_fx_changed = [&](fx::module const& fx_mod) {
+        auto const* const id =
+            std::get_if<ladspa::instance_id>(&fx_mod.fx_instance_id);
+        if (!id)
+        {
+            return false;
+        }
+
+        auto const* const prev =
+            prev_comps.ladspa_event_quantizations.find(*id);
+        return !prev || *prev != fx_state.ladspa_event_quantizations.at(*id) ||
+               prev_comps.pipelined_ladspa_instances->contains(*id) !=
+                   is_pipelined(fx_mod);
+    };
+
+    comps.ladspa_event_quantizations = fx_state.ladspa_event_quantizations;
+    comps.pipelined_ladspa_instances = fx_state.pipelined_ladspa_instances;
+
     for (auto const& [fx_mod_id, fx_mod] : fx_state.modules)
     {
         if (!params.at(fx_state.active_modules.at(fx_mod_id)).get())
@@ -231,7 +272,8 @@ make_fx_chain_components(
             continue;
         }
 
-        if (auto fx_comp = prev_comps.fx_modules.find(fx_mod_id))
+        if (auto fx_comp = prev_comps.fx_modules.find(fx_mod_id);
+            fx_comp && !ladspa_fx_changed(fx_mod))
         {
             BOOST_ASSERT(*fx_comp);
             comps.fx_modules.emplace(fx_mod_id, *fx_comp);
@@ -239,12 +281,15 @@ make_fx_chain_components(
         else
         {
             auto comp = components::make_fx(
+                fx_mod_id,
                 fx_mod,
                 get_fx_param_name,
                 ladspa_fx_proc_factory,
                 param_procs,
                 stream_procs,
-                sample_rate);
+                sample_rate,
+                is_pipelined(fx_mod) ? ladspa_pipeline_thread
+                                     : std::nullopt);
             if (comp)
             {
                 comps.fx_modules.emplace(fx_mod_id, std::move(comp));
@@ -253,6 +298,181 @@ make_fx_chain_components(
     }
 }
 
+// Latencies of the mixer channels in periods, added by the pipelined fx.
+class mixer_channel_latencies
+{
+public:
+    mixer_channel_latencies(
+        component_map const& comps,
+        mixer::state const& mixer_state)
+        : m_comps(comps)
+        , m_mixer_state(mixer_state)
+    {
+    }
+
+    auto in(mixer::channel_id const mixer_channel_id) -> std::size_t
+    {
+        return std::visit(
+            boost::hof::match(
+                [&](mixer::channel_id const src_channel_id) {
+                    return out(src_channel_id);
+                },
+                [&](mixer::mix_input) { return mix_input(mixer_channel_id); },
+                [](auto const&) { return 0uz; }),
+            m_mixer_state.io_map.at(mixer_channel_id).in());
+    }
+
+    auto out(mixer::channel_id const mixer_channel_id) -> std::size_t
+    {
+        if (auto const* const latency = m_out.find(mixer_channel_id))
+        {
+            return *latency;
+        }
+
+        // the mixer doesn't allow routing cycles, this only guards the
+        // recursion
+        m_out.emplace(mixer_channel_id, 0);
+
+        std::size_t latency = in(mixer_channel_id);
+        for (fx::module_id const fx_mod_id :
+             m_mixer_state.fx_chains.at(mixer_channel_id))
+        {
+            if (auto const* const comp = m_comps.fx_modules.find(fx_mod_id))
+            {
+                latency += (*comp)->period_latency();
+            }
+        }
+
+        m_out.at(mixer_channel_id) = latency;
+        return latency;
+    }
+
+    // The channels routed to a device are mixed in its outputs.
+    auto device(external_audio::device_id const device_id) -> std::size_t
+    {
+        std::size_t result{};
+        for (auto const& [mixer_channel_id, io] : m_mixer_state.io_map)
+        {
+            if (auto const* const dst =
+                    std::get_if<external_audio::device_id>(&io.out());
+                dst && *dst == device_id)
+            {
+                result = std::max(result, out(mixer_channel_id));
+            }
+        }
+        return result;
+    }
+
+private:
+    auto mix_input(mixer::channel_id const mixer_channel_id) -> std::size_t
+    {
+        std::size_t result{};
+        for (auto const& [src_channel_id, io] : m_mixer_state.io_map)
+        {
+            if (auto const* const dst =
+                    std::get_if<mixer::channel_id>(&io.out());
+                dst && *dst == mixer_channel_id)
+            {
+                result = std::max(result, out(src_channel_id));
+            }
+        }
+
+        for (auto const& [aux_send_key, aux_send] : m_comps.mixer_aux_sends)
+        {
+            if (aux_send_key.route == mixer_channel_id)
+            {
+                result = std::max(result, out(aux_send_key.channel_id));
+            }
+        }
+
+        return result;
+    }
+
+    component_map const& m_comps;
+    mixer::state const& m_mixer_state;
+    lean_map_facade<boost::container::flat_map<mixer::channel_id, std::size_t>>
+        m_out;
+};
+
+// Paths joining other paths with more pipelined fx are delayed by the
+// difference, so the mixed signals stay aligned.
+void
+make_latency_compensation_components(
+    component_map& comps,
+    component_map& prev_comps,
+    mixer::state const& mixer_state)
+{
+    mixer_channel_latencies latencies{comps, mixer_state};
+
+    auto make_delay = [](auto& delays,
+                         auto const& prev_delays,
+                         auto const& key,
+                         std::size_t const num_periods) {
+        if (num_periods == 0)
+        {
+            return;
+        }
+
+        if (auto comp = prev_delays.find(key);
+            comp && (*comp)->period_latency() == num_periods)
+        {
+            delays.emplace(key, *comp);
+        }
+        else
+        {
+            delays.emplace(
+                key,
+                audio::components::make_period_delay(
+                    2,
+                    num_periods,
+                    "latency_compensation"));
+        }
+    };
+
+    for (auto const& [mixer_channel_id, mixer_channel] : mixer_state.channels)
+    {
+        std::size_t const out_latency = latencies.out(mixer_channel_id);
+        std::size_t const route_latency = std::visit(
+            boost::hof::match(
+                [&](external_audio::device_id const device_id) {
+                    return latencies.device(device_id);
+                },
+                [&](mixer::channel_id const dst_channel_id) {
+                    return std::holds_alternative<mixer::mix_input>(
+                               mixer_state.io_map.at(dst_channel_id).in())
+                               ? latencies.in(dst_channel_id)
+                               : out_latency;
+                },
+                [&](auto const&) { return out_latency; }),
+            mixer_state.io_map.at(mixer_channel_id).out());
+
+        BOOST_ASSERT(out_latency <= route_latency);
+        make_delay(
+            comps.mixer_output_delays,
+            prev_comps.mixer_output_delays,
+            mixer_channel_id,
+            route_latency - out_latency);
+    }
+
+    for (auto const& [aux_send_key, aux_send] : comps.mixer_aux_sends)
+    {
+        if (std::holds_alternative<mixer::mix_input>(
+                mixer_state.io_map.at(aux_send_key.route).in()))
+        {
+            std::size_t const out_latency =
+                latencies.out(aux_send_key.channel_id);
+            std::size_t const route_latency = latencies.in(aux_send_key.route);
+
+            BOOST_ASSERT(out_latency <= route_latency);
+            make_delay(
+                comps.mixer_aux_send_delays,
+                prev_comps.mixer_aux_send_delays,
+                aux_send_key,
+                route_latency - out_latency);
+        }
+    }
+}
+
 auto
 make_midi_processors(
     std::unique_ptr<midi::input_event_handler> midi_in,
@@ -546,9 +766,21 @@ connect_aux_sends(
                         comps.mixer_inputs.at(aux).get();
                     BOOST_ASSERT(dst_mixer_channel_in_comp);
 
+                    audio::engine::component* aux_send_out =
+                        mixer_channel_aux_send->get();
+                    if (auto const* const delay =
+                            comps.mixer_aux_send_delays.find(
+                                component_map::mixer_aux_send_key{
+                                    mixer_channel_id,
+                                    aux}))
+                    {
+                        audio::engine::connect(g, *aux_send_out, **delay);
+                        aux_send_out = delay->get();
+                    }
+
                     audio::engine::connect(
                         g,
-                        *mixer_channel_aux_send->get(),
+                        *aux_send_out,
                         *dst_mixer_channel_in_comp);
                 }
             }
@@ -596,6 +828,15 @@ make_graph(
             mixer_state.fx_chains.at(mixer_channel_id),
             mixer_channel_out);
 
+        audio::engine::component* mixer_channel_routed_out =
+            &mixer_channel_out;
+        if (auto const* const delay =
+                comps.mixer_output_delays.find(mixer_channel_id))
+        {
+            audio::engine::connect(g, mixer_channel_out, **delay);
+            mixer_channel_routed_out = delay->get();
+        }
+
         connect_mixer_output(
             g,
             mixer_state,
@@ -603,7 +844,7 @@ make_graph(
             comps,
             output_procs,
             mixer_state.io_map.at(mixer_channel_id).out(),
-            mixer_channel_out);
+            *mixer_channel_routed_out);
 
         connect_aux_sends(g, mixer_state, mixer_channel_id, comps, params);
     }
@@ -723,9 +964,11 @@ struct audio_engine::impl
         audio::sample_rate const sr,
         std::span<audio::engine::rt_task_executor> const workers,
         std::size_t num_device_input_channels,
-        std::size_t num_device_output_channels)
+        std::size_t num_device_output_channels,
+        std::optional<thread::configuration> ladspa_pipeline_thread)
         : sample_rate(sr)
         , worker_threads(workers)
+        , ladspa_pipeline_thread(std::move(ladspa_pipeline_thread))
         , input_procs(
               make_io_processors<audio::engine::input_processor>(
                   num_device_input_channels))
@@ -739,6 +982,7 @@ struct audio_engine::impl
 
     audio::engine::process process;
     std::span<audio::engine::rt_task_executor> worker_threads;
+    std::optional<thread::configuration> ladspa_pipeline_thread;
 
     std::vector<std::unique_ptr<audio::engine::input_processor>> input_procs;
     std::vector<std::unique_ptr<audio::engine::output_processor>> output_procs;
@@ -752,6 +996,9 @@ struct audio_engine::impl
     parameter_processor_factory param_procs;
     processors::stream_processor_factory stream_procs;
 
+    audio::engine::frame_clock clock;
+    processors::capture_tap_factory capture_taps{clock};
+
     audio::engine::graph graph;
 };
 
@@ -759,13 +1006,15 @@ audio_engine::audio_engine(
     std::span<audio::engine::rt_task_executor> const workers,
     audio::sample_rate const sample_rate,
     unsigned const num_device_input_channels,
-    unsigned const num_device_output_channels)
+    unsigned const num_device_output_channels,
+    std::optional<thread::configuration> ladspa_pipeline_thread)
     : m_impl(
           make_pimpl<impl>(
               sample_rate,
               workers,
               num_device_input_channels,
-              num_device_output_channels))
+              num_device_output_channels,
+              std::move(ladspa_pipeline_thread)))
 {
 }
 
@@ -809,6 +1058,15 @@ template auto audio_engine::get_parameter_update(int_parameter_id) const
 template auto audio_engine::get_parameter_update(enum_parameter_id) const
     -> std::optional<int>;
 
+auto
+audio_engine::get_changed_parameters() const -> std::vector<parameter_id>
+{
+    std::vector<parameter_id> result;
+    m_impl->param_procs.for_each_changed(
+        [&result](parameter_id const& id) { result.push_back(id); });
+    return result;
+}
+
 auto
 audio_engine::get_learned_midi() const -> std::optional<midi::external_event>
 {
@@ -834,6 +1092,35 @@ audio_engine::get_stream(audio_stream_id const id) const -> audio_stream_buffer
     return audio_stream_buffer{};
 }
 
+auto
+audio_engine::current_frame() const noexcept -> std::uint64_t
+{
+    return m_impl->clock.now();
+}
+
+void
+audio_engine::arm_capture(
+    mixer::channel_id const id,
+    audio::engine::capture_window const& window) const
+{
+    if (auto proc = m_impl->capture_taps.find_processor(id))
+    {
+        proc->arm(window);
+    }
+}
+
+auto
+audio_engine::get_capture(mixer::channel_id const id) const
+    -> std::vector<audio::engine::captured_frames>
+{
+    if (auto proc = m_impl->capture_taps.find_processor(id))
+    {
+        return proc->consume();
+    }
+
+    return {};
+}
+
 bool
 audio_engine::rebuild(
     state const& st,
@@ -851,7 +1138,8 @@ audio_engine::rebuild(
         st.mixer_state,
         st.params,
         m_impl->param_procs,
-        m_impl->stream_procs);
+        m_impl->stream_procs,
+        m_impl->capture_taps);
     make_fx_chain_components(
         comps,
         m_impl->comps,
@@ -859,8 +1147,13 @@ audio_engine::rebuild(
         st.fx_state,
         st.params,
         ladspa_fx_proc_factory,
+        m_impl->ladspa_pipeline_thread,
         m_impl->param_procs,
         m_impl->stream_procs);
+    make_latency_compensation_components(
+        comps,
+        m_impl->comps,
+        st.mixer_state);
     auto const solo_groups = runtime::solo_groups(
         st.mixer_state.channels,
         st.mixer_state.io_map,
@@ -927,6 +1220,7 @@ audio_engine::rebuild(
 
     m_impl->param_procs.clear_expired();
     m_impl->stream_procs.clear_expired();
+    m_impl->capture_taps.clear_expired();
 
     {
         std::ofstream os("graph.dot");
@@ -963,7 +1257,9 @@ auto
 audio_engine::process(std::size_t const buffer_size) noexcept
     -> std::chrono::nanoseconds
 {
-    return m_impl->process(buffer_size);
+    auto const duration = m_impl->process(buffer_size);
+    m_impl->clock.advance(buffer_size);
+    return duration;
 }
 
 } // namespace piejam::runtime
@@ -16,7 +16,9 @@
 #include <piejam/runtime/actions/select_sample_rate.h>
 #include <piejam/runtime/actions/set_parameter_value.h>
 #include <piejam/runtime/audio_engine.h>
+#include <piejam/runtime/bounce_job.h>
 #include <piejam/runtime/fwd.h>
+#include <piejam/runtime/fx/ladspa_processor_factory.h>
 #include <piejam/runtime/middleware_functors.h>
 #include <piejam/runtime/midi_input_controller.h>
 #include <piejam/runtime/state.h>
@@ -37,6 +39,7 @@
 #include <piejam/ladspa/processor_factory.h>
 #include <piejam/midi/event.h>
 #include <piejam/midi/input_event_handler.h>
+#include <piejam/system/file_utils.h>
 #include <piejam/tuple.h>
 #include <piejam/tuple_element_compare.h>
 
@@ -46,6 +49,11 @@
 #include <boost/mp11/tuple.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
 
+#include <chrono>
+#include <format>
+#include <thread>
+#include <utility>
+
 namespace piejam::runtime
 {
 
@@ -83,12 +91,84 @@ struct update_info final : ui::cloneable_action<update_info, reducible_action>
     }
 };
 
+// Taps armed this far ahead start on the same frame, even if the arming
+// overlaps with the processing of a period.
+auto
+capture_arming_margin(state const& st) -> std::uint64_t
+{
+    return 2 * st.period_size.value();
+}
+
+// The stop frame is reached within a few periods, unless the audio
+// processing stalls.
+constexpr std::chrono::seconds capture_stop_timeout{1};
+
+// The first thread renders, one worker per further background cpu.
+auto
+bounce_threads(std::span<unsigned const> const background_cpus)
+    -> std::vector<thread::configuration>
+{
+    if (background_cpus.empty())
+    {
+        return {thread::configuration{
+            .affinity = std::nullopt,
+            .realtime_priority = std::nullopt,
+            .name = "bounce"}};
+    }
+
+    std::vector<thread::configuration> result;
+    result.reserve(background_cpus.size());
+
+    for (std::size_t i = 0; i < background_cpus.size(); ++i)
+    {
+        result.push_back(thread::configuration{
+            .affinity = background_cpus[i],
+            .realtime_priority = std::nullopt,
+            .name = i == 0 ? std::string{"bounce"}
+                           : std::format("bounce_worker_{}", i)});
+    }
+
+    return result;
+}
+
+// Below the audio thread, so the workers of the graph preempt it. It catches
+// up while they are waiting for the next period.
+auto
+make_ladspa_pipeline_thread_config(
+    thread::configuration const& audio_thread_config) -> thread::configuration
+{
+    return thread::configuration{
+        .affinity = std::nullopt,
+        .realtime_priority = audio_thread_config.realtime_priority.transform(
+            [](int const prio) { return prio - 1; }),
+        .name = "ladspa_pipeline"};
+}
+
+// The event quantizations are copied, the factory might outlive the state.
+auto
+make_ladspa_fx_processor_factory(
+    ladspa::processor_factory& ladspa_processor_factory,
+    state const& st) -> fx::simple_ladspa_processor_factory
+{
+    return [&ladspa_processor_factory,
+            sample_rate = st.sample_rate,
+            event_quantizations = st.fx_state.ladspa_event_quantizations](
+               ladspa::instance_id id) {
+        return ladspa_processor_factory.make_processor(
+            id,
+            sample_rate,
+            event_quantizations.at(id));
+    };
+}
+
 static auto
 current_rebuild_tracker_state(state const& st)
 {
     return std::tuple{
         st.mixer_state.io_map,
         st.mixer_state.fx_chains,
+        st.fx_state.ladspa_event_quantizations,
+        st.fx_state.pipelined_ladspa_instances,
         st.external_audio_state.device_channels,
         st.midi_learning.has_value(),
         st.audio_graph_update_count};
@@ -124,7 +204,8 @@ audio_engine_middleware::audio_engine_middleware(
     std::span<thread::configuration const> const wt_configs,
     audio::sound_card_manager& sound_card_manager,
     ladspa::processor_factory& ladspa_processor_factory,
-    std::unique_ptr<midi_input_controller> midi_controller)
+    std::unique_ptr<midi_input_controller> midi_controller,
+    std::vector<unsigned> background_cpus)
     : m_audio_thread_config(audio_thread_config)
     , m_workers(wt_configs.begin(), wt_configs.end())
     , m_sound_card_manager(sound_card_manager)
@@ -133,6 +214,7 @@ audio_engine_middleware::audio_engine_middleware(
           midi_controller ? std::move(midi_controller)
                           : make_dummy_midi_input_controller())
     , m_io_process(audio::make_dummy_io_process())
+    , m_background_cpus(std::move(background_cpus))
     , m_rebuild_tracker{make_pimpl<rebuild_tracker>()}
 {
 }
@@ -334,14 +416,12 @@ audio_engine_middleware::process_engine_action(
     mw_fs.next(a);
 }
 
-template <std::ranges::range Parameters>
 static void
 collect_parameter_updates(
-    Parameters&& params,
     audio_engine const& engine,
     actions::audio_engine_sync_update& action)
 {
-    algorithm::for_each_visit(std::forward<Parameters>(params), [&](auto id) {
+    algorithm::for_each_visit(engine.get_changed_parameters(), [&](auto id) {
         if (auto value = engine.get_parameter_update(id); value)
         {
             action.push_back(id, *value);
@@ -365,6 +445,21 @@ collect_stream_updates(
     }
 }
 
+static void
+collect_capture_updates(
+    std::span<mixer::channel_id const> const channels,
+    audio_engine const& engine,
+    actions::audio_engine_sync_update& action)
+{
+    for (auto id : channels)
+    {
+        if (auto captured = engine.get_capture(id); !captured.empty())
+        {
+            action.captures.emplace(id, std::move(captured));
+        }
+    }
+}
+
 template <>
 void
 audio_engine_middleware::process_engine_action(
@@ -377,20 +472,31 @@ audio_engine_middleware::process_engine_action(
 
         actions::audio_engine_sync_update next_action;
 
-        collect_parameter_updates(
-            st.midi_assignments.get() | std::views::keys,
-            *m_engine,
-            next_action);
+        collect_parameter_updates(*m_engine, next_action);
 
         collect_stream_updates(
             st.streams | std::views::keys,
             *m_engine,
             next_action);
 
+        // checked ahead of collecting, so the captures reach the stop frame
+        bool const capture_stopped =
+            m_capture_stop &&
+            (m_engine->current_frame() >= *m_capture_stop ||
+             !m_io_process->is_running() ||
+             std::chrono::steady_clock::now() >= m_capture_stop_deadline);
+
+        collect_capture_updates(m_capture_channels, *m_engine, next_action);
+
         if (!next_action.empty())
         {
             mw_fs.next(next_action);
         }
+
+        if (capture_stopped)
+        {
+            finish_recording(mw_fs);
+        }
     }
 }
 
@@ -398,10 +504,113 @@ template <>
 void
 audio_engine_middleware::process_engine_action(
     middleware_functors const& mw_fs,
-    actions::stop_recording const& a)
+    actions::start_recording const& a)
 {
+    if (!m_engine)
+    {
+        mw_fs.next(a);
+        return;
+    }
+
+    state const& st = mw_fs.get_state();
+
+    // Armed before the recorder opens the files, which may take longer than
+    // the arming margin.
+    audio::engine::capture_window const window{
+        .start = m_engine->current_frame() + capture_arming_margin(st),
+        .stop = audio::engine::capture_window::open_end};
+
+    m_capture_channels.clear();
+    for (auto const& [mixer_channel_id, mixer_channel] :
+         st.mixer_state.channels)
+    {
+        if (st.params.at(mixer_channel.record()).get())
+        {
+            m_engine->arm_capture(mixer_channel_id, window);
+            m_capture_channels.push_back(mixer_channel_id);
+        }
+    }
+
+    m_capture_start = window.start;
+
+    actions::start_recording next_action{a};
+    next_action.start_frame = window.start;
+    mw_fs.next(next_action);
+
+    if (!mw_fs.get_state().recording)
+    {
+        for (auto id : std::exchange(m_capture_channels, {}))
+        {
+            m_engine->arm_capture(id, audio::engine::capture_window{});
+        }
+    }
+}
+
+template <>
+void
+audio_engine_middleware::process_engine_action(
+    middleware_functors const& mw_fs,
+    actions::stop_recording const&)
+{
+    if (m_capture_stop)
+    {
+        return;
+    }
+
+    if (m_engine && m_io_process->is_running() && !m_capture_channels.empty())
+    {
+        audio::engine::capture_window const window{
+            .start = m_capture_start,
+            .stop = m_engine->current_frame() +
+                    capture_arming_margin(mw_fs.get_state())};
+
+        for (auto id : m_capture_channels)
+        {
+            m_engine->arm_capture(id, window);
+        }
+
+        // The take is complete, when the engine passed the stop frame. Until
+        // then, the recording goes on.
+        m_capture_stop = window.stop;
+        m_capture_stop_deadline =
+            std::chrono::steady_clock::now() + capture_stop_timeout;
+        return;
+    }
+
+    finish_recording(mw_fs);
+}
+
+template <>
+void
+audio_engine_middleware::process_engine_action(
+    middleware_functors const& mw_fs,
+    actions::bounce_recording const& a)
+{
+    if (m_bounce_job && !m_bounce_job->get_progress().finished)
+    {
+        spdlog::warn("A take is already being bounced.");
+        return;
+    }
+
+    state const& st = mw_fs.get_state();
+
+    m_bounce_job.reset();
+
+    try
+    {
+        m_bounce_job = std::make_unique<bounce_job>(
+            st,
+            make_ladspa_fx_processor_factory(m_ladspa_processor_factory, st),
+            a.take_dir,
+            system::make_unique_filename(a.take_dir, "mix", "wav"),
+            bounce_threads(m_background_cpus));
+    }
+    catch (std::exception const& err)
+    {
+        spdlog::error("Could not bounce take: {}", err.what());
+    }
+
     mw_fs.next(a);
-    rebuild(mw_fs.get_state());
 }
 
 template <>
@@ -418,6 +627,12 @@ audio_engine_middleware::process_engine_action(
         mw_fs.next(next_action);
     }
 
+    // releases the threads and buffers of a finished bounce
+    if (m_bounce_job && m_bounce_job->get_progress().finished)
+    {
+        m_bounce_job.reset();
+    }
+
     if (m_engine)
     {
         if (auto learned_midi = m_engine->get_learned_midi())
@@ -490,7 +705,8 @@ audio_engine_middleware::start_engine(state const& st)
             m_workers,
             st.sample_rate,
             st.selected_sound_card.num_channels.in(),
-            st.selected_sound_card.num_channels.out());
+            st.selected_sound_card.num_channels.out(),
+            make_ladspa_pipeline_thread_config(m_audio_thread_config));
 
         m_io_process->start(
             m_audio_thread_config,
@@ -510,6 +726,27 @@ audio_engine_middleware::start_engine(state const& st)
     }
 }
 
+void
+audio_engine_middleware::finish_recording(middleware_functors const& mw_fs)
+{
+    if (m_engine)
+    {
+        actions::audio_engine_sync_update final_update;
+        collect_capture_updates(m_capture_channels, *m_engine, final_update);
+
+        if (!final_update.empty())
+        {
+            mw_fs.next(final_update);
+        }
+    }
+
+    m_capture_channels.clear();
+    m_capture_stop.reset();
+
+    mw_fs.next(actions::stop_recording{});
+    rebuild(mw_fs.get_state());
+}
+
 void
 audio_engine_middleware::rebuild(state const& st)
 {
@@ -520,9 +757,7 @@ audio_engine_middleware::rebuild(state const& st)
 
     if (!m_engine->rebuild(
             st,
-            [this, sr = st.sample_rate](ladspa::instance_id id) {
-                return m_ladspa_processor_factory.make_processor(id, sr);
-            },
+            make_ladspa_fx_processor_factory(m_ladspa_processor_factory, st),
             m_midi_controller->make_input_event_handler()))
     {
         spdlog::error("Rebuilding audio engine graph failed.");
@@ -538,9 +773,10 @@ audio_engine_middleware::operator()(
     {
         auto const& st = mw_fs.get_state();
 
+        // the captures up to now are taken, the engine is gone afterwards
         if (st.recording)
         {
-            process_engine_action(mw_fs, actions::stop_recording{});
+            finish_recording(mw_fs);
         }
 
         close_sound_card();
@@ -0,0 +1,465 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/bounce_job.h>
+
+#include <piejam/runtime/audio_engine.h>
+#include <piejam/runtime/external_audio.h>
+#include <piejam/runtime/mixer.h>
+#include <piejam/runtime/recorder/file_writer.h>
+#include <piejam/runtime/recorder/peak_file.h>
+#include <piejam/runtime/state.h>
+
+#include <piejam/audio/engine/rt_task_executor.h>
+#include <piejam/audio/pcm_buffer_converter.h>
+#include <piejam/audio/period_size.h>
+#include <piejam/midi/input_event_handler.h>
+#include <piejam/npos.h>
+#include <piejam/thread/priority.h>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/assert.hpp>
+
+#include <sndfile.hh>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace piejam::runtime
+{
+
+namespace
+{
+
+constexpr std::size_t block_frames{audio::max_period_size.value()};
+
+// Reverbs and delays ring out after the end of the tracks.
+constexpr std::chrono::seconds tail_duration{2};
+
+constexpr std::chrono::seconds log_interval{5};
+
+struct track
+{
+    SndfileHandle file;
+
+    // device input channel of each channel of the file
+    std::vector<std::size_t> device_channels;
+};
+
+auto
+find_track_file(
+    std::filesystem::path const& take_dir,
+    std::string const& name) -> std::optional<std::filesystem::path>
+{
+    for (auto const format : {recording_format::wav, recording_format::flac})
+    {
+        auto file = take_dir / std::format(
+                                   "{}.{}",
+                                   name,
+                                   recorder::file_extension(format));
+
+        if (std::filesystem::exists(file))
+        {
+            return file;
+        }
+    }
+
+    return std::nullopt;
+}
+
+auto
+device_channels(
+    external_audio::state const& external_audio_state,
+    external_audio::device_id const device_id) -> std::vector<std::size_t>
+{
+    auto channel = [&](audio::bus_channel const ch) {
+        return external_audio_state.device_channels.at({device_id, ch});
+    };
+
+    if (external_audio_state.devices.at(device_id).bus_type ==
+        audio::bus_type::mono)
+    {
+        return {channel(audio::bus_channel::mono)};
+    }
+
+    return {
+        channel(audio::bus_channel::left),
+        channel(audio::bus_channel::right)};
+}
+
+} // namespace
+
+struct bounce_job::impl
+{
+    impl(
+        state const& st,
+        fx::simple_ladspa_processor_factory const& ladspa_fx_proc_factory,
+        std::filesystem::path const& take_dir,
+        std::filesystem::path const& mix_file,
+        std::span<thread::configuration const> const threads)
+        : sample_rate{st.sample_rate}
+        , mix_file{mix_file}
+        , render_conf{
+              threads.empty() ? thread::configuration{} : threads.front()}
+        , workers(
+              threads.empty() ? threads.end() : std::next(threads.begin()),
+              threads.end())
+        , engine{
+              workers,
+              st.sample_rate,
+              st.selected_sound_card.num_channels.in(),
+              st.selected_sound_card.num_channels.out(),
+              // offline, the fx are better processed inline
+              std::nullopt}
+        , inputs(
+              st.selected_sound_card.num_channels.in(),
+              std::vector<float>(block_frames))
+    {
+        state bounce_state = st;
+        std::size_t num_track_frames{};
+
+        for (auto const& [mixer_channel_id, mixer_channel] :
+             st.mixer_state.channels)
+        {
+            auto const* const device_id =
+                std::get_if<external_audio::device_id>(
+                    &st.mixer_state.io_map.at(mixer_channel_id).in());
+            if (!device_id)
+            {
+                continue;
+            }
+
+            auto const file =
+                find_track_file(take_dir, *st.strings.at(mixer_channel.name));
+            if (!file)
+            {
+                continue;
+            }
+
+            track t{
+                .file = SndfileHandle{file->c_str()},
+                .device_channels =
+                    device_channels(st.external_audio_state, *device_id),
+            };
+
+            if (t.file.rawHandle() == nullptr ||
+                static_cast<unsigned>(t.file.samplerate()) !=
+                    st.sample_rate.value())
+            {
+                spdlog::warn(
+                    "Bounce: skipping unreadable or resampled track {}",
+                    file->string());
+                continue;
+            }
+
+            t.device_channels.resize(
+                static_cast<std::size_t>(t.file.channels()),
+                npos);
+
+            num_track_frames = std::max(
+                num_track_frames,
+                static_cast<std::size_t>(t.file.frames()));
+
+            tracks.push_back(std::move(t));
+
+            // the track already went through the fx chain
+            bounce_state.mixer_state.fx_chains.assign(
+                mixer_channel_id,
+                fx::chain_t{});
+        }
+
+        if (tracks.empty())
+        {
+            throw std::runtime_error("no recorded tracks in take");
+        }
+
+        num_frames = num_track_frames +
+                     st.sample_rate.samples_for_duration(tail_duration);
+
+        auto const* const main_device = std::get_if<external_audio::device_id>(
+            &st.mixer_state.io_map.at(st.mixer_state.main).out());
+        if (!main_device)
+        {
+            throw std::runtime_error("main channel isn't routed to a device");
+        }
+
+        auto const main_channels =
+            device_channels(st.external_audio_state, *main_device);
+
+        mix_file_writer = recorder::with_peak_file(
+            recorder::make_file_writer(
+                recording_format::wav,
+                mix_file,
+                st.sample_rate,
+                2),
+            mix_file,
+            st.sample_rate);
+
+        init_process(
+            main_channels,
+            st.selected_sound_card.num_channels.out());
+
+        for (auto& worker : workers)
+        {
+            worker.wakeup(&this_thread::set_background_priority);
+        }
+
+        // the engine swaps in the new graph only while processing
+        thread = std::jthread{[this](std::stop_token stoken) {
+            run(stoken);
+        }};
+
+        if (!engine.rebuild(bounce_state, ladspa_fx_proc_factory, nullptr))
+        {
+            throw std::runtime_error("could not build audio engine graph");
+        }
+
+        built.store(true, std::memory_order_release);
+    }
+
+    void init_process(
+        std::span<std::size_t const> const main_channels,
+        std::size_t const num_outputs)
+    {
+        std::vector<audio::pcm_input_buffer_converter> in_conv;
+        for (std::vector<float> const& input : inputs)
+        {
+            in_conv.emplace_back([&input](std::span<float> const buffer) {
+                std::copy_n(
+                    input.begin(),
+                    std::min(buffer.size(), input.size()),
+                    buffer.begin());
+            });
+        }
+
+        std::vector<audio::pcm_output_buffer_converter> out_conv(num_outputs);
+        for (std::size_t i = 0; i < mix.size() && i < main_channels.size();
+             ++i)
+        {
+            if (main_channels[i] >= num_outputs)
+            {
+                continue;
+            }
+
+            std::vector<float>& out = mix[i];
+            out_conv[main_channels[i]] = audio::pcm_output_buffer_converter{
+                [&out](float const constant, std::size_t const size) {
+                    std::fill_n(out.begin(), size, constant);
+                },
+                [&out](std::span<float const> const buffer) {
+                    std::ranges::copy(buffer, out.begin());
+                }};
+        }
+
+        engine.init_process(in_conv, out_conv);
+    }
+
+    void run(std::stop_token const& stoken)
+    {
+        render_conf.apply();
+        this_thread::set_background_priority();
+
+        while (!built.load(std::memory_order_acquire))
+        {
+            if (stoken.stop_requested())
+            {
+                return;
+            }
+
+            engine.process(block_frames);
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+
+        render(stoken);
+    }
+
+    void render(std::stop_token const& stoken)
+    {
+        std::vector<float> interleaved(block_frames * 2);
+
+        auto const start = std::chrono::steady_clock::now();
+        auto next_log = start + log_interval;
+
+        std::size_t frame{};
+        while (frame < num_frames && !stoken.stop_requested())
+        {
+            std::size_t const frames =
+                std::min(block_frames, num_frames - frame);
+
+            read_tracks(frames);
+            engine.process(frames);
+
+            for (std::size_t f = 0; f < frames; ++f)
+            {
+                interleaved[2 * f] = mix[0][f];
+                interleaved[2 * f + 1] = mix[1][f];
+            }
+
+            if (auto const ec = mix_file_writer->write(
+                    std::span{interleaved}.first(frames * 2)))
+            {
+                spdlog::error("Bounce: could not write mix: {}", ec.message());
+                break;
+            }
+
+            frame += frames;
+
+            auto const now = std::chrono::steady_clock::now();
+            rendered_frames.store(frame, std::memory_order_relaxed);
+            elapsed.store(now - start, std::memory_order_relaxed);
+
+            if (now >= next_log)
+            {
+                next_log = now + log_interval;
+                log_progress("rendering");
+            }
+        }
+
+        if (auto const ec = mix_file_writer->close())
+        {
+            spdlog::error("Bounce: could not close mix: {}", ec.message());
+        }
+
+        if (frame < num_frames)
+        {
+            std::error_code ec;
+            std::filesystem::remove(mix_file, ec);
+            std::filesystem::remove(recorder::peak_file_path(mix_file), ec);
+            spdlog::info("Bounce: cancelled {}", mix_file.string());
+        }
+        else
+        {
+            log_progress("finished");
+        }
+
+        finished.store(true, std::memory_order_release);
+    }
+
+    // Unfed inputs are silent, the tracks are silent after their end.
+    void read_tracks(std::size_t const frames)
+    {
+        for (std::vector<float>& input : inputs)
+        {
+            std::fill_n(input.begin(), frames, 0.f);
+        }
+
+        for (track& t : tracks)
+        {
+            std::size_t const num_channels = t.device_channels.size();
+
+            track_buffer.resize(frames * num_channels);
+            auto const read = static_cast<std::size_t>(std::max<sf_count_t>(
+                t.file.readf(
+                    track_buffer.data(),
+                    static_cast<sf_count_t>(frames)),
+                0));
+
+            for (std::size_t ch = 0; ch < num_channels; ++ch)
+            {
+                std::size_t const device_channel = t.device_channels[ch];
+                if (device_channel >= inputs.size())
+                {
+                    continue;
+                }
+
+                for (std::size_t f = 0; f < read; ++f)
+                {
+                    inputs[device_channel][f] =
+                        track_buffer[f * num_channels + ch];
+                }
+            }
+        }
+    }
+
+    [[nodiscard]]
+    auto get_progress() const noexcept -> progress
+    {
+        std::size_t const rendered =
+            rendered_frames.load(std::memory_order_relaxed);
+        double const rendered_seconds =
+            static_cast<double>(rendered) /
+            static_cast<double>(sample_rate.value());
+        double const elapsed_seconds =
+            std::chrono::duration<double>(
+                elapsed.load(std::memory_order_relaxed))
+                .count();
+
+        return {
+            .rendered_frames = rendered,
+            .num_frames = num_frames,
+            .realtime_factor = elapsed_seconds > 0
+                                       ? rendered_seconds / elapsed_seconds
+                                       : 0.,
+            .finished = finished.load(std::memory_order_acquire),
+        };
+    }
+
+    void log_progress(std::string_view const what) const
+    {
+        auto const p = get_progress();
+        spdlog::info(
+            "Bounce: {} {}, {:.0f}%, {:.1f}x realtime",
+            what,
+            mix_file.string(),
+            100. * static_cast<double>(p.rendered_frames) /
+                static_cast<double>(p.num_frames),
+            p.realtime_factor);
+    }
+
+    audio::sample_rate sample_rate;
+    std::filesystem::path mix_file;
+    thread::configuration render_conf;
+    std::vector<audio::engine::rt_task_executor> workers;
+    audio_engine engine;
+
+    std::vector<track> tracks;
+    std::vector<float> track_buffer;
+    std::vector<std::vector<float>> inputs;
+    std::array<std::vector<float>, 2> mix{
+        std::vector<float>(block_frames),
+        std::vector<float>(block_frames)};
+    std::unique_ptr<recorder::file_writer> mix_file_writer;
+    std::size_t num_frames{};
+
+    std::atomic_bool built{};
+    std::atomic_bool finished{};
+    std::atomic_size_t rendered_frames{};
+    std::atomic<std::chrono::steady_clock::duration> elapsed{};
+
+    // last, so it is stopped first
+    std::jthread thread;
+};
+
+bounce_job::bounce_job(
+    state const& st,
+    fx::simple_ladspa_processor_factory const& ladspa_fx_proc_factory,
+    std::filesystem::path const& take_dir,
+    std::filesystem::path const& mix_file,
+    std::span<thread::configuration const> const threads)
+    : m_impl{make_pimpl<impl>(
+          st,
+          ladspa_fx_proc_factory,
+          take_dir,
+          mix_file,
+          threads)}
+{
+}
+
+bounce_job::~bounce_job() = default;
+
+auto
+bounce_job::get_progress() const noexcept -> progress
+{
+    return m_impl->get_progress();
+}
+
+} // namespace piejam::runtime
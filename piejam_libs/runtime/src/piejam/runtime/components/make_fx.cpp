@@ -27,6 +27,7 @@ namespace
 auto
 make_internal_fx(
     fx::internal_id id,
+    fx::module_id const fx_mod_id,
     fx::module const& fx_mod,
     audio::sample_rate const sample_rate,
     parameter_processor_factory& param_procs,
@@ -34,6 +35,7 @@ make_internal_fx(
     std::string_view const name) -> std::unique_ptr<audio::engine::component>
 {
     return internal_fx_component_factories::lookup(id)({
+        .fx_mod_id = fx_mod_id,
         .fx_mod = fx_mod,
         .sample_rate = sample_rate,
         .param_procs = param_procs,
@@ -46,12 +48,14 @@ make_internal_fx(
 
 auto
 make_fx(
+    fx::module_id const fx_mod_id,
     fx::module const& fx_mod,
     fx::get_parameter_name const& get_fx_param_name,
     fx::simple_ladspa_processor_factory const& ladspa_fx_proc_factory,
     parameter_processor_factory& param_procs,
     processors::stream_processor_factory& stream_procs,
     audio::sample_rate const sample_rate,
+    std::optional<thread::configuration> const& ladspa_pipeline_thread,
     std::string_view const name) -> std::unique_ptr<audio::engine::component>
 {
     return std::visit(
@@ -60,6 +64,7 @@ make_fx(
                 -> std::unique_ptr<audio::engine::component> {
                 return make_internal_fx(
                     id,
+                    fx_mod_id,
                     fx_mod,
                     sample_rate,
                     param_procs,
@@ -72,7 +77,8 @@ make_fx(
                     fx_mod,
                     get_fx_param_name,
                     [&, id]() { return ladspa_fx_proc_factory(id); },
-                    param_procs);
+                    param_procs,
+                    ladspa_pipeline_thread);
             },
             [](fx::unavailable_ladspa_id const&)
                 -> std::unique_ptr<audio::engine::component> {
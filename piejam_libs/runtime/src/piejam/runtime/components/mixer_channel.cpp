@@ -9,16 +9,17 @@
 #include <piejam/runtime/float_parameter.h>
 #include <piejam/runtime/mixer.h>
 #include <piejam/runtime/parameter_processor_factory.h>
+#include <piejam/runtime/processors/capture_tap_factory.h>
 #include <piejam/runtime/processors/stream_processor_factory.h>
 
 #include <piejam/audio/components/amplifier.h>
 #include <piejam/audio/components/identity.h>
 #include <piejam/audio/components/pan_balance.h>
+#include <piejam/audio/engine/capture_tap_processor.h>
 #include <piejam/audio/engine/component.h>
 #include <piejam/audio/engine/graph.h>
 #include <piejam/audio/engine/graph_algorithms.h>
 #include <piejam/audio/engine/graph_generic_algorithms.h>
-#include <piejam/audio/engine/pan_balance_processor.h>
 #include <piejam/audio/engine/stream_processor.h>
 #include <piejam/audio/sample_rate.h>
 #include <piejam/entity_id.h>
@@ -44,20 +45,18 @@ class mixer_channel_output final : public audio::engine::component
         -> std::unique_ptr<audio::engine::component>
     {
         return bus_type == audio::bus_type::mono
-                   ? audio::components::make_pan(
-                         audio::engine::make_pan_processor(name),
-                         name)
-                   : audio::components::make_balance(
-                         audio::engine::make_balance_processor(name),
-                         name);
+                   ? audio::components::make_pan(name)
+                   : audio::components::make_balance(name);
     }
 
 public:
     mixer_channel_output(
+        mixer::channel_id const mixer_channel_id,
         mixer::channel const& mixer_channel,
         std::string_view channel_name,
         parameter_processor_factory& param_procs,
         processors::stream_processor_factory& stream_procs,
+        processors::capture_tap_factory& capture_taps,
         audio::sample_rate const sample_rate)
         : m_volume_input_proc(param_procs.find_or_make_processor(
               mixer_channel.volume(),
@@ -87,6 +86,11 @@ public:
               2,
               sample_rate.samples_for_duration(std::chrono::milliseconds{120}),
               format_name(channel_name, "level_meter"))}
+        , m_capture_tap{capture_taps.make_processor(
+              mixer_channel_id,
+              num_channels(to_bus_type(mixer_channel.type)),
+              sample_rate.samples_for_duration(std::chrono::milliseconds{500}),
+              format_name(channel_name, "capture"))}
     {
         m_outputs.push_back(m_mute_solo->outputs()[0]);   // post L
         m_outputs.push_back(m_mute_solo->outputs()[1]);   // post R
@@ -155,6 +159,11 @@ public:
         audio::engine::connect(g, *m_pan_balance, *m_volume_amp);
         audio::engine::connect(g, *m_volume_amp, *m_mute_solo);
         audio::engine::connect(g, *m_volume_amp, *m_out_stream);
+
+        // Every channel is recorded behind its fx chain, but before
+        // pan/balance and fader. So the recording has the channels of the
+        // bus, a mono channel has no mono signal behind panning.
+        audio::engine::connect(g, *m_input, *m_capture_tap);
     }
 
 private:
@@ -169,6 +178,7 @@ private:
     std::unique_ptr<audio::engine::component> m_volume_amp;
     std::unique_ptr<audio::engine::component> m_mute_solo;
     std::shared_ptr<audio::engine::processor> m_out_stream;
+    std::shared_ptr<audio::engine::processor> m_capture_tap;
 
     boost::container::static_vector<audio::engine::graph_endpoint, 4> m_outputs;
 
@@ -187,7 +197,8 @@ public:
               aux_volume,
               format_name(channel_name, "aux_volume")))
         , m_volume_amp{audio::components::make_stereo_amplifier(
-              format_name(channel_name, "aux_amp"))}
+              format_name(channel_name, "aux_amp"),
+              audio::components::gain_stage::mixable)}
     {
     }
     auto inputs() const -> endpoints override
@@ -241,18 +252,22 @@ make_mixer_channel_input(mixer::channel const& mixer_channel)
 
 auto
 make_mixer_channel_output(
+    mixer::channel_id const mixer_channel_id,
     mixer::channel const& mixer_channel,
     std::string_view channel_name,
     parameter_processor_factory& param_procs,
     processors::stream_processor_factory& stream_procs,
+    processors::capture_tap_factory& capture_taps,
     audio::sample_rate const sample_rate)
     -> std::unique_ptr<audio::engine::component>
 {
     return std::make_unique<mixer_channel_output>(
+        mixer_channel_id,
         mixer_channel,
         channel_name,
         param_procs,
         stream_procs,
+        capture_taps,
         sample_rate);
 }
 
@@ -11,6 +11,7 @@
 #include <piejam/audio/engine/component.h>
 #include <piejam/audio/engine/event_identity_processor.h>
 #include <piejam/audio/engine/graph.h>
+#include <piejam/audio/engine/pipelined_processor.h>
 #include <piejam/audio/engine/processor_util.h>
 #include <piejam/range/indices.h>
 #include <piejam/range/iota.h>
@@ -35,8 +36,10 @@ public:
         fx::module const& fx_mod,
         fx::get_parameter_name const& get_fx_param_name,
         std::unique_ptr<audio::engine::processor> fx_proc,
-        parameter_processor_factory& param_proc_factory)
+        parameter_processor_factory& param_proc_factory,
+        std::size_t const period_latency)
         : m_fx_proc(std::move(fx_proc))
+        , m_period_latency(period_latency)
     {
         auto make_graph_endpoint = [this](std::size_t n) {
             return audio::engine::graph_endpoint{*m_fx_proc, n};
@@ -94,6 +97,11 @@ public:
         return m_event_outputs;
     }
 
+    auto period_latency() const noexcept -> std::size_t override
+    {
+        return m_period_latency;
+    }
+
     void connect(audio::engine::graph& g) const override
     {
         for (std::size_t i : range::indices(m_param_input_procs))
@@ -104,6 +112,7 @@ public:
 
 private:
     std::unique_ptr<audio::engine::processor> m_fx_proc;
+    std::size_t m_period_latency;
     boost::container::static_vector<audio::engine::graph_endpoint, 2> m_inputs;
     boost::container::static_vector<audio::engine::graph_endpoint, 2> m_outputs;
     std::vector<std::shared_ptr<audio::engine::processor>> m_param_input_procs;
@@ -119,9 +128,11 @@ public:
         fx::get_parameter_name const& get_fx_param_name,
         std::unique_ptr<audio::engine::processor> fx_left_proc,
         std::unique_ptr<audio::engine::processor> fx_right_proc,
-        parameter_processor_factory& param_proc_factory)
+        parameter_processor_factory& param_proc_factory,
+        std::size_t const period_latency)
         : m_fx_left_proc(std::move(fx_left_proc))
         , m_fx_right_proc(std::move(fx_right_proc))
+        , m_period_latency(period_latency)
     {
         BOOST_ASSERT(
             fx_mod.parameters->size() == m_fx_left_proc->event_inputs().size());
@@ -167,6 +178,11 @@ public:
         return m_event_outputs;
     }
 
+    auto period_latency() const noexcept -> std::size_t override
+    {
+        return m_period_latency;
+    }
+
     void connect(audio::engine::graph& g) const override
     {
         for (std::size_t i : range::indices(m_param_input_procs))
@@ -179,6 +195,7 @@ public:
 private:
     std::unique_ptr<audio::engine::processor> m_fx_left_proc;
     std::unique_ptr<audio::engine::processor> m_fx_right_proc;
+    std::size_t m_period_latency;
     std::array<audio::engine::graph_endpoint, 2> m_inputs{
         {{*m_fx_left_proc, 0}, {*m_fx_right_proc, 0}}};
     std::array<audio::engine::graph_endpoint, 2> m_outputs{
@@ -195,10 +212,22 @@ make_component(
     fx::module const& fx_mod,
     fx::get_parameter_name const& get_fx_param_name,
     processor_factory const& fx_ladspa_proc_factory,
-    parameter_processor_factory& param_proc_factory)
+    parameter_processor_factory& param_proc_factory,
+    std::optional<thread::configuration> const& pipeline_thread)
     -> std::unique_ptr<audio::engine::component>
 {
-    if (auto fx_proc = fx_ladspa_proc_factory(); fx_proc)
+    auto make_fx_proc = [&]() -> std::unique_ptr<audio::engine::processor> {
+        auto fx_proc = fx_ladspa_proc_factory();
+        return fx_proc && pipeline_thread
+                   ? audio::engine::make_pipelined_processor(
+                         std::move(fx_proc),
+                         *pipeline_thread)
+                   : std::move(fx_proc);
+    };
+
+    std::size_t const period_latency = pipeline_thread ? 1 : 0;
+
+    if (auto fx_proc = make_fx_proc(); fx_proc)
     {
         switch (fx_mod.bus_type)
         {
@@ -209,11 +238,12 @@ make_component(
                         fx_mod,
                         get_fx_param_name,
                         std::move(fx_proc),
-                        param_proc_factory);
+                        param_proc_factory,
+                        period_latency);
                 }
                 else if (audio::engine::is_mono_in_out_processor(*fx_proc))
                 {
-                    if (auto fx_second_proc = fx_ladspa_proc_factory();
+                    if (auto fx_second_proc = make_fx_proc();
                         fx_second_proc &&
                         audio::engine::is_mono_in_out_processor(
                             *fx_second_proc))
@@ -223,7 +253,8 @@ make_component(
                             get_fx_param_name,
                             std::move(fx_proc),
                             std::move(fx_second_proc),
-                            param_proc_factory);
+                            param_proc_factory,
+                            period_latency);
                     }
                 }
                 break;
@@ -235,7 +266,8 @@ make_component(
                         fx_mod,
                         get_fx_param_name,
                         std::move(fx_proc),
-                        param_proc_factory);
+                        param_proc_factory,
+                        period_latency);
                 }
                 break;
         }
@@ -4,6 +4,7 @@
 
 #include <piejam/runtime/ladspa_fx_middleware.h>
 
+#include <piejam/audio/engine/event_quantization.h>
 #include <piejam/ladspa/instance_manager.h>
 #include <piejam/range/indices.h>
 #include <piejam/redux/middleware_functors.h>
@@ -88,6 +89,8 @@ ladspa_fx_middleware::process_ladspa_fx_action(
             next_action.instance_id = id;
             next_action.plugin_desc = *plugin_desc;
             next_action.control_inputs = m_ladspa_control.control_inputs(id);
+            next_action.event_quantization =
+                m_ladspa_control.measure_event_quantization(id);
             next_action.initial_values = a.initial_values;
             next_action.midi_assignments = a.midi_assignments;
             next_action.show_fx_module = a.show_fx_module;
@@ -165,6 +168,17 @@ ladspa_fx_middleware::process_ladspa_fx_action(
                         ladspa_instance.plugin_desc = *plugin_desc;
                         ladspa_instance.control_inputs =
                             m_ladspa_control.control_inputs(instance_id);
+                        if (unavail.event_quantization)
+                        {
+                            ladspa_instance.event_quantization =
+                                *unavail.event_quantization;
+                        }
+                        else
+                        {
+                            ladspa_instance.event_quantization =
+                                m_ladspa_control.measure_event_quantization(
+                                    instance_id);
+                        }
 
                         send_action = true;
                     }
@@ -50,6 +50,8 @@ save_app_config(
         conf.enabled_midi_input_devices = enabled_midi_input_devices;
 
         conf.rec_session = state.rec_session + 1;
+        conf.rec_format = state.rec_format;
+        conf.rec_layout = state.rec_layout;
 
         conf.display_rotation = state.display_rotation;
         conf.startup_session = state.startup_session;
@@ -169,6 +171,9 @@ export_fx_plugin(
     plug.name = pd.name;
     plug.preset = export_parameter_values(fx_mod.parameters, st.params);
     plug.midi = export_midi_assignments(fx_mod.parameters, st.midi_assignments);
+    plug.event_granularity =
+        st.fx_state.ladspa_event_quantizations.at(id).granularity;
+    plug.pipelined = st.fx_state.pipelined_ladspa_instances->contains(id);
     return plug;
 }
 
@@ -187,6 +192,11 @@ export_fx_plugin(
     plug.name = fx_mod.name;
     plug.preset = unavail.parameter_values;
     plug.midi = unavail.midi_assignments;
+    if (unavail.event_quantization)
+    {
+        plug.event_granularity = unavail.event_quantization->granularity;
+    }
+    plug.pipelined = unavail.pipelined;
     return plug;
 }
 
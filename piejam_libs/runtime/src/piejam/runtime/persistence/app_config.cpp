@@ -33,6 +33,15 @@ NLOHMANN_JSON_SERIALIZE_ENUM(
     startup_session,
     {{startup_session::new_, "new"}, {startup_session::last, "last"}})
 
+NLOHMANN_JSON_SERIALIZE_ENUM(
+    recording_format,
+    {{recording_format::wav, "wav"}, {recording_format::flac, "flac"}})
+
+NLOHMANN_JSON_SERIALIZE_ENUM(
+    recording_layout,
+    {{recording_layout::file_per_track, "file_per_track"},
+     {recording_layout::single_file, "single_file"}})
+
 namespace persistence
 {
 
@@ -52,6 +61,8 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
     period_size,
     enabled_midi_input_devices,
     rec_session,
+    rec_format,
+    rec_layout,
     display_rotation,
     startup_session,
     last_session_file);
@@ -63,6 +74,22 @@ using upgrade_functions_array =
 template <size_t Version>
 static void upgrade(nlohmann::json&);
 
+template <>
+void
+upgrade<0>(nlohmann::json& conf)
+{
+    conf[s_key_app_config]["rec_format"] = recording_format::wav;
+    conf[s_key_version] = 1;
+}
+
+template <>
+void
+upgrade<1>(nlohmann::json& conf)
+{
+    conf[s_key_app_config]["rec_layout"] = recording_layout::file_per_track;
+    conf[s_key_version] = 2;
+}
+
 template <size_t... I>
 static auto
 make_upgrade_functions_array(std::index_sequence<I...>)
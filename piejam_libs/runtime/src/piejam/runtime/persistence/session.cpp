@@ -187,12 +187,32 @@ static auto const s_key_ladspa = "ladspa";
 
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(session::internal_fx, type, preset, midi);
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
-    session::ladspa_plugin,
-    id,
-    name,
-    preset,
-    midi);
+static auto const event_granularity_serializer =
+    optional_serializer<std::size_t>{"event_granularity"};
+
+void
+to_json(nlohmann::json& j, session::ladspa_plugin const& ladspa_plug)
+{
+    j = {
+        {"id", ladspa_plug.id},
+        {"name", ladspa_plug.name},
+        {"preset", ladspa_plug.preset},
+        {"midi", ladspa_plug.midi},
+        {"pipelined", ladspa_plug.pipelined},
+    };
+    event_granularity_serializer.to_json(j, ladspa_plug.event_granularity);
+}
+
+void
+from_json(nlohmann::json const& j, session::ladspa_plugin& ladspa_plug)
+{
+    j.at("id").get_to(ladspa_plug.id);
+    j.at("name").get_to(ladspa_plug.name);
+    j.at("preset").get_to(ladspa_plug.preset);
+    j.at("midi").get_to(ladspa_plug.midi);
+    event_granularity_serializer.from_json(j, ladspa_plug.event_granularity);
+    ladspa_plug.pipelined = j.value("pipelined", false);
+}
 
 void
 to_json(nlohmann::json& j, session::fx_plugin const& fx_plug)
@@ -0,0 +1,55 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/processors/capture_tap_factory.h>
+
+#include <piejam/audio/engine/capture_tap_processor.h>
+
+#include <boost/assert.hpp>
+#include <boost/hof/unpack.hpp>
+
+namespace piejam::runtime::processors
+{
+
+capture_tap_factory::capture_tap_factory(
+    audio::engine::frame_clock const& clock)
+    : m_clock{clock}
+{
+}
+
+capture_tap_factory::~capture_tap_factory() = default;
+
+auto
+capture_tap_factory::make_processor(
+    mixer::channel_id const id,
+    std::size_t const num_channels,
+    std::size_t const capacity_per_channel,
+    std::string_view const name) -> std::shared_ptr<processor_t>
+{
+    auto proc = std::make_shared<audio::engine::capture_tap_processor>(
+        m_clock,
+        num_channels,
+        capacity_per_channel,
+        name);
+    BOOST_VERIFY(m_procs.emplace(id, proc).second);
+    return proc;
+}
+
+auto
+capture_tap_factory::find_processor(mixer::channel_id const id) const
+    -> std::shared_ptr<processor_t>
+{
+    auto it = m_procs.find(id);
+    return it != m_procs.end() ? it->second.lock() : nullptr;
+}
+
+void
+capture_tap_factory::clear_expired()
+{
+    std::erase_if(m_procs, boost::hof::unpack([](auto, auto const proc) {
+                      return proc.expired();
+                  }));
+}
+
+} // namespace piejam::runtime::processors
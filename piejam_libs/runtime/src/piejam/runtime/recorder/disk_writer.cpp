@@ -0,0 +1,366 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/disk_writer.h>
+
+#include <piejam/algorithm/transform_to_vector.h>
+#include <piejam/thread/sleep_for.h>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/assert.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace piejam::runtime::recorder
+{
+
+namespace
+{
+
+// 4096 frames of 24 bit samples are a multiple of the page size for any
+// number of channels.
+constexpr std::size_t chunk_frames{4096};
+
+constexpr std::chrono::milliseconds poll_interval{50};
+
+struct track
+{
+    track(
+        std::unique_ptr<file_writer> file,
+        std::uint64_t const start_frame,
+        std::size_t const ring_buffer_frames)
+        : file{std::move(file)}
+        , ring{ring_buffer_frames * this->file->num_channels()}
+        , chunk(chunk_frames * this->file->num_channels())
+        , next_frame{start_frame}
+    {
+    }
+
+    // disk thread
+    std::unique_ptr<file_writer> file;
+    boost::lockfree::spsc_queue<float> ring;
+    std::vector<float> chunk;
+    bool failed{};
+    bool uncommitted{};
+    bool commit_failed{};
+
+    // producer thread
+    std::uint64_t next_frame{};
+    // dropped frames, which are still to be replaced by silence
+    std::size_t unpadded_frames{};
+
+    std::atomic_size_t dropped_frames{};
+    std::atomic_size_t gap_frames{};
+};
+
+// interleaves through a small buffer on the stack
+void
+push_interleaved(
+    boost::lockfree::spsc_queue<float>& ring,
+    disk_writer::channels_view const data) noexcept
+{
+    std::array<float, 1024> interleaved;
+    std::size_t const num_channels = data.num_channels();
+    std::size_t const num_frames = data.num_frames();
+    std::size_t const block_frames = interleaved.size() / num_channels;
+    auto const samples = data.samples();
+
+    for (std::size_t offset = 0; offset < num_frames; offset += block_frames)
+    {
+        std::size_t const frames = std::min(block_frames, num_frames - offset);
+
+        for (std::size_t frame = 0; frame < frames; ++frame)
+        {
+            for (std::size_t ch = 0; ch < num_channels; ++ch)
+            {
+                interleaved[frame * num_channels + ch] =
+                    samples[ch * num_frames + offset + frame];
+            }
+        }
+
+        BOOST_VERIFY(
+            ring.push(interleaved.data(), frames * num_channels) ==
+            frames * num_channels);
+    }
+}
+
+void
+push_silence(
+    boost::lockfree::spsc_queue<float>& ring,
+    std::size_t num_samples) noexcept
+{
+    static constexpr std::array<float, 1024> silence{};
+
+    while (num_samples > 0)
+    {
+        std::size_t const pushed =
+            ring.push(silence.data(), std::min(silence.size(), num_samples));
+        BOOST_ASSERT(pushed > 0);
+        num_samples -= pushed;
+    }
+}
+
+} // namespace
+
+struct disk_writer::impl
+{
+    impl(
+        files_t files,
+        std::uint64_t const start_frame,
+        std::size_t const ring_buffer_frames,
+        std::span<thread::configuration const> confs,
+        std::chrono::milliseconds const commit_interval)
+        : commit_interval{commit_interval}
+        , tracks{algorithm::transform_to_vector(
+              files,
+              [=](std::unique_ptr<file_writer>& file) {
+                  return std::make_unique<track>(
+                      std::move(file),
+                      start_frame,
+                      ring_buffer_frames);
+              })}
+    {
+        thread::configuration const default_conf{};
+        if (confs.empty())
+        {
+            confs = std::span{&default_conf, 1};
+        }
+
+        std::size_t const num_threads =
+            std::max<std::size_t>(std::min(confs.size(), tracks.size()), 1);
+
+        threads.reserve(num_threads);
+        for (std::size_t worker = 0; worker < num_threads; ++worker)
+        {
+            threads.emplace_back([this,
+                                  conf = confs[worker],
+                                  worker,
+                                  num_threads](std::stop_token stoken) {
+                conf.apply();
+                run(stoken, worker, num_threads);
+            });
+        }
+    }
+
+    void run(
+        std::stop_token const& stoken,
+        std::size_t const worker,
+        std::size_t const num_threads)
+    {
+        auto next_commit = std::chrono::steady_clock::now() + commit_interval;
+
+        while (!stoken.stop_requested())
+        {
+            write(false, worker, num_threads);
+
+            if (auto const now = std::chrono::steady_clock::now();
+                now >= next_commit)
+            {
+                commit(worker, num_threads);
+                next_commit = now + commit_interval;
+            }
+
+            thread::sleep_for(stoken, poll_interval);
+        }
+
+        write(true, worker, num_threads);
+
+        for_each_track(worker, num_threads, [](track& t) {
+            if (auto const ec = t.file->close())
+            {
+                spdlog::error("Could not close recording: {}", ec.message());
+            }
+        });
+    }
+
+    // Visits the tracks, which are assigned to the worker.
+    template <class F>
+    void for_each_track(
+        std::size_t const worker,
+        std::size_t const num_threads,
+        F&& f)
+    {
+        for (std::size_t i = worker; i < tracks.size(); i += num_threads)
+        {
+            f(*tracks[i]);
+        }
+    }
+
+    // One sync per file and interval keeps the cost of durability low.
+    void commit(std::size_t const worker, std::size_t const num_threads)
+    {
+        for_each_track(worker, num_threads, [](track& t) {
+            if (!t.uncommitted || t.failed)
+            {
+                return;
+            }
+
+            t.uncommitted = false;
+
+            if (auto const ec = t.file->commit();
+                ec && !std::exchange(t.commit_failed, true))
+            {
+                spdlog::error("Could not commit recording: {}", ec.message());
+            }
+        });
+    }
+
+    // Writes whole chunks, or everything if flushing.
+    void write(
+        bool const flush,
+        std::size_t const worker,
+        std::size_t const num_threads)
+    {
+        for_each_track(worker, num_threads, [flush](track& t) {
+            std::size_t const num_channels = t.file->num_channels();
+
+            while (t.ring.read_available() >= t.chunk.size() ||
+                   (flush && t.ring.read_available() > 0))
+            {
+                std::size_t const num_samples =
+                    t.ring.pop(t.chunk.data(), t.chunk.size());
+
+                if (t.failed)
+                {
+                    t.dropped_frames.fetch_add(
+                        num_samples / num_channels,
+                        std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (auto const ec = t.file->write(
+                        std::span{t.chunk}.first(num_samples)))
+                {
+                    spdlog::error(
+                        "Could not write recording: {}",
+                        ec.message());
+                    t.failed = true;
+                    t.dropped_frames.fetch_add(
+                        num_samples / num_channels,
+                        std::memory_order_relaxed);
+                }
+                else
+                {
+                    t.uncommitted = true;
+                }
+            }
+        });
+    }
+
+    std::chrono::milliseconds commit_interval;
+    std::vector<std::unique_ptr<track>> tracks;
+    std::vector<std::jthread> threads;
+};
+
+disk_writer::disk_writer(
+    files_t files,
+    std::uint64_t const start_frame,
+    std::size_t const ring_buffer_frames,
+    std::span<thread::configuration const> threads,
+    std::chrono::milliseconds const commit_interval)
+    : m_impl{make_pimpl<impl>(
+          std::move(files),
+          start_frame,
+          ring_buffer_frames,
+          threads,
+          commit_interval)}
+{
+}
+
+auto
+disk_writer::num_tracks() const noexcept -> std::size_t
+{
+    return m_impl->tracks.size();
+}
+
+auto
+disk_writer::push(
+    std::size_t const track_index,
+    std::uint64_t const frame,
+    channels_view const data) noexcept -> bool
+{
+    BOOST_ASSERT(track_index < m_impl->tracks.size());
+    track& t = *m_impl->tracks[track_index];
+
+    std::size_t const num_channels = t.file->num_channels();
+    std::size_t const num_frames = data.num_frames();
+    BOOST_ASSERT(data.num_channels() == num_channels);
+    BOOST_ASSERT(frame >= t.next_frame);
+
+    // The silence for a gap is pushed first, even if the frames after it
+    // are dropped. A gap, which doesn't fit, is continued on the next push.
+    // Previously dropped frames are part of the gap, but are counted as
+    // dropped already.
+    auto const gap = static_cast<std::size_t>(frame - t.next_frame);
+    std::size_t const space = t.ring.write_available() / num_channels;
+    std::size_t const padded = std::min(gap, space);
+
+    if (padded > 0)
+    {
+        push_silence(t.ring, padded * num_channels);
+        t.next_frame += padded;
+
+        std::size_t const padded_dropped =
+            std::min(padded, t.unpadded_frames);
+        t.unpadded_frames -= padded_dropped;
+        t.gap_frames.fetch_add(
+            padded - padded_dropped,
+            std::memory_order_relaxed);
+    }
+
+    if (padded < gap || space - padded < num_frames)
+    {
+        t.unpadded_frames += num_frames;
+        t.dropped_frames.fetch_add(num_frames, std::memory_order_relaxed);
+        return false;
+    }
+
+    push_interleaved(t.ring, data);
+    t.next_frame = frame + num_frames;
+
+    return true;
+}
+
+void
+disk_writer::close()
+{
+    // the threads drain their tracks, when they are stopped
+    m_impl->threads.clear();
+}
+
+auto
+disk_writer::dropped_frames() const noexcept -> std::size_t
+{
+    std::size_t result{};
+
+    for (auto const& t : m_impl->tracks)
+    {
+        result += t->dropped_frames.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+auto
+disk_writer::gap_frames() const noexcept -> std::size_t
+{
+    std::size_t result{};
+
+    for (auto const& t : m_impl->tracks)
+    {
+        result += t->gap_frames.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+} // namespace piejam::runtime::recorder
@@ -0,0 +1,170 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/file_writer.h>
+
+#include <piejam/runtime/recorder/flac_writer.h>
+#include <piejam/runtime/recorder/peak_writer.h>
+#include <piejam/runtime/recorder/wav_writer.h>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/assert.hpp>
+
+#include <optional>
+
+namespace piejam::runtime::recorder
+{
+
+namespace
+{
+
+class file_writer_with_peaks final : public file_writer
+{
+public:
+    file_writer_with_peaks(
+        std::unique_ptr<file_writer> file,
+        std::filesystem::path peak_file,
+        peak_writer peaks)
+        : m_file{std::move(file)}
+        , m_peak_file{std::move(peak_file)}
+        , m_peaks{std::move(peaks)}
+    {
+    }
+
+    auto num_channels() const noexcept -> std::size_t override
+    {
+        return m_file->num_channels();
+    }
+
+    auto write(std::span<float const> const interleaved)
+        -> std::error_code override
+    {
+        auto const ec = m_file->write(interleaved);
+
+        // the peaks only cover what is in the recording
+        if (!ec && m_peaks)
+        {
+            check(m_peaks->write(interleaved));
+        }
+
+        return ec;
+    }
+
+    auto commit() -> std::error_code override
+    {
+        if (m_peaks)
+        {
+            check(m_peaks->commit());
+        }
+
+        return m_file->commit();
+    }
+
+    auto close() -> std::error_code override
+    {
+        if (m_peaks)
+        {
+            check(m_peaks->close());
+            m_peaks.reset();
+        }
+
+        return m_file->close();
+    }
+
+private:
+    void check(std::error_code const ec)
+    {
+        if (ec)
+        {
+            spdlog::error(
+                "Could not write peak file {}: {}",
+                m_peak_file.string(),
+                ec.message());
+
+            m_peaks.reset();
+
+            std::error_code remove_ec;
+            std::filesystem::remove(m_peak_file, remove_ec);
+        }
+    }
+
+    std::unique_ptr<file_writer> m_file;
+    std::filesystem::path m_peak_file;
+    std::optional<peak_writer> m_peaks;
+};
+
+} // namespace
+
+auto
+file_extension(recording_format const format) noexcept -> std::string_view
+{
+    switch (format)
+    {
+        case recording_format::wav:
+            return "wav";
+
+        case recording_format::flac:
+            return "flac";
+    }
+
+    BOOST_ASSERT(false);
+    return {};
+}
+
+auto
+make_file_writer(
+    recording_format const format,
+    std::filesystem::path const& file,
+    audio::sample_rate const sample_rate,
+    std::size_t const num_channels) -> std::unique_ptr<file_writer>
+{
+    switch (format)
+    {
+        case recording_format::wav:
+            return std::make_unique<wav_writer>(
+                file,
+                sample_rate,
+                num_channels);
+
+        case recording_format::flac:
+            return std::make_unique<flac_writer>(
+                file,
+                sample_rate,
+                num_channels);
+    }
+
+    BOOST_ASSERT(false);
+    return {};
+}
+
+auto
+with_peak_file(
+    std::unique_ptr<file_writer> file,
+    std::filesystem::path const& audio_file,
+    audio::sample_rate const sample_rate) -> std::unique_ptr<file_writer>
+{
+    auto peak_file = peak_file_path(audio_file);
+
+    try
+    {
+        peak_writer peaks{peak_file, sample_rate, file->num_channels()};
+
+        return std::make_unique<file_writer_with_peaks>(
+            std::move(file),
+            std::move(peak_file),
+            std::move(peaks));
+    }
+    catch (std::system_error const& err)
+    {
+        spdlog::error(
+            "Could not create peak file {}: {}",
+            peak_file.string(),
+            err.what());
+
+        return file;
+    }
+}
+
+} // namespace piejam::runtime::recorder
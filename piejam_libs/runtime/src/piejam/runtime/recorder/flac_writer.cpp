@@ -0,0 +1,164 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/flac_writer.h>
+
+#include <boost/assert.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+#include <utility>
+
+namespace piejam::runtime::recorder
+{
+
+namespace
+{
+
+// Maps to FLAC level 2, which achieves most of the size reduction at a
+// fraction of the cpu time of the default level.
+constexpr double compression_level{0.25};
+
+class sndfile_error_category final : public std::error_category
+{
+public:
+    [[nodiscard]]
+    auto name() const noexcept -> char const* override
+    {
+        return "sndfile";
+    }
+
+    [[nodiscard]]
+    auto message(int const ev) const -> std::string override
+    {
+        return sf_error_number(ev);
+    }
+};
+
+auto
+sndfile_category() -> std::error_category const&
+{
+    static sndfile_error_category const s_category;
+    return s_category;
+}
+
+auto
+last_error() -> std::error_code
+{
+    return {errno, std::generic_category()};
+}
+
+auto
+create_file(std::filesystem::path const& file) -> int
+{
+    int const fd =
+        ::open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        throw std::system_error(last_error());
+    }
+
+    return fd;
+}
+
+} // namespace
+
+flac_writer::flac_writer(
+    std::filesystem::path const& file,
+    audio::sample_rate const sample_rate,
+    std::size_t const num_channels)
+    : m_fd{create_file(file)}
+    , m_file{
+          m_fd,
+          false,
+          SFM_WRITE,
+          SF_FORMAT_FLAC | SF_FORMAT_PCM_24,
+          static_cast<int>(num_channels),
+          static_cast<int>(sample_rate.value())}
+    , m_num_channels{num_channels}
+{
+    BOOST_ASSERT(num_channels > 0);
+
+    if (m_file.rawHandle() == nullptr)
+    {
+        ::close(m_fd);
+        throw std::system_error(m_file.error(), sndfile_category());
+    }
+
+    m_file.command(SFC_SET_CLIPPING, nullptr, SF_TRUE);
+
+    double level{compression_level};
+    m_file.command(SFC_SET_COMPRESSION_LEVEL, &level, sizeof(level));
+}
+
+flac_writer::~flac_writer()
+{
+    close();
+}
+
+auto
+flac_writer::write(std::span<float const> const interleaved) -> std::error_code
+{
+    BOOST_ASSERT(m_file.rawHandle() != nullptr);
+    BOOST_ASSERT(interleaved.size() % m_num_channels == 0);
+
+    auto const num_frames =
+        static_cast<sf_count_t>(interleaved.size() / m_num_channels);
+
+    if (m_file.writef(interleaved.data(), num_frames) != num_frames)
+    {
+        return {m_file.error(), sndfile_category()};
+    }
+
+    return {};
+}
+
+auto
+flac_writer::commit() -> std::error_code
+{
+    BOOST_ASSERT(m_file.rawHandle() != nullptr);
+
+    // failures of the encoder, e.g. writing its frames, are kept until the
+    // next write
+    if (int const err = m_file.error())
+    {
+        return {err, sndfile_category()};
+    }
+
+    if (::fdatasync(m_fd) != 0)
+    {
+        return last_error();
+    }
+
+    return {};
+}
+
+auto
+flac_writer::close() -> std::error_code
+{
+    if (m_fd < 0)
+    {
+        return {};
+    }
+
+    std::error_code ec;
+
+    // flushes the encoder and completes the stream info
+    if (int const err = sf_close(m_file.takeOwnership()))
+    {
+        ec = {err, sndfile_category()};
+    }
+
+    if (::close(std::exchange(m_fd, -1)) != 0 && !ec)
+    {
+        ec = last_error();
+    }
+
+    return ec;
+}
+
+} // namespace piejam::runtime::recorder
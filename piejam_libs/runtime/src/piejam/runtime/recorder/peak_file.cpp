@@ -0,0 +1,326 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/peak_file.h>
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+namespace piejam::runtime::recorder
+{
+
+// The levels are mapped as they are in the file.
+static_assert(std::endian::native == std::endian::little);
+static_assert(sizeof(peak) == 4);
+
+namespace
+{
+
+constexpr std::uint16_t version{1};
+
+constexpr std::size_t num_frames_offset{16};
+constexpr std::size_t levels_offset{24};
+constexpr std::size_t level_size{24};
+
+static_assert(
+    levels_offset + num_peak_levels * level_size <= peak_file_header::size);
+
+auto
+last_error() -> std::error_code
+{
+    return {errno, std::generic_category()};
+}
+
+auto
+bucket_size(std::size_t const num_channels) noexcept -> std::size_t
+{
+    return num_channels * sizeof(peak);
+}
+
+auto
+expected_buckets(std::size_t const num_frames, std::size_t const level) noexcept
+    -> std::size_t
+{
+    std::size_t const frames_per_bucket = peak_level_frames_per_bucket[level];
+    return (num_frames + frames_per_bucket - 1) / frames_per_bucket;
+}
+
+// Each bucket of the coarser level merges the buckets of the finer level,
+// which cover its frames.
+auto
+build_level(
+    std::span<peak const> const finer,
+    std::size_t const num_channels,
+    std::size_t const num_buckets,
+    std::size_t const ratio) -> std::vector<peak>
+{
+    std::size_t const num_finer_buckets = finer.size() / num_channels;
+
+    std::vector<peak> result(
+        num_buckets * num_channels,
+        peak{.min = std::numeric_limits<std::int16_t>::max(),
+             .max = std::numeric_limits<std::int16_t>::min()});
+
+    for (std::size_t bucket = 0; bucket < num_finer_buckets; ++bucket)
+    {
+        for (std::size_t ch = 0; ch < num_channels; ++ch)
+        {
+            peak const& p = finer[bucket * num_channels + ch];
+            peak& merged = result[bucket / ratio * num_channels + ch];
+            merged.min = std::min(merged.min, p.min);
+            merged.max = std::max(merged.max, p.max);
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
+auto
+peak_file_header::encode() const noexcept -> bytes_t
+{
+    bytes_t bytes{};
+
+    std::memcpy(bytes.data(), "PJPK", 4);
+    boost::endian::store_little_u16(bytes.data() + 4, version);
+    boost::endian::store_little_u16(
+        bytes.data() + 6,
+        static_cast<std::uint16_t>(num_channels));
+    boost::endian::store_little_u32(bytes.data() + 8, sample_rate.value());
+    boost::endian::store_little_u64(
+        bytes.data() + num_frames_offset,
+        num_frames);
+
+    for (std::size_t level = 0; level < num_peak_levels; ++level)
+    {
+        unsigned char* const entry =
+            bytes.data() + levels_offset + level * level_size;
+
+        boost::endian::store_little_u32(
+            entry,
+            static_cast<std::uint32_t>(peak_level_frames_per_bucket[level]));
+        boost::endian::store_little_u64(entry + 8, num_buckets[level]);
+        boost::endian::store_little_u64(entry + 16, offsets[level]);
+    }
+
+    return bytes;
+}
+
+auto
+peak_file_header::decode(bytes_t const& bytes) noexcept
+    -> std::optional<peak_file_header>
+{
+    if (std::memcmp(bytes.data(), "PJPK", 4) != 0 ||
+        boost::endian::load_little_u16(bytes.data() + 4) != version)
+    {
+        return std::nullopt;
+    }
+
+    peak_file_header header{
+        .num_channels = boost::endian::load_little_u16(bytes.data() + 6),
+        .sample_rate = audio::sample_rate{
+            boost::endian::load_little_u32(bytes.data() + 8)},
+        .num_frames = boost::endian::load_little_u64(
+            bytes.data() + num_frames_offset),
+    };
+
+    if (header.num_channels == 0)
+    {
+        return std::nullopt;
+    }
+
+    for (std::size_t level = 0; level < num_peak_levels; ++level)
+    {
+        unsigned char const* const entry =
+            bytes.data() + levels_offset + level * level_size;
+
+        if (boost::endian::load_little_u32(entry) !=
+            peak_level_frames_per_bucket[level])
+        {
+            return std::nullopt;
+        }
+
+        header.num_buckets[level] = boost::endian::load_little_u64(entry + 8);
+        header.offsets[level] = boost::endian::load_little_u64(entry + 16);
+    }
+
+    return header;
+}
+
+auto
+peak_file_path(std::filesystem::path const& audio_file)
+    -> std::filesystem::path
+{
+    auto result = audio_file;
+    result += ".peaks";
+    return result;
+}
+
+auto
+peak_level_for(double const frames_per_pixel) noexcept -> std::size_t
+{
+    std::size_t level{};
+
+    while (level + 1 < num_peak_levels &&
+           static_cast<double>(peak_level_frames_per_bucket[level + 1]) <=
+               frames_per_pixel)
+    {
+        ++level;
+    }
+
+    return level;
+}
+
+peak_file::peak_file(std::filesystem::path const& file)
+{
+    int const fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::system_error(last_error());
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0)
+    {
+        auto const ec = last_error();
+        ::close(fd);
+        throw std::system_error(ec);
+    }
+
+    auto const file_size = static_cast<std::size_t>(st.st_size);
+    if (file_size < peak_file_header::size)
+    {
+        ::close(fd);
+        throw std::system_error(
+            std::make_error_code(std::errc::invalid_argument));
+    }
+
+    void* const mapping =
+        ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    auto const map_ec = last_error();
+    ::close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        throw std::system_error(map_ec);
+    }
+
+    m_mapping = mapping;
+    m_mapping_size = file_size;
+
+    auto const* const bytes = static_cast<unsigned char const*>(mapping);
+
+    peak_file_header::bytes_t header_bytes{};
+    std::copy_n(bytes, header_bytes.size(), header_bytes.begin());
+
+    auto header = peak_file_header::decode(header_bytes);
+    if (!header)
+    {
+        unmap();
+        throw std::system_error(
+            std::make_error_code(std::errc::invalid_argument));
+    }
+
+    m_header = *header;
+
+    std::size_t const level_bucket_size = bucket_size(m_header.num_channels);
+
+    // the finest level must be complete, it is committed while recording
+    if (m_header.offsets[0] < peak_file_header::size ||
+        m_header.num_buckets[0] != expected_buckets(m_header.num_frames, 0) ||
+        m_header.offsets[0] + m_header.num_buckets[0] * level_bucket_size >
+            file_size)
+    {
+        unmap();
+        throw std::system_error(
+            std::make_error_code(std::errc::invalid_argument));
+    }
+
+    for (std::size_t level = 0; level < num_peak_levels; ++level)
+    {
+        std::size_t const num_buckets =
+            expected_buckets(m_header.num_frames, level);
+        std::size_t const offset = m_header.offsets[level];
+
+        if (m_header.num_buckets[level] == num_buckets &&
+            offset >= peak_file_header::size &&
+            offset % sizeof(peak) == 0 &&
+            offset + num_buckets * level_bucket_size <= file_size)
+        {
+            m_levels[level] = {
+                reinterpret_cast<peak const*>(bytes + offset),
+                num_buckets * m_header.num_channels};
+        }
+        else
+        {
+            BOOST_ASSERT(level > 0);
+
+            m_built_levels[level] = build_level(
+                m_levels[level - 1],
+                m_header.num_channels,
+                num_buckets,
+                peak_level_frames_per_bucket[level] /
+                    peak_level_frames_per_bucket[level - 1]);
+            m_levels[level] = m_built_levels[level];
+            m_header.num_buckets[level] = num_buckets;
+        }
+    }
+}
+
+peak_file::peak_file(peak_file&& other) noexcept
+    : m_mapping{std::exchange(other.m_mapping, nullptr)}
+    , m_mapping_size{std::exchange(other.m_mapping_size, 0)}
+    , m_header{other.m_header}
+    , m_levels{std::exchange(other.m_levels, {})}
+    , m_built_levels{std::move(other.m_built_levels)}
+{
+}
+
+peak_file::~peak_file()
+{
+    unmap();
+}
+
+auto
+peak_file::operator=(peak_file&& other) noexcept -> peak_file&
+{
+    if (this != &other)
+    {
+        unmap();
+
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+        m_mapping_size = std::exchange(other.m_mapping_size, 0);
+        m_header = other.m_header;
+        m_levels = std::exchange(other.m_levels, {});
+        m_built_levels = std::move(other.m_built_levels);
+    }
+
+    return *this;
+}
+
+void
+peak_file::unmap() noexcept
+{
+    if (m_mapping)
+    {
+        ::munmap(m_mapping, m_mapping_size);
+        m_mapping = nullptr;
+        m_mapping_size = 0;
+    }
+}
+
+} // namespace piejam::runtime::recorder
@@ -0,0 +1,359 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/peak_writer.h>
+
+#include <boost/assert.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace piejam::runtime::recorder
+{
+
+namespace
+{
+
+constexpr std::size_t frames_per_bucket{peak_level_frames_per_bucket[0]};
+
+auto
+last_error() -> std::error_code
+{
+    return {errno, std::generic_category()};
+}
+
+auto
+pwrite_fully(
+    int const fd,
+    std::span<unsigned char const> data,
+    std::size_t offset) -> std::error_code
+{
+    while (!data.empty())
+    {
+        ssize_t const res = ::pwrite(
+            fd,
+            data.data(),
+            data.size(),
+            static_cast<off_t>(offset));
+
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return last_error();
+        }
+
+        data = data.subspan(static_cast<std::size_t>(res));
+        offset += static_cast<std::size_t>(res);
+    }
+
+    return {};
+}
+
+auto
+as_bytes(std::span<peak const> const peaks) noexcept
+    -> std::span<unsigned char const>
+{
+    return {
+        reinterpret_cast<unsigned char const*>(peaks.data()),
+        peaks.size_bytes()};
+}
+
+auto
+to_int16(float const x) noexcept -> std::int16_t
+{
+    return static_cast<std::int16_t>(
+        std::lround(std::clamp(x, -1.f, 1.f) * 32767.f));
+}
+
+} // namespace
+
+peak_writer::peak_writer(
+    std::filesystem::path const& file,
+    audio::sample_rate const sample_rate,
+    std::size_t const num_channels)
+    : m_fd{::open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)}
+    , m_header{
+          .num_channels = num_channels,
+          .sample_rate = sample_rate,
+          .num_frames = 0,
+          .num_buckets = {},
+          .offsets = {peak_file_header::size},
+      }
+    , m_min(num_channels, std::numeric_limits<float>::infinity())
+    , m_max(num_channels, -std::numeric_limits<float>::infinity())
+{
+    BOOST_ASSERT(num_channels > 0);
+
+    if (m_fd == invalid)
+    {
+        throw std::system_error(last_error());
+    }
+
+    if (auto const ec = write_header())
+    {
+        ::close(m_fd);
+        throw std::system_error(ec);
+    }
+}
+
+peak_writer::peak_writer(peak_writer&& other) noexcept
+    : m_fd{std::exchange(other.m_fd, invalid)}
+    , m_header{other.m_header}
+    , m_num_frames{other.m_num_frames}
+    , m_min{std::move(other.m_min)}
+    , m_max{std::move(other.m_max)}
+    , m_bucket_frames{other.m_bucket_frames}
+    , m_pending{std::move(other.m_pending)}
+    , m_coarse_levels{std::move(other.m_coarse_levels)}
+{
+}
+
+peak_writer::~peak_writer()
+{
+    close();
+}
+
+auto
+peak_writer::operator=(peak_writer&& other) noexcept -> peak_writer&
+{
+    if (this != &other)
+    {
+        close();
+
+        m_fd = std::exchange(other.m_fd, invalid);
+        m_header = other.m_header;
+        m_num_frames = other.m_num_frames;
+        m_min = std::move(other.m_min);
+        m_max = std::move(other.m_max);
+        m_bucket_frames = other.m_bucket_frames;
+        m_pending = std::move(other.m_pending);
+        m_coarse_levels = std::move(other.m_coarse_levels);
+    }
+
+    return *this;
+}
+
+auto
+peak_writer::write(std::span<float const> const interleaved) -> std::error_code
+{
+    BOOST_ASSERT(m_fd != invalid);
+
+    std::size_t const num_channels = m_header.num_channels;
+    BOOST_ASSERT(interleaved.size() % num_channels == 0);
+
+    std::size_t const num_frames = interleaved.size() / num_channels;
+
+    for (std::size_t frame = 0; frame < num_frames;)
+    {
+        std::size_t const frames =
+            std::min(frames_per_bucket - m_bucket_frames, num_frames - frame);
+
+        for (std::size_t ch = 0; ch < num_channels; ++ch)
+        {
+            float min = m_min[ch];
+            float max = m_max[ch];
+
+            for (std::size_t f = frame; f < frame + frames; ++f)
+            {
+                float const sample = interleaved[f * num_channels + ch];
+                min = std::min(min, sample);
+                max = std::max(max, sample);
+            }
+
+            m_min[ch] = min;
+            m_max[ch] = max;
+        }
+
+        frame += frames;
+        m_bucket_frames += frames;
+
+        if (m_bucket_frames == frames_per_bucket)
+        {
+            complete_bucket();
+        }
+    }
+
+    m_num_frames += num_frames;
+
+    return write_pending();
+}
+
+auto
+peak_writer::commit() -> std::error_code
+{
+    BOOST_ASSERT(m_fd != invalid);
+
+    // only the written buckets of the finest level are committed
+    peak_file_header header{
+        .num_channels = m_header.num_channels,
+        .sample_rate = m_header.sample_rate,
+        .num_frames = m_header.num_buckets[0] * frames_per_bucket,
+        .num_buckets = {m_header.num_buckets[0]},
+        .offsets = {m_header.offsets[0]},
+    };
+
+    if (auto const ec = pwrite_fully(m_fd, header.encode(), 0))
+    {
+        return ec;
+    }
+
+    if (::fdatasync(m_fd) != 0)
+    {
+        return last_error();
+    }
+
+    return {};
+}
+
+auto
+peak_writer::close() -> std::error_code
+{
+    if (m_fd == invalid)
+    {
+        return {};
+    }
+
+    if (m_bucket_frames > 0)
+    {
+        complete_bucket();
+    }
+
+    for (std::size_t level = 1; level < num_peak_levels; ++level)
+    {
+        if (m_coarse_levels[level - 1].num_merged > 0)
+        {
+            complete_level_bucket(level);
+        }
+    }
+
+    std::error_code ec = write_pending();
+
+    std::size_t const bucket_size = m_header.num_channels * sizeof(peak);
+    for (std::size_t level = 1; level < num_peak_levels && !ec; ++level)
+    {
+        auto const& buckets = m_coarse_levels[level - 1].buckets;
+
+        m_header.offsets[level] =
+            m_header.offsets[level - 1] +
+            m_header.num_buckets[level - 1] * bucket_size;
+
+        ec = pwrite_fully(m_fd, as_bytes(buckets), m_header.offsets[level]);
+        if (!ec)
+        {
+            m_header.num_buckets[level] =
+                buckets.size() / m_header.num_channels;
+        }
+    }
+
+    if (!ec)
+    {
+        m_header.num_frames = m_num_frames;
+        ec = write_header();
+    }
+
+    if (::close(std::exchange(m_fd, invalid)) != 0 && !ec)
+    {
+        ec = last_error();
+    }
+
+    return ec;
+}
+
+void
+peak_writer::complete_bucket()
+{
+    std::size_t const offset = m_pending.size();
+
+    for (std::size_t ch = 0; ch < m_header.num_channels; ++ch)
+    {
+        m_pending.push_back(
+            peak{.min = to_int16(m_min[ch]), .max = to_int16(m_max[ch])});
+    }
+
+    std::ranges::fill(m_min, std::numeric_limits<float>::infinity());
+    std::ranges::fill(m_max, -std::numeric_limits<float>::infinity());
+    m_bucket_frames = 0;
+
+    merge(1, std::span{m_pending}.subspan(offset));
+}
+
+void
+peak_writer::merge(std::size_t const level, std::span<peak const> const peaks)
+{
+    auto& l = m_coarse_levels[level - 1];
+
+    if (l.num_merged == 0)
+    {
+        l.bucket.assign(peaks.begin(), peaks.end());
+    }
+    else
+    {
+        for (std::size_t ch = 0; ch < peaks.size(); ++ch)
+        {
+            l.bucket[ch].min = std::min(l.bucket[ch].min, peaks[ch].min);
+            l.bucket[ch].max = std::max(l.bucket[ch].max, peaks[ch].max);
+        }
+    }
+
+    if (++l.num_merged == peak_level_frames_per_bucket[level] /
+                             peak_level_frames_per_bucket[level - 1])
+    {
+        complete_level_bucket(level);
+    }
+}
+
+void
+peak_writer::complete_level_bucket(std::size_t const level)
+{
+    auto& l = m_coarse_levels[level - 1];
+
+    l.buckets.insert(l.buckets.end(), l.bucket.begin(), l.bucket.end());
+    l.num_merged = 0;
+
+    if (level + 1 < num_peak_levels)
+    {
+        merge(level + 1, l.bucket);
+    }
+}
+
+auto
+peak_writer::write_pending() -> std::error_code
+{
+    if (m_pending.empty())
+    {
+        return {};
+    }
+
+    std::size_t const bucket_size = m_header.num_channels * sizeof(peak);
+
+    if (auto const ec = pwrite_fully(
+            m_fd,
+            as_bytes(m_pending),
+            m_header.offsets[0] + m_header.num_buckets[0] * bucket_size))
+    {
+        return ec;
+    }
+
+    m_header.num_buckets[0] += m_pending.size() / m_header.num_channels;
+    m_pending.clear();
+
+    return {};
+}
+
+auto
+peak_writer::write_header() -> std::error_code
+{
+    return pwrite_fully(m_fd, m_header.encode(), 0);
+}
+
+} // namespace piejam::runtime::recorder
@@ -0,0 +1,417 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/stem_splitter.h>
+
+#include <piejam/runtime/recorder/peak_file.h>
+#include <piejam/runtime/recorder/wav_writer.h>
+
+#include <piejam/numeric/intx.h>
+#include <piejam/system/file_utils.h>
+
+#include <boost/endian/conversion.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace piejam::runtime::recorder
+{
+
+namespace
+{
+
+constexpr std::size_t bytes_per_sample{3};
+
+// Big blocks keep the number of reads low, the stems are written in the
+// same blocks.
+constexpr std::size_t block_size{4 * 1024 * 1024};
+
+// Layout of the fmt chunk, as written by the wav_writer.
+constexpr std::size_t fmt_offset{48};
+constexpr std::size_t num_channels_offset{fmt_offset + 10};
+constexpr std::size_t sample_rate_offset{fmt_offset + 12};
+constexpr std::size_t bits_per_sample_offset{fmt_offset + 22};
+
+class file_descriptor
+{
+public:
+    explicit file_descriptor(int const fd) noexcept
+        : m_fd{fd}
+    {
+    }
+
+    file_descriptor(file_descriptor const&) = delete;
+
+    ~file_descriptor()
+    {
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+        }
+    }
+
+    auto operator=(file_descriptor const&) -> file_descriptor& = delete;
+
+    [[nodiscard]]
+    auto get() const noexcept -> int
+    {
+        return m_fd;
+    }
+
+private:
+    int m_fd;
+};
+
+auto
+last_error() -> std::error_code
+{
+    return {errno, std::generic_category()};
+}
+
+auto
+pread_fully(int const fd, std::span<unsigned char> data, std::size_t offset)
+    -> std::error_code
+{
+    while (!data.empty())
+    {
+        ssize_t const res =
+            ::pread(fd, data.data(), data.size(), static_cast<off_t>(offset));
+
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return last_error();
+        }
+
+        if (res == 0)
+        {
+            return std::make_error_code(std::errc::io_error);
+        }
+
+        data = data.subspan(static_cast<std::size_t>(res));
+        offset += static_cast<std::size_t>(res);
+    }
+
+    return {};
+}
+
+auto
+has_tag(
+    std::span<unsigned char const> const header,
+    std::size_t const offset,
+    char const* const tag) noexcept -> bool
+{
+    return std::memcmp(header.data() + offset, tag, 4) == 0;
+}
+
+// The channels of a stem are taken from each bucket of each level.
+void
+write_stem_peaks(
+    peak_file const& peaks,
+    std::size_t const channel_offset,
+    std::size_t const num_channels,
+    std::filesystem::path const& file)
+{
+    peak_file_header header{
+        .num_channels = num_channels,
+        .sample_rate = peaks.sample_rate(),
+        .num_frames = peaks.num_frames(),
+    };
+
+    std::size_t offset{peak_file_header::size};
+    for (std::size_t level = 0; level < num_peak_levels; ++level)
+    {
+        header.num_buckets[level] = peaks.num_buckets(level);
+        header.offsets[level] = offset;
+        offset += header.num_buckets[level] * num_channels * sizeof(peak);
+    }
+
+    std::ofstream out{file, std::ios::binary | std::ios::trunc};
+
+    auto const header_bytes = header.encode();
+    out.write(
+        reinterpret_cast<char const*>(header_bytes.data()),
+        static_cast<std::streamsize>(header_bytes.size()));
+
+    for (std::size_t level = 0; level < num_peak_levels; ++level)
+    {
+        for (std::size_t bucket = 0; bucket < header.num_buckets[level];
+             ++bucket)
+        {
+            auto const stem_peaks = peaks.peaks(level, bucket)
+                                        .subspan(channel_offset, num_channels);
+            out.write(
+                reinterpret_cast<char const*>(stem_peaks.data()),
+                static_cast<std::streamsize>(stem_peaks.size_bytes()));
+        }
+    }
+
+    out.close();
+
+    if (!out)
+    {
+        std::error_code ec;
+        std::filesystem::remove(file, ec);
+    }
+}
+
+// The peaks are optional, without a valid peak file of the multitrack file
+// the stems just don't get any.
+void
+split_peak_file(
+    std::filesystem::path const& multitrack_file,
+    std::span<stem const> const stems,
+    std::span<std::filesystem::path const> const stem_files,
+    std::size_t const num_channels)
+{
+    std::optional<peak_file> peaks;
+
+    try
+    {
+        peaks.emplace(peak_file_path(multitrack_file));
+    }
+    catch (std::system_error const&)
+    {
+        return;
+    }
+
+    if (peaks->num_channels() != num_channels)
+    {
+        return;
+    }
+
+    std::size_t channel_offset{};
+    for (std::size_t i = 0; i < stems.size(); ++i)
+    {
+        write_stem_peaks(
+            *peaks,
+            channel_offset,
+            stems[i].num_channels,
+            peak_file_path(stem_files[i]));
+        channel_offset += stems[i].num_channels;
+    }
+}
+
+} // namespace
+
+auto
+split_stems(
+    std::filesystem::path const& multitrack_file,
+    std::span<stem const> const stems,
+    std::filesystem::path const& stems_dir) -> std::error_code
+{
+    file_descriptor const in{
+        ::open(multitrack_file.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (in.get() < 0)
+    {
+        return last_error();
+    }
+
+    std::array<unsigned char, wav_writer::data_offset> header{};
+    if (auto const ec = pread_fully(in.get(), header, 0))
+    {
+        return ec;
+    }
+
+    std::size_t const num_channels = std::accumulate(
+        stems.begin(),
+        stems.end(),
+        std::size_t{},
+        [](std::size_t const sum, stem const& s) {
+            return sum + s.num_channels;
+        });
+
+    if (!(has_tag(header, 0, "RIFF") || has_tag(header, 0, "RF64")) ||
+        !has_tag(header, 8, "WAVE") || !has_tag(header, fmt_offset, "fmt ") ||
+        !has_tag(header, wav_writer::data_offset - 8, "data") ||
+        boost::endian::load_little_u16(header.data() + num_channels_offset) !=
+            num_channels ||
+        boost::endian::load_little_u16(
+            header.data() + bits_per_sample_offset) != 8 * bytes_per_sample)
+    {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+
+    audio::sample_rate const sample_rate{
+        boost::endian::load_little_u32(header.data() + sample_rate_offset)};
+
+    struct stat st{};
+    if (::fstat(in.get(), &st) != 0)
+    {
+        return last_error();
+    }
+
+    std::size_t const frame_size = num_channels * bytes_per_sample;
+    std::size_t const num_frames =
+        (static_cast<std::size_t>(st.st_size) - wav_writer::data_offset) /
+        frame_size;
+
+    ::posix_fadvise(in.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    std::vector<std::filesystem::path> stem_files;
+    std::vector<wav_writer> writers;
+    stem_files.reserve(stems.size());
+    writers.reserve(stems.size());
+
+    try
+    {
+        for (stem const& s : stems)
+        {
+            stem_files.push_back(
+                system::make_unique_filename(stems_dir, s.name, "wav"));
+            writers.emplace_back(
+                stem_files.back(),
+                sample_rate,
+                s.num_channels);
+        }
+    }
+    catch (std::system_error const& err)
+    {
+        return err.code();
+    }
+
+    std::size_t const block_frames = block_size / frame_size;
+    std::vector<numeric::int24_io_t> block(block_frames * num_channels);
+    std::vector<numeric::int24_io_t> stem_block(block.size());
+
+    for (std::size_t frame = 0; frame < num_frames; frame += block_frames)
+    {
+        std::size_t const frames = std::min(block_frames, num_frames - frame);
+
+        if (auto const ec = pread_fully(
+                in.get(),
+                {reinterpret_cast<unsigned char*>(block.data()),
+                 frames * frame_size},
+                wav_writer::data_offset + frame * frame_size))
+        {
+            return ec;
+        }
+
+        std::size_t channel_offset{};
+        for (std::size_t i = 0; i < stems.size(); ++i)
+        {
+            std::size_t const stem_channels = stems[i].num_channels;
+
+            for (std::size_t f = 0; f < frames; ++f)
+            {
+                std::copy_n(
+                    block.begin() + static_cast<std::ptrdiff_t>(
+                                        f * num_channels + channel_offset),
+                    stem_channels,
+                    stem_block.begin() +
+                        static_cast<std::ptrdiff_t>(f * stem_channels));
+            }
+
+            if (auto const ec = writers[i].write_pcm(
+                    std::span{stem_block}.first(frames * stem_channels)))
+            {
+                return ec;
+            }
+
+            channel_offset += stem_channels;
+        }
+    }
+
+    for (auto& writer : writers)
+    {
+        if (auto const ec = writer.close())
+        {
+            return ec;
+        }
+    }
+
+    split_peak_file(multitrack_file, stems, stem_files, num_channels);
+
+    return {};
+}
+
+auto
+stems_file_path(std::filesystem::path const& multitrack_file)
+    -> std::filesystem::path
+{
+    auto result = multitrack_file;
+    result.replace_extension("stems");
+    return result;
+}
+
+// One line per stem: the number of channels, followed by the name.
+auto
+save_stems(
+    std::filesystem::path const& multitrack_file,
+    std::span<stem const> const stems) -> std::error_code
+{
+    auto const file = stems_file_path(multitrack_file);
+
+    {
+        std::ofstream out{file, std::ios::trunc};
+        for (stem const& s : stems)
+        {
+            out << s.num_channels << ' ' << s.name << '\n';
+        }
+
+        out.close();
+        if (!out)
+        {
+            std::error_code ec;
+            std::filesystem::remove(file, ec);
+            return std::make_error_code(std::errc::io_error);
+        }
+    }
+
+    file_descriptor const fd{::open(file.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd.get() < 0 || ::fsync(fd.get()) != 0)
+    {
+        return last_error();
+    }
+
+    return {};
+}
+
+auto
+load_stems(std::filesystem::path const& multitrack_file)
+    -> std::optional<std::vector<stem>>
+{
+    std::ifstream in{stems_file_path(multitrack_file)};
+    if (!in)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<stem> result;
+
+    stem s;
+    while (in >> s.num_channels && in.get() == ' ' &&
+           std::getline(in, s.name))
+    {
+        if (s.num_channels == 0)
+        {
+            return std::nullopt;
+        }
+
+        result.push_back(s);
+    }
+
+    if (!in.eof() || result.empty())
+    {
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+} // namespace piejam::runtime::recorder
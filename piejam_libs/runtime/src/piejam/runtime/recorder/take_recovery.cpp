@@ -0,0 +1,164 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/take_recovery.h>
+
+#include <piejam/runtime/recorder/wav_writer.h>
+
+#include <spdlog/spdlog.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace piejam::runtime::recorder
+{
+
+namespace
+{
+
+// Without a sync, the marker might get lost together with the take.
+void
+sync_file(std::filesystem::path const& file)
+{
+    int const fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    ::fsync(fd);
+    ::close(fd);
+}
+
+} // namespace
+
+void
+mark_take_started(
+    std::filesystem::path const& marker_file,
+    std::filesystem::path const& take_dir)
+{
+    {
+        std::ofstream out{marker_file, std::ios::trunc};
+        out << take_dir.string();
+
+        if (!out)
+        {
+            spdlog::warn(
+                "Could not mark take as started: {}",
+                take_dir.string());
+            return;
+        }
+    }
+
+    sync_file(marker_file);
+}
+
+void
+mark_take_finished(std::filesystem::path const& marker_file)
+{
+    std::error_code ec;
+    std::filesystem::remove(marker_file, ec);
+}
+
+auto
+pop_interrupted_take(std::filesystem::path const& marker_file)
+    -> std::optional<std::filesystem::path>
+{
+    std::string take_dir;
+
+    {
+        std::ifstream in{marker_file};
+        if (!in || !std::getline(in, take_dir))
+        {
+            return std::nullopt;
+        }
+    }
+
+    mark_take_finished(marker_file);
+
+    if (take_dir.empty())
+    {
+        return std::nullopt;
+    }
+
+    return take_dir;
+}
+
+void
+repair_take(std::filesystem::path const& take_dir)
+{
+    std::error_code ec;
+    for (auto const& entry :
+         std::filesystem::directory_iterator{take_dir, ec})
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".wav")
+        {
+            continue;
+        }
+
+        if (auto const repair_ec = wav_writer::repair(entry.path()))
+        {
+            spdlog::error(
+                "Could not repair recording {}: {}",
+                entry.path().string(),
+                repair_ec.message());
+        }
+        else
+        {
+            spdlog::info("Repaired recording {}", entry.path().string());
+        }
+    }
+
+    if (ec)
+    {
+        spdlog::error(
+            "Could not scan interrupted take {}: {}",
+            take_dir.string(),
+            ec.message());
+    }
+}
+
+auto
+find_pending_splits(std::filesystem::path const& recordings_dir)
+    -> std::vector<std::filesystem::path>
+{
+    std::vector<std::filesystem::path> result;
+
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it{recordings_dir, ec},
+         end;
+         !ec && it != end;
+         it.increment(ec))
+    {
+        if (!it->is_regular_file() || it->path().extension() != ".stems")
+        {
+            continue;
+        }
+
+        auto multitrack_file = it->path();
+        multitrack_file.replace_extension("wav");
+
+        if (std::error_code exists_ec;
+            std::filesystem::is_regular_file(multitrack_file, exists_ec))
+        {
+            result.push_back(std::move(multitrack_file));
+        }
+    }
+
+    if (ec)
+    {
+        spdlog::error(
+            "Could not scan recordings for pending splits: {}",
+            ec.message());
+    }
+
+    return result;
+}
+
+} // namespace piejam::runtime::recorder
@@ -0,0 +1,204 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/track_merger.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace piejam::runtime::recorder
+{
+
+track_merger::track_merger(
+    std::vector<std::size_t> const& track_num_channels,
+    std::uint64_t const start_frame,
+    std::size_t const max_skew_frames)
+    : m_num_channels{std::accumulate(
+          track_num_channels.begin(),
+          track_num_channels.end(),
+          std::size_t{})}
+    , m_next_frame{start_frame}
+    , m_max_skew_frames{max_skew_frames}
+    , m_capacity{std::max<std::size_t>(2 * max_skew_frames, 1)}
+    , m_ring(m_num_channels * m_capacity)
+    , m_pending_frames(track_num_channels.size())
+{
+    BOOST_ASSERT(m_num_channels > 0);
+
+    std::exclusive_scan(
+        track_num_channels.begin(),
+        track_num_channels.end(),
+        std::back_inserter(m_track_channel_offsets),
+        std::size_t{});
+}
+
+void
+track_merger::push(
+    std::size_t const track,
+    std::uint64_t const frame,
+    channels_view const data)
+{
+    BOOST_ASSERT(track < m_track_channel_offsets.size());
+
+    std::size_t const offset = m_track_channel_offsets[track];
+    BOOST_ASSERT(offset + data.num_channels() <= m_num_channels);
+
+    std::size_t& pending_frames = m_pending_frames[track];
+    std::uint64_t const expected_frame = m_next_frame + pending_frames;
+
+    std::size_t skipped{};
+    std::size_t gap{};
+
+    if (frame < expected_frame)
+    {
+        // already padded, because the track was lagging behind
+        skipped = static_cast<std::size_t>(std::min<std::uint64_t>(
+            expected_frame - frame,
+            data.num_frames()));
+    }
+    else
+    {
+        gap = static_cast<std::size_t>(frame - expected_frame);
+        m_gap_frames += gap;
+    }
+
+    std::size_t const num_frames = data.num_frames() - skipped;
+    reserve(pending_frames + gap + num_frames);
+
+    for (std::size_t ch = 0; ch < data.num_channels(); ++ch)
+    {
+        auto const samples = data.samples().subspan(
+            ch * data.num_frames() + skipped,
+            num_frames);
+        float* const channel = m_ring.data() + (offset + ch) * m_capacity;
+
+        std::size_t pos = (m_head + pending_frames) % m_capacity;
+        for (std::size_t i = 0; i < gap; ++i)
+        {
+            channel[pos] = 0.f;
+            pos = pos + 1 == m_capacity ? 0 : pos + 1;
+        }
+
+        for (float const sample : samples)
+        {
+            channel[pos] = sample;
+            pos = pos + 1 == m_capacity ? 0 : pos + 1;
+        }
+    }
+
+    pending_frames += gap + num_frames;
+}
+
+auto
+track_merger::pull() -> channels_view
+{
+    auto const [min, max] = std::ranges::minmax(m_pending_frames);
+
+    if (max - min <= m_max_skew_frames)
+    {
+        return pull(min);
+    }
+
+    std::size_t const num_frames = max - m_max_skew_frames;
+
+    for (std::size_t const pending_frames : m_pending_frames)
+    {
+        m_gap_frames += num_frames - std::min(num_frames, pending_frames);
+    }
+
+    return pull(num_frames);
+}
+
+auto
+track_merger::flush() -> channels_view
+{
+    return pull(std::ranges::max(m_pending_frames));
+}
+
+auto
+track_merger::pull(std::size_t const num_frames) -> channels_view
+{
+    m_merged.resize(m_num_channels * num_frames);
+
+    for (std::size_t track = 0; track < m_track_channel_offsets.size();
+         ++track)
+    {
+        std::size_t const first_channel = m_track_channel_offsets[track];
+        std::size_t const last_channel =
+            track + 1 < m_track_channel_offsets.size()
+                ? m_track_channel_offsets[track + 1]
+                : m_num_channels;
+
+        std::size_t& pending_frames = m_pending_frames[track];
+        std::size_t const copied = std::min(num_frames, pending_frames);
+
+        // the pending frames may wrap around the end of the ring
+        std::size_t const first_part = std::min(copied, m_capacity - m_head);
+
+        for (std::size_t ch = first_channel; ch < last_channel; ++ch)
+        {
+            auto const channel = std::next(
+                m_ring.begin(),
+                static_cast<std::ptrdiff_t>(ch * m_capacity));
+            auto const out = std::next(
+                m_merged.begin(),
+                static_cast<std::ptrdiff_t>(ch * num_frames));
+
+            auto it = std::copy_n(
+                std::next(channel, static_cast<std::ptrdiff_t>(m_head)),
+                first_part,
+                out);
+            it = std::copy_n(channel, copied - first_part, it);
+            std::fill(
+                it,
+                std::next(out, static_cast<std::ptrdiff_t>(num_frames)),
+                0.f);
+        }
+
+        pending_frames -= copied;
+    }
+
+    m_head = (m_head + num_frames) % m_capacity;
+    m_next_frame += num_frames;
+
+    return channels_view{m_merged, m_num_channels};
+}
+
+void
+track_merger::reserve(std::size_t const num_frames)
+{
+    if (num_frames <= m_capacity)
+    {
+        return;
+    }
+
+    std::size_t const new_capacity = std::max(num_frames, 2 * m_capacity);
+    std::vector<float> new_ring(m_num_channels * new_capacity);
+
+    // unwrapped, the frame at m_next_frame moves to the start
+    for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+    {
+        auto const channel = std::next(
+            m_ring.begin(),
+            static_cast<std::ptrdiff_t>(ch * m_capacity));
+        auto const head =
+            std::next(channel, static_cast<std::ptrdiff_t>(m_head));
+
+        std::rotate_copy(
+            channel,
+            head,
+            std::next(channel, static_cast<std::ptrdiff_t>(m_capacity)),
+            std::next(
+                new_ring.begin(),
+                static_cast<std::ptrdiff_t>(ch * new_capacity)));
+    }
+
+    m_ring = std::move(new_ring);
+    m_capacity = new_capacity;
+    m_head = 0;
+}
+
+} // namespace piejam::runtime::recorder
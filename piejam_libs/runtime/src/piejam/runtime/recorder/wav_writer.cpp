@@ -0,0 +1,527 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/wav_writer.h>
+
+#include <piejam/audio/pcm_convert.h>
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+namespace piejam::runtime::recorder
+{
+
+namespace
+{
+
+constexpr std::size_t bytes_per_sample{3};
+
+// Preallocating in big steps keeps the number of fallocate calls low.
+constexpr std::size_t preallocation_size{16 * 1024 * 1024};
+
+constexpr std::size_t riff_size_offset{4};
+constexpr std::size_t data_size_offset{wav_writer::data_offset - 4};
+
+// Reserved for the ds64 chunk, see EBU Tech 3306.
+constexpr std::size_t ds64_offset{12};
+constexpr std::uint32_t ds64_size{28};
+
+constexpr std::size_t fmt_offset{ds64_offset + 8 + ds64_size};
+constexpr std::size_t num_channels_offset{fmt_offset + 10};
+constexpr std::size_t bits_per_sample_offset{fmt_offset + 22};
+
+using header_t = std::array<unsigned char, wav_writer::data_offset>;
+
+class header_builder
+{
+public:
+    explicit header_builder(header_t& header) noexcept
+        : m_header{header}
+    {
+    }
+
+    void tag(std::string_view const id) noexcept
+    {
+        BOOST_ASSERT(id.size() == 4);
+        std::memcpy(m_header.data() + m_pos, id.data(), 4);
+        m_pos += 4;
+    }
+
+    void u16(std::uint16_t const value) noexcept
+    {
+        boost::endian::store_little_u16(m_header.data() + m_pos, value);
+        m_pos += 2;
+    }
+
+    void u32(std::uint32_t const value) noexcept
+    {
+        boost::endian::store_little_u32(m_header.data() + m_pos, value);
+        m_pos += 4;
+    }
+
+    void bytes(std::span<unsigned char const> const data) noexcept
+    {
+        std::ranges::copy(data, m_header.begin() + m_pos);
+        m_pos += data.size();
+    }
+
+    void seek(std::size_t const pos) noexcept
+    {
+        BOOST_ASSERT(pos >= m_pos);
+        m_pos = pos;
+    }
+
+    [[nodiscard]]
+    auto pos() const noexcept -> std::size_t
+    {
+        return m_pos;
+    }
+
+private:
+    header_t& m_header;
+    std::size_t m_pos{};
+};
+
+// RIFF/WAVE header. The first JUNK chunk reserves the space for turning the
+// file into RF64 on close, if it exceeds 4 GiB. The second one pads the data
+// chunk to the data offset. More than two channels require the extensible
+// format.
+auto
+make_header(audio::sample_rate const sample_rate, std::size_t num_channels)
+    -> header_t
+{
+    header_t header{};
+    header_builder b{header};
+
+    auto const channels = static_cast<std::uint16_t>(num_channels);
+    auto const block_align =
+        static_cast<std::uint16_t>(num_channels * bytes_per_sample);
+    bool const extensible = num_channels > 2;
+
+    b.tag("RIFF");
+    b.u32(0);
+    b.tag("WAVE");
+
+    b.tag("JUNK");
+    b.u32(ds64_size);
+    b.seek(b.pos() + ds64_size);
+
+    b.tag("fmt ");
+    b.u32(extensible ? 40 : 16);
+    b.u16(extensible ? 0xfffe : 0x0001);
+    b.u16(channels);
+    b.u32(sample_rate.value());
+    b.u32(sample_rate.value() * block_align);
+    b.u16(block_align);
+    b.u16(8 * bytes_per_sample);
+
+    if (extensible)
+    {
+        b.u16(22);                   // extension size
+        b.u16(8 * bytes_per_sample); // valid bits per sample
+        b.u32(0);                    // channel mask, no speaker positions
+
+        // KSDATAFORMAT_SUBTYPE_PCM
+        b.u32(0x00000001);
+        b.u16(0x0000);
+        b.u16(0x0010);
+        b.bytes(std::array<unsigned char, 8>{
+            0x80,
+            0x00,
+            0x00,
+            0xaa,
+            0x00,
+            0x38,
+            0x9b,
+            0x71});
+    }
+
+    b.tag("JUNK");
+    b.u32(
+        static_cast<std::uint32_t>(wav_writer::data_offset - 8 - b.pos() - 4));
+
+    b.seek(wav_writer::data_offset - 8);
+    b.tag("data");
+    b.u32(0);
+
+    return header;
+}
+
+auto
+last_error() -> std::error_code
+{
+    return {errno, std::generic_category()};
+}
+
+auto
+pwrite_fully(
+    int const fd,
+    std::span<unsigned char const> data,
+    std::size_t offset) -> std::error_code
+{
+    while (!data.empty())
+    {
+        ssize_t const res = ::pwrite(
+            fd,
+            data.data(),
+            data.size(),
+            static_cast<off_t>(offset));
+
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return last_error();
+        }
+
+        data = data.subspan(static_cast<std::size_t>(res));
+        offset += static_cast<std::size_t>(res);
+    }
+
+    return {};
+}
+
+// Patches the sizes of a file up to 4 GiB.
+auto
+write_riff_sizes(int const fd, std::size_t const data_size) -> std::error_code
+{
+    std::array<unsigned char, 4> size_field{};
+
+    boost::endian::store_little_u32(
+        size_field.data(),
+        static_cast<std::uint32_t>(wav_writer::data_offset + data_size - 8));
+    if (auto const ec = pwrite_fully(fd, size_field, riff_size_offset))
+    {
+        return ec;
+    }
+
+    boost::endian::store_little_u32(
+        size_field.data(),
+        static_cast<std::uint32_t>(data_size));
+    return pwrite_fully(fd, size_field, data_size_offset);
+}
+
+// Turns the file into RF64, the 32 bit sizes are replaced by the ds64 chunk.
+auto
+write_rf64_sizes(
+    int const fd,
+    std::size_t const data_size,
+    std::size_t const num_frames) -> std::error_code
+{
+    std::array<unsigned char, 8> riff{};
+    std::memcpy(riff.data(), "RF64", 4);
+    boost::endian::store_little_u32(
+        riff.data() + 4,
+        std::numeric_limits<std::uint32_t>::max());
+
+    std::array<unsigned char, 8 + ds64_size> ds64{};
+    std::memcpy(ds64.data(), "ds64", 4);
+    boost::endian::store_little_u32(ds64.data() + 4, ds64_size);
+    boost::endian::store_little_u64(
+        ds64.data() + 8,
+        wav_writer::data_offset + data_size - 8);
+    boost::endian::store_little_u64(ds64.data() + 16, data_size);
+    boost::endian::store_little_u64(ds64.data() + 24, num_frames);
+    // no table entries
+
+    std::array<unsigned char, 4> data_size_field{};
+    boost::endian::store_little_u32(
+        data_size_field.data(),
+        std::numeric_limits<std::uint32_t>::max());
+
+    if (auto const ec = pwrite_fully(fd, ds64, ds64_offset))
+    {
+        return ec;
+    }
+
+    if (auto const ec = pwrite_fully(fd, data_size_field, data_size_offset))
+    {
+        return ec;
+    }
+
+    // the RF64 id goes last, so an interrupted patch leaves a RIFF file
+    return pwrite_fully(fd, riff, 0);
+}
+
+auto
+write_sizes(
+    int const fd,
+    std::size_t const data_size,
+    std::size_t const num_frames) -> std::error_code
+{
+    return wav_writer::data_offset + data_size - 8 >
+                   std::numeric_limits<std::uint32_t>::max()
+               ? write_rf64_sizes(fd, data_size, num_frames)
+               : write_riff_sizes(fd, data_size);
+}
+
+auto
+has_tag(
+    header_t const& header,
+    std::size_t const offset,
+    char const* const tag) noexcept -> bool
+{
+    return std::memcmp(header.data() + offset, tag, 4) == 0;
+}
+
+auto
+repair_file(int const fd) -> std::error_code
+{
+    header_t header{};
+    if (::pread(fd, header.data(), header.size(), 0) !=
+        static_cast<ssize_t>(header.size()))
+    {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+
+    std::size_t const num_channels =
+        boost::endian::load_little_u16(header.data() + num_channels_offset);
+
+    if (!(has_tag(header, 0, "RIFF") || has_tag(header, 0, "RF64")) ||
+        !has_tag(header, 8, "WAVE") || !has_tag(header, fmt_offset, "fmt ") ||
+        !has_tag(header, wav_writer::data_offset - 8, "data") ||
+        num_channels == 0 ||
+        boost::endian::load_little_u16(
+            header.data() + bits_per_sample_offset) != 8 * bytes_per_sample)
+    {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0)
+    {
+        return last_error();
+    }
+
+    std::size_t const frame_size = num_channels * bytes_per_sample;
+    std::size_t const num_frames =
+        (static_cast<std::size_t>(st.st_size) - wav_writer::data_offset) /
+        frame_size;
+    std::size_t const data_size = num_frames * frame_size;
+
+    std::size_t const file_size = wav_writer::data_offset + data_size;
+    if (static_cast<std::size_t>(st.st_size) != file_size &&
+        ::ftruncate(fd, static_cast<off_t>(file_size)) != 0)
+    {
+        return last_error();
+    }
+
+    if (auto const ec = write_sizes(fd, data_size, num_frames))
+    {
+        return ec;
+    }
+
+    if (::fdatasync(fd) != 0)
+    {
+        return last_error();
+    }
+
+    return {};
+}
+
+} // namespace
+
+wav_writer::wav_writer(
+    std::filesystem::path const& file,
+    audio::sample_rate const sample_rate,
+    std::size_t const num_channels)
+    : m_fd{::open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)}
+    , m_sample_rate{sample_rate}
+    , m_num_channels{num_channels}
+{
+    BOOST_ASSERT(num_channels > 0);
+
+    if (m_fd == invalid)
+    {
+        throw std::system_error(last_error());
+    }
+
+    auto const header = make_header(sample_rate, num_channels);
+    if (auto const ec = pwrite_fully(m_fd, header, 0))
+    {
+        ::close(m_fd);
+        throw std::system_error(ec);
+    }
+}
+
+wav_writer::wav_writer(wav_writer&& other) noexcept
+    : m_fd{std::exchange(other.m_fd, invalid)}
+    , m_sample_rate{other.m_sample_rate}
+    , m_num_channels{other.m_num_channels}
+    , m_num_frames{other.m_num_frames}
+    , m_allocated_size{other.m_allocated_size}
+    , m_preallocate{other.m_preallocate}
+    , m_pcm{std::move(other.m_pcm)}
+{
+}
+
+wav_writer::~wav_writer()
+{
+    close();
+}
+
+auto
+wav_writer::operator=(wav_writer&& other) noexcept -> wav_writer&
+{
+    if (this != &other)
+    {
+        close();
+
+        m_fd = std::exchange(other.m_fd, invalid);
+        m_sample_rate = other.m_sample_rate;
+        m_num_channels = other.m_num_channels;
+        m_num_frames = other.m_num_frames;
+        m_allocated_size = other.m_allocated_size;
+        m_preallocate = other.m_preallocate;
+        m_pcm = std::move(other.m_pcm);
+    }
+
+    return *this;
+}
+
+auto
+wav_writer::write(std::span<float const> const interleaved) -> std::error_code
+{
+    m_pcm.resize(interleaved.size());
+    std::ranges::transform(
+        interleaved,
+        m_pcm.begin(),
+        &audio::pcm_convert::to<audio::pcm_format::s24_3le>);
+
+    return write_pcm(m_pcm);
+}
+
+auto
+wav_writer::write_pcm(std::span<numeric::int24_io_t const> const interleaved)
+    -> std::error_code
+{
+    BOOST_ASSERT(m_fd != invalid);
+    BOOST_ASSERT(interleaved.size() % m_num_channels == 0);
+
+    std::size_t const offset =
+        data_offset + m_num_frames * m_num_channels * bytes_per_sample;
+    std::size_t const size = interleaved.size() * bytes_per_sample;
+
+    if (m_preallocate && offset + size > m_allocated_size)
+    {
+        std::size_t const allocate_size =
+            std::max(offset + size - m_allocated_size, preallocation_size);
+
+        if (::fallocate(
+                m_fd,
+                FALLOC_FL_KEEP_SIZE,
+                static_cast<off_t>(m_allocated_size),
+                static_cast<off_t>(allocate_size)) == 0)
+        {
+            m_allocated_size += allocate_size;
+        }
+        else if (errno == EOPNOTSUPP)
+        {
+            // not supported by the file system, just write
+            m_preallocate = false;
+        }
+        else
+        {
+            return last_error();
+        }
+    }
+
+    if (auto const ec = pwrite_fully(
+            m_fd,
+            {reinterpret_cast<unsigned char const*>(interleaved.data()),
+             size},
+            offset))
+    {
+        return ec;
+    }
+
+    m_num_frames += interleaved.size() / m_num_channels;
+
+    return {};
+}
+
+auto
+wav_writer::commit() -> std::error_code
+{
+    BOOST_ASSERT(m_fd != invalid);
+
+    if (auto const ec = write_sizes(
+            m_fd,
+            m_num_frames * m_num_channels * bytes_per_sample,
+            m_num_frames))
+    {
+        return ec;
+    }
+
+    // the header and the data are synced at once
+    if (::fdatasync(m_fd) != 0)
+    {
+        return last_error();
+    }
+
+    return {};
+}
+
+auto
+wav_writer::close() -> std::error_code
+{
+    if (m_fd == invalid)
+    {
+        return {};
+    }
+
+    std::size_t const data_size =
+        m_num_frames * m_num_channels * bytes_per_sample;
+    std::size_t const file_size = data_offset + data_size;
+
+    std::error_code ec = write_sizes(m_fd, data_size, m_num_frames);
+
+    // release the preallocated space behind the data
+    if (::ftruncate(m_fd, static_cast<off_t>(file_size)) != 0 && !ec)
+    {
+        ec = last_error();
+    }
+
+    if (::close(std::exchange(m_fd, invalid)) != 0 && !ec)
+    {
+        ec = last_error();
+    }
+
+    return ec;
+}
+
+auto
+wav_writer::repair(std::filesystem::path const& file) -> std::error_code
+{
+    int const fd = ::open(file.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd == invalid)
+    {
+        return last_error();
+    }
+
+    std::error_code ec = repair_file(fd);
+
+    if (::close(fd) != 0 && !ec)
+    {
+        ec = last_error();
+    }
+
+    return ec;
+}
+
+} // namespace piejam::runtime::recorder
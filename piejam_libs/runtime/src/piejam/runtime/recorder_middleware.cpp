@@ -8,40 +8,426 @@
 #include <piejam/runtime/actions/recorder_action.h>
 #include <piejam/runtime/actions/recording.h>
 #include <piejam/runtime/middleware_functors.h>
+#include <piejam/runtime/recorder/disk_writer.h>
+#include <piejam/runtime/recorder/file_writer.h>
+#include <piejam/runtime/recorder/peak_file.h>
+#include <piejam/runtime/recorder/stem_splitter.h>
+#include <piejam/runtime/recorder/take_recovery.h>
+#include <piejam/runtime/recorder/track_merger.h>
+#include <piejam/runtime/recorder/wav_writer.h>
 #include <piejam/runtime/state.h>
 #include <piejam/runtime/ui/action.h>
 #include <piejam/runtime/ui/update_state_action.h>
 
+#include <piejam/algorithm/transform_to_vector.h>
+#include <piejam/audio/engine/capture.h>
 #include <piejam/audio/multichannel_buffer.h>
-#include <piejam/numeric/mipp_iterator.h>
 #include <piejam/system/file_utils.h>
-
-#include <sndfile.hh>
+#include <piejam/thread/configuration.h>
+#include <piejam/thread/worker.h>
 
 #include <spdlog/spdlog.h>
 
 #include <boost/assert.hpp>
 #include <boost/container/flat_map.hpp>
-#include <boost/range/algorithm_ext/push_back.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <format>
-#include <ranges>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <vector>
 
 namespace piejam::runtime
 {
 
+namespace
+{
+
+// Covers long stalls of the disk, e.g. while an SD card is erasing blocks.
+constexpr std::chrono::seconds disk_buffer_duration{10};
+
+// Tracks of a multitrack file, which lag behind longer, are padded with
+// silence.
+constexpr std::chrono::seconds max_track_skew{1};
+
+auto
+background_thread(
+    std::span<unsigned const> const background_cpus,
+    std::string name) -> thread::configuration
+{
+    return thread::configuration{
+        .affinity = background_cpus.empty()
+                        ? std::nullopt
+                        : std::optional{background_cpus.front()},
+        .realtime_priority = std::nullopt,
+        .name = std::move(name)};
+}
+
+void
+split_multitrack_file(
+    std::filesystem::path const& multitrack_file,
+    std::vector<recorder::stem> const& stems)
+{
+    if (auto const ec = recorder::split_stems(
+            multitrack_file,
+            stems,
+            multitrack_file.parent_path()))
+    {
+        spdlog::error("Could not split recording into stems: {}", ec.message());
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(recorder::stems_file_path(multitrack_file), ec);
+    std::filesystem::remove(multitrack_file, ec);
+    std::filesystem::remove(recorder::peak_file_path(multitrack_file), ec);
+}
+
+// Wave files are written by a single thread, writing is bound by the disk.
+// Encoding FLAC is bound by the cpu, the tracks are spread over encoder
+// threads on the background cpus.
+auto
+disk_writer_threads(
+    recording_format const format,
+    std::size_t const num_tracks,
+    std::span<unsigned const> const background_cpus)
+    -> std::vector<thread::configuration>
+{
+    switch (format)
+    {
+        case recording_format::wav:
+            return {thread::configuration{
+                .affinity = std::nullopt,
+                .realtime_priority = std::nullopt,
+                .name = "disk_writer"}};
+
+        case recording_format::flac:
+        {
+            std::size_t const num_threads = std::max<std::size_t>(
+                std::min(num_tracks, background_cpus.size()),
+                1);
+
+            std::vector<thread::configuration> result;
+            result.reserve(num_threads);
+
+            for (std::size_t i = 0; i < num_threads; ++i)
+            {
+                result.push_back(thread::configuration{
+                    .affinity = background_cpus.empty()
+                                    ? std::nullopt
+                                    : std::optional{background_cpus[i]},
+                    .realtime_priority = std::nullopt,
+                    .name = std::format("rec_encoder_{}", i)});
+            }
+
+            return result;
+        }
+    }
+
+    BOOST_ASSERT(false);
+    return {};
+}
+
+} // namespace
+
 struct recorder_middleware::impl
 {
-    using open_streams_t =
-        boost::container::flat_map<audio_stream_id, SndfileHandle>;
+    using track_indices_t =
+        boost::container::flat_map<mixer::channel_id, std::size_t>;
 
     std::filesystem::path recordings_dir;
-    open_streams_t open_streams{};
+    std::vector<unsigned> background_cpus;
+    track_indices_t track_indices{};
+    std::unique_ptr<recorder::disk_writer> disk_writer{};
+    std::size_t reported_dropped_frames{};
+    std::size_t reported_gap_frames{};
+
+    // single file recording
+    std::optional<recorder::track_merger> track_merger{};
+    std::filesystem::path multitrack_file{};
+    std::vector<recorder::stem> stems{};
+
+    // closing of takes, stem splitting and recovery of interrupted takes
+    thread::worker worker{background_thread(background_cpus, "recorder")};
+
+    [[nodiscard]]
+    auto take_marker_file() const -> std::filesystem::path
+    {
+        return recordings_dir / ".recording";
+    }
+
+    auto start_file_per_track(
+        state const& st,
+        std::filesystem::path const& take_dir,
+        std::uint64_t const start_frame) -> bool
+    {
+        track_indices_t new_track_indices;
+        recorder::disk_writer::files_t files;
+
+        for (auto const& [mixer_channel_id, mixer_channel] :
+             st.mixer_state.channels)
+        {
+            if (!st.params.at(mixer_channel.record()).get())
+            {
+                continue;
+            }
+
+            auto filename = system::make_unique_filename(
+                take_dir,
+                *st.strings.at(mixer_channel.name),
+                recorder::file_extension(st.rec_format));
+
+            try
+            {
+                files.push_back(recorder::with_peak_file(
+                    recorder::make_file_writer(
+                        st.rec_format,
+                        filename,
+                        st.sample_rate,
+                        audio::num_channels(to_bus_type(mixer_channel.type))),
+                    filename,
+                    st.sample_rate));
+                new_track_indices.emplace(mixer_channel_id, files.size() - 1);
+            }
+            catch (std::system_error const& err)
+            {
+                spdlog::error(
+                    "Could not create file for recording: {}",
+                    err.what());
+            }
+        }
+
+        if (files.empty())
+        {
+            return false;
+        }
+
+        auto const threads =
+            disk_writer_threads(st.rec_format, files.size(), background_cpus);
+
+        track_indices = std::move(new_track_indices);
+        reported_dropped_frames = 0;
+        reported_gap_frames = 0;
+        disk_writer = std::make_unique<recorder::disk_writer>(
+            std::move(files),
+            start_frame,
+            st.sample_rate.samples_for_duration(disk_buffer_duration),
+            threads);
+
+        return true;
+    }
+
+    // The stems are always split into wave files, the samples are copied
+    // without conversion.
+    auto start_single_file(
+        state const& st,
+        std::filesystem::path const& take_dir,
+        std::uint64_t const start_frame) -> bool
+    {
+        track_indices_t new_track_indices;
+        std::vector<recorder::stem> new_stems;
+
+        for (auto const& [mixer_channel_id, mixer_channel] :
+             st.mixer_state.channels)
+        {
+            if (st.params.at(mixer_channel.record()).get())
+            {
+                new_stems.push_back(recorder::stem{
+                    .name = *st.strings.at(mixer_channel.name),
+                    .num_channels =
+                        audio::num_channels(to_bus_type(mixer_channel.type))});
+                new_track_indices.emplace(
+                    mixer_channel_id,
+                    new_stems.size() - 1);
+            }
+        }
+
+        if (new_stems.empty())
+        {
+            return false;
+        }
+
+        auto const num_channels = algorithm::transform_to_vector(
+            new_stems,
+            [](recorder::stem const& s) { return s.num_channels; });
+
+        auto file = take_dir / "multitrack.wav";
+
+        recorder::disk_writer::files_t files;
+        try
+        {
+            files.push_back(recorder::with_peak_file(
+                std::make_unique<recorder::wav_writer>(
+                    file,
+                    st.sample_rate,
+                    std::accumulate(
+                        num_channels.begin(),
+                        num_channels.end(),
+                        std::size_t{})),
+                file,
+                st.sample_rate));
+        }
+        catch (std::system_error const& err)
+        {
+            spdlog::error(
+                "Could not create file for recording: {}",
+                err.what());
+            return false;
+        }
+
+        // Without the stems, the split can't be resumed after a shutdown.
+        if (auto const ec = recorder::save_stems(file, new_stems))
+        {
+            spdlog::warn("Could not save stems of recording: {}", ec.message());
+        }
+
+        track_indices = std::move(new_track_indices);
+        reported_dropped_frames = 0;
+        reported_gap_frames = 0;
+        track_merger.emplace(
+            num_channels,
+            start_frame,
+            st.sample_rate.samples_for_duration(max_track_skew));
+        multitrack_file = std::move(file);
+        stems = std::move(new_stems);
+        disk_writer = std::make_unique<recorder::disk_writer>(
+            std::move(files),
+            start_frame,
+            st.sample_rate.samples_for_duration(disk_buffer_duration),
+            disk_writer_threads(recording_format::wav, 1, background_cpus));
+
+        return true;
+    }
+
+    void push(
+        mixer::channel_id const channel_id,
+        audio::engine::captured_frames const& captured)
+    {
+        auto it = track_indices.find(channel_id);
+        if (it == track_indices.end())
+        {
+            return;
+        }
+
+        if (track_merger)
+        {
+            track_merger->push(
+                it->second,
+                captured.frame,
+                captured.data.view());
+        }
+        else
+        {
+            disk_writer->push(it->second, captured.frame, captured.data.view());
+        }
+    }
+
+    [[nodiscard]]
+    auto gap_frames() const noexcept -> std::size_t
+    {
+        return disk_writer->gap_frames() +
+               (track_merger ? track_merger->gap_frames() : 0);
+    }
+
+    // Closing drains the rings and syncs the files, which may take a while.
+    // It is done on the worker, in order with marking the takes.
+    void stop()
+    {
+        if (!disk_writer)
+        {
+            return;
+        }
+
+        std::size_t merged_gap_frames{};
+
+        if (track_merger)
+        {
+            std::uint64_t const frame = track_merger->next_frame();
+            disk_writer->push(0, frame, track_merger->flush());
+            merged_gap_frames = track_merger->gap_frames();
+            track_merger.reset();
+        }
+
+        track_indices.clear();
+
+        worker.post(
+            [writer = std::shared_ptr{std::move(disk_writer)},
+             marker_file = take_marker_file(),
+             merged_gap_frames,
+             file = std::exchange(multitrack_file, {}),
+             stems = std::exchange(stems, {})]() {
+                writer->close();
+
+                recorder::mark_take_finished(marker_file);
+
+                if (std::size_t const dropped_frames =
+                        writer->dropped_frames();
+                    dropped_frames > 0)
+                {
+                    spdlog::warn(
+                        "Recording dropped {} frames in total",
+                        dropped_frames);
+                }
+
+                if (std::size_t const gap_frames =
+                        writer->gap_frames() + merged_gap_frames;
+                    gap_frames > 0)
+                {
+                    spdlog::warn(
+                        "Recording has gaps of {} frames in total, filled "
+                        "with silence",
+                        gap_frames);
+                }
+
+                if (!stems.empty())
+                {
+                    split_multitrack_file(file, stems);
+                }
+            });
+    }
 };
 
-recorder_middleware::recorder_middleware(std::filesystem::path recordings_dir)
-    : m_impl(make_pimpl<impl>(std::move(recordings_dir)))
+recorder_middleware::recorder_middleware(
+    std::filesystem::path recordings_dir,
+    std::vector<unsigned> background_cpus)
+    : m_impl(make_pimpl<impl>(
+          std::move(recordings_dir),
+          std::move(background_cpus)))
 {
+    if (auto take_dir =
+            recorder::pop_interrupted_take(m_impl->take_marker_file()))
+    {
+        spdlog::warn("Recovering interrupted take {}", take_dir->string());
+        m_impl->worker.post([take_dir = std::move(*take_dir)]() {
+            recorder::repair_take(take_dir);
+        });
+    }
+
+    // Splits, which were still pending at shutdown, are resumed. They are
+    // looked up right away, before a new take can leave its stems around.
+    for (auto& multitrack_file :
+         recorder::find_pending_splits(m_impl->recordings_dir))
+    {
+        auto stems = recorder::load_stems(multitrack_file);
+        if (!stems)
+        {
+            spdlog::error(
+                "Could not load stems of recording {}",
+                multitrack_file.string());
+            continue;
+        }
+
+        spdlog::info("Resuming split of {}", multitrack_file.string());
+        m_impl->worker.post([file = std::move(multitrack_file),
+                             stems = std::move(*stems)]() {
+            split_multitrack_file(file, stems);
+        });
+    }
 }
 
 void
@@ -67,7 +453,7 @@ template <>
 void
 recorder_middleware::process_recorder_action(
     middleware_functors const& mw_fs,
-    actions::start_recording const&)
+    actions::start_recording const& a)
 {
     auto const& st = mw_fs.get_state();
 
@@ -85,64 +471,20 @@ recorder_middleware::process_recorder_action(
         return;
     }
 
-    impl::open_streams_t open_streams;
-
-    for (auto const& [mixer_channel_id, mixer_channel] :
-         st.mixer_state.channels)
-    {
-        if (!st.params.at(mixer_channel.record()).get())
-        {
-            continue;
-        }
-
-        auto filename = system::make_unique_filename(
-            take_dir,
-            *st.strings.at(mixer_channel.name),
-            "wav");
-
-        auto const format = SF_FORMAT_WAV | SF_FORMAT_PCM_24;
-        std::size_t const num_channels =
-            audio::num_channels(to_bus_type(mixer_channel.type));
-        if (SndfileHandle::formatCheck(
-                format,
-                static_cast<int>(num_channels),
-                st.sample_rate.as<int>()))
-        {
-            SndfileHandle sndfile(
-                filename.string(),
-                SFM_WRITE,
-                format,
-                static_cast<int>(num_channels),
-                st.sample_rate.as<int>());
-
-            if (sndfile)
-            {
-                open_streams.emplace(
-                    mixer_channel.out_stream,
-                    std::move(sndfile));
-            }
-            else
-            {
-                auto const* const message = sndfile.strError();
-                spdlog::error(
-                    "Could not create file for recording: {}",
-                    message);
-            }
-        }
-        else
-        {
-            spdlog::error(
-                "Could not create file for recording: Invalid file "
-                "format.");
-        }
-    }
-
-    if (open_streams.empty())
+    bool const started =
+        st.rec_layout == recording_layout::single_file
+            ? m_impl->start_single_file(st, take_dir, a.start_frame)
+            : m_impl->start_file_per_track(st, take_dir, a.start_frame);
+    if (!started)
     {
         return;
     }
 
-    m_impl->open_streams = std::move(open_streams);
+    // after the previous take is finished on the worker
+    m_impl->worker.post(
+        [marker_file = m_impl->take_marker_file(), take_dir]() {
+            recorder::mark_take_started(marker_file, take_dir);
+        });
 
     mw_fs.next(update_state_action{[](state& st) { st.recording = true; }});
 }
@@ -155,7 +497,7 @@ recorder_middleware::process_recorder_action(
 {
     BOOST_ASSERT(mw_fs.get_state().recording);
 
-    m_impl->open_streams.clear();
+    m_impl->stop();
 
     mw_fs.next(update_state_action{[](state& new_st) {
         new_st.recording = false;
@@ -169,50 +511,39 @@ recorder_middleware::process_recorder_action(
     middleware_functors const& mw_fs,
     actions::audio_engine_sync_update const& a)
 {
-    for (auto const& [stream_id, buffer] : a.streams)
+    if (m_impl->disk_writer)
     {
-        if (auto it = m_impl->open_streams.find(stream_id);
-            it != m_impl->open_streams.end())
+        for (auto const& [channel_id, captures] : a.captures)
         {
-            auto const num_frames = buffer->num_frames();
-            BOOST_ASSERT(
-                buffer->layout() ==
-                audio::multichannel_layout::non_interleaved);
-            BOOST_ASSERT(
-                buffer->num_channels() == 1 || buffer->num_channels() == 2);
-
-            auto write_data = buffer->samples();
-
-            audio::multichannel_buffer<float>::vector interleaved;
-            if (buffer->num_channels() == 2)
+            for (auto const& captured : captures)
             {
-                auto stereo_view =
-                    buffer->view()
-                        .cast<audio::multichannel_layout_non_interleaved, 2>();
-                interleaved.resize(stereo_view.samples().size());
-
-                std::ranges::transform(
-                    numeric::mipp_range(stereo_view.channels()[0]),
-                    numeric::mipp_range(stereo_view.channels()[1]),
-                    numeric::make_mipp_iterator_x2(interleaved.data()),
-                    [](auto reg_l, auto reg_r) {
-                        return mipp::interleave(reg_l, reg_r);
-                    });
-
-                write_data = interleaved;
+                m_impl->push(channel_id, captured);
             }
+        }
 
-            auto const written =
-                it->second.writef(write_data.data(), num_frames);
-            if (static_cast<std::size_t>(written) < num_frames)
-            {
-                auto const frames_not_written = num_frames - written;
-                auto const* const message = it->second.strError();
-                spdlog::warn(
-                    "Could not write {} frames: {}",
-                    frames_not_written,
-                    message);
-            }
+        if (m_impl->track_merger)
+        {
+            std::uint64_t const frame = m_impl->track_merger->next_frame();
+            m_impl->disk_writer->push(0, frame, m_impl->track_merger->pull());
+        }
+
+        if (std::size_t const dropped_frames =
+                m_impl->disk_writer->dropped_frames();
+            dropped_frames > m_impl->reported_dropped_frames)
+        {
+            spdlog::warn(
+                "Recording dropped {} frames",
+                dropped_frames - m_impl->reported_dropped_frames);
+            m_impl->reported_dropped_frames = dropped_frames;
+        }
+
+        if (std::size_t const gap_frames = m_impl->gap_frames();
+            gap_frames > m_impl->reported_gap_frames)
+        {
+            spdlog::warn(
+                "Recording has a gap of {} frames, filled with silence",
+                gap_frames - m_impl->reported_gap_frames);
+            m_impl->reported_gap_frames = gap_frames;
         }
     }
 
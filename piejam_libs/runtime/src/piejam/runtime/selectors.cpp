@@ -1050,6 +1050,14 @@ selector<bool> const select_recording([](state const& st) {
     return st.recording;
 });
 
+selector<recording_format> const select_recording_format([](state const& st) {
+    return st.rec_format;
+});
+
+selector<recording_layout> const select_recording_layout([](state const& st) {
+    return st.rec_layout;
+});
+
 selector<std::size_t> const select_xruns([](state const& st) {
     return st.xruns;
 });
@@ -234,6 +234,7 @@ insert_ladspa_fx_module(
     ladspa::instance_id const instance_id,
     ladspa::plugin_descriptor const& plugin_desc,
     std::span<ladspa::port_descriptor const> const control_inputs,
+    audio::engine::event_quantization const event_quantization,
     std::span<parameter_value_assignment const> initial_values,
     std::span<parameter_midi_assignment const> midi_assigns) -> fx::module_id
 {
@@ -245,6 +246,9 @@ insert_ladspa_fx_module(
             control_inputs,
             st.params));
     st.fx_state.ladspa_instances.emplace(instance_id, plugin_desc);
+    st.fx_state.ladspa_event_quantizations.emplace(
+        instance_id,
+        event_quantization);
 
     insert_fx_module(
         st,
@@ -324,6 +328,8 @@ remove_fx_module(
     if (auto id = std::get_if<ladspa::instance_id>(&fx_mod.fx_instance_id))
     {
         st.fx_state.ladspa_instances.erase(*id);
+        st.fx_state.ladspa_event_quantizations.erase(*id);
+        st.fx_state.pipelined_ladspa_instances.lock()->erase(*id);
     }
     else if (
         auto id =
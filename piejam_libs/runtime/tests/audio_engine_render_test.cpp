@@ -5,7 +5,9 @@
 #include <piejam/audio/types.h>
 #include <piejam/midi/input_event_handler.h>
 #include <piejam/runtime/audio_engine.h>
+#include <piejam/runtime/external_audio.h>
 #include <piejam/runtime/fwd.h>
+#include <piejam/runtime/mixer.h>
 #include <piejam/runtime/state.h>
 
 #include <gtest/gtest.h>
@@ -31,7 +33,7 @@ struct audio_engine_render_test : public ::testing::Test
     std::vector<float> audio_in_right{std::vector<float>(buffer_size)};
     std::vector<float> audio_out_left{std::vector<float>(buffer_size)};
     std::vector<float> audio_out_right{std::vector<float>(buffer_size)};
-    audio_engine sut{{}, sample_rate, 2, 2};
+    audio_engine sut{{}, sample_rate, 2, 2, std::nullopt};
 
     std::size_t sine_wave_pos{};
     std::vector<audio::pair<float>> output;
@@ -131,4 +133,102 @@ TEST_F(audio_engine_render_test, add_input_channel)
     dump_output("add_input_channel.txt");
 }
 
+TEST_F(audio_engine_render_test, mono_channel_is_captured_in_mono)
+{
+    auto st = make_initial_state();
+
+    auto const mono_id =
+        add_mixer_channel(st, mixer::channel_type::mono, "mono");
+    auto const stereo_id =
+        add_mixer_channel(st, mixer::channel_type::stereo, "stereo");
+
+    rebuild(st);
+
+    audio::engine::capture_window const window{
+        .start = sut.current_frame(),
+        .stop = audio::engine::capture_window::open_end};
+    sut.arm_capture(mono_id, window);
+    sut.arm_capture(stereo_id, window);
+
+    render(4);
+
+    auto const mono = sut.get_capture(mono_id);
+    ASSERT_FALSE(mono.empty());
+    EXPECT_TRUE(std::ranges::all_of(mono, [](auto const& captured) {
+        return captured.data.num_channels() == 1;
+    }));
+
+    auto const stereo = sut.get_capture(stereo_id);
+    ASSERT_FALSE(stereo.empty());
+    EXPECT_TRUE(std::ranges::all_of(stereo, [](auto const& captured) {
+        return captured.data.num_channels() == 2;
+    }));
+}
+
+TEST_F(audio_engine_render_test, channels_are_captured_before_the_fader)
+{
+    auto st = make_initial_state();
+    st.selected_sound_card.num_channels = io_pair<unsigned>{2u, 2u};
+
+    auto const mono_in = add_external_audio_device(
+        st,
+        "Mono In",
+        io_direction::input,
+        audio::bus_type::mono);
+    st.external_audio_state.device_channels.assign(
+        {mono_in, audio::bus_channel::mono},
+        0);
+
+    auto const stereo_in = add_external_audio_device(
+        st,
+        "Stereo In",
+        io_direction::input,
+        audio::bus_type::stereo);
+    st.external_audio_state.device_channels.assign(
+        {stereo_in, audio::bus_channel::left},
+        0);
+    st.external_audio_state.device_channels.assign(
+        {stereo_in, audio::bus_channel::right},
+        1);
+
+    auto const mono_id =
+        add_mixer_channel(st, mixer::channel_type::mono, "mono");
+    auto const stereo_id =
+        add_mixer_channel(st, mixer::channel_type::stereo, "stereo");
+    st.mixer_state.io_map.assign(
+        mono_id,
+        io_pair<mixer::io_address_t>{mono_in, default_t{}});
+    st.mixer_state.io_map.assign(
+        stereo_id,
+        io_pair<mixer::io_address_t>{stereo_in, default_t{}});
+
+    rebuild(st);
+
+    sut.set_parameter_value(st.mixer_state.channels.at(mono_id).volume(), 0.f);
+    sut.set_parameter_value(
+        st.mixer_state.channels.at(stereo_id).volume(),
+        0.f);
+
+    render(4);
+
+    audio::engine::capture_window const window{
+        .start = sut.current_frame(),
+        .stop = audio::engine::capture_window::open_end};
+    sut.arm_capture(mono_id, window);
+    sut.arm_capture(stereo_id, window);
+
+    render(4);
+
+    auto has_signal = [](auto const& captures) {
+        return std::ranges::any_of(captures, [](auto const& captured) {
+            return std::ranges::any_of(
+                captured.data.view().samples(),
+                [](float const sample) { return sample != 0.f; });
+        });
+    };
+
+    EXPECT_TRUE(has_signal(sut.get_capture(mono_id)));
+    EXPECT_TRUE(has_signal(sut.get_capture(stereo_id)));
+}
+
 } // namespace piejam::runtime::test
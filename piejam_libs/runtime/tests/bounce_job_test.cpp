@@ -0,0 +1,167 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/bounce_job.h>
+
+#include <piejam/runtime/external_audio.h>
+#include <piejam/runtime/mixer.h>
+#include <piejam/runtime/recorder/wav_writer.h>
+#include <piejam/runtime/state.h>
+
+#include <gtest/gtest.h>
+
+#include <sndfile.hh>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace piejam::runtime::test
+{
+
+struct bounce_job_test : testing::Test
+{
+    std::filesystem::path take_dir{
+        std::filesystem::temp_directory_path() / "piejam_bounce_job_test"};
+    std::filesystem::path mix_file{take_dir / "mix.wav"};
+
+    state st{make_initial_state()};
+    mixer::channel_id guitar{};
+
+    static constexpr std::size_t num_take_frames{4800};
+
+    bounce_job_test()
+    {
+        std::filesystem::create_directories(take_dir);
+
+        st.sample_rate = audio::sample_rate{48000};
+        st.selected_sound_card.num_channels = io_pair<unsigned>{1u, 2u};
+
+        auto const in = add_external_audio_device(
+            st,
+            "In",
+            io_direction::input,
+            audio::bus_type::mono);
+        st.external_audio_state.device_channels.assign(
+            {in, audio::bus_channel::mono},
+            0);
+
+        auto const out = add_external_audio_device(
+            st,
+            "Out",
+            io_direction::output,
+            audio::bus_type::stereo);
+        st.external_audio_state.device_channels.assign(
+            {out, audio::bus_channel::left},
+            0);
+        st.external_audio_state.device_channels.assign(
+            {out, audio::bus_channel::right},
+            1);
+
+        guitar = add_mixer_channel(st, mixer::channel_type::mono, "Guitar");
+        st.mixer_state.io_map.assign(
+            guitar,
+            io_pair<mixer::io_address_t>{in, st.mixer_state.main});
+        st.mixer_state.io_map.assign(
+            st.mixer_state.main,
+            io_pair<mixer::io_address_t>{mixer::mix_input{}, out});
+    }
+
+    ~bounce_job_test() override
+    {
+        std::filesystem::remove_all(take_dir);
+    }
+
+    void write_take(std::string const& name, float const value)
+    {
+        recorder::wav_writer track{
+            take_dir / (name + ".wav"),
+            st.sample_rate,
+            1};
+        ASSERT_FALSE(track.write(std::vector<float>(num_take_frames, value)));
+    }
+
+    static auto wait_until_finished(bounce_job const& job)
+        -> bounce_job::progress
+    {
+        auto const deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds{10};
+
+        auto progress = job.get_progress();
+        while (!progress.finished &&
+               std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            progress = job.get_progress();
+        }
+
+        return progress;
+    }
+};
+
+TEST_F(bounce_job_test, take_without_tracks_is_rejected)
+{
+    EXPECT_THROW(
+        bounce_job(st, {}, take_dir, mix_file),
+        std::runtime_error);
+}
+
+TEST_F(bounce_job_test, track_is_rendered_through_main_into_the_mix)
+{
+    write_take("Guitar", 0.5f);
+
+    bounce_job job{st, {}, take_dir, mix_file};
+
+    auto const progress = wait_until_finished(job);
+    ASSERT_TRUE(progress.finished);
+    EXPECT_EQ(progress.rendered_frames, progress.num_frames);
+    EXPECT_GT(progress.num_frames, num_take_frames);
+    EXPECT_GT(progress.realtime_factor, 0.);
+
+    SndfileHandle mix{mix_file.c_str()};
+    ASSERT_EQ(mix.channels(), 2);
+    ASSERT_EQ(static_cast<std::size_t>(mix.frames()), progress.num_frames);
+
+    std::vector<float> frames(progress.num_frames * 2);
+    ASSERT_EQ(
+        mix.readf(frames.data(), mix.frames()),
+        static_cast<sf_count_t>(progress.num_frames));
+
+    // the center of the track, panned to the center
+    std::size_t const center = num_take_frames / 2;
+    EXPECT_GT(frames[2 * center], 0.f);
+    EXPECT_FLOAT_EQ(frames[2 * center], frames[2 * center + 1]);
+
+    // the tail is silent
+    EXPECT_FLOAT_EQ(frames[frames.size() - 2], 0.f);
+    EXPECT_FLOAT_EQ(frames[frames.size() - 1], 0.f);
+}
+
+TEST_F(bounce_job_test, volume_and_pan_of_the_session_are_applied)
+{
+    write_take("Guitar", 0.5f);
+
+    auto const& guitar_channel = st.mixer_state.channels.at(guitar);
+    st.params.at(guitar_channel.volume()).set(0.5f);
+    st.params.at(guitar_channel.pan_balance()).set(-1.f);
+
+    bounce_job job{st, {}, take_dir, mix_file};
+
+    auto const progress = wait_until_finished(job);
+    ASSERT_TRUE(progress.finished);
+
+    SndfileHandle mix{mix_file.c_str()};
+    std::vector<float> frames(progress.num_frames * 2);
+    ASSERT_EQ(
+        mix.readf(frames.data(), mix.frames()),
+        static_cast<sf_count_t>(progress.num_frames));
+
+    // hard left, at half the volume
+    std::size_t const center = num_take_frames / 2;
+    EXPECT_NEAR(frames[2 * center], 0.25f, 1e-3f);
+    EXPECT_NEAR(frames[2 * center + 1], 0.f, 1e-3f);
+}
+
+} // namespace piejam::runtime::test
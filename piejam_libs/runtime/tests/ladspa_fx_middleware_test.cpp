@@ -7,6 +7,7 @@
 
 #include <piejam/ladspa/port_descriptor.h>
 #include <piejam/runtime/actions/insert_fx_module.h>
+#include <piejam/runtime/actions/reload_missing_plugins.h>
 #include <piejam/runtime/ladspa_fx_middleware.h>
 #include <piejam/runtime/state.h>
 #include <piejam/runtime/ui/action.h>
@@ -14,6 +15,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <optional>
+
 namespace piejam::runtime::test
 {
 
@@ -131,6 +134,7 @@ TEST_F(
     auto instance_id = ladspa::instance_id::generate();
     EXPECT_CALL(lfx_ctrl_mock, load(plugin_desc)).WillOnce(Return(instance_id));
     EXPECT_CALL(lfx_ctrl_mock, control_inputs(instance_id));
+    EXPECT_CALL(lfx_ctrl_mock, measure_event_quantization(instance_id));
     EXPECT_CALL(
         mf_mock,
         next(
@@ -143,4 +147,101 @@ TEST_F(
     sut(make_middleware_functors(mf_mock), action);
 }
 
+TEST_F(
+    ladspa_fx_middleware_test,
+    inserted_ladspa_fx_uses_the_measured_event_quantization)
+{
+    using testing::Field;
+    using testing::Return;
+    using testing::ReturnRef;
+    using testing::WhenDynamicCastTo;
+
+    ladspa_fx_middleware sut(lfx_ctrl_mock);
+
+    ladspa::plugin_id_t const plug_id{23};
+
+    state st;
+    ladspa::plugin_descriptor plugin_desc{.id = plug_id};
+    st.fx_registry.entries = std::vector<fx::registry::item>{plugin_desc};
+    EXPECT_CALL(mf_mock, get_state()).WillRepeatedly(ReturnRef(st));
+
+    auto instance_id = ladspa::instance_id::generate();
+    EXPECT_CALL(lfx_ctrl_mock, load(plugin_desc)).WillOnce(Return(instance_id));
+    EXPECT_CALL(lfx_ctrl_mock, control_inputs(instance_id));
+    EXPECT_CALL(lfx_ctrl_mock, measure_event_quantization(instance_id))
+        .WillOnce(Return(audio::engine::control_rate_events));
+    EXPECT_CALL(
+        mf_mock,
+        next(
+            WhenDynamicCastTo<actions::insert_ladspa_fx_module const&>(Field(
+                &actions::insert_ladspa_fx_module::event_quantization,
+                audio::engine::control_rate_events))));
+
+    actions::load_ladspa_fx_plugin action;
+    action.plugin_id = plug_id;
+    sut(make_middleware_functors(mf_mock), action);
+}
+
+TEST_F(
+    ladspa_fx_middleware_test,
+    reloaded_ladspa_fx_keeps_the_stored_event_quantization)
+{
+    using testing::Return;
+    using testing::ReturnRef;
+    using testing::WhenDynamicCastTo;
+
+    ladspa_fx_middleware sut(lfx_ctrl_mock);
+
+    ladspa::plugin_id_t const plug_id{23};
+
+    state st;
+    auto const channel_id =
+        add_mixer_channel(st, mixer::channel_type::mono, "mono");
+    insert_missing_ladspa_fx_module(
+        st,
+        channel_id,
+        0,
+        fx::unavailable_ladspa{
+            .plugin_id = plug_id,
+            .parameter_values = {},
+            .midi_assignments = {},
+            .event_quantization = audio::engine::control_rate_events},
+        "fx");
+    ladspa::plugin_descriptor plugin_desc{
+        .id = plug_id,
+        .num_inputs = 1,
+        .num_outputs = 1};
+    st.fx_registry.entries = std::vector<fx::registry::item>{plugin_desc};
+    EXPECT_CALL(mf_mock, get_state()).WillRepeatedly(ReturnRef(st));
+
+    auto instance_id = ladspa::instance_id::generate();
+    EXPECT_CALL(lfx_ctrl_mock, load(plugin_desc)).WillOnce(Return(instance_id));
+    EXPECT_CALL(lfx_ctrl_mock, control_inputs(instance_id));
+    EXPECT_CALL(lfx_ctrl_mock, measure_event_quantization(instance_id))
+        .Times(0);
+
+    std::optional<audio::engine::event_quantization> event_quantization;
+    EXPECT_CALL(
+        mf_mock,
+        next(WhenDynamicCastTo<
+             actions::replace_missing_ladspa_fx_module const&>(testing::_)))
+        .WillOnce([&](action const& a) {
+            for (auto const& chain :
+                 dynamic_cast<actions::replace_missing_ladspa_fx_module const&>(
+                     a)
+                     .fx_chain_replacements)
+            {
+                for (auto const& replacement : chain.fx_mod_replacements)
+                {
+                    event_quantization =
+                        replacement.ladspa_fx_instance.event_quantization;
+                }
+            }
+        });
+
+    sut(make_middleware_functors(mf_mock), actions::reload_missing_plugins{});
+
+    EXPECT_EQ(event_quantization, audio::engine::control_rate_events);
+}
+
 } // namespace piejam::runtime::test
@@ -4,6 +4,7 @@
 
 #include <piejam/ladspa/instance_manager.h>
 
+#include <piejam/audio/engine/event_quantization.h>
 #include <piejam/entity_id.h>
 
 #include <gmock/gmock.h>
@@ -20,6 +21,11 @@ struct ladspa_instance_manager_mock : public ladspa::instance_manager
         control_inputs,
         (ladspa::instance_id const&),
         (const));
+    MOCK_METHOD(
+        audio::engine::event_quantization,
+        measure_event_quantization,
+        (ladspa::instance_id const&),
+        (const));
 };
 
 } // namespace piejam::runtime::test
@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <piejam/audio/engine/event_quantization.h>
 #include <piejam/audio/sample_rate.h>
 #include <piejam/ladspa/processor_factory.h>
 
@@ -15,7 +16,9 @@ struct ladspa_processor_factory_mock : public ladspa::processor_factory
     MOCK_METHOD(
         std::unique_ptr<audio::engine::processor>,
         make_processor,
-        (ladspa::instance_id const&, audio::sample_rate));
+        (ladspa::instance_id const&,
+         audio::sample_rate,
+         audio::engine::event_quantization));
 };
 
 } // namespace piejam::runtime::test
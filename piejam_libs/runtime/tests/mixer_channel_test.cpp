@@ -0,0 +1,74 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/components/mixer_channel.h>
+
+#include <piejam/audio/engine/component.h>
+#include <piejam/audio/engine/frame_clock.h>
+#include <piejam/audio/engine/graph.h>
+#include <piejam/audio/engine/graph_algorithms.h>
+#include <piejam/audio/engine/stream_processor.h>
+#include <piejam/audio/engine/weighted_sum_processor.h>
+#include <piejam/audio/sample_rate.h>
+#include <piejam/runtime/parameter_processor_factory.h>
+#include <piejam/runtime/processors/capture_tap_factory.h>
+#include <piejam/runtime/processors/stream_processor_factory.h>
+#include <piejam/runtime/state.h>
+
+#include <gtest/gtest.h>
+
+namespace piejam::runtime::components::test
+{
+
+TEST(mixer_channel_output, channels_mixed_into_a_bus_are_fused)
+{
+    state st;
+    auto const stereo_id =
+        add_mixer_channel(st, mixer::channel_type::stereo, "stereo");
+    auto const mono_id =
+        add_mixer_channel(st, mixer::channel_type::mono, "mono");
+
+    parameter_processor_factory param_procs;
+    processors::stream_processor_factory stream_procs;
+    audio::engine::frame_clock clock;
+    processors::capture_tap_factory capture_taps{clock};
+
+    auto make_output = [&](mixer::channel_id const id) {
+        return make_mixer_channel_output(
+            id,
+            st.mixer_state.channels.at(id),
+            "channel",
+            param_procs,
+            stream_procs,
+            capture_taps,
+            audio::sample_rate{48000});
+    };
+
+    auto const stereo = make_output(stereo_id);
+    auto const mono = make_output(mono_id);
+    auto const bus =
+        stream_procs.make_processor(audio_stream_id::generate(), 2, 1024);
+
+    audio::engine::graph g;
+    stereo->connect(g);
+    mono->connect(g);
+
+    // the post fader outputs of both channels feed the bus
+    for (std::size_t ch = 0; ch < 2; ++ch)
+    {
+        g.audio.insert(stereo->outputs()[ch], {*bus, ch});
+        g.audio.insert(mono->outputs()[ch], {*bus, ch});
+    }
+
+    auto const [result, mixers] = audio::engine::finalize_graph(g);
+
+    for (std::size_t ch = 0; ch < 2; ++ch)
+    {
+        auto const mixer = audio::engine::connected_source(result, {*bus, ch});
+        ASSERT_TRUE(mixer);
+        EXPECT_TRUE(audio::engine::is_weighted_sum_processor(mixer->proc));
+    }
+}
+
+} // namespace piejam::runtime::components::test
@@ -10,6 +10,8 @@
 
 #include <boost/hof/match.hpp>
 
+#include <vector>
+
 namespace piejam::runtime::processors::test
 {
 
@@ -145,6 +147,57 @@ TEST(
     });
 }
 
+TEST(parameter_processor_factory, for_each_changed_visits_only_changed)
+{
+    factory_t sut;
+    auto id = parameter::id_t<int_param_fake>::generate();
+    auto proc = sut.find_or_make_processor(id);
+    auto other_id = parameter::id_t<float_param_fake>::generate();
+    auto other_proc = sut.find_or_make_processor(other_id);
+
+    audio::engine::processor_test_environment test_env(*proc, 16);
+    test_env.insert_input_event<int>(0, 3, 9);
+
+    proc->process(test_env.ctx);
+
+    std::vector<factory_t::parameter_id> changed;
+    sut.for_each_changed(
+        [&](factory_t::parameter_id const& id) { changed.push_back(id); });
+
+    ASSERT_EQ(1u, changed.size());
+    EXPECT_EQ(factory_t::parameter_id{id}, changed.front());
+}
+
+TEST(parameter_processor_factory, for_each_changed_is_reset_after_visit)
+{
+    factory_t sut;
+    auto id = parameter::id_t<int_param_fake>::generate();
+    auto proc = sut.find_or_make_processor(id);
+
+    audio::engine::processor_test_environment test_env(*proc, 16);
+    test_env.insert_input_event<int>(0, 3, 9);
+
+    proc->process(test_env.ctx);
+
+    sut.for_each_changed([](factory_t::parameter_id const&) {});
+    sut.for_each_changed([](factory_t::parameter_id const&) { FAIL(); });
+}
+
+TEST(parameter_processor_factory, set_does_not_mark_changed)
+{
+    factory_t sut;
+    auto id = parameter::id_t<int_param_fake>::generate();
+    auto proc = sut.find_or_make_processor(id);
+
+    sut.set(id, 5);
+
+    audio::engine::processor_test_environment test_env(*proc, 16);
+
+    proc->process(test_env.ctx);
+
+    sut.for_each_changed([](factory_t::parameter_id const&) { FAIL(); });
+}
+
 TEST(parameter_processor_factory, clear_expired)
 {
     factory_t sut;
@@ -157,4 +210,20 @@ TEST(parameter_processor_factory, clear_expired)
     EXPECT_FALSE(proc.lock());
 }
 
+TEST(parameter_processor_factory, unchanged_value_does_not_mark_changed)
+{
+    factory_t sut;
+    auto id = parameter::id_t<int_param_fake>::generate();
+    auto proc = sut.find_or_make_processor(id);
+
+    sut.set(id, 9);
+
+    audio::engine::processor_test_environment test_env(*proc, 16);
+    test_env.insert_input_event<int>(0, 3, 9);
+
+    proc->process(test_env.ctx);
+
+    sut.for_each_changed([](factory_t::parameter_id const&) { FAIL(); });
+}
+
 } // namespace piejam::runtime::processors::test
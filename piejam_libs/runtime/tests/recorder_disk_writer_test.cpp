@@ -0,0 +1,292 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/disk_writer.h>
+
+#include <piejam/runtime/recorder/wav_writer.h>
+#include <piejam/thread/configuration.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace piejam::runtime::recorder::test
+{
+
+struct recorder_disk_writer_test : testing::Test
+{
+    static constexpr audio::sample_rate sr{48000};
+
+    std::filesystem::path mono_file{
+        std::filesystem::temp_directory_path() /
+        "piejam_recorder_disk_writer_test_mono.wav"};
+    std::filesystem::path stereo_file{
+        std::filesystem::temp_directory_path() /
+        "piejam_recorder_disk_writer_test_stereo.wav"};
+
+    ~recorder_disk_writer_test() override
+    {
+        std::filesystem::remove(mono_file);
+        std::filesystem::remove(stereo_file);
+    }
+
+    auto make_files() -> disk_writer::files_t
+    {
+        disk_writer::files_t files;
+        files.push_back(std::make_unique<wav_writer>(mono_file, sr, 1));
+        files.push_back(std::make_unique<wav_writer>(stereo_file, sr, 2));
+        return files;
+    }
+};
+
+TEST_F(recorder_disk_writer_test, all_pushed_frames_are_written_on_destruction)
+{
+    std::vector<float> mono(1000, 0.25f);
+    std::vector<float> stereo(2 * 1000, 0.5f);
+
+    {
+        disk_writer sut{make_files(), 0, 48000};
+        ASSERT_EQ(sut.num_tracks(), 2u);
+
+        for (std::uint64_t i = 0; i < 10; ++i)
+        {
+            EXPECT_TRUE(
+                sut.push(0, i * 1000, disk_writer::channels_view{mono, 1}));
+            EXPECT_TRUE(
+                sut.push(1, i * 1000, disk_writer::channels_view{stereo, 2}));
+        }
+
+        EXPECT_EQ(sut.dropped_frames(), 0u);
+        EXPECT_EQ(sut.gap_frames(), 0u);
+    }
+
+    EXPECT_EQ(
+        std::filesystem::file_size(mono_file),
+        wav_writer::data_offset + 10 * 1000 * 3);
+    EXPECT_EQ(
+        std::filesystem::file_size(stereo_file),
+        wav_writer::data_offset + 10 * 1000 * 2 * 3);
+}
+
+TEST_F(recorder_disk_writer_test, all_pushed_frames_are_written_on_close)
+{
+    std::vector<float> mono(1000, 0.25f);
+
+    disk_writer sut{make_files(), 0, 48000};
+
+    EXPECT_TRUE(sut.push(0, 300, disk_writer::channels_view{mono, 1}));
+
+    sut.close();
+
+    EXPECT_EQ(
+        std::filesystem::file_size(mono_file),
+        wav_writer::data_offset + 1300 * 3);
+    EXPECT_EQ(sut.gap_frames(), 300u);
+}
+
+TEST_F(recorder_disk_writer_test, tracks_are_written_by_multiple_threads)
+{
+    std::vector<float> mono(1000, 0.25f);
+    std::vector<float> stereo(2 * 1000, 0.5f);
+
+    std::vector<thread::configuration> const threads(3);
+
+    {
+        disk_writer sut{make_files(), 0, 48000, threads};
+
+        for (std::uint64_t i = 0; i < 10; ++i)
+        {
+            EXPECT_TRUE(
+                sut.push(0, i * 1000, disk_writer::channels_view{mono, 1}));
+            EXPECT_TRUE(
+                sut.push(1, i * 1000, disk_writer::channels_view{stereo, 2}));
+        }
+    }
+
+    EXPECT_EQ(
+        std::filesystem::file_size(mono_file),
+        wav_writer::data_offset + 10 * 1000 * 3);
+    EXPECT_EQ(
+        std::filesystem::file_size(stereo_file),
+        wav_writer::data_offset + 10 * 1000 * 2 * 3);
+}
+
+namespace
+{
+
+struct counting_file_writer final : file_writer
+{
+    explicit counting_file_writer(std::atomic_size_t& commits)
+        : commits{commits}
+    {
+    }
+
+    [[nodiscard]]
+    auto num_channels() const noexcept -> std::size_t override
+    {
+        return 1;
+    }
+
+    auto write(std::span<float const>) -> std::error_code override
+    {
+        return {};
+    }
+
+    auto commit() -> std::error_code override
+    {
+        ++commits;
+        return {};
+    }
+
+    auto close() -> std::error_code override
+    {
+        return {};
+    }
+
+    std::atomic_size_t& commits;
+};
+
+} // namespace
+
+TEST(recorder_disk_writer, written_files_are_committed_periodically)
+{
+    std::atomic_size_t commits{};
+
+    disk_writer::files_t files;
+    files.push_back(std::make_unique<counting_file_writer>(commits));
+
+    disk_writer sut{
+        std::move(files),
+        0,
+        48000,
+        {},
+        std::chrono::milliseconds{1}};
+
+    // nothing written, nothing to commit
+    std::this_thread::sleep_for(std::chrono::milliseconds{120});
+    EXPECT_EQ(commits, 0u);
+
+    std::vector<float> mono(8192);
+    ASSERT_TRUE(sut.push(0, 0, disk_writer::channels_view{mono, 1}));
+
+    for (int i = 0; i < 100 && commits == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    EXPECT_EQ(commits, 1u);
+}
+
+TEST_F(recorder_disk_writer_test, overflowing_push_is_dropped_and_counted)
+{
+    std::vector<float> mono(5000);
+
+    {
+        disk_writer sut{make_files(), 0, 4096};
+
+        EXPECT_FALSE(sut.push(0, 0, disk_writer::channels_view{mono, 1}));
+        EXPECT_EQ(sut.dropped_frames(), 5000u);
+    }
+
+    EXPECT_EQ(std::filesystem::file_size(mono_file), wav_writer::data_offset);
+}
+
+TEST_F(recorder_disk_writer_test, gap_is_filled_with_silence_and_counted)
+{
+    std::vector<float> mono(1000, 0.25f);
+
+    {
+        disk_writer sut{make_files(), 500, 48000};
+
+        EXPECT_TRUE(sut.push(0, 500, disk_writer::channels_view{mono, 1}));
+        EXPECT_TRUE(sut.push(0, 1700, disk_writer::channels_view{mono, 1}));
+
+        EXPECT_EQ(sut.gap_frames(), 200u);
+        EXPECT_EQ(sut.dropped_frames(), 0u);
+    }
+
+    EXPECT_EQ(
+        std::filesystem::file_size(mono_file),
+        wav_writer::data_offset + 2200 * 3);
+}
+
+TEST_F(recorder_disk_writer_test, late_start_is_a_gap)
+{
+    std::vector<float> mono(1000, 0.25f);
+
+    {
+        disk_writer sut{make_files(), 0, 48000};
+
+        EXPECT_TRUE(sut.push(0, 300, disk_writer::channels_view{mono, 1}));
+        EXPECT_EQ(sut.gap_frames(), 300u);
+    }
+
+    EXPECT_EQ(
+        std::filesystem::file_size(mono_file),
+        wav_writer::data_offset + 1300 * 3);
+}
+
+TEST_F(recorder_disk_writer_test, dropped_frames_are_padded_on_next_push)
+{
+    std::vector<float> mono(3000);
+    std::vector<float> small(100);
+
+    {
+        // the disk thread writes whole chunks only, nothing is drained until
+        // destruction
+        disk_writer sut{make_files(), 0, 4096};
+
+        EXPECT_TRUE(sut.push(0, 0, disk_writer::channels_view{mono, 1}));
+        EXPECT_FALSE(sut.push(0, 3000, disk_writer::channels_view{mono, 1}));
+        EXPECT_EQ(sut.dropped_frames(), 3000u);
+        EXPECT_EQ(sut.gap_frames(), 0u);
+
+        // the dropped frames are padded as far as there is space, but not
+        // counted again
+        EXPECT_FALSE(sut.push(0, 6000, disk_writer::channels_view{small, 1}));
+        EXPECT_EQ(sut.dropped_frames(), 3100u);
+        EXPECT_EQ(sut.gap_frames(), 0u);
+    }
+
+    EXPECT_EQ(
+        std::filesystem::file_size(mono_file),
+        wav_writer::data_offset + 4096 * 3);
+}
+
+TEST_F(recorder_disk_writer_test, gap_after_dropped_frames_is_counted_once)
+{
+    std::vector<float> mono(3000);
+    std::vector<float> small(100);
+
+    {
+        disk_writer sut{make_files(), 0, 8192};
+
+        EXPECT_TRUE(sut.push(0, 0, disk_writer::channels_view{mono, 1}));
+        EXPECT_TRUE(sut.push(0, 3000, disk_writer::channels_view{mono, 1}));
+        EXPECT_FALSE(sut.push(0, 6000, disk_writer::channels_view{mono, 1}));
+
+        // make room for the padding, by waiting for a chunk to be written
+        for (int i = 0; i < 100 && std::filesystem::file_size(mono_file) <
+                                       wav_writer::data_offset + 4096 * 3;
+             ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+
+        // 3000 dropped frames and 500 frames missing from the engine
+        EXPECT_TRUE(sut.push(0, 9500, disk_writer::channels_view{small, 1}));
+        EXPECT_EQ(sut.dropped_frames(), 3000u);
+        EXPECT_EQ(sut.gap_frames(), 500u);
+    }
+
+    EXPECT_EQ(
+        std::filesystem::file_size(mono_file),
+        wav_writer::data_offset + 9600 * 3);
+}
+
+} // namespace piejam::runtime::recorder::test
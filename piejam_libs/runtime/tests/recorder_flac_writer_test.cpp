@@ -0,0 +1,114 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/flac_writer.h>
+
+#include <gtest/gtest.h>
+
+#include <sndfile.hh>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace piejam::runtime::recorder::test
+{
+
+struct recorder_flac_writer_test : testing::Test
+{
+    std::filesystem::path file{
+        std::filesystem::temp_directory_path() /
+        "piejam_recorder_flac_writer_test.flac"};
+
+    ~recorder_flac_writer_test() override
+    {
+        std::filesystem::remove(file);
+    }
+};
+
+TEST_F(recorder_flac_writer_test, written_samples_are_read_back_losslessly)
+{
+    constexpr std::size_t num_frames{10000};
+
+    std::vector<float> samples(2 * num_frames);
+    for (std::size_t frame = 0; frame < num_frames; ++frame)
+    {
+        float const phase = 2.f * std::numbers::pi_v<float> *
+                            static_cast<float>(frame) / 100.f;
+        samples[2 * frame] = 0.5f * std::sin(phase);
+        samples[2 * frame + 1] = -0.25f * std::sin(phase);
+    }
+
+    {
+        flac_writer sut{file, audio::sample_rate{48000}, 2};
+        EXPECT_EQ(sut.num_channels(), 2u);
+        EXPECT_FALSE(sut.write(std::span{samples}.first(2 * 4000)));
+        EXPECT_FALSE(sut.write(std::span{samples}.subspan(2 * 4000)));
+        EXPECT_FALSE(sut.close());
+    }
+
+    SndfileHandle in(file.c_str());
+    ASSERT_NE(in.rawHandle(), nullptr);
+    EXPECT_EQ(in.format(), SF_FORMAT_FLAC | SF_FORMAT_PCM_24);
+    EXPECT_EQ(in.channels(), 2);
+    EXPECT_EQ(in.samplerate(), 48000);
+    ASSERT_EQ(in.frames(), static_cast<sf_count_t>(num_frames));
+
+    std::vector<float> result(samples.size());
+    ASSERT_EQ(
+        in.readf(result.data(), static_cast<sf_count_t>(num_frames)),
+        static_cast<sf_count_t>(num_frames));
+
+    // only the 24 bit quantization remains
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        EXPECT_NEAR(result[i], samples[i], 1.f / (1 << 23));
+    }
+}
+
+TEST_F(recorder_flac_writer_test, samples_beyond_full_scale_are_clipped)
+{
+    std::vector<float> const samples{2.f, -2.f};
+
+    {
+        flac_writer sut{file, audio::sample_rate{48000}, 1};
+        EXPECT_FALSE(sut.write(samples));
+    }
+
+    SndfileHandle in(file.c_str());
+    std::vector<float> result(samples.size());
+    ASSERT_EQ(in.readf(result.data(), 2), 2);
+
+    EXPECT_NEAR(result[0], 1.f, 1.f / (1 << 22));
+    EXPECT_NEAR(result[1], -1.f, 1.f / (1 << 22));
+}
+
+TEST_F(recorder_flac_writer_test, commit_keeps_the_file_writable)
+{
+    std::vector<float> const samples(4096, 0.5f);
+
+    {
+        flac_writer sut{file, audio::sample_rate{48000}, 1};
+        EXPECT_FALSE(sut.write(samples));
+        EXPECT_FALSE(sut.commit());
+        EXPECT_FALSE(sut.write(samples));
+        EXPECT_FALSE(sut.close());
+    }
+
+    SndfileHandle in(file.c_str());
+    ASSERT_NE(in.rawHandle(), nullptr);
+    EXPECT_EQ(in.frames(), 2 * 4096);
+}
+
+TEST_F(recorder_flac_writer_test, throws_if_file_cannot_be_created)
+{
+    EXPECT_THROW(
+        (flac_writer{
+            std::filesystem::path{"/nonexistent/dir/file.flac"},
+            audio::sample_rate{48000},
+            1}),
+        std::system_error);
+}
+
+} // namespace piejam::runtime::recorder::test
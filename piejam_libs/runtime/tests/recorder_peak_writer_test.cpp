@@ -0,0 +1,188 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/peak_writer.h>
+
+#include <piejam/runtime/recorder/file_writer.h>
+#include <piejam/runtime/recorder/peak_file.h>
+#include <piejam/runtime/recorder/wav_writer.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace piejam::runtime::recorder::test
+{
+
+struct recorder_peak_writer_test : testing::Test
+{
+    std::filesystem::path file{
+        std::filesystem::temp_directory_path() /
+        "piejam_recorder_peak_writer_test.peaks"};
+
+    ~recorder_peak_writer_test() override
+    {
+        std::filesystem::remove(file);
+    }
+};
+
+TEST_F(recorder_peak_writer_test, empty_file_has_no_buckets)
+{
+    {
+        peak_writer sut{file, audio::sample_rate{48000}, 2};
+    }
+
+    peak_file const peaks{file};
+    EXPECT_EQ(peaks.num_channels(), 2u);
+    EXPECT_EQ(peaks.sample_rate(), audio::sample_rate{48000});
+    EXPECT_EQ(peaks.num_frames(), 0u);
+    EXPECT_EQ(peaks.num_buckets(0), 0u);
+    EXPECT_EQ(peaks.num_buckets(1), 0u);
+    EXPECT_EQ(peaks.num_buckets(2), 0u);
+}
+
+TEST_F(recorder_peak_writer_test, buckets_hold_min_and_max_per_channel)
+{
+    {
+        peak_writer sut{file, audio::sample_rate{48000}, 2};
+
+        // one full bucket and a partial one, written in odd blocks
+        std::vector<float> frames;
+        for (int frame = 0; frame < 300; ++frame)
+        {
+            frames.push_back(frame == 100 ? 0.5f : 0.f);
+            frames.push_back(frame == 260 ? -1.f : 0.25f);
+        }
+
+        ASSERT_FALSE(sut.write(std::span{frames}.first(2 * 77)));
+        ASSERT_FALSE(sut.write(std::span{frames}.subspan(2 * 77)));
+        EXPECT_FALSE(sut.close());
+    }
+
+    peak_file const peaks{file};
+    EXPECT_EQ(peaks.num_frames(), 300u);
+    ASSERT_EQ(peaks.num_buckets(0), 2u);
+    EXPECT_EQ(peaks.peaks(0, 0)[0], (peak{0, 16384}));
+    EXPECT_EQ(peaks.peaks(0, 0)[1], (peak{8192, 8192}));
+    EXPECT_EQ(peaks.peaks(0, 1)[0], (peak{0, 0}));
+    EXPECT_EQ(peaks.peaks(0, 1)[1], (peak{-32767, 8192}));
+
+    ASSERT_EQ(peaks.num_buckets(1), 1u);
+    EXPECT_EQ(peaks.peaks(1, 0)[0], (peak{0, 16384}));
+    EXPECT_EQ(peaks.peaks(1, 0)[1], (peak{-32767, 8192}));
+
+    ASSERT_EQ(peaks.num_buckets(2), 1u);
+    EXPECT_EQ(peaks.peaks(2, 0)[1], (peak{-32767, 8192}));
+}
+
+TEST_F(recorder_peak_writer_test, coarser_levels_merge_the_finer_ones)
+{
+    constexpr std::size_t num_frames{65536 + 5000};
+
+    {
+        peak_writer sut{file, audio::sample_rate{48000}, 1};
+
+        std::vector<float> frames(num_frames);
+        for (std::size_t frame = 0; frame < num_frames; ++frame)
+        {
+            frames[frame] = static_cast<float>(frame % 4096) / 8192.f;
+        }
+
+        ASSERT_FALSE(sut.write(frames));
+        EXPECT_FALSE(sut.close());
+    }
+
+    peak_file const peaks{file};
+    ASSERT_EQ(peaks.num_buckets(0), (num_frames + 255) / 256);
+    ASSERT_EQ(peaks.num_buckets(1), (num_frames + 4095) / 4096);
+    ASSERT_EQ(peaks.num_buckets(2), 2u);
+
+    EXPECT_EQ(peaks.peaks(0, 1)[0], (peak{1024, 2044}));
+    EXPECT_EQ(peaks.peaks(1, 3)[0], (peak{0, 16380}));
+    EXPECT_EQ(peaks.peaks(1, 16)[0], (peak{0, 16380}));
+    EXPECT_EQ(peaks.peaks(2, 1)[0], (peak{0, 16380}));
+}
+
+TEST_F(recorder_peak_writer_test, committed_file_is_readable_while_recording)
+{
+    peak_writer sut{file, audio::sample_rate{48000}, 1};
+
+    std::vector<float> frames(5000, 0.5f);
+    ASSERT_FALSE(sut.write(frames));
+    ASSERT_FALSE(sut.commit());
+
+    // only the complete buckets are committed, the coarser levels are built
+    peak_file const peaks{file};
+    EXPECT_EQ(peaks.num_frames(), 19u * 256u);
+    EXPECT_EQ(peaks.num_buckets(0), 19u);
+    EXPECT_EQ(peaks.num_buckets(1), 2u);
+    EXPECT_EQ(peaks.num_buckets(2), 1u);
+    EXPECT_EQ(peaks.peaks(1, 1)[0], (peak{16384, 16384}));
+    EXPECT_EQ(peaks.peaks(2, 0)[0], (peak{16384, 16384}));
+}
+
+TEST_F(recorder_peak_writer_test, foreign_file_is_rejected)
+{
+    {
+        std::ofstream out{file, std::ios::binary};
+        out << std::string(peak_file_header::size, 'x');
+    }
+
+    EXPECT_THROW(peak_file{file}, std::system_error);
+}
+
+TEST(recorder_peak_file, level_has_at_most_one_bucket_per_pixel)
+{
+    EXPECT_EQ(peak_level_for(1.), 0u);
+    EXPECT_EQ(peak_level_for(4095.), 0u);
+    EXPECT_EQ(peak_level_for(4096.), 1u);
+    EXPECT_EQ(peak_level_for(65535.), 1u);
+    EXPECT_EQ(peak_level_for(65536.), 2u);
+    EXPECT_EQ(peak_level_for(1e9), 2u);
+}
+
+TEST(recorder_peak_file, path_is_next_to_the_recording)
+{
+    EXPECT_EQ(
+        peak_file_path("/take/vocals.wav"),
+        std::filesystem::path{"/take/vocals.wav.peaks"});
+}
+
+TEST(recorder_with_peak_file, writes_recording_and_peaks)
+{
+    auto const audio_file = std::filesystem::temp_directory_path() /
+                            "piejam_recorder_with_peak_file_test.wav";
+
+    {
+        auto sut = with_peak_file(
+            std::make_unique<wav_writer>(
+                audio_file,
+                audio::sample_rate{48000},
+                1),
+            audio_file,
+            audio::sample_rate{48000});
+
+        std::array const frames{0.5f, -0.5f};
+        EXPECT_FALSE(sut->write(frames));
+        EXPECT_FALSE(sut->close());
+    }
+
+    EXPECT_EQ(
+        std::filesystem::file_size(audio_file),
+        wav_writer::data_offset + 2 * 3);
+
+    {
+        peak_file const peaks{peak_file_path(audio_file)};
+        EXPECT_EQ(peaks.num_frames(), 2u);
+        EXPECT_EQ(peaks.peaks(0, 0)[0], (peak{-16384, 16384}));
+    }
+
+    std::filesystem::remove(audio_file);
+    std::filesystem::remove(peak_file_path(audio_file));
+}
+
+} // namespace piejam::runtime::recorder::test
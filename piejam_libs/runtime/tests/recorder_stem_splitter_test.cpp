@@ -0,0 +1,169 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/stem_splitter.h>
+
+#include <piejam/runtime/recorder/peak_file.h>
+#include <piejam/runtime/recorder/peak_writer.h>
+#include <piejam/runtime/recorder/wav_writer.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace piejam::runtime::recorder::test
+{
+
+namespace
+{
+
+auto
+read_file(std::filesystem::path const& file) -> std::vector<unsigned char>
+{
+    std::ifstream in{file, std::ios::binary};
+    return {std::istreambuf_iterator<char>{in}, {}};
+}
+
+} // namespace
+
+struct recorder_stem_splitter_test : testing::Test
+{
+    std::filesystem::path dir{
+        std::filesystem::temp_directory_path() /
+        "piejam_recorder_stem_splitter_test"};
+
+    recorder_stem_splitter_test()
+    {
+        std::filesystem::create_directories(dir);
+    }
+
+    ~recorder_stem_splitter_test() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+};
+
+TEST_F(recorder_stem_splitter_test, stems_get_their_channels)
+{
+    std::array const stems{stem{"mono", 1}, stem{"stereo", 2}};
+
+    {
+        wav_writer multitrack{
+            dir / "multitrack.wav",
+            audio::sample_rate{44100},
+            3};
+
+        std::vector<float> frames;
+        for (int frame = 0; frame < 1000; ++frame)
+        {
+            frames.push_back(0.25f);
+            frames.push_back(0.5f);
+            frames.push_back(-0.5f);
+        }
+
+        ASSERT_FALSE(multitrack.write(frames));
+    }
+
+    ASSERT_FALSE(split_stems(dir / "multitrack.wav", stems, dir));
+
+    auto const mono = read_file(dir / "mono.wav");
+    ASSERT_EQ(mono.size(), wav_writer::data_offset + 1000 * 3);
+
+    auto const stereo = read_file(dir / "stereo.wav");
+    ASSERT_EQ(stereo.size(), wav_writer::data_offset + 1000 * 2 * 3);
+
+    // 0.25, 0.5 and -0.5 in 24 bit little endian
+    EXPECT_EQ(mono[wav_writer::data_offset + 2], 0x20);
+    EXPECT_EQ(stereo[wav_writer::data_offset + 2], 0x40);
+    EXPECT_EQ(stereo[wav_writer::data_offset + 5], 0xc0);
+    EXPECT_EQ(stereo[stereo.size() - 1], 0xc0);
+}
+
+TEST_F(recorder_stem_splitter_test, peak_file_is_split_along)
+{
+    std::array const stems{stem{"mono", 1}, stem{"stereo", 2}};
+
+    {
+        wav_writer multitrack{
+            dir / "multitrack.wav",
+            audio::sample_rate{44100},
+            3};
+        peak_writer peaks{
+            peak_file_path(dir / "multitrack.wav"),
+            audio::sample_rate{44100},
+            3};
+
+        std::vector<float> frames;
+        for (int frame = 0; frame < 1000; ++frame)
+        {
+            frames.push_back(0.25f);
+            frames.push_back(0.5f);
+            frames.push_back(-0.5f);
+        }
+
+        ASSERT_FALSE(multitrack.write(frames));
+        ASSERT_FALSE(peaks.write(frames));
+    }
+
+    ASSERT_FALSE(split_stems(dir / "multitrack.wav", stems, dir));
+
+    peak_file const mono{peak_file_path(dir / "mono.wav")};
+    ASSERT_EQ(mono.num_channels(), 1u);
+    EXPECT_EQ(mono.num_frames(), 1000u);
+    EXPECT_EQ(mono.num_buckets(0), 4u);
+    EXPECT_EQ(mono.peaks(2, 0)[0], (peak{8192, 8192}));
+
+    peak_file const stereo{peak_file_path(dir / "stereo.wav")};
+    ASSERT_EQ(stereo.num_channels(), 2u);
+    EXPECT_EQ(stereo.peaks(0, 3)[0], (peak{16384, 16384}));
+    EXPECT_EQ(stereo.peaks(0, 3)[1], (peak{-16384, -16384}));
+}
+
+TEST_F(recorder_stem_splitter_test, mismatching_channels_are_rejected)
+{
+    std::array const stems{stem{"mono", 1}};
+
+    {
+        wav_writer multitrack{
+            dir / "multitrack.wav",
+            audio::sample_rate{44100},
+            2};
+    }
+
+    EXPECT_EQ(
+        split_stems(dir / "multitrack.wav", stems, dir),
+        std::make_error_code(std::errc::invalid_argument));
+}
+
+TEST_F(recorder_stem_splitter_test, missing_file_is_reported)
+{
+    std::array const stems{stem{"mono", 1}};
+
+    EXPECT_TRUE(split_stems(dir / "missing.wav", stems, dir));
+}
+
+TEST_F(recorder_stem_splitter_test, saved_stems_are_loaded)
+{
+    std::array const stems{stem{"mono", 1}, stem{"two words", 2}};
+
+    ASSERT_FALSE(save_stems(dir / "multitrack.wav", stems));
+
+    auto const loaded = load_stems(dir / "multitrack.wav");
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(loaded->size(), 2u);
+    EXPECT_EQ((*loaded)[0].name, "mono");
+    EXPECT_EQ((*loaded)[0].num_channels, 1u);
+    EXPECT_EQ((*loaded)[1].name, "two words");
+    EXPECT_EQ((*loaded)[1].num_channels, 2u);
+}
+
+TEST_F(recorder_stem_splitter_test, missing_stems_are_not_loaded)
+{
+    EXPECT_FALSE(load_stems(dir / "multitrack.wav"));
+}
+
+} // namespace piejam::runtime::recorder::test
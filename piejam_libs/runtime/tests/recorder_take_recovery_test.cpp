@@ -0,0 +1,98 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/take_recovery.h>
+
+#include <piejam/runtime/recorder/stem_splitter.h>
+#include <piejam/runtime/recorder/wav_writer.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <fstream>
+#include <vector>
+
+namespace piejam::runtime::recorder::test
+{
+
+struct recorder_take_recovery_test : testing::Test
+{
+    std::filesystem::path dir{
+        std::filesystem::temp_directory_path() /
+        "piejam_recorder_take_recovery_test"};
+    std::filesystem::path marker_file{dir / ".recording"};
+    std::filesystem::path take_dir{dir / "take_0000"};
+
+    recorder_take_recovery_test()
+    {
+        std::filesystem::create_directories(take_dir);
+    }
+
+    ~recorder_take_recovery_test() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+};
+
+TEST_F(recorder_take_recovery_test, finished_take_is_not_recovered)
+{
+    mark_take_started(marker_file, take_dir);
+    mark_take_finished(marker_file);
+
+    EXPECT_FALSE(pop_interrupted_take(marker_file));
+}
+
+TEST_F(recorder_take_recovery_test, interrupted_take_is_popped_once)
+{
+    mark_take_started(marker_file, take_dir);
+
+    EXPECT_EQ(pop_interrupted_take(marker_file), take_dir);
+    EXPECT_FALSE(pop_interrupted_take(marker_file));
+}
+
+TEST_F(recorder_take_recovery_test, repair_take_completes_wave_files)
+{
+    auto const file = take_dir / "track.wav";
+
+    {
+        wav_writer writer{file, audio::sample_rate{48000}, 1};
+        std::array const frames{0.f, 0.5f, -0.5f};
+        ASSERT_FALSE(writer.write(frames));
+    }
+
+    // header never updated
+    {
+        std::fstream io{file, std::ios::binary | std::ios::in | std::ios::out};
+        io.seekp(wav_writer::data_offset - 4);
+        io.write("\0\0\0\0", 4);
+    }
+
+    repair_take(take_dir);
+
+    std::ifstream in{file, std::ios::binary};
+    in.seekg(wav_writer::data_offset - 4);
+    std::array<unsigned char, 4> data_size{};
+    in.read(reinterpret_cast<char*>(data_size.data()), 4);
+    EXPECT_EQ(data_size[0], 9u);
+}
+
+TEST_F(recorder_take_recovery_test, unsplit_multitrack_file_is_pending)
+{
+    auto const file = take_dir / "multitrack.wav";
+    std::array const stems{stem{"mono", 1}};
+
+    {
+        wav_writer writer{file, audio::sample_rate{48000}, 1};
+    }
+
+    ASSERT_FALSE(save_stems(file, stems));
+
+    EXPECT_EQ(find_pending_splits(dir), std::vector{file});
+
+    std::filesystem::remove(stems_file_path(file));
+
+    EXPECT_TRUE(find_pending_splits(dir).empty());
+}
+
+} // namespace piejam::runtime::recorder::test
@@ -0,0 +1,156 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/track_merger.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace piejam::runtime::recorder::test
+{
+
+namespace
+{
+
+auto
+to_vector(track_merger::channels_view const view) -> std::vector<float>
+{
+    return {view.samples().begin(), view.samples().end()};
+}
+
+} // namespace
+
+TEST(recorder_track_merger, merges_tracks_channel_by_channel)
+{
+    track_merger sut{{1, 2}, 0, 100};
+    ASSERT_EQ(sut.num_channels(), 3u);
+
+    std::vector const mono{1.f, 2.f};
+    std::vector const stereo{3.f, 4.f, 5.f, 6.f};
+    sut.push(0, 0, track_merger::channels_view{mono, 1});
+    sut.push(1, 0, track_merger::channels_view{stereo, 2});
+
+    auto const merged = sut.pull();
+    EXPECT_EQ(merged.num_channels(), 3u);
+    EXPECT_EQ(merged.num_frames(), 2u);
+    EXPECT_THAT(
+        to_vector(merged),
+        testing::ElementsAre(1.f, 2.f, 3.f, 4.f, 5.f, 6.f));
+}
+
+TEST(recorder_track_merger, only_frames_available_for_all_tracks_are_pulled)
+{
+    track_merger sut{{1, 1}, 0, 100};
+
+    std::vector const a{1.f, 2.f, 3.f};
+    std::vector const b{4.f};
+    sut.push(0, 0, track_merger::channels_view{a, 1});
+    sut.push(1, 0, track_merger::channels_view{b, 1});
+
+    EXPECT_THAT(to_vector(sut.pull()), testing::ElementsAre(1.f, 4.f));
+    EXPECT_EQ(sut.next_frame(), 1u);
+
+    std::vector const c{5.f, 6.f};
+    sut.push(1, 1, track_merger::channels_view{c, 1});
+
+    EXPECT_THAT(
+        to_vector(sut.pull()),
+        testing::ElementsAre(2.f, 3.f, 5.f, 6.f));
+    EXPECT_EQ(sut.pull().num_frames(), 0u);
+}
+
+TEST(recorder_track_merger, lagging_track_is_padded_beyond_max_skew)
+{
+    track_merger sut{{1, 1}, 0, 2};
+
+    std::vector const a{1.f, 2.f, 3.f, 4.f};
+    sut.push(0, 0, track_merger::channels_view{a, 1});
+
+    EXPECT_THAT(
+        to_vector(sut.pull()),
+        testing::ElementsAre(1.f, 2.f, 0.f, 0.f));
+    EXPECT_EQ(sut.pull().num_frames(), 0u);
+    EXPECT_EQ(sut.gap_frames(), 2u);
+
+    // the padded frames are skipped
+    std::vector const b{5.f, 6.f, 7.f};
+    sut.push(1, 0, track_merger::channels_view{b, 1});
+
+    EXPECT_THAT(
+        to_vector(sut.flush()),
+        testing::ElementsAre(3.f, 4.f, 7.f, 0.f));
+}
+
+TEST(recorder_track_merger, gaps_are_filled_with_silence)
+{
+    track_merger sut{{1, 1}, 10, 100};
+
+    std::vector const a{1.f, 2.f, 3.f};
+    std::vector const b{4.f};
+    std::vector const c{5.f};
+    sut.push(0, 10, track_merger::channels_view{a, 1});
+    sut.push(1, 10, track_merger::channels_view{b, 1});
+    sut.push(1, 12, track_merger::channels_view{c, 1});
+
+    EXPECT_EQ(sut.gap_frames(), 1u);
+    EXPECT_THAT(
+        to_vector(sut.pull()),
+        testing::ElementsAre(1.f, 2.f, 3.f, 4.f, 0.f, 5.f));
+    EXPECT_EQ(sut.next_frame(), 13u);
+}
+
+TEST(recorder_track_merger, pending_frames_wrap_around)
+{
+    track_merger sut{{1, 1}, 0, 2};
+
+    std::vector const a{1.f, 2.f, 3.f};
+    std::vector const b{4.f, 5.f, 6.f};
+    sut.push(0, 0, track_merger::channels_view{a, 1});
+    sut.push(1, 0, track_merger::channels_view{b, 1});
+    EXPECT_EQ(sut.pull().num_frames(), 3u);
+
+    sut.push(0, 3, track_merger::channels_view{b, 1});
+    sut.push(1, 3, track_merger::channels_view{a, 1});
+
+    EXPECT_THAT(
+        to_vector(sut.pull()),
+        testing::ElementsAre(4.f, 5.f, 6.f, 1.f, 2.f, 3.f));
+    EXPECT_EQ(sut.gap_frames(), 0u);
+}
+
+TEST(recorder_track_merger, storage_grows_for_a_track_far_ahead)
+{
+    track_merger sut{{1, 1}, 0, 2};
+
+    std::vector const a{1.f, 2.f, 3.f};
+    std::vector const b{4.f, 5.f, 6.f, 7.f, 8.f, 9.f};
+    sut.push(0, 0, track_merger::channels_view{a, 1});
+    sut.push(1, 0, track_merger::channels_view{a, 1});
+    EXPECT_EQ(sut.pull().num_frames(), 3u);
+
+    sut.push(0, 3, track_merger::channels_view{b, 1});
+    sut.push(1, 3, track_merger::channels_view{a, 1});
+
+    std::vector const expected{
+        4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 1.f, 2.f, 3.f, 0.f, 0.f, 0.f};
+    EXPECT_EQ(to_vector(sut.flush()), expected);
+}
+
+TEST(recorder_track_merger, flush_pads_missing_frames)
+{
+    track_merger sut{{1, 1}, 0, 100};
+
+    std::vector const a{1.f, 2.f};
+    std::vector const b{3.f};
+    sut.push(0, 0, track_merger::channels_view{a, 1});
+    sut.push(1, 0, track_merger::channels_view{b, 1});
+
+    EXPECT_THAT(
+        to_vector(sut.flush()),
+        testing::ElementsAre(1.f, 2.f, 3.f, 0.f));
+}
+
+} // namespace piejam::runtime::recorder::test
@@ -0,0 +1,220 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/recorder/wav_writer.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace piejam::runtime::recorder::test
+{
+
+namespace
+{
+
+auto
+read_file(std::filesystem::path const& file) -> std::vector<unsigned char>
+{
+    std::ifstream in{file, std::ios::binary};
+    return {std::istreambuf_iterator<char>{in}, {}};
+}
+
+auto
+u32_at(std::vector<unsigned char> const& data, std::size_t const offset)
+    -> std::uint32_t
+{
+    return static_cast<std::uint32_t>(data[offset]) |
+           (static_cast<std::uint32_t>(data[offset + 1]) << 8) |
+           (static_cast<std::uint32_t>(data[offset + 2]) << 16) |
+           (static_cast<std::uint32_t>(data[offset + 3]) << 24);
+}
+
+auto
+tag_at(std::vector<unsigned char> const& data, std::size_t const offset)
+    -> std::string
+{
+    return {reinterpret_cast<char const*>(data.data() + offset), 4};
+}
+
+} // namespace
+
+struct recorder_wav_writer_test : testing::Test
+{
+    std::filesystem::path file{
+        std::filesystem::temp_directory_path() /
+        "piejam_recorder_wav_writer_test.wav"};
+
+    ~recorder_wav_writer_test() override
+    {
+        std::filesystem::remove(file);
+    }
+};
+
+TEST_F(recorder_wav_writer_test, empty_file_has_complete_header)
+{
+    {
+        wav_writer sut{file, audio::sample_rate{48000}, 2};
+    }
+
+    auto const data = read_file(file);
+    ASSERT_EQ(data.size(), wav_writer::data_offset);
+    EXPECT_EQ(tag_at(data, 0), "RIFF");
+    EXPECT_EQ(u32_at(data, 4), wav_writer::data_offset - 8);
+    EXPECT_EQ(tag_at(data, 8), "WAVE");
+    EXPECT_EQ(tag_at(data, 12), "JUNK");
+    EXPECT_EQ(u32_at(data, 16), 28u);
+    EXPECT_EQ(tag_at(data, 48), "fmt ");
+    EXPECT_EQ(u32_at(data, 60), 48000u);
+    EXPECT_EQ(tag_at(data, 72), "JUNK");
+    EXPECT_EQ(u32_at(data, 76), wav_writer::data_offset - 8 - 80);
+    EXPECT_EQ(tag_at(data, wav_writer::data_offset - 8), "data");
+    EXPECT_EQ(u32_at(data, wav_writer::data_offset - 4), 0u);
+}
+
+TEST_F(recorder_wav_writer_test, write_appends_24_bit_samples)
+{
+    {
+        wav_writer sut{file, audio::sample_rate{48000}, 2};
+        std::array const frames{0.f, 0.5f, -0.5f, 1.f};
+        EXPECT_FALSE(sut.write(frames));
+        EXPECT_FALSE(sut.write(frames));
+        EXPECT_EQ(sut.num_frames(), 4u);
+        EXPECT_FALSE(sut.close());
+    }
+
+    auto const data = read_file(file);
+    ASSERT_EQ(data.size(), wav_writer::data_offset + 8 * 3);
+    EXPECT_EQ(u32_at(data, 4), data.size() - 8);
+    EXPECT_EQ(u32_at(data, wav_writer::data_offset - 4), 8u * 3u);
+
+    auto sample_at = [&](std::size_t const index) {
+        std::size_t const offset = wav_writer::data_offset + index * 3;
+        return static_cast<std::int32_t>(
+                   (static_cast<std::uint32_t>(data[offset]) << 8) |
+                   (static_cast<std::uint32_t>(data[offset + 1]) << 16) |
+                   (static_cast<std::uint32_t>(data[offset + 2]) << 24)) >>
+               8;
+    };
+
+    EXPECT_EQ(sample_at(0), 0);
+    EXPECT_EQ(sample_at(1), 0x400000);
+    EXPECT_EQ(sample_at(2), -0x400000);
+    EXPECT_EQ(sample_at(3), 0x7fffff);
+    EXPECT_EQ(sample_at(5), 0x400000);
+}
+
+TEST_F(recorder_wav_writer_test, write_pcm_appends_samples_unchanged)
+{
+    std::array<numeric::int24_io_t, 2> pcm{};
+    std::memcpy(pcm.data(), "\x01\x02\x03\x04\x05\x06", 6);
+
+    {
+        wav_writer sut{file, audio::sample_rate{48000}, 1};
+        EXPECT_FALSE(sut.write_pcm(pcm));
+        EXPECT_EQ(sut.num_frames(), 2u);
+    }
+
+    auto const data = read_file(file);
+    ASSERT_EQ(data.size(), wav_writer::data_offset + 6);
+    EXPECT_EQ(data[wav_writer::data_offset], 0x01);
+    EXPECT_EQ(data[wav_writer::data_offset + 5], 0x06);
+}
+
+TEST_F(recorder_wav_writer_test, more_than_two_channels_use_extensible_format)
+{
+    {
+        wav_writer sut{file, audio::sample_rate{48000}, 4};
+    }
+
+    auto const data = read_file(file);
+    ASSERT_EQ(data.size(), wav_writer::data_offset);
+    EXPECT_EQ(u32_at(data, 52), 40u);
+    EXPECT_EQ(data[56], 0xfe);
+    EXPECT_EQ(data[57], 0xff);
+    EXPECT_EQ(tag_at(data, 96), "JUNK");
+}
+
+TEST_F(recorder_wav_writer_test, commit_completes_header_of_open_file)
+{
+    wav_writer sut{file, audio::sample_rate{48000}, 2};
+    std::array const frames{0.f, 0.5f, -0.5f, 1.f};
+    ASSERT_FALSE(sut.write(frames));
+
+    EXPECT_FALSE(sut.commit());
+
+    auto data = read_file(file);
+    ASSERT_EQ(data.size(), wav_writer::data_offset + 4 * 3);
+    EXPECT_EQ(u32_at(data, 4), data.size() - 8);
+    EXPECT_EQ(u32_at(data, wav_writer::data_offset - 4), 4u * 3u);
+
+    ASSERT_FALSE(sut.write(frames));
+    EXPECT_FALSE(sut.close());
+
+    data = read_file(file);
+    EXPECT_EQ(u32_at(data, wav_writer::data_offset - 4), 8u * 3u);
+}
+
+TEST_F(recorder_wav_writer_test, repair_completes_header_and_cuts_partial_frame)
+{
+    {
+        wav_writer sut{file, audio::sample_rate{48000}, 2};
+        std::array const frames{0.f, 0.5f, -0.5f, 1.f};
+        ASSERT_FALSE(sut.write(frames));
+    }
+
+    // as if the header was never updated and the last frame is incomplete
+    {
+        std::fstream io{file, std::ios::binary | std::ios::in | std::ios::out};
+        io.seekp(4);
+        io.write("\0\0\0\0", 4);
+        io.seekp(wav_writer::data_offset - 4);
+        io.write("\0\0\0\0", 4);
+        io.seekp(0, std::ios::end);
+        io.write("\1\2\3\4", 4);
+    }
+
+    EXPECT_FALSE(wav_writer::repair(file));
+
+    auto const data = read_file(file);
+    ASSERT_EQ(data.size(), wav_writer::data_offset + 2 * 2 * 3);
+    EXPECT_EQ(tag_at(data, 0), "RIFF");
+    EXPECT_EQ(u32_at(data, 4), data.size() - 8);
+    EXPECT_EQ(u32_at(data, wav_writer::data_offset - 4), 2u * 2u * 3u);
+}
+
+TEST(recorder_wav_writer, repair_rejects_foreign_files)
+{
+    auto const file = std::filesystem::temp_directory_path() /
+                      "piejam_recorder_wav_writer_test_foreign.wav";
+
+    {
+        std::ofstream out{file, std::ios::binary};
+        out << std::string(wav_writer::data_offset, 'x');
+    }
+
+    EXPECT_EQ(
+        wav_writer::repair(file),
+        std::make_error_code(std::errc::invalid_argument));
+
+    std::filesystem::remove(file);
+}
+
+TEST(recorder_wav_writer, throws_if_file_cannot_be_created)
+{
+    EXPECT_THROW(
+        (wav_writer{
+            "/nonexistent_piejam_dir/test.wav",
+            audio::sample_rate{48000},
+            1}),
+        std::system_error);
+}
+
+} // namespace piejam::runtime::recorder::test
@@ -4,7 +4,11 @@
 
 #include <piejam/runtime/state.h>
 
+#include <piejam/audio/engine/event_quantization.h>
+#include <piejam/ladspa/plugin_descriptor.h>
 #include <piejam/numeric/dB_convert.h>
+#include <piejam/runtime/actions/set_ladspa_fx_event_quantization.h>
+#include <piejam/runtime/actions/set_ladspa_fx_pipelined.h>
 #include <piejam/runtime/parameter/store.h>
 
 #include <gtest/gtest.h>
@@ -65,4 +69,69 @@ TEST_F(
     EXPECT_EQ(nullptr, sut.mixer_state.channels.find(channel_id));
 }
 
+TEST_F(
+    state_with_one_mixer_input,
+    ladspa_fx_module_keeps_its_event_quantization)
+{
+    auto const instance_id = ladspa::instance_id::generate();
+    auto const fx_mod_id = insert_ladspa_fx_module(
+        sut,
+        channel_id,
+        0,
+        instance_id,
+        ladspa::plugin_descriptor{},
+        {},
+        audio::engine::control_rate_events,
+        {},
+        {});
+
+    EXPECT_EQ(
+        audio::engine::control_rate_events,
+        sut.fx_state.ladspa_event_quantizations.at(instance_id));
+
+    actions::set_ladspa_fx_event_quantization action;
+    action.fx_mod_id = fx_mod_id;
+    action.event_quantization = audio::engine::period_rate_events;
+    action.reduce(sut);
+
+    EXPECT_EQ(
+        audio::engine::period_rate_events,
+        sut.fx_state.ladspa_event_quantizations.at(instance_id));
+
+    remove_fx_module(sut, channel_id, fx_mod_id);
+
+    EXPECT_FALSE(sut.fx_state.ladspa_event_quantizations.contains(instance_id));
+}
+
+TEST_F(state_with_one_mixer_input, ladspa_fx_module_can_be_pipelined)
+{
+    auto const instance_id = ladspa::instance_id::generate();
+    auto const fx_mod_id = insert_ladspa_fx_module(
+        sut,
+        channel_id,
+        0,
+        instance_id,
+        ladspa::plugin_descriptor{},
+        {},
+        audio::engine::control_rate_events,
+        {},
+        {});
+
+    EXPECT_FALSE(
+        sut.fx_state.pipelined_ladspa_instances->contains(instance_id));
+
+    actions::set_ladspa_fx_pipelined action;
+    action.fx_mod_id = fx_mod_id;
+    action.pipelined = true;
+    action.reduce(sut);
+
+    EXPECT_TRUE(
+        sut.fx_state.pipelined_ladspa_instances->contains(instance_id));
+
+    remove_fx_module(sut, channel_id, fx_mod_id);
+
+    EXPECT_FALSE(
+        sut.fx_state.pipelined_ladspa_instances->contains(instance_id));
+}
+
 } // namespace piejam::runtime::test
@@ -0,0 +1,134 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace piejam::thread
+{
+
+// A set of indices, which can be marked dirty lock-free from any thread and
+// are collected by a single consumer thread. Index allocation and consumption
+// must happen on the same (non-realtime) thread. Storage grows in blocks with
+// stable addresses, so flags handed out earlier stay valid.
+class dirty_set
+{
+    using word_t = std::uint64_t;
+
+    static_assert(std::atomic<word_t>::is_always_lock_free);
+
+    static constexpr std::size_t bits_per_word = 64;
+    static constexpr std::size_t words_per_block = 64;
+    static constexpr std::size_t bits_per_block =
+        bits_per_word * words_per_block;
+
+    struct block
+    {
+        std::array<std::atomic<word_t>, words_per_block> words{};
+    };
+
+public:
+    class flag
+    {
+    public:
+        constexpr flag() noexcept = default;
+
+        void mark() const noexcept
+        {
+            if (m_word)
+            {
+                m_word->fetch_or(m_mask, std::memory_order_release);
+            }
+        }
+
+    private:
+        friend class dirty_set;
+
+        constexpr flag(std::atomic<word_t>& word, word_t mask) noexcept
+            : m_word{&word}
+            , m_mask{mask}
+        {
+        }
+
+        std::atomic<word_t>* m_word{};
+        word_t m_mask{};
+    };
+
+    [[nodiscard]]
+    auto acquire() -> std::size_t
+    {
+        if (!m_free.empty())
+        {
+            auto const index = m_free.back();
+            m_free.pop_back();
+            return index;
+        }
+
+        if (m_size == m_blocks.size() * bits_per_block)
+        {
+            m_blocks.push_back(std::make_unique<block>());
+        }
+
+        return m_size++;
+    }
+
+    void release(std::size_t const index)
+    {
+        m_free.push_back(index);
+    }
+
+    [[nodiscard]]
+    auto get_flag(std::size_t const index) const noexcept -> flag
+    {
+        return flag{
+            word_at(index / bits_per_word),
+            word_t{1} << (index % bits_per_word)};
+    }
+
+    template <std::invocable<std::size_t> F>
+    void consume(F&& f)
+    {
+        std::size_t const num_words =
+            (m_size + bits_per_word - 1) / bits_per_word;
+
+        for (std::size_t w = 0; w < num_words; ++w)
+        {
+            auto& word = word_at(w);
+            if (word.load(std::memory_order_relaxed) == 0)
+            {
+                continue;
+            }
+
+            for (word_t bits = word.exchange(0, std::memory_order_acquire);
+                 bits != 0;
+                 bits &= bits - 1)
+            {
+                std::invoke(
+                    f,
+                    w * bits_per_word +
+                        static_cast<std::size_t>(std::countr_zero(bits)));
+            }
+        }
+    }
+
+private:
+    auto word_at(std::size_t const w) const noexcept -> std::atomic<word_t>&
+    {
+        return m_blocks[w / words_per_block]->words[w % words_per_block];
+    }
+
+    std::vector<std::unique_ptr<block>> m_blocks;
+    std::vector<std::size_t> m_free;
+    std::size_t m_size{};
+};
+
+} // namespace piejam::thread
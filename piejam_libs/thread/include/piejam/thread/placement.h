@@ -0,0 +1,31 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/thread/fwd.h>
+
+#include <span>
+#include <vector>
+
+namespace piejam::thread
+{
+
+//! Returns the cpus, which none of the given real-time threads is pinned to.
+//! Background work placed there can't delay the audio processing.
+//!
+//! If the real-time threads occupy every cpu, the result is empty. Background
+//! threads are left unpinned then, instead of competing with a real-time
+//! thread on its cpu.
+[[nodiscard]]
+auto background_cpus(
+    std::span<configuration const> realtime_threads,
+    unsigned num_cpus) -> std::vector<unsigned>;
+
+//! Same as above, for the cpus of this machine.
+[[nodiscard]]
+auto background_cpus(std::span<configuration const> realtime_threads)
+    -> std::vector<unsigned>;
+
+} // namespace piejam::thread
@@ -9,4 +9,8 @@ namespace piejam::this_thread
 
 void set_realtime_priority(int prio);
 
+//! Lowers the thread below the normal threads, for long running work, which
+//! may take its time. Failing is harmless, the thread keeps its priority.
+void set_background_priority() noexcept;
+
 } // namespace piejam::this_thread
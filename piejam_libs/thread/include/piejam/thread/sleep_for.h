@@ -0,0 +1,33 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
+
+namespace piejam::thread
+{
+
+//! Sleeps for the duration, but wakes up as soon as a stop is requested.
+//! Meant for threads polling for work. Returns false, if a stop was
+//! requested.
+template <class Rep, class Period>
+auto
+sleep_for(
+    std::stop_token const& stoken,
+    std::chrono::duration<Rep, Period> const& duration) -> bool
+{
+    std::mutex mutex;
+    std::condition_variable_any cv;
+    std::unique_lock lock{mutex};
+
+    return !cv.wait_for(lock, stoken, duration, [&] {
+        return stoken.stop_requested();
+    });
+}
+
+} // namespace piejam::thread
@@ -0,0 +1,94 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/thread/configuration.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace piejam::thread
+{
+
+//! Background thread, which runs posted jobs in order.
+//!
+//! Meant for non real-time work (analysis, disk i/o, ...), posting a job
+//! locks a mutex and may allocate. Jobs which are still pending on
+//! destruction are discarded, a running job is waited for.
+class worker
+{
+public:
+    using job_t = std::function<void()>;
+
+    explicit worker(configuration conf = {})
+        : m_thread([this, conf = std::move(conf)](std::stop_token stoken) {
+            conf.apply();
+            run(stoken);
+        })
+    {
+    }
+
+    worker(worker const&) = delete;
+    worker(worker&&) = delete;
+
+    ~worker()
+    {
+        {
+            std::lock_guard const lock{m_mutex};
+            m_thread.request_stop();
+        }
+
+        m_cv.notify_one();
+    }
+
+    auto operator=(worker const&) -> worker& = delete;
+    auto operator=(worker&&) -> worker& = delete;
+
+    void post(job_t job)
+    {
+        {
+            std::lock_guard const lock{m_mutex};
+            m_jobs.push_back(std::move(job));
+        }
+
+        m_cv.notify_one();
+    }
+
+private:
+    void run(std::stop_token const& stoken)
+    {
+        std::unique_lock lock{m_mutex};
+
+        while (true)
+        {
+            m_cv.wait(lock, [&] {
+                return stoken.stop_requested() || !m_jobs.empty();
+            });
+
+            if (stoken.stop_requested())
+            {
+                break;
+            }
+
+            job_t job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<job_t> m_jobs;
+
+    std::jthread m_thread;
+};
+
+} // namespace piejam::thread
@@ -0,0 +1,56 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/thread/placement.h>
+
+#include <piejam/thread/configuration.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace piejam::thread
+{
+
+auto
+background_cpus(
+    std::span<configuration const> realtime_threads,
+    unsigned const num_cpus) -> std::vector<unsigned>
+{
+    BOOST_ASSERT(num_cpus > 0);
+
+    std::vector<bool> occupied(num_cpus);
+
+    for (auto const& conf : realtime_threads)
+    {
+        if (conf.affinity && *conf.affinity < num_cpus)
+        {
+            occupied[*conf.affinity] = true;
+        }
+    }
+
+    std::vector<unsigned> result;
+
+    for (unsigned cpu = 0; cpu < num_cpus; ++cpu)
+    {
+        if (!occupied[cpu])
+        {
+            result.push_back(cpu);
+        }
+    }
+
+    return result;
+}
+
+auto
+background_cpus(std::span<configuration const> realtime_threads)
+    -> std::vector<unsigned>
+{
+    return background_cpus(
+        realtime_threads,
+        std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+} // namespace piejam::thread
@@ -6,6 +6,8 @@
 
 #include <pthread.h>
 #include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
 
 #include <system_error>
 
@@ -23,4 +25,14 @@ set_realtime_priority(int prio)
     }
 }
 
+void
+set_background_priority() noexcept
+{
+    sched_param const parm{.sched_priority = 0};
+    pthread_setschedparam(pthread_self(), SCHED_BATCH, &parm);
+
+    // the nice value is per thread on linux
+    setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), 10);
+}
+
 } // namespace piejam::this_thread
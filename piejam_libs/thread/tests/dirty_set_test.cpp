@@ -0,0 +1,127 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/thread/dirty_set.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace piejam::thread::test
+{
+
+namespace
+{
+
+auto
+consume_all(dirty_set& sut) -> std::vector<std::size_t>
+{
+    std::vector<std::size_t> result;
+    sut.consume([&result](std::size_t index) { result.push_back(index); });
+    return result;
+}
+
+} // namespace
+
+TEST(dirty_set, consume_on_empty_set)
+{
+    dirty_set sut;
+    EXPECT_TRUE(consume_all(sut).empty());
+}
+
+TEST(dirty_set, acquire_returns_consecutive_indices)
+{
+    dirty_set sut;
+    EXPECT_EQ(0u, sut.acquire());
+    EXPECT_EQ(1u, sut.acquire());
+    EXPECT_EQ(2u, sut.acquire());
+}
+
+TEST(dirty_set, released_index_is_reused)
+{
+    dirty_set sut;
+    auto const a = sut.acquire();
+    [[maybe_unused]] auto const b = sut.acquire();
+    sut.release(a);
+    EXPECT_EQ(a, sut.acquire());
+}
+
+TEST(dirty_set, only_marked_indices_are_consumed)
+{
+    dirty_set sut;
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+        indices.push_back(sut.acquire());
+    }
+
+    sut.get_flag(indices[3]).mark();
+    sut.get_flag(indices[64]).mark();
+    sut.get_flag(indices[199]).mark();
+
+    EXPECT_THAT(consume_all(sut), testing::ElementsAre(3u, 64u, 199u));
+}
+
+TEST(dirty_set, consume_clears_marks)
+{
+    dirty_set sut;
+    auto const index = sut.acquire();
+    sut.get_flag(index).mark();
+    sut.get_flag(index).mark();
+
+    EXPECT_THAT(consume_all(sut), testing::ElementsAre(index));
+    EXPECT_TRUE(consume_all(sut).empty());
+}
+
+TEST(dirty_set, flags_stay_valid_when_growing)
+{
+    dirty_set sut;
+    auto const first = sut.acquire();
+    auto const first_flag = sut.get_flag(first);
+
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+        [[maybe_unused]] auto const index = sut.acquire();
+    }
+
+    first_flag.mark();
+    EXPECT_THAT(consume_all(sut), testing::ElementsAre(first));
+}
+
+TEST(dirty_set, default_flag_mark_is_noop)
+{
+    dirty_set::flag const sut;
+    sut.mark();
+}
+
+TEST(dirty_set, concurrent_marks_are_not_lost)
+{
+    dirty_set sut;
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < 128; ++i)
+    {
+        indices.push_back(sut.acquire());
+    }
+
+    {
+        std::jthread t1([&] {
+            for (std::size_t i = 0; i < 128; i += 2)
+            {
+                sut.get_flag(indices[i]).mark();
+            }
+        });
+        std::jthread t2([&] {
+            for (std::size_t i = 1; i < 128; i += 2)
+            {
+                sut.get_flag(indices[i]).mark();
+            }
+        });
+    }
+
+    EXPECT_EQ(128u, consume_all(sut).size());
+}
+
+} // namespace piejam::thread::test
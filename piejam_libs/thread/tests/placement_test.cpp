@@ -0,0 +1,64 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/thread/placement.h>
+
+#include <piejam/thread/configuration.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace piejam::thread::test
+{
+
+namespace
+{
+
+auto
+pinned(unsigned const cpu) -> configuration
+{
+    return {.affinity = cpu, .realtime_priority = 96, .name = std::nullopt};
+}
+
+} // namespace
+
+TEST(background_cpus, all_cpus_without_realtime_threads)
+{
+    EXPECT_THAT(background_cpus({}, 4), testing::ElementsAre(0u, 1u, 2u, 3u));
+}
+
+TEST(background_cpus, skips_occupied_cpus)
+{
+    std::vector const threads{pinned(1), pinned(2)};
+
+    EXPECT_THAT(background_cpus(threads, 4), testing::ElementsAre(0u, 3u));
+}
+
+TEST(background_cpus, unpinned_threads_occupy_nothing)
+{
+    std::vector const threads{
+        configuration{
+            .affinity = std::nullopt,
+            .realtime_priority = 96,
+            .name = std::nullopt},
+        pinned(0)};
+
+    EXPECT_THAT(background_cpus(threads, 2), testing::ElementsAre(1u));
+}
+
+TEST(background_cpus, none_if_realtime_threads_occupy_every_cpu)
+{
+    std::vector const threads{pinned(1), pinned(2), pinned(3), pinned(0)};
+
+    EXPECT_TRUE(background_cpus(threads, 4).empty());
+}
+
+TEST(background_cpus, single_cpu)
+{
+    std::vector const threads{pinned(0)};
+
+    EXPECT_TRUE(background_cpus(threads, 1).empty());
+}
+
+} // namespace piejam::thread::test
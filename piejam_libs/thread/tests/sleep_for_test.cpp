@@ -0,0 +1,49 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/thread/sleep_for.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace piejam::thread::test
+{
+
+TEST(sleep_for, sleeps_for_the_duration)
+{
+    std::stop_source source;
+
+    auto const start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(sleep_for(source.get_token(), std::chrono::milliseconds{20}));
+    EXPECT_GE(
+        std::chrono::steady_clock::now() - start,
+        std::chrono::milliseconds{20});
+}
+
+TEST(sleep_for, stop_request_wakes_up)
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    bool result{true};
+    std::jthread sleeper{[&](std::stop_token stoken) {
+        result = sleep_for(stoken, std::chrono::seconds{10});
+    }};
+
+    sleeper.request_stop();
+    sleeper.join();
+
+    EXPECT_FALSE(result);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{5});
+}
+
+TEST(sleep_for, returns_immediately_if_stopped_already)
+{
+    std::stop_source source;
+    source.request_stop();
+
+    EXPECT_FALSE(sleep_for(source.get_token(), std::chrono::seconds{10}));
+}
+
+} // namespace piejam::thread::test
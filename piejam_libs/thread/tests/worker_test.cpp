@@ -0,0 +1,67 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2026  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/thread/worker.h>
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <vector>
+
+namespace piejam::thread::test
+{
+
+TEST(worker, posted_job_is_run)
+{
+    worker sut;
+
+    std::promise<void> done;
+    sut.post([&] { done.set_value(); });
+
+    EXPECT_EQ(
+        done.get_future().wait_for(std::chrono::seconds{1}),
+        std::future_status::ready);
+}
+
+TEST(worker, jobs_are_run_in_order)
+{
+    std::vector<int> order;
+    std::promise<void> done;
+
+    {
+        worker sut;
+
+        for (int i = 0; i < 10; ++i)
+        {
+            sut.post([&order, i] { order.push_back(i); });
+        }
+
+        sut.post([&] { done.set_value(); });
+
+        done.get_future().wait();
+    }
+
+    EXPECT_EQ(order, (std::vector{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(worker, destruction_waits_for_running_job)
+{
+    bool finished{};
+    std::promise<void> started;
+
+    {
+        worker sut;
+        sut.post([&] {
+            started.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            finished = true;
+        });
+
+        started.get_future().wait();
+    }
+
+    EXPECT_TRUE(finished);
+}
+
+} // namespace piejam::thread::test